@@ -5,6 +5,8 @@
 #define MATA_NFA_INTERNALS_HH_
 
 #include "nfa.hh"
+#include "simulation.hh"
+#include "product-view.hh"
 #include "mata/simlib/util/binary_relation.hh"
 
 /**
@@ -42,6 +44,48 @@ Nfa minimize_brzozowski(const Nfa& aut);
  */
 Nfa minimize_hopcroft(const Nfa& dfa_trimmed);
 
+/**
+ * Hopcroft minimization of automata with the splitter loop distributed among multiple threads.
+ *
+ * When a splitter (or a block) is large enough, marking of the source states of its transitions (or marking of the
+ *  transitions incoming to the block) is distributed among the threads. Each thread marks only the elements of the
+ *  blocks (splitters) assigned to it, so the threads never modify the same block. Pays off only for huge automata.
+ * @param[in] dfa_trimmed Deterministic automaton without useless states. Perform trimming before calling this function.
+ * @param[in] num_of_threads Number of threads to use. The sequential algorithm is used for a single thread.
+ * @return Minimized deterministic automaton, equal to the result of @c minimize_hopcroft() up to state renaming.
+ */
+Nfa minimize_hopcroft_parallel(const Nfa& dfa_trimmed, size_t num_of_threads);
+
+/**
+ * @brief Get the number of threads requested by the "threads" key of @p params.
+ *
+ * @param[in] function_name Name of the calling function used in the error message.
+ * @param[in] params Parameters with an optional "threads" key, "0" meaning all hardware threads.
+ * @return Number of threads, 1 if the key is missing.
+ */
+size_t get_num_of_threads(const std::string& function_name, const ParameterMap& params);
+
+/**
+ * @brief Check whether the "simulation" key of @p params requests pruning by a simulation.
+ *
+ * @param[in] function_name Name of the calling function used in the error message.
+ * @param[in] params Parameters with an optional "simulation" key. The only supported value is "forward".
+ * @return True iff the key is set to "forward".
+ * @throws std::runtime_error The key has an unknown value.
+ */
+bool use_simulation(const std::string& function_name, const ParameterMap& params);
+
+/**
+ * @brief Get the threshold on the number of states for @c BitStateSet macrostates requested by the
+ *  "bit_state_set_threshold" key of @p params.
+ *
+ * @param[in] function_name Name of the calling function used in the error message.
+ * @param[in] params Parameters with an optional "bit_state_set_threshold" key, "0" meaning never use bitsets.
+ * @return Threshold, @c DEFAULT_BIT_STATE_SET_THRESHOLD if the key is missing.
+ * @throws std::runtime_error The key has an invalid value.
+ */
+size_t get_bit_state_set_threshold(const std::string& function_name, const ParameterMap& params);
+
 /**
  * Complement implemented by determization, adding sink state and making automaton complete. Then it adds final states
  *  which were non final in the original automaton.
@@ -81,10 +125,95 @@ bool is_included_naive(const Nfa& smaller, const Nfa& bigger, const Alphabet* al
  * @param[in] bigger Automaton which language should include the smaller one
  * @param[in] alphabet Alphabet of both automata (not needed for antichain algorithm)
  * @param[out] cex A potential counterexample word which breaks inclusion
+ * @param[in] bit_state_set_threshold Use @c BitStateSet macrostates if @p bigger has fewer states.
+ * @return True if smaller language is included,
+ * i.e., if the final intersection of smaller complement of bigger is empty.
+ */
+bool is_included_antichains(const Nfa& smaller, const Nfa& bigger, const Alphabet*  alphabet = nullptr, Run* cex = nullptr,
+                            size_t bit_state_set_threshold = DEFAULT_BIT_STATE_SET_THRESHOLD);
+
+/**
+ * Inclusion implemented by antichain algorithms, running over frozen automata.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[out] cex A potential counterexample word which breaks inclusion
+ * @param[in] bit_state_set_threshold Use @c BitStateSet macrostates if @p bigger has fewer states.
+ * @return True if smaller language is included,
+ * i.e., if the final intersection of smaller complement of bigger is empty.
+ */
+bool is_included_antichains(const FrozenNfa& smaller, const FrozenNfa& bigger, Run* cex = nullptr,
+                            size_t bit_state_set_threshold = DEFAULT_BIT_STATE_SET_THRESHOLD);
+
+/**
+ * Inclusion implemented by antichain algorithms, pruned by the maximal forward simulation on the disjoint union of
+ *  @p smaller and @p bigger.
+ *
+ * A product state (p, R) is skipped if p is simulated by some state of R, and it is subsumed by (q, S) if p is
+ *  simulated by q and each state of S is simulated by some state of R. Sets of states of @p bigger are kept minimized,
+ *  i.e., without states simulated by other states of the set.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[out] cex A potential counterexample word which breaks inclusion
+ * @param[in] bit_state_set_threshold Use @c BitStateSet macrostates if @p bigger has fewer states.
+ * @return True if smaller language is included,
+ * i.e., if the final intersection of smaller complement of bigger is empty.
+ */
+bool is_included_antichains_simulation(const Nfa& smaller, const Nfa& bigger, Run* cex = nullptr,
+                                       size_t bit_state_set_threshold = DEFAULT_BIT_STATE_SET_THRESHOLD);
+
+/**
+ * Inclusion implemented by antichain algorithms, processing the product states by @p num_of_threads threads.
+ *
+ * Each thread processes its own worklist (depth-first) and steals the oldest product states from worklists of other
+ *  threads when its own worklist is empty. The antichain is sharded by the states of @p smaller, each shard guarded
+ *  by its own lock. The first thread to find a counterexample cancels all other threads.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] num_of_threads Number of threads to use. The sequential algorithm is used for a single thread.
+ * @param[out] cex A potential counterexample word which breaks inclusion. Not necessarily the same counterexample as
+ *  found by the sequential algorithm.
  * @return True if smaller language is included,
  * i.e., if the final intersection of smaller complement of bigger is empty.
  */
-bool is_included_antichains(const Nfa& smaller, const Nfa& bigger, const Alphabet*  alphabet = nullptr, Run* cex = nullptr);
+bool is_included_antichains_parallel(const Nfa& smaller, const Nfa& bigger, size_t num_of_threads, Run* cex = nullptr);
+bool is_included_antichains_parallel(const FrozenNfa& smaller, const FrozenNfa& bigger, size_t num_of_threads,
+                                     Run* cex = nullptr);
+
+/**
+ * Inclusion implemented by bisimulation up to congruence (HKC) of Bonchi and Pous.
+ *
+ * Checks that the macrostate of initial states of both automata is equivalent to the macrostate of initial states
+ *  of @p bigger, exploring pairs of macrostates breadth-first and skipping pairs in the congruence closure of the
+ *  already explored pairs. Typically explores far fewer pairs than antichains.
+ * @param[in] smaller Automaton which language should be included in the bigger one
+ * @param[in] bigger Automaton which language should include the smaller one
+ * @param[in] alphabet Alphabet of both automata (not needed for HKC)
+ * @param[out] cex A potential counterexample word which breaks inclusion, some shortest one
+ * @return True if smaller language is included.
+ */
+bool is_included_hkc(const Nfa& smaller, const Nfa& bigger, const Alphabet* alphabet = nullptr, Run* cex = nullptr);
+
+/**
+ * Equivalence implemented by bisimulation up to congruence (HKC) of Bonchi and Pous, see @c is_included_hkc().
+ * @param[in] lhs First automaton.
+ * @param[in] rhs Second automaton.
+ * @param[out] cex Some shortest word in the language of exactly one of the automata, if they are not equivalent.
+ * @return True if @p lhs and @p rhs are equivalent.
+ */
+bool are_equivalent_hkc(const Nfa& lhs, const Nfa& rhs, Word* cex = nullptr);
+
+/**
+ * Inclusion checking of lazy products with antichains, see @c ProductView.
+ *
+ * Product states of both views are discovered (and their transitions computed) only when the check reaches them,
+ *  and the check stops at the first counterexample. Wrap a single automaton by @c ProductView(const Nfa&).
+ * @param[in] smaller View which language should be included in the bigger one.
+ * @param[in] bigger View which language should include the smaller one.
+ * @param[out] cex A potential counterexample word which breaks inclusion, with a path through product states of
+ *  @p smaller.
+ * @return True if smaller language is included.
+ */
+bool is_included_antichains(ProductView& smaller, ProductView& bigger, Run* cex = nullptr);
 
 /**
  * Universality check implemented by checking emptiness of complemented automaton
@@ -100,10 +229,51 @@ bool is_universal_naive(const Nfa& aut, const Alphabet& alphabet, Run* cex);
  * @param[in] aut Automaton which universality is checked
  * @param[in] alphabet Alphabet of the automaton
  * @param[out] cex Counterexample word which eventually breaks the universality
+ * @param[in] bit_state_set_threshold Use @c BitStateSet macrostates if @p aut has fewer states.
+ * @return True if the automaton is universal, otherwise false.
+ */
+bool is_universal_antichains(const Nfa& aut, const Alphabet& alphabet, Run* cex,
+                             size_t bit_state_set_threshold = DEFAULT_BIT_STATE_SET_THRESHOLD);
+
+/**
+ * Universality checking based on subset construction with antichain, pruned by the maximal forward simulation.
+ *
+ * Macrostates are kept minimized, i.e., without states simulated by other states of the macrostate, and a macrostate
+ *  is subsumed by another one if each of its states is simulated by some state of the other one.
+ * @param[in] aut Automaton which universality is checked
+ * @param[in] alphabet Alphabet of the automaton
+ * @param[out] cex Counterexample word which eventually breaks the universality
+ * @param[in] bit_state_set_threshold Use @c BitStateSet macrostates if @p aut has fewer states.
  * @return True if the automaton is universal, otherwise false.
  */
-bool is_universal_antichains(const Nfa& aut, const Alphabet& alphabet, Run* cex);
+bool is_universal_antichains_simulation(const Nfa& aut, const Alphabet& alphabet, Run* cex,
+                                        size_t bit_state_set_threshold = DEFAULT_BIT_STATE_SET_THRESHOLD);
 
+/**
+ * @brief Compute the maximal direct simulation over states of @p aut.
+ *
+ * The simulation is computed natively over @c Delta by a partition-relation refinement.
+ * @param[in] aut Automaton to compute the simulation for.
+ * @param[in] params Parameters of the simulation:
+ * - "direction": "forward" (final states are simulated only by final states), "backward" (initial states are
+ *   simulated only by initial states, over the reverted transitions)
+ * @param[in] states If not @c nullptr, compute the simulation over the automaton restricted to @p states only,
+ *   ignoring transitions to other states. Allows recomputing the simulation, e.g., only over useful states after
+ *   @c Nfa::trim() without renumbering.
+ * @return Simulation relation, with blocks of mutually similar states.
+ */
+SimulationRelation compute_simulation(const Nfa& aut, const ParameterMap& params = {{ "direction", "forward" }},
+                                      const StateSet* states = nullptr);
+
+/**
+ * @brief Compute a relation over states of @p aut as a dense matrix.
+ *
+ * @param[in] params Parameters of the relation:
+ * - "relation": "simulation"
+ * - "direction": "forward", "backward"
+ * @return Relation as a @c Simlib::Util::BinaryRelation, taking space quadratic in the number of states. Prefer
+ *  @c compute_simulation() for big automata.
+ */
 Simlib::Util::BinaryRelation compute_relation(
         const Nfa& aut,
         const ParameterMap&  params = {{ "relation", "simulation"}, { "direction", "forward"}});
@@ -123,6 +293,44 @@ Simlib::Util::BinaryRelation compute_relation(
 Nfa product(const Nfa& lhs, const Nfa& rhs, const std::function<bool(State,State)> && final_condition,
             const Symbol first_epsilon = EPSILON, std::unordered_map<std::pair<State,State>, State> *prod_map = nullptr);
 
+/**
+ * @brief Compute product of two frozen NFAs, see @c product(const Nfa&, const Nfa&, ...).
+ */
+Nfa product(const FrozenNfa& lhs, const FrozenNfa& rhs, const std::function<bool(State,State)> && final_condition,
+            const Symbol first_epsilon = EPSILON, std::unordered_map<std::pair<State,State>, State> *prod_map = nullptr);
+
+/**
+ * @brief Compute product of NFAs @p automata in a single pass over tuples of their states, final condition is to be
+ *  specified.
+ *
+ * Tuples of states are interned in a @c TupleStore and the symbols are synchronized over all operands at once.
+ *  The operands are processed ordered by their number of states, the tuples passed to @p final_condition are always
+ *  in the order of @p automata. Each operand takes its ε-transitions on its own, the other operands stay in their
+ *  states.
+ * @param[in] automata NFAs to compute the product of, at least one.
+ * @param[in] final_condition The predicate that tells whether a tuple of states is final (conjunction for
+ *  intersection).
+ * @param[in] first_epsilon The smallest epsilon.
+ * @return NFA as a product of NFAs @p automata with ε-transitions preserved.
+ */
+Nfa product(std::span<const Nfa> automata, const std::function<bool(std::span<const State>)> && final_condition,
+            Symbol first_epsilon = EPSILON);
+
+/**
+ * @brief Remove ε-transitions over @p epsilon from @p aut into @p result.
+ *
+ * The ε-closures are computed over the SCCs of the graph of ε-transitions, condensed by @c Nfa::tarjan_scc_discover():
+ *  the SCCs are processed in a reverse topological order and the transitions of each SCC are merged once with the
+ *  already computed transitions of the SCCs reachable over a single ε-transition. All states in an SCC get the same
+ *  transitions, appended to @p result in the order of symbols.
+ *
+ * Shared by @c mata::nfa::remove_epsilon() and @c mata::nft::remove_epsilon().
+ * @param[in] aut Automaton to remove ε-transitions from.
+ * @param[in] epsilon Symbol of the ε-transitions.
+ * @param[out] result Automaton whose transitions and final states are replaced. Other members are kept.
+ */
+void remove_epsilon(const Nfa& aut, Symbol epsilon, Nfa& result);
+
 /**
  * @brief Concatenate two NFAs.
  *
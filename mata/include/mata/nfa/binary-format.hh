@@ -0,0 +1,164 @@
+/* binary-format.hh -- Binary, memory-mappable format of automata.
+ */
+
+#ifndef MATA_NFA_BINARY_FORMAT_HH_
+#define MATA_NFA_BINARY_FORMAT_HH_
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "mata/alphabet.hh"
+#include "mata/nfa/types.hh"
+#include "mata/nfa/delta.hh"
+#include "mata/utils/sparse-set.hh"
+
+/**
+ * Binary format of automata, loaded by mapping the file into memory.
+ *
+ * The file starts with a @c Header, followed by sections, each aligned to 8 bytes:
+ *  1. initial states as a bitset of 64-bit words,
+ *  2. final states as a bitset of 64-bit words,
+ *  3. transitions in the compressed sparse row (CSR) format as in @c FrozenDelta: offsets of symbol posts of each
+ *     state (@c num_of_states + 1 values), offsets of targets of each symbol post (@c num_of_symbol_posts + 1
+ *     values) and targets of all symbol posts,
+ *  4. levels of states (NFT only, @c num_of_states values),
+ *  5. optional alphabet as a string table: symbols, offsets of their names (@c num_of_alphabet_symbols + 1 values),
+ *  6. symbols of all symbol posts,
+ *  7. characters of the names of the alphabet symbols.
+ *
+ * The data are stored in the native byte order and with the native sizes of @c State and @c Symbol, both checked when
+ *  the file is mapped. Hence, the file is portable only between machines with the same byte order and type sizes.
+ */
+namespace mata::nfa::binary {
+
+/// Version of the format, increased on each incompatible change of the layout.
+constexpr uint32_t FORMAT_VERSION{ 1 };
+
+/// Kind of the automaton stored in the file.
+enum class AutomatonKind : uint32_t {
+    NFA = 0,
+    NFT = 1,
+};
+
+/// Header of the binary format.
+struct Header {
+    char magic[8];
+    /// @c 0x01020304 written in the native byte order of the machine which saved the file.
+    uint32_t byte_order;
+    uint32_t version;
+    uint32_t kind;
+    uint32_t state_size;
+    uint32_t symbol_size;
+    uint32_t reserved;
+    uint64_t num_of_states;
+    uint64_t num_of_symbol_posts;
+    uint64_t num_of_transitions;
+    /// Number of levels of an NFT, 0 for an NFA.
+    uint64_t num_of_levels;
+    /// Number of symbols in the alphabet string table, 0 when no alphabet is stored.
+    uint64_t num_of_alphabet_symbols;
+    /// Number of characters of all names in the alphabet string table.
+    uint64_t alphabet_names_size;
+};
+
+/**
+ * @brief Save @p aut into @p path in the binary format.
+ *
+ * @param[in] path File to write the automaton into.
+ * @param[in] aut Automaton to save.
+ * @param[in] kind Kind of the automaton.
+ * @param[in] levels Levels of states of an NFT, one for each state. Empty for an NFA.
+ * @param[in] num_of_levels Number of levels of an NFT. 0 for an NFA.
+ * @param[in] alphabet If specified, the names of all symbols from @c Alphabet::get_alphabet_symbols() are stored.
+ * @throws std::runtime_error The file cannot be written or @p levels do not match the states of an NFT.
+ */
+void save(const std::filesystem::path& path, const Nfa& aut, AutomatonKind kind, std::span<const uint64_t> levels = {},
+          size_t num_of_levels = 0, const Alphabet* alphabet = nullptr);
+
+/**
+ * @brief Automaton in the binary format mapped into memory.
+ *
+ * All sections of the file are accessed directly in the mapped memory, without parsing or copying. Use the accessors
+ *  to run read-only algorithms over the file, or @c get_delta(), @c get_initial() and @c get_final() to construct an
+ *  automaton. The mapping is released when the object is destroyed, invalidating all spans returned by the object.
+ */
+class MappedAutomaton {
+public:
+    /**
+     * @brief Map the file @p path into memory.
+     *
+     * @throws std::runtime_error The file cannot be mapped or is not a valid file in the binary format of this version
+     *  for this machine, e.g., its sections do not fit into the file or levels of states are out of range.
+     */
+    explicit MappedAutomaton(const std::filesystem::path& path);
+    MappedAutomaton(const MappedAutomaton&) = delete;
+    MappedAutomaton(MappedAutomaton&& other) noexcept;
+    MappedAutomaton& operator=(const MappedAutomaton&) = delete;
+    MappedAutomaton& operator=(MappedAutomaton&& other) noexcept;
+    ~MappedAutomaton();
+
+    const Header& header() const { return *header_; }
+    AutomatonKind kind() const { return static_cast<AutomatonKind>(header_->kind); }
+    size_t num_of_states() const { return header_->num_of_states; }
+
+    bool is_initial(const State state) const { return state < num_of_states() && is_in_bitset(initial_, state); }
+    bool is_final(const State state) const { return state < num_of_states() && is_in_bitset(final_, state); }
+
+    /// Symbol posts of state @c q are at indices <tt>[state_offsets()[q], state_offsets()[q+1])</tt>.
+    std::span<const uint64_t> state_offsets() const { return state_offsets_; }
+    std::span<const Symbol> symbols() const { return symbols_; }
+    /// Targets of symbol post @c i are at indices <tt>[target_offsets()[i], target_offsets()[i+1])</tt>.
+    std::span<const uint64_t> target_offsets() const { return target_offsets_; }
+    std::span<const State> targets() const { return targets_; }
+    /// Levels of states of an NFT, empty for an NFA.
+    std::span<const uint64_t> levels() const { return levels_; }
+
+    /// Check whether the file contains an alphabet.
+    bool has_alphabet() const { return !alphabet_symbols_.empty(); }
+
+    /**
+     * @brief Add all symbols of the stored alphabet to @p alphabet.
+     *
+     * @throws std::runtime_error A symbol name is already in @p alphabet with a different symbol.
+     */
+    void fill_alphabet(OnTheFlyAlphabet& alphabet) const;
+
+    /**
+     * @brief Construct transitions from the mapped CSR arrays.
+     *
+     * The transitions are appended to each state post in their stored (sorted) order, no sorting or searching is
+     *  performed.
+     * @throws std::runtime_error The transitions are not sorted or refer to states outside the automaton.
+     */
+    Delta get_delta() const;
+    utils::SparseSet<State> get_initial() const { return get_states(initial_); }
+    utils::SparseSet<State> get_final() const { return get_states(final_); }
+
+private:
+    void* data_{ nullptr };
+    size_t size_{ 0 };
+
+    const Header* header_{ nullptr };
+    std::span<const uint64_t> initial_{};
+    std::span<const uint64_t> final_{};
+    std::span<const uint64_t> state_offsets_{};
+    std::span<const uint64_t> target_offsets_{};
+    std::span<const State> targets_{};
+    std::span<const uint64_t> levels_{};
+    std::span<const uint64_t> alphabet_symbols_{};
+    std::span<const uint64_t> alphabet_name_offsets_{};
+    std::span<const Symbol> symbols_{};
+    std::span<const char> alphabet_names_{};
+
+    static bool is_in_bitset(const std::span<const uint64_t> bitset, const State state) {
+        return (bitset[state / 64] >> (state % 64)) & 1;
+    }
+    utils::SparseSet<State> get_states(std::span<const uint64_t> bitset) const;
+    void unmap();
+}; // class MappedAutomaton.
+
+} // namespace mata::nfa::binary.
+
+#endif // MATA_NFA_BINARY_FORMAT_HH_.
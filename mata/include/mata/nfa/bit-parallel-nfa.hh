@@ -0,0 +1,159 @@
+/* bit-parallel-nfa.hh -- Bit-parallel simulation of small NFAs.
+ */
+
+#ifndef MATA_NFA_BIT_PARALLEL_NFA_HH_
+#define MATA_NFA_BIT_PARALLEL_NFA_HH_
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "mata/nfa/types.hh"
+
+namespace mata::nfa {
+
+class Nfa;
+
+/**
+ * @brief Compiled NFA with at most @p Width positions, simulated by bit-parallel operations over sets of positions.
+ *
+ * The automaton is first made epsilon-free (the epsilon closure is folded into the transitions) and trimmed. Then,
+ *  as in the Glushkov automaton, each state is split into positions, one for each group of symbols over which the
+ *  state is entered from the same set of sources (e.g., a character class), and one more for each initial state.
+ *  Each source then enters a position over all symbols of its group, hence one step of the simulation over symbol
+ *  @c a from the set of positions @c S is <tt>follow(S) & symbol_mask[a]</tt>, where @c follow(S) are all successors
+ *  of @c S over any symbol.
+ *
+ * Sets of positions are bit masks of @p Width bits. @c follow(S) is computed by looking up each byte of @c S in a
+ *  precomputed table of successors of all subsets of the 8 positions of the byte, hence a step costs at most
+ *  <tt>Width / 8</tt> table lookups and word-wide ORs, instead of walking @c StatePost of each state.
+ *
+ * Instances are provided for widths 64, 128 and 256, see @c BitParallelNfa64, @c BitParallelNfa128 and
+ *  @c BitParallelNfa256.
+ *
+ * @tparam Width Maximal number of positions, a multiple of 64.
+ */
+template<size_t Width>
+class BitParallelNfa {
+    static_assert(Width > 0 && Width % 64 == 0, "The width of BitParallelNfa must be a positive multiple of 64.");
+
+public:
+    /// Maximal number of positions.
+    static constexpr size_t MAX_POSITIONS{ Width };
+
+    /**
+     * @brief Compile @p aut.
+     *
+     * @param[in] aut Automaton to compile.
+     * @param[in] epsilon Symbol to handle as an epsilon. Epsilon transitions are removed before the compilation.
+     * @throws std::runtime_error The automaton has more than @p Width positions.
+     */
+    explicit BitParallelNfa(const Nfa& aut, Symbol epsilon = EPSILON);
+
+    /// Number of positions of the compiled automaton.
+    size_t num_of_positions() const { return num_of_positions_; }
+
+    /// Check whether @p word is in the language of the automaton.
+    bool is_in_lang(std::span<const Symbol> word) const;
+    /// Check whether @p bytes, each byte being a symbol, is in the language of the automaton.
+    bool is_in_lang(std::string_view bytes) const;
+
+    /// Check whether some prefix of @p word is in the language of the automaton.
+    bool is_prfx_in_lang(std::span<const Symbol> word) const;
+    /// Check whether some prefix of @p bytes, each byte being a symbol, is in the language of the automaton.
+    bool is_prfx_in_lang(std::string_view bytes) const;
+
+    /**
+     * @brief Find the first match of the automaton in @p word, i.e., the smallest @c end such that some infix
+     *  <tt>word[begin, end)</tt> is in the language of the automaton.
+     *
+     * @return The end of the first match, or @c std::nullopt if no infix of @p word is in the language.
+     */
+    std::optional<size_t> find_first_match(std::span<const Symbol> word) const;
+    /// Find the first match of the automaton in @p bytes, each byte being a symbol. See the overload for words.
+    std::optional<size_t> find_first_match(std::string_view bytes) const;
+
+private:
+    static constexpr size_t NUM_OF_WORDS{ Width / 64 };
+    static constexpr size_t NUM_OF_BYTES{ 256 };
+
+    /// Set of positions.
+    struct Mask {
+        std::array<uint64_t, NUM_OF_WORDS> words{};
+
+        void set(const size_t position) { words[position / 64] |= uint64_t{ 1 } << (position % 64); }
+        bool any() const {
+            for (const uint64_t word: words) { if (word != 0) { return true; } }
+            return false;
+        }
+        bool intersects_with(const Mask& other) const {
+            for (size_t i{ 0 }; i < NUM_OF_WORDS; ++i) { if ((words[i] & other.words[i]) != 0) { return true; } }
+            return false;
+        }
+        /// Get the byte @p index of the mask, i.e., the positions <tt>[8 * index, 8 * index + 8)</tt>.
+        size_t get_byte(const size_t index) const { return (words[index / 8] >> (index % 8 * 8)) & 0xFF; }
+        Mask& operator|=(const Mask& other) {
+            for (size_t i{ 0 }; i < NUM_OF_WORDS; ++i) { words[i] |= other.words[i]; }
+            return *this;
+        }
+        Mask& operator&=(const Mask& other) {
+            for (size_t i{ 0 }; i < NUM_OF_WORDS; ++i) { words[i] &= other.words[i]; }
+            return *this;
+        }
+    };
+
+    size_t num_of_positions_{ 0 };
+    /// Number of bytes of masks with some position.
+    size_t num_of_used_bytes_{ 0 };
+    Mask initial_{};
+    Mask final_{};
+    /// Positions entered over each symbol smaller than @c NUM_OF_BYTES.
+    std::array<Mask, NUM_OF_BYTES> byte_masks_{};
+    /// Positions entered over each symbol at least @c NUM_OF_BYTES.
+    std::unordered_map<Symbol, Mask> symbol_masks_{};
+    /// Successors of all subsets of positions in each byte: the successors of the subset @c v of the byte @c i of a
+    ///  mask are at <tt>i * NUM_OF_BYTES + v</tt>.
+    std::vector<Mask> byte_follow_{};
+
+    static Symbol to_symbol(const Symbol symbol) { return symbol; }
+    static Symbol to_symbol(const char byte) { return static_cast<unsigned char>(byte); }
+
+    const Mask& get_symbol_mask(const Symbol symbol) const {
+        if (symbol < NUM_OF_BYTES) { return byte_masks_[symbol]; }
+        static const Mask EMPTY_MASK{};
+        const auto it{ symbol_masks_.find(symbol) };
+        return it == symbol_masks_.end() ? EMPTY_MASK : it->second;
+    }
+
+    /// Compute the positions reachable from @p current over @p symbol.
+    Mask step(const Mask& current, const Symbol symbol) const {
+        Mask next{};
+        for (size_t byte_index{ 0 }; byte_index < num_of_used_bytes_; ++byte_index) {
+            if (const size_t byte{ current.get_byte(byte_index) }; byte != 0) {
+                next |= byte_follow_[byte_index * NUM_OF_BYTES + byte];
+            }
+        }
+        next &= get_symbol_mask(symbol);
+        return next;
+    }
+
+    template<typename Symbols> bool is_in_lang_impl(const Symbols& word) const;
+    template<typename Symbols> bool is_prfx_in_lang_impl(const Symbols& word) const;
+    template<typename Symbols> std::optional<size_t> find_first_match_impl(const Symbols& word) const;
+}; // class BitParallelNfa.
+
+extern template class BitParallelNfa<64>;
+extern template class BitParallelNfa<128>;
+extern template class BitParallelNfa<256>;
+
+using BitParallelNfa64 = BitParallelNfa<64>;
+using BitParallelNfa128 = BitParallelNfa<128>;
+using BitParallelNfa256 = BitParallelNfa<256>;
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_BIT_PARALLEL_NFA_HH_.
@@ -0,0 +1,178 @@
+/* bit-state-set.hh -- Set of states represented as a fixed-width bitset.
+ */
+
+#ifndef MATA_NFA_BIT_STATE_SET_HH_
+#define MATA_NFA_BIT_STATE_SET_HH_
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <vector>
+
+#include "mata/nfa/types.hh"
+
+namespace mata::nfa {
+
+/**
+ * @brief Default threshold on the number of states of an automaton below which subset constructions
+ *  (@c determinize(), @c is_included_antichains(), @c is_universal_antichains()) represent macrostates as
+ *  @c BitStateSet instead of @c StateSet.
+ *
+ * A @c BitStateSet takes <tt>num_of_states / 8</tt> bytes regardless of the number of states in the set, hence the
+ *  bitsets pay off only for automata with not too many states. The subset constructions take the threshold as an
+ *  argument, the dispatching functions from the "bit_state_set_threshold" key of their parameters.
+ */
+inline constexpr size_t DEFAULT_BIT_STATE_SET_THRESHOLD{ 2048 };
+
+/// Whether subset constructions over an automaton with @p num_of_states states should use @c BitStateSet.
+constexpr bool use_bit_state_sets(const size_t num_of_states,
+                                  const size_t threshold = DEFAULT_BIT_STATE_SET_THRESHOLD) {
+    return num_of_states < threshold;
+}
+
+/**
+ * @brief Set of states over a fixed domain <tt>[0, domain_size)</tt>, represented as a bitset.
+ *
+ * All binary operations (union, intersection, inclusion, comparison) are word-wise loops without branches over
+ *  the 64-bit blocks, written so that compilers can vectorize them for the target architecture without any
+ *  architecture-specific code. Both operands of binary operations must have the same domain size.
+ */
+class BitStateSet {
+public:
+    using Block = uint64_t;
+    static constexpr size_t BLOCK_SIZE{ 64 };
+
+    BitStateSet() = default;
+    /// Create an empty set over the domain <tt>[0, domain_size)</tt>.
+    explicit BitStateSet(const size_t domain_size): blocks_((domain_size + BLOCK_SIZE - 1) / BLOCK_SIZE, 0) {}
+    /// Create a set over the domain <tt>[0, domain_size)</tt> with @p states.
+    template<std::ranges::range States>
+    BitStateSet(const size_t domain_size, const States& states): BitStateSet(domain_size) { insert(states); }
+
+    size_t domain_size() const { return blocks_.size() * BLOCK_SIZE; }
+    size_t num_of_blocks() const { return blocks_.size(); }
+    const Block* blocks() const { return blocks_.data(); }
+
+    bool contains(const State state) const {
+        assert(state < domain_size());
+        return (blocks_[state / BLOCK_SIZE] >> (state % BLOCK_SIZE)) & 1;
+    }
+    bool operator[](const State state) const { return contains(state); }
+
+    void insert(const State state) {
+        assert(state < domain_size());
+        blocks_[state / BLOCK_SIZE] |= Block{ 1 } << (state % BLOCK_SIZE);
+    }
+    template<std::ranges::range States>
+    void insert(const States& states) { for (const State state: states) { insert(state); } }
+
+    void erase(const State state) {
+        assert(state < domain_size());
+        blocks_[state / BLOCK_SIZE] &= ~(Block{ 1 } << (state % BLOCK_SIZE));
+    }
+
+    /// Remove all states, keeping the domain.
+    void clear() { std::fill(blocks_.begin(), blocks_.end(), 0); }
+
+    /// Number of states in the set.
+    size_t size() const {
+        size_t size{ 0 };
+        for (const Block block: blocks_) { size += static_cast<size_t>(std::popcount(block)); }
+        return size;
+    }
+
+    bool empty() const {
+        Block any{ 0 };
+        for (const Block block: blocks_) { any |= block; }
+        return any == 0;
+    }
+
+    bool is_subset_of(const BitStateSet& other) const {
+        assert(num_of_blocks() == other.num_of_blocks());
+        Block extra{ 0 };
+        for (size_t i{ 0 }, num_of_blocks{ blocks_.size() }; i < num_of_blocks; ++i) {
+            extra |= blocks_[i] & ~other.blocks_[i];
+        }
+        return extra == 0;
+    }
+
+    bool intersects_with(const BitStateSet& other) const {
+        assert(num_of_blocks() == other.num_of_blocks());
+        Block common{ 0 };
+        for (size_t i{ 0 }, num_of_blocks{ blocks_.size() }; i < num_of_blocks; ++i) {
+            common |= blocks_[i] & other.blocks_[i];
+        }
+        return common != 0;
+    }
+
+    /// Union with @p other in-place.
+    BitStateSet& operator|=(const BitStateSet& other) {
+        assert(num_of_blocks() == other.num_of_blocks());
+        for (size_t i{ 0 }, num_of_blocks{ blocks_.size() }; i < num_of_blocks; ++i) { blocks_[i] |= other.blocks_[i]; }
+        return *this;
+    }
+
+    /// Intersection with @p other in-place.
+    BitStateSet& operator&=(const BitStateSet& other) {
+        assert(num_of_blocks() == other.num_of_blocks());
+        for (size_t i{ 0 }, num_of_blocks{ blocks_.size() }; i < num_of_blocks; ++i) { blocks_[i] &= other.blocks_[i]; }
+        return *this;
+    }
+
+    BitStateSet operator|(const BitStateSet& other) const { BitStateSet result{ *this }; return result |= other; }
+    BitStateSet operator&(const BitStateSet& other) const { BitStateSet result{ *this }; return result &= other; }
+
+    bool operator==(const BitStateSet& other) const = default;
+    /// Lexicographic order on the blocks (not the order of @c StateSet). Allows using the sets as keys of maps.
+    std::strong_ordering operator<=>(const BitStateSet& other) const = default;
+
+    size_t hash() const {
+        size_t hash{ blocks_.size() };
+        for (const Block block: blocks_) {
+            // Mixing as in boost::hash_combine, with the 64-bit golden ratio constant.
+            hash ^= std::hash<Block>{}(block) + 0x9e3779b97f4a7c15ULL + (hash << 12) + (hash >> 4);
+        }
+        return hash;
+    }
+
+    /// Call @p function on each state in the set, in an ascending order.
+    template<typename Function>
+    void for_each(Function&& function) const {
+        for (size_t i{ 0 }, num_of_blocks{ blocks_.size() }; i < num_of_blocks; ++i) {
+            for (Block block{ blocks_[i] }; block != 0; block &= block - 1) {
+                function(static_cast<State>(i * BLOCK_SIZE + static_cast<size_t>(std::countr_zero(block))));
+            }
+        }
+    }
+
+    /// Write the states in an ascending order into @p states (cleared first).
+    void to_vector(std::vector<State>& states) const {
+        states.clear();
+        for_each([&](const State state) { states.push_back(state); });
+    }
+
+    /// Convert to @c StateSet.
+    StateSet to_state_set() const {
+        StateSet state_set{};
+        for_each([&](const State state) { state_set.push_back(state); });
+        return state_set;
+    }
+
+private:
+    std::vector<Block> blocks_{};
+}; // class BitStateSet.
+
+} // namespace mata::nfa.
+
+namespace std {
+template<>
+struct hash<mata::nfa::BitStateSet> {
+    size_t operator()(const mata::nfa::BitStateSet& set) const noexcept { return set.hash(); }
+};
+} // namespace std.
+
+#endif // MATA_NFA_BIT_STATE_SET_HH_.
@@ -4,8 +4,10 @@
 #define LIBMATA_BUILDER_HH
 
 #include "nfa.hh"
+#include "symbolic-nfa.hh"
 
 #include <filesystem>
+#include <random>
 
 
 /**
@@ -59,12 +61,34 @@ Nfa create_sigma_star_nfa(Alphabet* alphabet = new OnTheFlyAlphabet{});
  */
 Nfa create_random_nfa_tabakov_vardi(const size_t num_of_states, const size_t alphabet_size, const double states_trans_ratio_per_symbol, const double final_state_density);
 
+/**
+ * Creates Tabakov-Vardi random NFA using the random number engine @p generator.
+ *
+ * The same as @c create_random_nfa_tabakov_vardi() seeded by @c std::random_device, but the automaton depends only on
+ *  the state of @p generator. Use a fixed seed of @p generator to create reproducible automata.
+ */
+Nfa create_random_nfa_tabakov_vardi(const size_t num_of_states, const size_t alphabet_size, const double states_trans_ratio_per_symbol, const double final_state_density, std::mt19937& generator);
+
 /** Loads an automaton from Parsed object */
 // TODO this function should the same thing as the one taking IntermediateAut or be deleted
 Nfa construct(const mata::parser::ParsedSection& parsec, Alphabet* alphabet, NameStateMap* state_map = nullptr);
 
 /** Loads an automaton from Parsed object */
 Nfa construct(const mata::IntermediateAut& inter_aut, Alphabet* alphabet, NameStateMap* state_map = nullptr);
+/**
+ * @brief Load an automaton over a bitvector alphabet (e.g., in the @c NFA-bits format) as a @c SymbolicNfa.
+ *
+ * The formula of each transition is translated into a BDD guard directly, without the mintermization.
+ * @param[in] inter_aut Parsed automaton with a bitvector alphabet.
+ * @param[in] manager Manager of the BDDs, share it among automata to be combined.
+ * @param[in,out] symbol_to_bddvar BDD variables of the bitvector variables, new variables are added for names not
+ *  present yet. Share it among automata to be combined.
+ * @param[out] state_map Map of state names to states.
+ */
+SymbolicNfa construct_symbolic(
+    const mata::IntermediateAut& inter_aut, const Cudd& manager,
+    std::unordered_map<std::string, BDD>* symbol_to_bddvar = nullptr, NameStateMap* state_map = nullptr
+);
 /** Loads an automaton from Parsed object; version for python binding */
 void construct(
     Nfa* result, const mata::IntermediateAut& inter_aut, Alphabet* alphabet, NameStateMap* state_map = nullptr
@@ -80,6 +104,17 @@ Nfa construct(const ParsedObject& parsed, Alphabet* alphabet = nullptr,
     return construct(parsed, alphabet, state_map);
 } // construct().
 
+/**
+ * Parse NFA from the mata format in a buffer in memory.
+ *
+ * Automata of type @c NFA-explicit with states named by the marker @c q and enumerated initial and final states are
+ *  constructed directly while tokenizing the buffer. Other automata are parsed through @c IntermediateAut.
+ *
+ * @param nfa_in_mata Buffer containing NFA in mata format.
+ * @throws std::runtime_error Parsing of NFA fails.
+ */
+Nfa parse_from_mata(std::string_view nfa_in_mata);
+
 /**
  * Parse NFA from the mata format in an input stream.
  *
@@ -105,6 +140,18 @@ Nfa parse_from_mata(const std::string& nfa_in_mata);
  */
 Nfa parse_from_mata(const std::filesystem::path& nfa_file);
 
+/**
+ * Load NFA from a file in the binary format, see @c Nfa::save_binary().
+ *
+ * The file is mapped into memory and the automaton is constructed directly from the mapped transitions, without any
+ *  parsing.
+ * @param path Path to the file containing NFA in the binary format.
+ * @param alphabet If specified and the file contains an alphabet, the symbols of the alphabet are added to
+ *  @p alphabet, which is set as the alphabet of the NFA.
+ * @throws std::runtime_error @p path is not a file with an NFA in the binary format.
+ */
+Nfa mmap_binary(const std::filesystem::path& path, OnTheFlyAlphabet* alphabet = nullptr);
+
 } // namespace mata::nfa::builder.
 
 #endif //LIBMATA_BUILDER_HH
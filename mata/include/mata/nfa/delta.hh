@@ -7,6 +7,7 @@
 #include "mata/utils/synchronized-iterator.hh"
 #include "mata/alphabet.hh"
 #include "mata/nfa/types.hh"
+#include "mata/nfa/reverse-delta.hh"
 
 #include <iterator>
 
@@ -193,6 +194,15 @@ public:
      * Count the number of all moves in @c StatePost.
      */
     size_t num_of_moves() const;
+
+    /**
+     * @brief Append moves given as pairs of a symbol and a target, in any order and possibly with duplicates.
+     *
+     * @p moves are sorted and deduplicated in place first, so that they can be collected in a reused buffer. All their
+     *  symbols must be greater than the symbols already in @c StatePost (e.g., when filling an empty @c StatePost).
+     * @param[in,out] moves Moves to append.
+     */
+    void append_moves(std::vector<std::pair<Symbol, State>>& moves);
 }; // class StatePost.
 
 /**
@@ -250,6 +260,14 @@ public:
      */
     StateSet unify_targets() const;
 
+    /**
+     * @brief Get union of all targets into a reusable buffer @p unified_targets.
+     *
+     * The buffer is cleared first and then filled with the sorted targets without duplicates. Reusing the same buffer
+     *  for many calls avoids allocating a new @c StateSet for each symbol.
+     */
+    void unify_targets(std::vector<State>& unified_targets) const;
+
     /**
      * @brief Synchronize with the given SymbolPost @p sync.
      *
@@ -350,11 +368,15 @@ public:
 
     template <typename... Args>
     StatePost& emplace_back(Args&&... args) {
+        reverse_delta_cache_.invalidate();
 	// Forwarding the variadic template pack of arguments to the emplace_back() of the underlying container.
         return state_posts_.emplace_back(std::forward<Args>(args)...);
     }
 
-    void clear() { state_posts_.clear(); }
+    void clear() {
+        reverse_delta_cache_.invalidate();
+        state_posts_.clear();
+    }
 
     /**
      * @brief Allocate state posts up to @p num_of_states states, creating empty @c StatePost for yet unallocated state
@@ -365,6 +387,7 @@ public:
      */
     void allocate(const size_t num_of_states) {
         assert(num_of_states >= this->num_of_states());
+        reverse_delta_cache_.invalidate();
         state_posts_.resize(num_of_states);
     }
 
@@ -409,6 +432,7 @@ public:
      * @param post_vector Vector of posts to be appended.
      */
     void append(const std::vector<StatePost>& post_vector) {
+        reverse_delta_cache_.invalidate();
         for(const StatePost& pst : post_vector) {
             this->state_posts_.push_back(pst);
         }
@@ -453,10 +477,21 @@ public:
      * @param state_to[in] Target state for transitions to get.
      * @return Transitions leading to @p state_to.
      *
-     * Operation is slow, traverses over all symbol posts.
+     * Operation is slow, traverses over all symbol posts. Use @c get_reverse_delta() for repeated queries.
      */
     std::vector<Transition> get_transitions_to(State state_to) const;
 
+    /**
+     * @brief Get the index of transitions incoming to each state.
+     *
+     * The index is built on the first call and cached in the delta, so that repeated backward traversals of an
+     *  unchanged delta do not rebuild the predecessors. Any mutating operation of the delta drops the cached index.
+     *  Modifications through a reference obtained from @c mutable_state_post() or @c emplace_back() before the call
+     *  are not tracked, hence do not keep such references while using the index.
+     * @return Shared index, valid even after the delta changes (it then describes the delta before the change).
+     */
+    std::shared_ptr<const ReverseDelta> get_reverse_delta() const { return reverse_delta_cache_.get(*this); }
+
     /**
      * Iterate over @p epsilon symbol posts under the given @p state.
      * @param[in] state State from which epsilon transitions are checked.
@@ -500,6 +535,7 @@ public:
     Symbol get_max_symbol() const;
 protected:
     std::vector<StatePost> state_posts_;
+    ReverseDeltaCache reverse_delta_cache_{};
 }; // class Delta.
 
 /**
@@ -0,0 +1,191 @@
+/* frozen-delta.hh -- Read-only transition relation in the compressed sparse row (CSR) format.
+ */
+
+#ifndef MATA_NFA_FROZEN_DELTA_HH_
+#define MATA_NFA_FROZEN_DELTA_HH_
+
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include "mata/utils/synchronized-iterator.hh"
+#include "mata/nfa/types.hh"
+#include "mata/nfa/delta.hh"
+
+namespace mata::nfa {
+
+/**
+ * @brief Read-only transition relation compacted into the compressed sparse row (CSR) format.
+ *
+ * @c Delta stores the transitions in a hierarchy of @c StatePost, @c SymbolPost and @c StateSet, that is, in three
+ *  levels of separately allocated vectors. @c FrozenDelta stores the same transitions in four flat arrays:
+ *  - @c state_offsets_: The symbol posts of state @c q are at indices <tt>[state_offsets_[q], state_offsets_[q+1])</tt>,
+ *  - @c symbols_: The symbol of each symbol post,
+ *  - @c target_offsets_: The targets of symbol post @c i are at indices
+ *    <tt>[target_offsets_[i], target_offsets_[i+1])</tt>,
+ *  - @c targets_: The targets of all symbol posts.
+ *
+ * Symbols of a state and targets of a symbol post are ordered in an ascending order, as in @c Delta. As all symbol
+ *  posts of a state are stored next to each other, the targets of all transitions from a state form a single
+ *  contiguous span, see @c successors().
+ *
+ * @c FrozenDelta cannot be modified. Create it from a @c Delta once all transitions are added and use it for
+ *  read-only algorithms. Use @c thaw() to get a modifiable @c Delta back.
+ */
+class FrozenDelta {
+public:
+    /// View of a symbol post of a @c FrozenDelta.
+    struct SymbolPostView {
+        Symbol symbol;
+        std::span<const State> targets;
+    };
+
+    /// View of all symbol posts of a state of a @c FrozenDelta, iterable as @c SymbolPostView.
+    class StatePostView {
+    public:
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = SymbolPostView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = SymbolPostView;
+
+            const_iterator() = default;
+            const_iterator(const FrozenDelta* delta, const Symbol* symbol_it): delta_{ delta }, symbol_it_{ symbol_it } {}
+
+            SymbolPostView operator*() const { return { *symbol_it_, delta_->targets(symbol_it_) }; }
+            const_iterator& operator++() { ++symbol_it_; return *this; }
+            const_iterator operator++(int) { const_iterator tmp{ *this }; ++symbol_it_; return tmp; }
+            bool operator==(const const_iterator& other) const { return symbol_it_ == other.symbol_it_; }
+
+        private:
+            const FrozenDelta* delta_{ nullptr };
+            const Symbol* symbol_it_{ nullptr };
+        };
+
+        StatePostView(const FrozenDelta* delta, std::span<const Symbol> symbols): delta_{ delta }, symbols_{ symbols } {}
+
+        const_iterator begin() const { return { delta_, symbols_.data() }; }
+        const_iterator end() const { return { delta_, symbols_.data() + symbols_.size() }; }
+        size_t size() const { return symbols_.size(); }
+        bool empty() const { return symbols_.empty(); }
+
+    private:
+        const FrozenDelta* delta_;
+        std::span<const Symbol> symbols_;
+    };
+
+    FrozenDelta() = default;
+    /// Compact @p delta into the CSR format.
+    explicit FrozenDelta(const Delta& delta);
+
+    bool operator==(const FrozenDelta& other) const = default;
+
+    /// Number of states with allocated (possibly empty) posts, the same as @c Delta::num_of_states().
+    size_t num_of_states() const { return state_offsets_.size() - 1; }
+    size_t num_of_symbol_posts() const { return symbols_.size(); }
+    size_t num_of_transitions() const { return targets_.size(); }
+    /// Check whether there are no transitions.
+    bool empty() const { return targets_.empty(); }
+
+    /**
+     * @brief Get a view of all symbol posts of @p source.
+     *
+     * Similarly to @c Delta::operator[], an empty view is returned for states without allocated posts.
+     */
+    StatePostView operator[](const State source) const { return { this, symbols(source) }; }
+
+    /**
+     * @brief Get symbols of all transitions from @p source, ordered in an ascending order.
+     *
+     * Pointers into the returned span identify the symbol posts of @p source, see @c targets(const Symbol*).
+     */
+    std::span<const Symbol> symbols(const State source) const {
+        if (source >= num_of_states()) { return {}; }
+        return { symbols_.data() + state_offsets_[source], symbols_.data() + state_offsets_[source + 1] };
+    }
+
+    /**
+     * @brief Get targets of the symbol post identified by @p symbol_it.
+     *
+     * @param[in] symbol_it Pointer into a span returned by @c symbols().
+     */
+    std::span<const State> targets(const Symbol* const symbol_it) const {
+        const auto symbol_post_index{ static_cast<size_t>(symbol_it - symbols_.data()) };
+        return { targets_.data() + target_offsets_[symbol_post_index],
+                 targets_.data() + target_offsets_[symbol_post_index + 1] };
+    }
+
+    /// Get targets of transitions from @p source over @p symbol.
+    std::span<const State> targets(State source, Symbol symbol) const;
+
+    /**
+     * @brief Get targets of all transitions from @p source over all symbols.
+     *
+     * The targets are ordered per symbol, hence the span is not sorted and can contain duplicates.
+     */
+    std::span<const State> successors(const State source) const {
+        if (source >= num_of_states()) { return {}; }
+        return { targets_.data() + target_offsets_[state_offsets_[source]],
+                 targets_.data() + target_offsets_[state_offsets_[source + 1]] };
+    }
+
+    /// Convert back into a modifiable @c Delta.
+    Delta thaw() const;
+
+private:
+    std::vector<size_t> state_offsets_{ 0 };
+    std::vector<Symbol> symbols_{};
+    std::vector<size_t> target_offsets_{ 0 };
+    std::vector<State> targets_{};
+}; // class FrozenDelta.
+
+/**
+ * @brief Synchronized existential iterator over symbols of several states of a @c FrozenDelta.
+ *
+ * Counterpart of @c SynchronizedExistentialSymbolPostIterator for @c FrozenDelta. Positions are pointers into
+ *  @c FrozenDelta::symbols(), from which the targets are accessed.
+ */
+class SynchronizedExistentialFrozenSymbolIterator : public utils::SynchronizedExistentialIterator<const Symbol*> {
+public:
+    explicit SynchronizedExistentialFrozenSymbolIterator(const FrozenDelta& delta): delta_{ &delta } {}
+    SynchronizedExistentialFrozenSymbolIterator(const SynchronizedExistentialFrozenSymbolIterator& other) = default;
+    SynchronizedExistentialFrozenSymbolIterator& operator=(const SynchronizedExistentialFrozenSymbolIterator& other) = default;
+
+    /// Add symbol posts of @p source to the iterator.
+    void push_back(const State source) {
+        const std::span<const Symbol> symbols{ delta_->symbols(source) };
+        SynchronizedExistentialIterator::push_back(symbols.data(), symbols.data() + symbols.size());
+    }
+    using SynchronizedExistentialIterator::push_back;
+
+    /// Symbol the iterator is currently synchronized at.
+    Symbol get_current_symbol() { return *get_current_minimum(); }
+
+    /**
+     * @brief Get union of all targets.
+     */
+    StateSet unify_targets() const;
+
+    /**
+     * @brief Get union of all targets into a reusable buffer @p unified_targets.
+     *
+     * The buffer is cleared first and then filled with the sorted targets without duplicates.
+     */
+    void unify_targets(std::vector<State>& unified_targets) const;
+
+    /**
+     * @brief Synchronize with the given symbol @p sync_symbol.
+     *
+     * @return True iff the synchronized iterator points to the same symbol as @p sync_symbol.
+     */
+    bool synchronize_with(Symbol sync_symbol);
+
+private:
+    const FrozenDelta* delta_;
+}; // class SynchronizedExistentialFrozenSymbolIterator.
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_FROZEN_DELTA_HH_.
@@ -0,0 +1,151 @@
+/* macrostate-store.hh -- Hash-consed storage of macrostates (sets of states) and tuples of states.
+ */
+
+#ifndef MATA_NFA_MACROSTATE_STORE_HH_
+#define MATA_NFA_MACROSTATE_STORE_HH_
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "mata/nfa/types.hh"
+
+namespace mata::nfa {
+
+/// Identifier of a macrostate interned in a @c MacrostateStore.
+using MacrostateId = uint32_t;
+
+/**
+ * @brief Interned (hash-consed) store of sequences of states, see @c MacrostateStore and @c TupleStore.
+ *
+ * All sequences are laid out contiguously in a single arena of states and addressed by a 32-bit @c MacrostateId.
+ *  Each sequence is stored only once. Its hash is computed once on insertion and kept next to it, and sequences are
+ *  looked up through an open-addressing (linear probing) index over the identifiers. Compared to
+ *  @c std::unordered_map<StateSet, State>, no heap allocation is performed per sequence.
+ *
+ * Identifiers are assigned consecutively from 0 in the order of insertion. Subset and product constructions create a
+ *  new state for each new sequence, hence the identifier of a sequence is the state of the constructed automaton, and
+ *  the store is a view mapping both ways between the sequences and the states.
+ *
+ * Views returned by @c operator[] are invalidated by any insertion into the store.
+ *
+ * @tparam SORTED Whether the stored sequences are sorted sets of states (macrostates of subset constructions), or
+ *  ordered tuples of states (states of product constructions), where the position of a state is significant.
+ */
+template<bool SORTED>
+class StateSequenceStore {
+public:
+    /**
+     * @brief A (read-only) view of a sequence in the store.
+     *
+     * For @c MacrostateStore, states are sorted in an ascending order. For @c TupleStore, the i-th state is the
+     *  state of the i-th component of the tuple.
+     */
+    using Sequence = std::span<const State>;
+    using Macrostate = Sequence;
+    using Tuple = Sequence;
+
+    /// Identifier returned when a sequence is not present in the store.
+    static constexpr MacrostateId NOT_FOUND = std::numeric_limits<MacrostateId>::max();
+
+    StateSequenceStore();
+
+    /// Number of sequences in the store.
+    size_t size() const { return hashes_.size(); }
+    bool empty() const { return hashes_.empty(); }
+    /// Number of states stored in the arena over all sequences.
+    size_t num_of_stored_states() const { return arena_.size(); }
+
+    /**
+     * @brief Get a view of the sequence @p id.
+     *
+     * The view is invalidated by the next insertion.
+     */
+    Sequence operator[](const MacrostateId id) const {
+        return { arena_.data() + offsets_[id], arena_.data() + offsets_[id + 1] };
+    }
+
+    /// Number of states in the sequence @p id.
+    size_t size_of(const MacrostateId id) const { return offsets_[id + 1] - offsets_[id]; }
+
+    /// Precomputed hash of the sequence @p id.
+    size_t hash_of(const MacrostateId id) const { return hashes_[id]; }
+
+    /// Copy the sequence @p id out of the store as a @c StateSet. Only for @c MacrostateStore.
+    StateSet get_state_set(MacrostateId id) const requires SORTED;
+
+    /**
+     * @brief Find the sequence @p sequence in the store.
+     *
+     * @param[in] sequence Sorted set of states (without duplicates) for @c MacrostateStore, tuple of states for
+     *  @c TupleStore.
+     * @return Identifier of the sequence, or @c NOT_FOUND when it is not stored.
+     */
+    MacrostateId find(Sequence sequence) const;
+    MacrostateId find(const StateSet& macrostate) const requires SORTED {
+        return find(Sequence{ macrostate.to_vector() });
+    }
+
+    /**
+     * @brief Insert the sequence @p sequence if it is not stored yet.
+     *
+     * @param[in] sequence Sorted set of states (without duplicates) for @c MacrostateStore, tuple of states for
+     *  @c TupleStore. Must not point into the store itself.
+     * @return A pair of the identifier of the sequence and a flag whether the sequence was newly inserted.
+     */
+    std::pair<MacrostateId, bool> insert(Sequence sequence);
+    std::pair<MacrostateId, bool> insert(const StateSet& macrostate) requires SORTED {
+        return insert(Sequence{ macrostate.to_vector() });
+    }
+
+    /**
+     * @brief Reserve space for @p num_of_sequences sequences with @p num_of_states states in total.
+     */
+    void reserve(size_t num_of_sequences, size_t num_of_states = 0);
+
+    /// Remove all sequences from the store. The allocated memory is kept for reuse.
+    void clear();
+
+    /**
+     * @brief Fill @p subset_map with all macrostates mapped to their identifiers.
+     *
+     * Materializes the classic subset map from the store. Use only when the explicit map is really needed.
+     */
+    void fill_subset_map(std::unordered_map<StateSet, State>& subset_map) const requires SORTED;
+
+private:
+    static constexpr MacrostateId EMPTY_SLOT = NOT_FOUND;
+
+    std::vector<State> arena_{}; ///< States of all sequences laid out contiguously.
+    /// Sequence @c id occupies <tt>arena_[offsets_[id], offsets_[id + 1])</tt>.
+    std::vector<size_t> offsets_{};
+    std::vector<size_t> hashes_{}; ///< Precomputed hash of each sequence.
+    /// Open-addressing index over sequence identifiers. The size is always a power of two.
+    std::vector<MacrostateId> index_{};
+
+    static size_t compute_hash(Sequence sequence);
+    /// Find the slot in @c index_ with @p sequence, or the empty slot where it would be inserted.
+    size_t find_slot(Sequence sequence, size_t hash) const;
+    void rehash(size_t new_index_size);
+}; // class StateSequenceStore.
+
+extern template class StateSequenceStore<true>;
+extern template class StateSequenceStore<false>;
+
+/**
+ * @brief Interned (hash-consed) store of macrostates, i.e., sorted sets of states, used in subset constructions
+ *  (e.g., @c determinize()).
+ */
+using MacrostateStore = StateSequenceStore<true>;
+
+/**
+ * @brief Interned (hash-consed) store of ordered tuples of states, used in product constructions (e.g.,
+ *  @c ProductView or the n-ary @c intersection()).
+ */
+using TupleStore = StateSequenceStore<false>;
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_MACROSTATE_STORE_HH_.
@@ -0,0 +1,142 @@
+/* matcher.hh -- Streaming matcher of words against an NFA determinized lazily.
+ */
+
+#ifndef MATA_NFA_MATCHER_HH_
+#define MATA_NFA_MATCHER_HH_
+
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "mata/nfa/types.hh"
+#include "mata/nfa/macrostate-store.hh"
+#include "mata/utils/utils.hh"
+
+namespace mata::nfa {
+
+class Nfa;
+
+/**
+ * @brief Matcher of words against an NFA, determinizing the NFA lazily while reading the words.
+ *
+ * The matcher reads symbols one by one and keeps the current macrostate, i.e., the set of states reachable over the
+ *  symbols read so far, as in @c Nfa::is_in_lang(). The macrostates are interned in a @c MacrostateStore, and the
+ *  transitions between them are cached in a table with a row for each macrostate and a column for each symbol used
+ *  in the automaton. Hence, each transition of the (partial) determinized automaton is computed only once, and
+ *  matching further words over the cached part of the automaton costs a single table lookup per symbol.
+ *
+ * The cache is bounded by the maximal number of macrostates. When the bound is reached, the whole cache is flushed
+ *  and filled again from the current macrostate, similarly to the DFA of RE2.
+ *
+ * As in @c Nfa::is_in_lang(), epsilon transitions are not followed. Remove them with @c remove_epsilon() first.
+ *
+ * The automaton must outlive the matcher and must not be modified while the matcher is used.
+ */
+class Matcher {
+public:
+    /// Default maximal number of cached macrostates.
+    static constexpr size_t DEFAULT_MAX_CACHED_STATES{ 10000 };
+
+    /**
+     * @brief Create a matcher for @p aut.
+     *
+     * @param[in] aut Automaton to match words against.
+     * @param[in] max_cached_states Maximal number of cached macrostates before the cache is flushed. Values
+     *  smaller than 2 are raised to 2, the dead and the initial macrostate.
+     */
+    explicit Matcher(const Nfa& aut, size_t max_cached_states = DEFAULT_MAX_CACHED_STATES);
+
+    /// Start reading a new word from the initial macrostate.
+    void reset() { current_ = initial_; }
+
+    /// Read @p symbol.
+    void feed(Symbol symbol) { current_ = step(current_, symbol); }
+    /// Read all symbols of @p word.
+    void feed(std::span<const Symbol> word);
+    /// Read @p bytes, each byte being a symbol (as in automata created by the @c re2parser).
+    void feed(std::string_view bytes);
+
+    /// Check whether the word read since the last @c reset() is in the language of the automaton.
+    bool accepts() const { return is_final_[current_]; }
+    /// Check whether no continuation of the word read since the last @c reset() is in the language.
+    bool is_dead() const { return current_ == DEAD; }
+
+    /// Check whether @p word is in the language of the automaton. Equivalent to @c Nfa::is_in_lang().
+    bool match(std::span<const Symbol> word);
+    /// Check whether @p bytes, each byte being a symbol, is in the language of the automaton.
+    bool match(std::string_view bytes);
+    /// Check whether some prefix of @p word is in the language of the automaton. Equivalent to
+    ///  @c Nfa::is_prfx_in_lang().
+    bool match_prefix(std::span<const Symbol> word);
+
+    /**
+     * @brief Check for each of @p words whether it is in the language of the automaton.
+     *
+     * @return Vector with @c true at index @c i iff @c words[i] is in the language.
+     */
+    BoolVector match_all(std::span<const Word> words);
+
+    /// Number of macrostates currently in the cache.
+    size_t num_of_cached_states() const { return macrostates_.size(); }
+    /// Number of flushes of the cache since the creation of the matcher.
+    size_t num_of_flushes() const { return num_of_flushes_; }
+
+private:
+    /// Cached transition which was not computed yet.
+    static constexpr MacrostateId UNKNOWN{ MacrostateStore::NOT_FOUND };
+    /// Column of all symbols not used in the automaton, leading to the dead (empty) macrostate.
+    static constexpr size_t OTHER_SYMBOL{ 0 };
+    /// The dead (empty) macrostate, interned first into the cache.
+    static constexpr MacrostateId DEAD{ 0 };
+    /// Number of symbols indexed directly in @c column_of_byte_.
+    static constexpr size_t NUM_OF_BYTES{ 256 };
+
+    const Nfa& aut_;
+    size_t max_cached_states_;
+    size_t num_of_flushes_{ 0 };
+
+    /// Column of each symbol smaller than @c NUM_OF_BYTES in @c transitions_.
+    std::vector<size_t> column_of_byte_;
+    /// Column of each symbol at least @c NUM_OF_BYTES in @c transitions_.
+    std::unordered_map<Symbol, size_t> column_of_symbol_{};
+    /// Symbol of each column of @c transitions_.
+    std::vector<Symbol> symbol_of_column_{};
+
+    MacrostateStore macrostates_{};
+    BoolVector is_final_{};
+    /// Cached transitions: the target of macrostate @c m over the symbol of column @c c is at
+    ///  <tt>m * symbol_of_column_.size() + c</tt>, or @c UNKNOWN if not computed yet.
+    std::vector<MacrostateId> transitions_{};
+
+    /// Initial states of the automaton, sorted, to intern the initial macrostate again after a flush.
+    std::vector<State> initial_states_{};
+    MacrostateId initial_{ DEAD };
+    MacrostateId current_{ DEAD };
+
+    /// Buffer for computing targets of transitions.
+    std::vector<State> targets_buffer_{};
+
+    size_t get_column(const Symbol symbol) const {
+        if (symbol < NUM_OF_BYTES) { return column_of_byte_[symbol]; }
+        const auto it{ column_of_symbol_.find(symbol) };
+        return it == column_of_symbol_.end() ? OTHER_SYMBOL : it->second;
+    }
+
+    /// Get the successor of @p macrostate over @p symbol, computing it if it is not cached.
+    MacrostateId step(const MacrostateId macrostate, const Symbol symbol) {
+        const size_t column{ get_column(symbol) };
+        const MacrostateId target{ transitions_[macrostate * symbol_of_column_.size() + column] };
+        return target != UNKNOWN ? target : compute_step(macrostate, column);
+    }
+
+    MacrostateId compute_step(MacrostateId macrostate, size_t column);
+    /// Intern @p macrostate (sorted, without duplicates) in the cache.
+    MacrostateId intern(std::span<const State> macrostate);
+    /// Remove all macrostates from the cache and intern the dead and the initial macrostates again.
+    void flush();
+}; // class Matcher.
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_MATCHER_HH_.
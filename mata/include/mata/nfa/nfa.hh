@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <limits>
 #include <set>
@@ -20,6 +21,7 @@
 #include <vector>
 #include <queue>
 #include <optional>
+#include <span>
 
 #include "mata/alphabet.hh"
 #include "mata/parser/parser.hh"
@@ -30,6 +32,10 @@
 #include "mata/utils/sparse-set.hh"
 #include "types.hh"
 #include "delta.hh"
+#include "macrostate-store.hh"
+#include "frozen-delta.hh"
+#include "bit-state-set.hh"
+#include "traversal-workspace.hh"
 
 /**
  * @brief Nondeterministic Finite Automata including structures, transitions and algorithms.
@@ -172,10 +178,11 @@ public:
      * @brief Get set of reachable states.
      *
      * Reachable states are states accessible from any initial state.
+     * @param[in,out] workspace Optional buffers of the traversal, reused across calls.
      * @return Set of reachable states.
      * TODO: with the new get_useful_states, it might be useless now.
      */
-    StateSet get_reachable_states() const;
+    StateSet get_reachable_states(TraversalWorkspace* workspace = nullptr) const;
 
     /**
      * @brief Get set of terminating states.
@@ -190,9 +197,10 @@ public:
      * @brief Get the useful states using a modified Tarjan's algorithm. A state
      * is useful if it is reachable from an initial state and can reach a final state.
      *
+     * @param[in,out] workspace Optional buffers of the traversal, reused across calls.
      * @return BoolVector Bool vector whose ith value is true iff the state i is useful.
      */
-    BoolVector get_useful_states() const;
+    BoolVector get_useful_states(TraversalWorkspace* workspace = nullptr) const;
 
     /**
      * @brief Structure for storing callback functions (event handlers) utilizing
@@ -224,9 +232,10 @@ public:
      * the starting point of a path ending in a final state).
      *
      * @param[out] state_renaming Mapping of trimmed states to new states.
+     * @param[in,out] workspace Optional buffers of the traversal, reused across calls.
      * @return @c this after trimming.
      */
-    Nfa& trim(StateRenaming* state_renaming = nullptr);
+    Nfa& trim(StateRenaming* state_renaming = nullptr, TraversalWorkspace* workspace = nullptr);
 
     /**
      * @brief Decodes automaton from UTF-8 encoding. Method removes unreachable states from delta.
@@ -238,8 +247,10 @@ public:
 
     /**
      * @brief Returns vector ret where ret[q] is the length of the shortest path from any initial state to q
+     *
+     * @param[in,out] workspace Optional buffers of the traversal, reused across calls.
      */
-    std::vector<State> distances_from_initial() const;
+    std::vector<State> distances_from_initial(TraversalWorkspace* workspace = nullptr) const;
 
     /**
      * @brief Returns vector ret where ret[q] is the length of the shortest path from q to any final state
@@ -347,16 +358,28 @@ public:
      */
     void print_to_mata(const std::string& filename, const Alphabet* alphabet = nullptr) const;
 
+    /**
+     * @brief Save the automaton to the file @p path in the binary format, see @c binary::MappedAutomaton.
+     *
+     * Load the automaton with @c builder::mmap_binary(), which maps the file into memory instead of parsing it.
+     * @param[in] path File to save the automaton to.
+     * @param[in] alphabet If specified, the names of the symbols of @p alphabet are saved with the automaton.
+     */
+    void save_binary(const std::filesystem::path& path, const Alphabet* alphabet = nullptr) const;
+
     // TODO: Relict from VATA. What to do with inclusion/ universality/ this post function? Revise all of them.
     StateSet post(const StateSet& states, const Symbol& symbol) const;
 
     /**
      * Check whether the language of NFA is empty.
-     * Currently calls is_lang_empty_scc if cex is null
+     *
+     * Final states are searched for by a breadth-first search from the initial states, hence @p cex is a shortest
+     *  accepting run.
      * @param[out] cex Counter-example path for a case the language is not empty.
+     * @param[in,out] workspace Optional buffers of the traversal, reused across calls.
      * @return True if the language is empty, false otherwise.
      */
-    bool is_lang_empty(Run* cex = nullptr) const;
+    bool is_lang_empty(Run* cex = nullptr, TraversalWorkspace* workspace = nullptr) const;
 
     /**
      * @brief Check if the language is empty using Tarjan's SCC discover algorithm.
@@ -405,7 +428,17 @@ public:
      */
     void fill_alphabet(mata::OnTheFlyAlphabet& alphabet_to_fill) const;
 
-    /// Is the language of the automaton universal?
+    /**
+     * @brief Is the language of the automaton universal?
+     *
+     * @param[in] alphabet Alphabet to check universality over.
+     * @param[out] cex Counterexample word not in the language.
+     * @param[in] params Parameters to control the universality check algorithm:
+     * - "algorithm": "naive", "antichains" (Default: "antichains")
+     * - "simulation": "forward" to prune "antichains" up to the maximal forward simulation (Default: none).
+     * - "bit_state_set_threshold": Use bitsets as macrostates of "antichains" if the automaton has fewer states, "0"
+     *   for never (Default: "2048", see @c DEFAULT_BIT_STATE_SET_THRESHOLD).
+     */
     bool is_universal(const Alphabet& alphabet, Run* cex = nullptr,
                       const ParameterMap& params = {{ "algorithm", "antichains" }}) const;
     /// Is the language of the automaton universal?
@@ -497,6 +530,48 @@ public:
     Nfa& complement_deterministic(const mata::utils::OrdVector<Symbol>& symbols, std::optional<State> sink_state = std::nullopt);
 }; // class Nfa.
 
+/**
+ * @brief Read-only NFA with the transition relation frozen into a @c FrozenDelta.
+ *
+ * Read-only algorithms on large automata (emptiness, useful states, product, inclusion, determinization) iterate over
+ *  the flat arrays of @c FrozenDelta instead of the nested vectors of @c Delta. Freeze the automaton once it is
+ *  constructed and run the algorithms on the frozen automaton.
+ */
+struct FrozenNfa {
+    FrozenDelta delta{};
+    utils::SparseSet<State> initial{};
+    utils::SparseSet<State> final{};
+
+    FrozenNfa() = default;
+    /// Freeze @p nfa.
+    explicit FrozenNfa(const Nfa& nfa): delta{ nfa.delta }, initial{ nfa.initial }, final{ nfa.final } {}
+
+    /// Number of states, see @c Nfa::num_of_states().
+    size_t num_of_states() const;
+
+    /**
+     * @brief Check whether the language is empty, see @c Nfa::is_lang_empty().
+     *
+     * @param[out] cex Counter-example path for a case the language is not empty.
+     */
+    bool is_lang_empty(Run* cex = nullptr) const;
+
+    /// Get the useful states, see @c Nfa::get_useful_states().
+    BoolVector get_useful_states() const;
+
+    /// Tarjan's SCC discover algorithm, see @c Nfa::tarjan_scc_discover().
+    void tarjan_scc_discover(const Nfa::TarjanDiscoverCallback& callback) const;
+
+    /// Compute the length of the shortest path from each state to a final state, see @c Nfa::distances_to_final().
+    std::vector<State> distances_to_final() const;
+
+    /// Get the shortest accepting run from @p q, see @c Nfa::get_shortest_accepting_run_from_state().
+    Run get_shortest_accepting_run_from_state(State q, const std::vector<State>& distances_to_final) const;
+
+    /// Convert back into a modifiable @c Nfa.
+    Nfa thaw() const { return Nfa{ delta.thaw(), initial, final }; }
+}; // struct FrozenNfa.
+
 // Allow variadic number of arguments of the same type.
 //
 // Using parameter pack and variadic arguments.
@@ -615,6 +690,19 @@ Nfa lang_difference(
 Nfa intersection(const Nfa& lhs, const Nfa& rhs,
                  const Symbol first_epsilon = EPSILON, std::unordered_map<std::pair<State, State>, State> *prod_map = nullptr);
 
+/**
+ * @brief Compute intersection of NFAs @p automata in a single product construction.
+ *
+ * Builds the product over tuples of states of all automata at once, instead of intermediate products of pairs of
+ *  automata as <tt>intersection(intersection(a, b), c)</tt> does. ε-transitions are preserved as in
+ *  @c intersection(const Nfa&, const Nfa&, ...): each automaton takes its ε-transitions on its own.
+ *
+ * @param[in] automata NFAs to compute intersection for, at least one.
+ * @param[in] first_epsilon smallest epsilon.
+ * @return NFA as a product of NFAs @p automata with ε-transitions preserved.
+ */
+Nfa intersection(std::span<const Nfa> automata, Symbol first_epsilon = EPSILON);
+
 /**
  * @brief Concatenate two NFAs.
  *
@@ -671,7 +759,9 @@ Nfa complement(const Nfa& aut, const utils::OrdVector<Symbol>& symbols,
  *
  * @param[in] aut Automaton whose minimal version to compute.
  * @param[in] params Optional parameters to control the minimization algorithm:
- * - "algorithm": "brzozowski"
+ * - "algorithm": "brzozowski", "hopcroft" (determinizes and trims @p aut first when needed)
+ * - "threads": Number of threads for "hopcroft", "0" for all hardware threads (Default: "1"). Multiple threads are
+ *   used only for automata with more than a million states after determinization.
  * @return Minimal deterministic automaton.
  */
 Nfa minimize(const Nfa &aut, const ParameterMap& params = { { "algorithm", "brzozowski" } });
@@ -681,6 +771,8 @@ Nfa minimize(const Nfa &aut, const ParameterMap& params = { { "algorithm", "brzo
  *
  * @param[in] aut Automaton to determinize.
  * @param[out] subset_map Map that maps sets of states of input automaton to states of determinized automaton.
+ *  The map is materialized from a @c MacrostateStore after the determinization, prefer the overload taking
+ *  @c MacrostateStore when the map is large.
  * @param[in] macrostate_discover Callback event handler for discovering a new macrostate for the first time. The
  *  parameters are the determinized NFA constructed so far, the current macrostate, and the set of the original states
  *  corresponding to the macrostate. Return @c true if the determinization should continue, and @c false if the
@@ -692,6 +784,34 @@ Nfa determinize(
     const Nfa& aut, std::unordered_map<StateSet, State> *subset_map = nullptr,
     std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover = std::nullopt);
 
+/**
+ * @brief Determinize automaton, storing the macrostates in a hash-consed @c MacrostateStore.
+ *
+ * The identifier of each macrostate in @p macrostates is the state of the determinized automaton representing the
+ *  macrostate, so @p macrostates is a (lazy) view of the subset map which avoids storing a @c StateSet per macrostate.
+ *
+ * @param[in] aut Automaton to determinize.
+ * @param[out] macrostates Store of macrostates (cleared first). The macrostate with identifier @c q corresponds to the
+ *  state @c q of the determinized automaton. If @c nullptr, a local store is used.
+ * @param[in] macrostate_discover Callback event handler for discovering a new macrostate for the first time. See the
+ *  other overload of @c determinize().
+ * @param[in] bit_state_set_threshold Unite targets in a @c BitStateSet if @p aut has fewer states.
+ * @return Determinized automaton.
+ */
+Nfa determinize(
+    const Nfa& aut, MacrostateStore* macrostates,
+    std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover = std::nullopt,
+    size_t bit_state_set_threshold = DEFAULT_BIT_STATE_SET_THRESHOLD);
+
+/**
+ * @brief Determinize frozen automaton, see @c determinize(const Nfa&, MacrostateStore*).
+ *
+ * @param[in] aut Frozen automaton to determinize.
+ * @param[out] macrostates Store of macrostates (cleared first). If @c nullptr, a local store is used.
+ * @return Determinized automaton.
+ */
+Nfa determinize(const FrozenNfa& aut, MacrostateStore* macrostates = nullptr);
+
 /**
  * @brief Reduce the size of the automaton.
  *
@@ -715,7 +835,12 @@ Nfa reduce(const Nfa &aut, StateRenaming *state_renaming = nullptr,
  * @param[out] cex Counterexample for the inclusion.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "hkc" (Default: "antichains")
+ * - "threads": Number of threads for "antichains", "0" for all hardware threads (Default: "1")
+ * - "simulation": "forward" to prune "antichains" up to the maximal forward simulation (Default: none). Takes
+ *   precedence over "threads".
+ * - "bit_state_set_threshold": Use bitsets as macrostates of "antichains" for automata with fewer states, "0" for
+ *   never (Default: "2048", see @c DEFAULT_BIT_STATE_SET_THRESHOLD).
  * @return True if @p smaller is included in @p bigger, false otherwise.
  */
 bool is_included(const Nfa& smaller, const Nfa& bigger, Run* cex, const Alphabet* alphabet = nullptr,
@@ -728,7 +853,12 @@ bool is_included(const Nfa& smaller, const Nfa& bigger, Run* cex, const Alphabet
  * @param[in] bigger Second automaton to concatenate.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "hkc" (Default: "antichains")
+ * - "threads": Number of threads for "antichains", "0" for all hardware threads (Default: "1")
+ * - "simulation": "forward" to prune "antichains" up to the maximal forward simulation (Default: none). Takes
+ *   precedence over "threads".
+ * - "bit_state_set_threshold": Use bitsets as macrostates of "antichains" for automata with fewer states, "0" for
+ *   never (Default: "2048", see @c DEFAULT_BIT_STATE_SET_THRESHOLD).
  * @return True if @p smaller is included in @p bigger, false otherwise.
  */
 inline bool is_included(const Nfa& smaller, const Nfa& bigger, const Alphabet* const alphabet = nullptr,
@@ -743,7 +873,12 @@ inline bool is_included(const Nfa& smaller, const Nfa& bigger, const Alphabet* c
  * @param[in] rhs Second automaton to concatenate.
  * @param[in] alphabet Alphabet of both NFAs to compute with.
  * @param[in] params[ Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "hkc" (Default: "antichains")
+ * - "threads": Number of threads for "antichains", "0" for all hardware threads (Default: "1")
+ * - "simulation": "forward" to prune "antichains" up to the maximal forward simulation (Default: none). Takes
+ *   precedence over "threads".
+ * - "bit_state_set_threshold": Use bitsets as macrostates of "antichains" for automata with fewer states, "0" for
+ *   never (Default: "2048", see @c DEFAULT_BIT_STATE_SET_THRESHOLD).
  * @return True if @p lhs and @p rhs are equivalent, false otherwise.
  */
 bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet* alphabet,
@@ -763,7 +898,12 @@ bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet* alphabet,
  * @param[in] lhs First automaton to concatenate.
  * @param[in] rhs Second automaton to concatenate.
  * @param[in] params Optional parameters to control the equivalence check algorithm:
- * - "algorithm": "naive", "antichains" (Default: "antichains")
+ * - "algorithm": "naive", "antichains", "hkc" (Default: "antichains")
+ * - "threads": Number of threads for "antichains", "0" for all hardware threads (Default: "1")
+ * - "simulation": "forward" to prune "antichains" up to the maximal forward simulation (Default: none). Takes
+ *   precedence over "threads".
+ * - "bit_state_set_threshold": Use bitsets as macrostates of "antichains" for automata with fewer states, "0" for
+ *   never (Default: "2048", see @c DEFAULT_BIT_STATE_SET_THRESHOLD).
  * @return True if @p lhs and @p rhs are equivalent, false otherwise.
  */
 bool are_equivalent(const Nfa& lhs, const Nfa& rhs, const ParameterMap& params = {{ "algorithm", "antichains"}});
@@ -0,0 +1,93 @@
+/* product-view.hh -- Lazy (on-the-fly) product of NFAs.
+ */
+
+#ifndef MATA_NFA_PRODUCT_VIEW_HH_
+#define MATA_NFA_PRODUCT_VIEW_HH_
+
+#include <deque>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "mata/nfa/types.hh"
+#include "mata/nfa/delta.hh"
+#include "mata/nfa/macrostate-store.hh"
+
+namespace mata::nfa {
+
+class Nfa;
+
+/**
+ * @brief Lazy product (intersection) of NFAs which constructs product states only when they are discovered.
+ *
+ * Product states are tuples of states of the operands, one state from each operand. Each discovered tuple is interned
+ *  in a @c TupleStore and identified by the order of its discovery. Transitions from a product state are computed
+ *  on the first call of @c post() and cached, hence algorithms running over the view with early termination never
+ *  compute transitions of the product states which they do not explore, nor any table over all pairs of states.
+ *
+ * A product state is final iff all states in its tuple are final. All symbols (including epsilons) are synchronized,
+ *  that is, the view is the product for automata without epsilon transitions.
+ *
+ * The operands must outlive the view and must not be modified while the view is used.
+ */
+class ProductView {
+public:
+    /// Create a lazy product of @p operands. At least one operand is required.
+    explicit ProductView(std::vector<const Nfa*> operands);
+    ProductView(const Nfa& lhs, const Nfa& rhs): ProductView(std::vector<const Nfa*>{ &lhs, &rhs }) {}
+    /// Create a view of a single automaton, allowing to mix automata and products in algorithms over views.
+    explicit ProductView(const Nfa& aut): ProductView(std::vector<const Nfa*>{ &aut }) {}
+
+    size_t num_of_operands() const { return operands_.size(); }
+
+    /// Number of product states discovered so far.
+    size_t num_of_discovered_states() const { return tuples_.size(); }
+
+    /// Initial product states: all tuples of initial states of the operands.
+    const StateSet& initial() const { return initial_; }
+
+    /**
+     * @brief Get the transitions from product state @p state.
+     *
+     * Computed and cached on the first call for @p state. Targets are product states, discovered by the call if
+     *  they are new. The returned reference stays valid as long as the view.
+     */
+    const StatePost& post(State state);
+
+    /// Check whether product state @p state is final.
+    bool is_final(State state) const;
+
+    /// Get the tuple of states of the operands for product state @p state. Invalidated by discovering new states.
+    std::span<const State> get_tuple(const State state) const { return tuples_[static_cast<MacrostateId>(state)]; }
+
+    /**
+     * @brief Check whether the language of the product is empty.
+     *
+     * Explores the product breadth-first from the initial states and stops at the first final product state.
+     * @param[out] cex Some shortest accepting run through product states, if the language is not empty.
+     */
+    bool is_lang_empty(Run* cex = nullptr);
+
+    /// Get some shortest word in the language of the product, @c std::nullopt if the language is empty.
+    std::optional<Word> get_shortest_word();
+
+private:
+    static constexpr size_t NO_POST{ std::numeric_limits<size_t>::max() };
+
+    std::vector<const Nfa*> operands_;
+    /// Tuples of discovered product states.
+    TupleStore tuples_{};
+    StateSet initial_{};
+    /// Cached transitions of product states. A deque keeps the references returned by @c post() valid.
+    std::deque<StatePost> posts_{};
+    /// Index of the cached transitions of each discovered product state in @c posts_, @c NO_POST if not computed.
+    std::vector<size_t> post_index_{};
+
+    /// Get the product state for @p tuple, discovering it if it is new.
+    State intern(std::span<const State> tuple);
+}; // class ProductView.
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_PRODUCT_VIEW_HH_.
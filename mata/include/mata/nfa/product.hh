@@ -0,0 +1,312 @@
+/* product.hh -- Product construction shared by NFAs and NFTs.
+ */
+
+#ifndef MATA_NFA_PRODUCT_HH_
+#define MATA_NFA_PRODUCT_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/utils/synchronized-iterator.hh"
+
+namespace mata::nfa::algorithms {
+
+using ProductMap = std::unordered_map<std::pair<State, State>, State>;
+
+/// Epsilon policy of @c compute_product(): symbols from @c first_epsilon up are epsilons, taken by each operand on its
+///  own while the other operand stays in its state.
+struct FirstEpsilon {
+    static constexpr bool HAS_EPSILONS{ true };
+    Symbol first_epsilon{ EPSILON };
+
+    bool is_epsilon(const Symbol symbol) const { return first_epsilon <= symbol; }
+};
+
+/// Epsilon policy of @c compute_product(): all symbols (including @c EPSILON) are synchronized as regular symbols.
+struct NoEpsilons {
+    static constexpr bool HAS_EPSILONS{ false };
+
+    static constexpr bool is_epsilon(const Symbol) { return false; }
+};
+
+/**
+ * @brief Level policy of @c compute_product() for automata without levels: both operands always move together, to the
+ *  targets of the transitions over the same symbol.
+ *
+ * A level policy decides which pairs of states are created, how the product states are created, whether the operands
+ *  in a pair of states synchronize (or only one of them moves, the other one waiting), and in which states the
+ *  operands end after a synchronized move. See the level policy of the product of NFTs in @c mata::nft.
+ */
+struct SingleLevel {
+    using Result = Nfa;
+    /// Whether @c DONT_CARE synchronizes with all symbols. Requires @c Symbol @c DONT_CARE in the policy.
+    static constexpr bool HAS_DONT_CARE{ false };
+
+    Result create_result() const { return Nfa{}; }
+    /// Whether the pair of states can form a product state.
+    bool can_pair(State, State) const { return true; }
+    /// Create a product state for the pair of (non-initial) states.
+    State add_state(Nfa& product, State, State) const { return product.add_state(); }
+    /// Whether both states in the pair move together.
+    bool is_synchronized(State, State) const { return true; }
+    /// Whether the lhs state waits while the rhs state moves (if the pair is not synchronized).
+    bool lhs_waits(State, State) const { return false; }
+    /// Pair of states after a synchronized move from the sources to the targets.
+    std::pair<State, State> targets(State, State, const State lhs_target, const State rhs_target) const {
+        return { lhs_target, rhs_target };
+    }
+};
+
+namespace product_detail {
+    // Access to the symbol posts of Delta and FrozenDelta, so that the product can be computed over both. Symbol posts
+    //  of Delta are iterated by StatePost iterators, symbol posts of FrozenDelta by pointers to their symbols.
+    inline std::pair<StatePost::const_iterator, StatePost::const_iterator> symbol_posts_of(
+        const Nfa& aut, const State state) {
+        const StatePost& state_post{ aut.delta[state] };
+        return { state_post.cbegin(), state_post.cend() };
+    }
+    inline std::pair<const Symbol*, const Symbol*> symbol_posts_of(const FrozenNfa& aut, const State state) {
+        const std::span<const Symbol> symbols{ aut.delta.symbols(state) };
+        return { symbols.data(), symbols.data() + symbols.size() };
+    }
+    inline Symbol symbol_of(const StatePost::const_iterator& symbol_post_it) { return symbol_post_it->symbol; }
+    inline Symbol symbol_of(const Symbol* symbol_it) { return *symbol_it; }
+    inline const StateSet& targets_of(const Nfa&, const StatePost::const_iterator& symbol_post_it) {
+        return symbol_post_it->targets;
+    }
+    inline std::span<const State> targets_of(const FrozenNfa& aut, const Symbol* symbol_it) {
+        return aut.delta.targets(symbol_it);
+    }
+    inline StatePost::const_iterator first_epsilon_it_of(const Nfa& aut, const State state, const Symbol first_epsilon) {
+        return aut.delta[state].first_epsilon_it(first_epsilon);
+    }
+    inline const Symbol* first_epsilon_it_of(const FrozenNfa& aut, const State state, const Symbol first_epsilon) {
+        const std::span<const Symbol> symbols{ aut.delta.symbols(state) };
+        return symbols.data() + (std::lower_bound(symbols.begin(), symbols.end(), first_epsilon) - symbols.begin());
+    }
+
+    /**
+     * @brief Mapping of pairs of states to product states and back.
+     *
+     * The pairs are mapped by a matrix over all pairs of states if it is small enough, by a vector of unordered maps
+     *  (about twice slower) otherwise.
+     */
+    class ProductStorage {
+    public:
+        /// The largest matrix of pairs of states we are brave enough to allocate.
+        static constexpr size_t MAX_PRODUCT_MATRIX_SIZE{ 50'000'000 };
+
+        ProductStorage(const size_t lhs_num_of_states, const size_t rhs_num_of_states, ProductMap* product_map)
+            : large_product_{ lhs_num_of_states * rhs_num_of_states > MAX_PRODUCT_MATRIX_SIZE },
+              product_map_{ product_map } {
+            assert(lhs_num_of_states < Limits::max_state);
+            assert(rhs_num_of_states < Limits::max_state);
+            if (!large_product_) {
+                matrix_.assign(lhs_num_of_states, std::vector<State>(rhs_num_of_states, Limits::max_state));
+            } else {
+                vec_map_.resize(lhs_num_of_states);
+            }
+        }
+        ProductStorage(const ProductStorage&) = delete;
+        ProductStorage& operator=(const ProductStorage&) = delete;
+
+        /// Get the product state of the pair of states, or @c Limits::max_state if there is none.
+        State get(const State lhs_state, const State rhs_state) const {
+            if (!large_product_) { return matrix_[lhs_state][rhs_state]; }
+            const auto it{ vec_map_[lhs_state].find(rhs_state) };
+            return it == vec_map_[lhs_state].end() ? Limits::max_state : it->second;
+        }
+
+        void insert(const State lhs_state, const State rhs_state, const State product_state) {
+            if (!large_product_) {
+                matrix_[lhs_state][rhs_state] = product_state;
+            } else {
+                vec_map_[lhs_state][rhs_state] = product_state;
+            }
+            if (pairs_.size() <= product_state) { pairs_.resize(product_state + 1); }
+            pairs_[product_state] = { lhs_state, rhs_state };
+            // The mapping is not used internally, it is filled only if it is requested (it is expensive).
+            if (product_map_ != nullptr) { (*product_map_)[std::make_pair(lhs_state, rhs_state)] = product_state; }
+        }
+
+        /// Get the pair of states of @p product_state.
+        std::pair<State, State> pair_of(const State product_state) const { return pairs_[product_state]; }
+
+    private:
+        bool large_product_;
+        ProductMap* product_map_;
+        std::vector<std::vector<State>> matrix_{};
+        std::vector<std::unordered_map<State, State>> vec_map_{};
+        std::vector<std::pair<State, State>> pairs_{};
+    };
+
+    /// Add @p symbol_post to @p state_post, merging it with the symbol post over the same symbol if there is one.
+    inline void add_symbol_post(StatePost& state_post, SymbolPost&& symbol_post) {
+        if (symbol_post.empty()) { return; }
+        if (state_post.empty() || state_post.back().symbol < symbol_post.symbol) {
+            // Symbols are mostly added in order, the symbol post can be pushed back.
+            state_post.push_back(std::move(symbol_post));
+            return;
+        }
+        const auto symbol_post_it{ state_post.find(symbol_post.symbol) };
+        if (symbol_post_it == state_post.end()) {
+            state_post.insert(std::move(symbol_post));
+        } else {
+            symbol_post_it->insert(symbol_post.targets);
+        }
+    }
+} // namespace product_detail.
+
+/**
+ * @brief Compute the product of @p lhs and @p rhs, with the final condition, the epsilon policy and the level policy
+ *  given at compile time.
+ *
+ * The product is constructed from the pairs of initial states, exploring only the reachable pairs of states. Both
+ *  NFAs (and frozen NFAs) with @c SingleLevel and NFTs with their level policy are instantiations of this template;
+ *  @p final_condition is called directly (not through @c std::function) for each new pair of states.
+ * @param[in] final_condition The predicate that tells whether a pair of states is final (conjunction for intersection).
+ * @param[out] product_map Can be used to get the mapping of the pairs of the original states to product states. Only
+ *  filled in if not @c nullptr.
+ * @param[in] level_policy Level policy, see @c SingleLevel.
+ * @param[in] epsilon_policy Epsilon policy, @c FirstEpsilon or @c NoEpsilons.
+ */
+template<typename Aut, typename FinalCondition, typename LevelPolicy = SingleLevel,
+         typename EpsilonPolicy = FirstEpsilon>
+typename LevelPolicy::Result compute_product(
+    const Aut& lhs, const Aut& rhs, const FinalCondition& final_condition, ProductMap* product_map = nullptr,
+    const LevelPolicy& level_policy = {}, const EpsilonPolicy& epsilon_policy = {}) {
+    using namespace product_detail;
+    using SymbolPostIterator = decltype(symbol_posts_of(lhs, State{}).first);
+
+    typename LevelPolicy::Result product{ level_policy.create_result() };
+    ProductStorage storage{ lhs.num_of_states(), rhs.num_of_states(), product_map };
+    // Product states to process.
+    std::vector<State> worklist{};
+
+    /// Get the product state of the pair of states, creating it if it does not exist yet.
+    const auto get_product_state = [&](const State lhs_state, const State rhs_state) {
+        State product_state{ storage.get(lhs_state, rhs_state) };
+        if (product_state == Limits::max_state) {
+            product_state = level_policy.add_state(product, lhs_state, rhs_state);
+            assert(product_state < Limits::max_state);
+            storage.insert(lhs_state, rhs_state, product_state);
+            worklist.push_back(product_state);
+            if (final_condition(lhs_state, rhs_state)) { product.final.insert(product_state); }
+        }
+        return product_state;
+    };
+
+    /// Add the product state of the pair of states to @p product_symbol_post, if the pair can form a product state.
+    const auto add_target = [&](const State lhs_state, const State rhs_state, SymbolPost& product_symbol_post) {
+        if (level_policy.can_pair(lhs_state, rhs_state)) {
+            product_symbol_post.insert(get_product_state(lhs_state, rhs_state));
+        }
+    };
+
+    /// Add transitions of @p aut from @p source to the product, @p to_pair giving the pair of states of each target.
+    const auto move_alone = [&](const Aut& aut, const SymbolPostIterator first, const SymbolPostIterator last,
+                                const State product_source, const auto& to_pair) {
+        for (auto symbol_post_it{ first }; symbol_post_it != last; ++symbol_post_it) {
+            SymbolPost product_symbol_post{ symbol_of(symbol_post_it) };
+            for (const State target: targets_of(aut, symbol_post_it)) {
+                const auto [lhs_state, rhs_state]{ to_pair(target) };
+                add_target(lhs_state, rhs_state, product_symbol_post);
+            }
+            add_symbol_post(product.delta.mutable_state_post(product_source), std::move(product_symbol_post));
+        }
+    };
+
+    for (const State lhs_initial_state: lhs.initial) {
+        for (const State rhs_initial_state: rhs.initial) {
+            const State product_initial_state{ product.add_state() };
+            storage.insert(lhs_initial_state, rhs_initial_state, product_initial_state);
+            worklist.push_back(product_initial_state);
+            product.initial.insert(product_initial_state);
+            if (final_condition(lhs_initial_state, rhs_initial_state)) { product.final.insert(product_initial_state); }
+        }
+    }
+
+    mata::utils::SynchronizedUniversalIterator<SymbolPostIterator> sync_iterator(2);
+    while (!worklist.empty()) {
+        const State product_source{ worklist.back() };
+        worklist.pop_back();
+        const auto [lhs_source, rhs_source]{ storage.pair_of(product_source) };
+        const auto [lhs_symbol_posts_begin, lhs_symbol_posts_end]{ symbol_posts_of(lhs, lhs_source) };
+        const auto [rhs_symbol_posts_begin, rhs_symbol_posts_end]{ symbol_posts_of(rhs, rhs_source) };
+
+        if (level_policy.is_synchronized(lhs_source, rhs_source)) {
+            // Create transitions from the pair of sources to all pairs of targets of the transitions over the same
+            //  symbol (other than epsilons).
+            sync_iterator.reset();
+            sync_iterator.push_back(lhs_symbol_posts_begin, lhs_symbol_posts_end);
+            sync_iterator.push_back(rhs_symbol_posts_begin, rhs_symbol_posts_end);
+            while (sync_iterator.advance()) {
+                const std::vector<SymbolPostIterator>& same_symbol_posts{ sync_iterator.get_current() };
+                assert(same_symbol_posts.size() == 2); // One move per state in the pair.
+                const Symbol symbol{ symbol_of(same_symbol_posts[0]) };
+                if (epsilon_policy.is_epsilon(symbol)) { break; }
+                SymbolPost product_symbol_post{ symbol };
+                for (const State lhs_target: targets_of(lhs, same_symbol_posts[0])) {
+                    for (const State rhs_target: targets_of(rhs, same_symbol_posts[1])) {
+                        const auto [lhs_state, rhs_state]{
+                            level_policy.targets(lhs_source, rhs_source, lhs_target, rhs_target) };
+                        add_target(lhs_state, rhs_state, product_symbol_post);
+                    }
+                }
+                add_symbol_post(product.delta.mutable_state_post(product_source), std::move(product_symbol_post));
+            }
+
+            if constexpr (LevelPolicy::HAS_DONT_CARE) {
+                // DONT_CARE of one operand synchronizes with each symbol of the other operand.
+                const auto synchronize_dont_care = [&](const bool dont_care_on_lhs) {
+                    const Aut& dont_care_aut{ dont_care_on_lhs ? lhs : rhs };
+                    const Aut& specific_aut{ dont_care_on_lhs ? rhs : lhs };
+                    const State dont_care_source{ dont_care_on_lhs ? lhs_source : rhs_source };
+                    const State specific_source{ dont_care_on_lhs ? rhs_source : lhs_source };
+                    const StatePost& dont_care_state_post{ dont_care_aut.delta[dont_care_source] };
+                    const auto dont_care_symbol_post_it{ dont_care_state_post.find(LevelPolicy::DONT_CARE) };
+                    if (dont_care_symbol_post_it == dont_care_state_post.end()) { return; }
+                    for (const SymbolPost& specific_symbol_post: specific_aut.delta[specific_source]) {
+                        SymbolPost product_symbol_post{ specific_symbol_post.symbol };
+                        for (const State dont_care_target: dont_care_symbol_post_it->targets) {
+                            for (const State specific_target: specific_symbol_post.targets) {
+                                const auto [lhs_state, rhs_state]{ dont_care_on_lhs
+                                    ? level_policy.targets(lhs_source, rhs_source, dont_care_target, specific_target)
+                                    : level_policy.targets(lhs_source, rhs_source, specific_target, dont_care_target) };
+                                add_target(lhs_state, rhs_state, product_symbol_post);
+                            }
+                        }
+                        add_symbol_post(product.delta.mutable_state_post(product_source),
+                                        std::move(product_symbol_post));
+                    }
+                };
+                synchronize_dont_care(true);
+                synchronize_dont_care(false);
+            }
+        } else if (level_policy.lhs_waits(lhs_source, rhs_source)) {
+            move_alone(rhs, rhs_symbol_posts_begin, rhs_symbol_posts_end, product_source,
+                       [&](const State target) { return std::make_pair(lhs_source, target); });
+        } else {
+            move_alone(lhs, lhs_symbol_posts_begin, lhs_symbol_posts_end, product_source,
+                       [&](const State target) { return std::make_pair(target, rhs_source); });
+        }
+
+        if constexpr (EpsilonPolicy::HAS_EPSILONS) {
+            // Epsilon transitions are taken by each operand on its own, the other operand stays in its state.
+            move_alone(lhs, first_epsilon_it_of(lhs, lhs_source, epsilon_policy.first_epsilon), lhs_symbol_posts_end,
+                       product_source, [&](const State target) { return std::make_pair(target, rhs_source); });
+            move_alone(rhs, first_epsilon_it_of(rhs, rhs_source, epsilon_policy.first_epsilon), rhs_symbol_posts_end,
+                       product_source, [&](const State target) { return std::make_pair(lhs_source, target); });
+        }
+    }
+    return product;
+} // compute_product().
+
+} // namespace mata::nfa::algorithms.
+
+#endif // MATA_NFA_PRODUCT_HH_.
@@ -0,0 +1,99 @@
+/* reverse-delta.hh -- Index of transitions incoming to states (predecessors).
+ */
+
+#ifndef MATA_NFA_REVERSE_DELTA_HH_
+#define MATA_NFA_REVERSE_DELTA_HH_
+
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "mata/nfa/types.hh"
+
+namespace mata::nfa {
+
+class Delta;
+
+/// Transition incoming to a state, seen from its target.
+struct IncomingTransition {
+    Symbol symbol; ///< Transition symbol.
+    State source; ///< Source state.
+    /// Index of the transition in the order of @c Delta::transitions().
+    size_t index;
+};
+
+/**
+ * @brief Index of transitions of a @c Delta by their target states, i.e., predecessors of each state.
+ *
+ * Transitions incoming to all states are stored in a single array in the compressed sparse row (CSR) format, built by
+ *  a counting sort over the targets in time linear in the number of transitions (plus sorting the transitions incoming
+ *  to each state).
+ *
+ * The index does not change with the delta it was built from. Use @c Delta::get_reverse_delta() to get an index
+ *  cached in the delta and rebuilt only after the delta changes.
+ */
+class ReverseDelta {
+public:
+    ReverseDelta() = default;
+    /// Build the index of transitions of @p delta.
+    explicit ReverseDelta(const Delta& delta);
+
+    /// Number of states of the delta the index was built from.
+    size_t num_of_states() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    size_t num_of_transitions() const { return transitions_.size(); }
+
+    /**
+     * @brief Get transitions incoming to @p target, ordered by the symbol and then by the source.
+     *
+     * @return Incoming transitions, empty for states outside the index.
+     */
+    std::span<const IncomingTransition> operator[](const State target) const {
+        if (target >= num_of_states()) { return {}; }
+        return { transitions_.data() + offsets_[target], transitions_.data() + offsets_[target + 1] };
+    }
+
+private:
+    /// Transitions incoming to state @c q are at indices <tt>[offsets_[q], offsets_[q + 1])</tt>.
+    std::vector<size_t> offsets_{};
+    std::vector<IncomingTransition> transitions_{};
+}; // class ReverseDelta.
+
+/**
+ * @brief Lazily built @c ReverseDelta of a @c Delta, owned by the delta.
+ *
+ * Copies of the delta share the built index. Mutating operations of the delta drop the index, so it is rebuilt on
+ *  the next request. Concurrent requests from multiple threads (to a delta not being modified) are safe.
+ */
+class ReverseDeltaCache {
+public:
+    ReverseDeltaCache() = default;
+    ReverseDeltaCache(const ReverseDeltaCache& other): reverse_delta_{ other.load() } {}
+    ReverseDeltaCache(ReverseDeltaCache&& other) noexcept: reverse_delta_{ std::move(other.reverse_delta_) } {}
+    ReverseDeltaCache& operator=(const ReverseDeltaCache& other) {
+        if (this != &other) { reverse_delta_ = other.load(); }
+        return *this;
+    }
+    ReverseDeltaCache& operator=(ReverseDeltaCache&& other) noexcept {
+        reverse_delta_ = std::move(other.reverse_delta_);
+        return *this;
+    }
+
+    /// Get the index of @p delta, building it if it is not built yet.
+    std::shared_ptr<const ReverseDelta> get(const Delta& delta) const;
+    /// Drop the index. Called by mutating operations of the owning delta.
+    void invalidate() { if (reverse_delta_ != nullptr) { reverse_delta_.reset(); } }
+
+private:
+    mutable std::mutex mutex_{};
+    mutable std::shared_ptr<const ReverseDelta> reverse_delta_{};
+
+    std::shared_ptr<const ReverseDelta> load() const {
+        const std::lock_guard lock{ mutex_ };
+        return reverse_delta_;
+    }
+}; // class ReverseDeltaCache.
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_REVERSE_DELTA_HH_.
@@ -0,0 +1,82 @@
+/* simulation.hh -- Simulation preorder over states of an automaton.
+ */
+
+#ifndef MATA_NFA_SIMULATION_HH_
+#define MATA_NFA_SIMULATION_HH_
+
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "mata/simlib/util/binary_relation.hh"
+#include "mata/nfa/types.hh"
+
+namespace mata::nfa {
+
+/**
+ * @brief Simulation preorder over states, represented by a partition of states and a partial order on its blocks.
+ *
+ * Each block contains mutually simulating states. A state @c q is simulated by a state @c r iff the block of @c q is
+ *  below (or equal to) the block of @c r. For each block, the blocks above it are stored in a sorted vector, hence
+ *  the relation takes space proportional to the number of related pairs of blocks instead of the square of the
+ *  number of states as @c Simlib::Util::BinaryRelation.
+ *
+ * States outside the domain of the relation (see @c algorithms::compute_simulation()) are in no block and are
+ *  related only to themselves.
+ */
+class SimulationRelation {
+public:
+    static constexpr size_t NO_BLOCK{ std::numeric_limits<size_t>::max() };
+
+    SimulationRelation() = default;
+    /**
+     * @brief Create a relation from the blocks of states and the order on blocks.
+     *
+     * @param[in] block_of_state Block of each state, @c NO_BLOCK for states outside the domain.
+     * @param[in] blocks_above For each block, all blocks above it (including the block itself), in an ascending order.
+     */
+    SimulationRelation(std::vector<size_t> block_of_state, std::vector<std::vector<size_t>> blocks_above);
+
+    size_t num_of_states() const { return block_of_state_.size(); }
+    size_t num_of_blocks() const { return blocks_above_.size(); }
+
+    /// Get the block of @p state, @c NO_BLOCK if the state is outside the domain of the relation.
+    size_t get_block(const State state) const {
+        return state < block_of_state_.size() ? block_of_state_[state] : NO_BLOCK;
+    }
+
+    /// Check whether @p lower_block is simulated by @p upper_block.
+    bool is_block_below(size_t lower_block, size_t upper_block) const;
+
+    /// Get all blocks above @p block (including @p block), in an ascending order.
+    std::span<const size_t> get_blocks_above(const size_t block) const { return blocks_above_[block]; }
+
+    /// Check whether @p state is simulated by @p simulating_state. Same as @c Simlib::Util::BinaryRelation::get().
+    bool get(State state, State simulating_state) const;
+
+    /// Get the smallest state in the block of @p state, @p state itself if it is outside the domain.
+    State get_representative(const State state) const {
+        const size_t block{ get_block(state) };
+        return block == NO_BLOCK ? state : representatives_[block];
+    }
+
+    /**
+     * @brief Get the representative of each state, see @c get_representative().
+     *
+     * Corresponds to @c Simlib::Util::BinaryRelation::get_quotient_projection() of the symmetric part of the relation.
+     */
+    std::vector<size_t> get_quotient_projection() const;
+
+    /// Convert into a dense @c Simlib::Util::BinaryRelation over all states.
+    Simlib::Util::BinaryRelation to_binary_relation() const;
+
+private:
+    std::vector<size_t> block_of_state_{};
+    std::vector<std::vector<size_t>> blocks_above_{};
+    /// The smallest state of each block.
+    std::vector<State> representatives_{};
+}; // class SimulationRelation.
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_SIMULATION_HH_.
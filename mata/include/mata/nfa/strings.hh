@@ -4,6 +4,11 @@
 #ifndef MATA_NFA_STRING_SOLVING_HH_
 #define MATA_NFA_STRING_SOLVING_HH_
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "mata/alphabet.hh"
 #include "mata/nfa/delta.hh"
 #include "mata/nfa/types.hh"
@@ -161,6 +166,48 @@ public:
     using EpsilonDepthTransitions = std::unordered_map<EpsilonDepth, std::vector<Transition>>;
     using EpsilonDepthTransitionMap = std::unordered_map<EpsilonDepth, std::unordered_map<State, std::vector<Transition>>>;
 
+    /**
+     * View of a segment over the segment automaton.
+     *
+     * The states of the segment are the states of one depth, renamed to 0, 1, ... in the order of their original
+     *  numbers. The transitions of the segment are the transitions of the segment automaton between these states,
+     *  except for ε-transitions. Initial states of the segment are the initial states of the segment automaton (for
+     *  the first segment) or the targets of ε-transitions leading to the segment. Final states are the final states of
+     *  the segment automaton (for the last segment) or the sources of ε-transitions leaving the segment.
+     */
+    class SegmentView {
+    public:
+        SegmentView(const Segmentation& segmentation, const size_t segment_idx)
+            : segmentation_{ segmentation }, segment_idx_{ segment_idx } {}
+
+        size_t num_of_states() const {
+            return segmentation_.segment_offsets[segment_idx_ + 1] - segmentation_.segment_offsets[segment_idx_];
+        }
+        /// Original state of the segment state @p state.
+        State original_state(const State state) const {
+            return segmentation_.segment_states[segmentation_.segment_offsets[segment_idx_] + state];
+        }
+        /// Whether the original state @p original_state is in the segment.
+        bool contains(const State original_state) const {
+            return original_state < segmentation_.state_depths.size()
+                   && segmentation_.state_depths[original_state] == segment_idx_;
+        }
+        /// Segment state of the original state @p original_state. The state must be in the segment.
+        State segment_state(const State original_state) const {
+            assert(contains(original_state));
+            return segmentation_.renamed_states[original_state];
+        }
+        /**
+         * Create an NFA of the segment, with the renamed states.
+         * @return Segment NFA. For the untrimmed segment with the original states, see @c get_untrimmed_segments().
+         */
+        Nfa to_nfa() const;
+
+    private:
+        const Segmentation& segmentation_;
+        const size_t segment_idx_;
+    }; // Class SegmentView.
+
     /**
      * Prepare automaton @p aut for segmentation.
      * @param[in] aut Segment automaton to make segments for.
@@ -170,18 +217,36 @@ public:
         compute_epsilon_depths(); // Map depths to epsilon transitions.
     }
 
+    /**
+     * Get ε-transitions for each depth.
+     * @return ε-transitions of the depth @c i at the position @c i.
+     */
+    const std::vector<std::vector<Transition>>& get_epsilon_transitions() const { return depth_epsilon_transitions; }
+
     /**
      * Get segmentation depths for ε-transitions.
      * @return Map of depths to lists of ε-transitions.
      */
-    const EpsilonDepthTransitions& get_epsilon_depths() const { return epsilon_depth_transitions; }
+    const EpsilonDepthTransitions& get_epsilon_depths() const;
 
     /**
      * Get the epsilon depth trans map object (mapping of depths and states to eps-successors)
      *
      * @return Map of depths to a map of states to transitions
      */
-    const EpsilonDepthTransitionMap& get_epsilon_depth_trans_map() const { return this->eps_depth_trans_map; }
+    const EpsilonDepthTransitionMap& get_epsilon_depth_trans_map() const;
+
+    /// Number of segments.
+    size_t num_of_segments() const { return segment_offsets.size() - 1; }
+
+    /**
+     * Get a view of a segment.
+     * @param[in] segment_idx Index of the segment, from the left (initial states in segment automaton).
+     */
+    SegmentView get_segment_view(const size_t segment_idx) const {
+        assert(segment_idx < num_of_segments());
+        return SegmentView{ *this, segment_idx };
+    }
 
     /**
      * Get segment automata.
@@ -197,31 +262,47 @@ public:
      */
     const std::vector<Nfa>& get_untrimmed_segments();
 
-    const VisitedEpsMap& get_visited_eps() const { return this->visited_eps; }
+    /**
+     * Get the number of visited epsilons for each state reached by a transition.
+     *
+     * Initial states not reached by any transition have no entry.
+     * @return Map of states to the numbers of visited epsilons on the way to the state.
+     */
+    const VisitedEpsMap& get_visited_eps() const;
 
 private:
+    /// Depth of states not reachable from the initial states.
+    static constexpr EpsilonDepth UNREACHED_DEPTH{ std::numeric_limits<EpsilonDepth>::max() };
+
     const std::set<Symbol> epsilons; ///< Symbol for which to execute segmentation.
     /// Automaton to execute segmentation for. Must be a segment automaton (can be split into @p segments).
     const SegNfa& automaton;
-    EpsilonDepthTransitions epsilon_depth_transitions{}; ///< Epsilon depths.
-    EpsilonDepthTransitionMap eps_depth_trans_map{}; /// Epsilon depths with mapping of states to epsilon transitions
+    std::vector<EpsilonDepth> state_depths{}; ///< Depth of each state.
+    std::vector<std::vector<Transition>> depth_epsilon_transitions{}; ///< ε-transitions indexed by depths.
+    /// Reached states grouped by their depths (segments), in the order of their numbers within each depth.
+    std::vector<State> segment_states{};
+    /// Position of the first state of the segment @c i in @c segment_states, for all segments and the end.
+    std::vector<size_t> segment_offsets{};
+    std::vector<State> renamed_states{}; ///< Position of each reached state within its segment.
+    /// Number of visited epsilons (in the order of @c epsilons) for each state, @c epsilons.size() per state.
+    std::vector<unsigned> visited_eps_counters{};
+    // The maps below are created on demand by the const getters from the vectors above.
+    mutable EpsilonDepthTransitions epsilon_depth_transitions{}; ///< Epsilon depths, created on demand.
+    /// Epsilon depths with mapping of states to epsilon transitions, created on demand.
+    mutable EpsilonDepthTransitionMap eps_depth_trans_map{};
     std::vector<SegNfa> segments{}; ///< Segments for @p automaton.
     std::vector<SegNfa> segments_raw{}; ///< Raw segments for @p automaton.
-    VisitedEpsMap visited_eps{}; /// number of visited eps for each state
+    mutable VisitedEpsMap visited_eps{}; ///< Number of visited eps for each state, created on demand.
 
     /**
-     * Pair of state and its depth.
+     * Compute epsilon depths with their transitions.
      */
-    struct StateDepthTuple {
-        State state; ///< State with a depth.
-        EpsilonDepth depth; ///< Depth of a state.
-        VisitedEpsilonsCounterMap eps; /// visited epsilons and their numbers
-    };
+    void compute_epsilon_depths();
 
     /**
-     * Compute epsilon depths with their transitions.
+     * Group the reached states by their depths into segments.
      */
-    void compute_epsilon_depths();
+    void group_states_into_segments();
 
     /**
      * Split segment @c automaton into @c segments.
@@ -242,43 +323,6 @@ private:
      */
     void update_current_segment(size_t current_depth, const Transition& transition);
 
-    /**
-     * Initialize map of visited states.
-     * @return Map of visited states.
-     */
-    std::unordered_map<State, bool> initialize_visited_map() const;
-
-    /**
-     * Initialize worklist of states with depths to process.
-     * @return Queue of state and its depth pairs.
-     */
-    std::deque<StateDepthTuple> initialize_worklist() const;
-
-    /**
-     * Process pair of state and its depth.
-     * @param[in] state_depth_pair Current state depth pair.
-     * @param[out] worklist Worklist of state and depth pairs to process.
-     */
-    void process_state_depth_pair(const StateDepthTuple& state_depth_pair, std::deque<StateDepthTuple>& worklist);
-
-    /**
-     * Add states with non-epsilon transitions to the @p worklist.
-     * @param move[in] Move from current state.
-     * @param depth[in] Current depth.
-     * @param worklist[out] Worklist of state and depth pairs to process.
-     */
-    void add_transitions_to_worklist(const StateDepthTuple& state_depth_pair, const SymbolPost& move,
-                                     std::deque<StateDepthTuple>& worklist);
-
-    /**
-     * Process epsilon transitions for the current state.
-     * @param[in] state_depth_pair Current state depth pair.
-     * @param[in] move Move from current state.
-     * @param[out] worklist Worklist of state and depth pairs to process.
-     */
-    void handle_epsilon_transitions(const StateDepthTuple& state_depth_pair, const SymbolPost& move,
-                                    std::deque<StateDepthTuple>& worklist);
-
     /**
      * @brief Remove inner initial and final states.
      *
@@ -325,6 +369,86 @@ void segs_one_initial_final(
  */
 std::vector<Noodle> noodlify(const SegNfa& aut, Symbol epsilon, bool include_empty = false);
 
+/**
+ * @brief Generator of noodles of a segment automaton, producing the noodles on demand.
+ *
+ * The generator walks the chains of ε-transitions (one ε-transition from each depth) depth-first, from the last depth
+ *  to the first one. A chain is extended only by the ε-transitions whose targets reach the source of the previously
+ *  chosen ε-transition, so that the combinations of ε-transitions which are not connected are never enumerated. The
+ *  segments of the noodles (a segment with one initial and one final state, trimmed and reduced) are computed lazily
+ *  when first reached and are shared between the noodles.
+ *
+ * The noodles are produced in the order in which @c noodlify() returns them.
+ */
+class NoodleGenerator {
+public:
+    /**
+     * Prepare the generation of noodles of @p aut.
+     * @param[in] aut Segment automaton to noodlify.
+     * @param[in] epsilon Epsilon symbol to noodlify for.
+     * @param[in] include_empty Whether to also include empty noodles.
+     */
+    NoodleGenerator(const SegNfa& aut, Symbol epsilon, bool include_empty = false);
+
+    /**
+     * Produce the next noodle.
+     * @return The next noodle, or @c std::nullopt if all noodles have already been produced.
+     */
+    std::optional<Noodle> next();
+
+    /**
+     * Produce all remaining noodles, passing each of them to @p consume as soon as it is produced.
+     *
+     * With more threads, the chains ending with different ε-transitions of the last depth are walked in parallel. The
+     *  calls of @p consume are serialized, but the noodles are not produced in any particular order then, and the
+     *  generator produces no more noodles afterwards, even if the production was stopped.
+     * @param[in] consume Consumer of noodles. Returns @c false to stop the production of noodles.
+     * @param[in] num_of_threads Number of threads to produce the noodles with (0 for the number of hardware threads).
+     * @return @c false if the production was stopped by @p consume, @c true otherwise.
+     */
+    bool produce(const std::function<bool(Noodle&&)>& consume, size_t num_of_threads = 1);
+
+private:
+    /// Choice of an ε-transition, followed by a segment with one initial and one final state.
+    struct Choice {
+        State source; ///< Source of the ε-transition, the final state of the previous segment.
+        std::shared_ptr<SegNfa> segment; ///< Segment following the ε-transition.
+    };
+
+    /// Choices of ε-transitions at a depth, given the source of the ε-transition chosen at the next depth.
+    struct Frame {
+        std::vector<Choice> choices{};
+        size_t next_choice{ 0 };
+    };
+
+    /// Depth-first walk over the chains of ε-transitions.
+    struct Walk {
+        /// Frames from the last depth. The frame at the position @c i is for the depth @c num_of_depths - 1 - i.
+        std::vector<Frame> frames{};
+        /// Segments of the choices leading to the frames (the last segment of the noodle first).
+        Noodle segments{};
+        bool started{ false };
+    };
+
+    std::vector<SegNfa> segments_{}; ///< Segments of the segment automaton, with states renamed in each segment.
+    /// ε-transitions for each depth, between the renamed states of the neighbouring segments.
+    std::vector<std::vector<Transition>> epsilon_transitions_{};
+    const bool include_empty_;
+    State unused_state_; ///< State not used in any segment, standing for all initial (final) states.
+    /// Segments (by their index) with one initial and one final state, @c nullptr if the segment is empty (and not
+    ///  included).
+    std::map<std::tuple<size_t, State, State>, std::shared_ptr<SegNfa>> segments_one_initial_final_{};
+    std::mutex segments_mutex_{};
+    Walk walk_{};
+
+    /// Segment @p segment_idx with the only initial state @p initial_state and the only final state @p final_state.
+    std::shared_ptr<SegNfa> get_segment(size_t segment_idx, State initial_state, State final_state);
+    /// Choices of ε-transitions at @p depth followed by a segment reaching @p final_state.
+    std::vector<Choice> get_choices(size_t depth, State final_state);
+    /// Advance the @p walk to the next noodle. Return @c std::nullopt when there is none.
+    std::optional<Noodle> advance(Walk& walk);
+}; // Class NoodleGenerator.
+
 /**
  * @brief Create noodles from segment automaton @p aut.
  *
@@ -0,0 +1,136 @@
+/* symbolic-nfa.hh -- NFA with transitions guarded by BDDs over bitvector variables.
+ */
+
+#ifndef MATA_NFA_SYMBOLIC_NFA_HH_
+#define MATA_NFA_SYMBOLIC_NFA_HH_
+
+#include <span>
+#include <vector>
+
+#include "mata/cudd/cuddObj.hh"
+#include "mata/nfa/types.hh"
+#include "mata/utils/sparse-set.hh"
+
+namespace mata::nfa {
+
+class Nfa;
+
+/// Move of a @c SymbolicNfa: a target state and the guard over which the target is entered.
+struct SymbolicMove {
+    BDD guard; ///< Set of letters (assignments to the bitvector variables) of the move.
+    State target; ///< Target state.
+};
+
+/**
+ * @brief NFA over bitvector letters with transitions guarded by BDDs, e.g., automata in the @c NFA-bits format.
+ *
+ * Instead of splitting the guards into minterms upfront (see @c Mintermization), each transition keeps its guard,
+ *  a BDD over the bitvector variables representing the set of letters of the transition. Operations work with
+ *  conjunctions of the guards and their satisfiability, and the minterms are computed only locally when needed (e.g.,
+ *  over the guards leaving a single macrostate in the determinization). Use @c mintermize() to export the automaton
+ *  into an explicit @c Nfa.
+ *
+ * Each source has at most one move to each target: guards of transitions between the same states are disjoined.
+ *  Transitions with an unsatisfiable guard are not stored.
+ *
+ * All automata combined by an operation must share the BDD manager (copies of a @c Cudd share the manager).
+ */
+class SymbolicNfa {
+public:
+    /// Manager of the guards.
+    Cudd manager;
+    utils::SparseSet<State> initial{};
+    utils::SparseSet<State> final{};
+
+    explicit SymbolicNfa(const Cudd& manager, const size_t num_of_states = 0)
+        : manager{ manager }, posts_(num_of_states) {}
+
+    /// Number of states, i.e., one more than the largest state used by transitions, initial or final states.
+    size_t num_of_states() const;
+    /// Add a new state to the automaton.
+    State add_state() {
+        const State state{ num_of_states() };
+        posts_.resize(state + 1);
+        return state;
+    }
+
+    /**
+     * @brief Add a transition from @p source to @p target over the letters of @p guard.
+     *
+     * The guard is disjoined with the guard of an existing move from @p source to @p target.
+     */
+    void add_transition(State source, const BDD& guard, State target);
+
+    /// Moves from @p source, ordered by their targets.
+    std::span<const SymbolicMove> moves(const State source) const {
+        if (source >= posts_.size()) { return {}; }
+        return posts_[source];
+    }
+
+    /// Number of moves, i.e., pairs of states connected by a transition.
+    size_t num_of_transitions() const;
+
+    /// Check whether the guards of the moves from each state are pairwise disjoint and there is at most one initial
+    ///  state.
+    bool is_deterministic() const;
+
+    /**
+     * @brief Check whether the language of the automaton is empty.
+     *
+     * @param[out] cex Sets of letters of a shortest accepting run, one set (BDD) for each transition of the run. Any word
+     *  picking a letter from each of the sets is in the language.
+     * @return True iff the language is empty.
+     */
+    bool is_lang_empty(std::vector<BDD>* cex = nullptr) const;
+
+    /// Check whether the word of @p letters, each letter being a (satisfiable) conjunction of literals of all
+    ///  variables, is in the language of the automaton.
+    bool is_in_lang(std::span<const BDD> letters) const;
+
+private:
+    /// Moves of each state, ordered by the targets.
+    std::vector<std::vector<SymbolicMove>> posts_{};
+}; // class SymbolicNfa.
+
+/**
+ * @brief Compute the product of @p lhs and @p rhs, with conjunctions of the guards as the guards of the product.
+ *
+ * Only the reachable part of the product is constructed.
+ * @throws std::runtime_error The automata do not share the BDD manager.
+ */
+SymbolicNfa intersection(const SymbolicNfa& lhs, const SymbolicNfa& rhs);
+
+/**
+ * @brief Determinize @p aut by the subset construction over guards.
+ *
+ * The guards of the moves leaving each macrostate are refined into their local minterms only, the macrostate then has
+ *  a move for each of the local minterms.
+ * @return Deterministic automaton with only reachable macrostates and without the empty (sink) macrostate.
+ */
+SymbolicNfa determinize(const SymbolicNfa& aut);
+
+/**
+ * @brief Check inclusion of the languages of @p smaller in @p bigger.
+ *
+ * Pairs of a state of @p smaller and a macrostate of @p bigger are explored, the guard of each move of @p smaller
+ *  split into the local minterms of the guards leaving the macrostate.
+ * @param[out] cex Sets of letters of a word accepted by @p smaller and not by @p bigger, see
+ *  @c SymbolicNfa::is_lang_empty().
+ * @return True iff the language of @p smaller is included in the language of @p bigger.
+ * @throws std::runtime_error The automata do not share the BDD manager.
+ */
+bool is_included(const SymbolicNfa& smaller, const SymbolicNfa& bigger, std::vector<BDD>* cex = nullptr);
+
+/**
+ * @brief Export @p aut into an explicit @c Nfa over the minterms of all its guards.
+ *
+ * The symbols are assigned deterministically, by refining the minterms with the guards in the order of their first
+ *  occurrence in the transitions.
+ * @param[out] minterms Minterm of each symbol of the resulting automaton, the symbol being the index.
+ * @return Automaton with the same states, and a transition over each minterm included in a guard of a move.
+ */
+Nfa mintermize(const SymbolicNfa& aut, std::vector<BDD>* minterms = nullptr);
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_SYMBOLIC_NFA_HH_.
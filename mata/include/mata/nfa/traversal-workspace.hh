@@ -0,0 +1,202 @@
+/* traversal-workspace.hh -- Reusable buffers of graph traversals over automata.
+ */
+
+#ifndef MATA_NFA_TRAVERSAL_WORKSPACE_HH_
+#define MATA_NFA_TRAVERSAL_WORKSPACE_HH_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "mata/nfa/types.hh"
+#include "mata/nfa/delta.hh"
+
+namespace mata::nfa {
+
+/**
+ * @brief Queue of states in a ring buffer.
+ *
+ * The capacity is a power of two, doubled only when the queue is full, hence a queue reused across traversals stops
+ *  allocating once it is large enough.
+ */
+class StateQueue {
+public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    void clear() { head_ = 0; size_ = 0; }
+
+    void push(const State state) {
+        if (size_ == buffer_.size()) { grow(); }
+        buffer_[(head_ + size_) & (buffer_.size() - 1)] = state;
+        ++size_;
+    }
+
+    State pop() {
+        const State state{ buffer_[head_] };
+        head_ = (head_ + 1) & (buffer_.size() - 1);
+        --size_;
+        return state;
+    }
+
+private:
+    std::vector<State> buffer_{};
+    size_t head_{ 0 };
+    size_t size_{ 0 };
+
+    void grow() {
+        std::vector<State> buffer(buffer_.empty() ? 16 : 2 * buffer_.size());
+        for (size_t i{ 0 }; i < size_; ++i) { buffer[i] = buffer_[(head_ + i) & (buffer_.size() - 1)]; }
+        buffer_ = std::move(buffer);
+        head_ = 0;
+    }
+}; // class StateQueue.
+
+/**
+ * @brief Data of a state in the non-recursive Tarjan's algorithm, see @c Nfa::tarjan_scc_discover().
+ *
+ * @tparam SuccessorIterator Iterator over successors of the state, storing the state of the iteration.
+ */
+template<typename SuccessorIterator>
+struct TarjanNodeData {
+    SuccessorIterator current_move{};
+    SuccessorIterator end_move{};
+    // index of a node (corresponds to the time of discovery)
+    unsigned long index{ 0 };
+    // index of a lower node in the same SCC
+    unsigned long lowlink{ 0 };
+    // was the node already initialized (=the initial phase of the Tarjan's recursive call was executed)
+    bool initilized{ false };
+    // is node on Tarjan's stack?
+    bool on_stack{ false };
+
+    TarjanNodeData() = default;
+
+    template<typename Successors>
+    TarjanNodeData(const Successors& successors, unsigned long index)
+        : current_move(successors.begin()), end_move(successors.end()), index(index), lowlink(index),
+          initilized(true), on_stack(true) {}
+};
+
+/// Buffers of the non-recursive Tarjan's algorithm, see @c Nfa::tarjan_scc_discover().
+template<typename SuccessorIterator>
+struct TarjanBuffers {
+    std::vector<TarjanNodeData<SuccessorIterator>> node_info{};
+    /// Simulated program stack of the recursive calls.
+    std::vector<State> program_stack{};
+    std::vector<State> tarjan_stack{};
+    /// The last discovered SCC.
+    std::vector<State> scc{};
+
+    /// Prepare the buffers for an automaton with @p num_of_states states, keeping the allocated memory.
+    void start(const size_t num_of_states) {
+        node_info.assign(num_of_states, {});
+        program_stack.clear();
+        tarjan_stack.clear();
+        scc.clear();
+    }
+};
+
+/**
+ * @brief Buffers of graph traversals (BFS, DFS, Tarjan's algorithm) over automata, reused across calls.
+ *
+ * Algorithms such as @c Nfa::is_lang_empty(), @c Nfa::get_reachable_states(), @c Nfa::distances_from_initial(),
+ *  @c Nfa::get_useful_states() and @c Nfa::trim() optionally accept a workspace. When the same workspace is passed to
+ *  repeated calls, the buffers grow to the size of the largest automaton and no further heap allocation is
+ *  performed by the traversals themselves (only the returned results are allocated).
+ *
+ * Visited states are marked by the number (epoch) of the current traversal, hence starting a new traversal does not
+ *  clear the marks. Parents of states form a flat array indexed by states, valid only for visited states.
+ *
+ * A workspace must not be used by two traversals at the same time, e.g., from multiple threads.
+ */
+class TraversalWorkspace {
+public:
+    TraversalWorkspace() = default;
+
+    /**
+     * @brief Start a new traversal of an automaton with @p num_of_states states.
+     *
+     * All states become unvisited, and the queue and the stack become empty.
+     */
+    void start(const size_t num_of_states) {
+        if (visit_epochs_.size() < num_of_states) {
+            visit_epochs_.resize(num_of_states, 0);
+            parents_.resize(num_of_states);
+            parent_symbols_.resize(num_of_states);
+        }
+        if (++epoch_ == 0) { // Overflow of epochs: clear the marks of all past traversals.
+            std::fill(visit_epochs_.begin(), visit_epochs_.end(), 0);
+            epoch_ = 1;
+        }
+        queue.clear();
+        stack.clear();
+    }
+
+    bool is_visited(const State state) const { return visit_epochs_[state] == epoch_; }
+
+    /**
+     * @brief Mark @p state as visited.
+     *
+     * @return True iff @p state was not visited yet in the current traversal.
+     */
+    bool visit(const State state) {
+        if (visit_epochs_[state] == epoch_) { return false; }
+        visit_epochs_[state] = epoch_;
+        return true;
+    }
+
+    /// Mark @p state as visited from @p parent over @p symbol. See @c visit(State).
+    bool visit(const State state, const State parent, const Symbol symbol) {
+        if (!visit(state)) { return false; }
+        parents_[state] = parent;
+        parent_symbols_[state] = symbol;
+        return true;
+    }
+
+    /// State from which @p state was visited, @p state itself for states visited without a parent.
+    State get_parent(const State state) const { return parents_[state]; }
+    /// Symbol over which @p state was visited from its parent.
+    Symbol get_parent_symbol(const State state) const { return parent_symbols_[state]; }
+
+    /**
+     * @brief Mark @p state as visited without a parent, i.e., as a root of the traversal.
+     *
+     * @return True iff @p state was not visited yet in the current traversal.
+     */
+    bool visit_root(const State state) { return visit(state, state, Symbol{ 0 }); }
+
+    /**
+     * @brief Get the run from a root to @p state following the parents.
+     *
+     * @param[out] run Run to fill with the path and the word.
+     */
+    void get_run_to(State state, Run& run) const {
+        run.path.clear();
+        run.word.clear();
+        run.path.push_back(state);
+        while (parents_[state] != state) {
+            run.word.push_back(parent_symbols_[state]);
+            state = parents_[state];
+            run.path.push_back(state);
+        }
+        std::reverse(run.path.begin(), run.path.end());
+        std::reverse(run.word.begin(), run.word.end());
+    }
+
+    /// Queue of breadth-first traversals.
+    StateQueue queue{};
+    /// Stack of depth-first traversals.
+    std::vector<State> stack{};
+    /// Buffers of the Tarjan's algorithm over @c Nfa.
+    TarjanBuffers<StatePost::Moves::const_iterator> tarjan{};
+
+private:
+    uint32_t epoch_{ 0 };
+    std::vector<uint32_t> visit_epochs_{};
+    std::vector<State> parents_{};
+    std::vector<Symbol> parent_symbols_{};
+}; // class TraversalWorkspace.
+
+} // namespace mata::nfa.
+
+#endif // MATA_NFA_TRAVERSAL_WORKSPACE_HH_.
@@ -109,6 +109,23 @@ Nft product(const Nft& lhs, const Nft& rhs, const std::function<bool(State,State
             std::unordered_map<std::pair<State,State>, State> *prod_map = nullptr, JumpMode jump_mode = JumpMode::RepeatSymbol,
             const State lhs_first_aux_state = Limits::max_state, const State rhs_first_aux_state = Limits::max_state);
 
+/**
+ * @brief Compose two NFTs by inserting levels to both of them, intersecting them, and projecting out the
+ *  synchronization levels.
+ *
+ * Materializes all the intermediate transducers. Use @c mata::nft::compose(), which computes the composition on the
+ *  fly, instead.
+ * @param[in] lhs First transducer to compose.
+ * @param[in] rhs Second transducer to compose.
+ * @param[in] lhs_sync_levels Ordered vector of synchronization levels of the @p lhs.
+ * @param[in] rhs_sync_levels Ordered vector of synchronization levels of the @p rhs.
+ * @param[in] jump_mode Specifies if the symbol on a jump transition (a transition with a length greater than 1)
+ *  is interpreted as a sequence repeating the same symbol or as a single instance of the symbol followed by a sequence of @c DONT_CARE.
+ * @return A new NFT after the composition.
+ */
+Nft compose_naive(const Nft& lhs, const Nft& rhs, const utils::OrdVector<Level>& lhs_sync_levels,
+                  const utils::OrdVector<Level>& rhs_sync_levels, JumpMode jump_mode = JumpMode::RepeatSymbol);
+
 /**
  * @brief Concatenate two NFTs.
  *
@@ -0,0 +1,111 @@
+/* applier.hh -- Application of an NFT to many NFAs, computing their images.
+ */
+
+#ifndef MATA_NFT_APPLIER_HH_
+#define MATA_NFT_APPLIER_HH_
+
+#include <span>
+#include <vector>
+
+#include "mata/nft/types.hh"
+#include "mata/nfa/nfa.hh"
+#include "mata/utils/utils.hh"
+
+namespace mata::nft {
+
+class Nft;
+
+/**
+ * @brief Application of an NFT to NFAs, computing the images of their languages directly as NFAs.
+ *
+ * The image of an NFA @c A is the set of words on the output level of all tuples accepted by the NFT whose word on the
+ *  input level is in the language of @c A. It is the language of `project_to(nft.apply(A, input_level), ...)` for the
+ *  forward application (input level 0 and output level 1 of a 2-level NFT), and of the corresponding projection of
+ *  `nft.apply_backward(A, input_level)` for the backward application (the preimage, input level 1 and output level 0).
+ *  Other levels than the input and the output level are projected out.
+ *
+ * The NFT is preprocessed once when the applier is created: for each state on level 0, all steps, i.e., the paths
+ *  over all levels to the next state on level 0, are indexed by the symbol read on the input level, with jumps
+ *  expanded according to the jump mode. Steps reading and writing epsilon are folded into the other steps by the
+ *  epsilon closures of the states on level 0. Each application is then a single product of the NFA with the indexed
+ *  steps, without building the NFT of the NFA, the composition, and the projection.
+ *
+ * As in @c compose(), @c DONT_CARE on the input level reads any symbol of the NFA or epsilon (and so does
+ *  @c DONT_CARE of the NFA). @c DONT_CARE on the output level is kept in the image.
+ *  The images may contain epsilon transitions (steps not writing on the output level, or epsilon transitions of the
+ *  NFA).
+ *
+ * The NFT may be modified or destroyed after the applier is created. The applier is not modified by applying it, and
+ *  can be used by multiple threads at once.
+ */
+class NftApplier {
+public:
+    /**
+     * @brief Preprocess @p nft for the application on @p input_level producing the images on @p output_level.
+     *
+     * @param[in] jump_mode Specifies if the symbol on a jump transition (a transition with a length greater than 1)
+     *  is interpreted as a sequence repeating the same symbol, or as a single instance of the symbol followed by a
+     *  sequence of @c DONT_CARE symbols.
+     * @throws std::invalid_argument The levels are equal or not levels of @p nft.
+     */
+    explicit NftApplier(const Nft& nft, Level input_level = 0, Level output_level = 1,
+                        JumpMode jump_mode = JumpMode::RepeatSymbol);
+
+    /// Compute the image of the language of @p nfa. The image is trimmed.
+    nfa::Nfa apply(const nfa::Nfa& nfa) const;
+
+    /**
+     * @brief Compute the images of the languages of all @p nfas.
+     *
+     * @param[in] num_of_threads Number of threads computing the images, each applying the NFT to a part of @p nfas,
+     *  or 0 for the number of hardware threads.
+     * @return The images, in the order of @p nfas.
+     */
+    std::vector<nfa::Nfa> apply(std::span<const nfa::Nfa> nfas, size_t num_of_threads = 1) const;
+
+    /**
+     * @brief Check whether the image of the language of @p nfa is empty.
+     *
+     * The product is explored only until a final state is reached, without constructing the image.
+     */
+    bool is_image_empty(const nfa::Nfa& nfa) const;
+
+    /// Number of the indexed steps, i.e., the paths over all levels between states on level 0.
+    size_t num_of_steps() const { return num_of_steps_; }
+
+private:
+    /// Path over all levels of the NFT from a state on level 0 to the next state on level 0.
+    struct Step {
+        Symbol input;
+        Symbol output;
+        State target;
+
+        auto operator<=>(const Step&) const = default;
+    };
+
+    Level input_level_;
+    Level output_level_;
+    /// Steps from each state on level 0 (and the states in its epsilon closure), sorted by the input symbol.
+    std::vector<std::vector<Step>> steps_{};
+    /// Whether a final state is in the epsilon closure of the state.
+    BoolVector is_final_{};
+    std::vector<State> initial_{};
+    size_t num_of_steps_{ 0 };
+
+    /// Append all steps from @p source to @p steps.
+    void collect_steps(const Nft& nft, State source, JumpMode jump_mode, std::vector<Step>& steps) const;
+    /// Fold the steps reading and writing epsilon into the other steps of the epsilon closures.
+    void fold_epsilon_steps();
+
+    /**
+     * @brief Explore the product of @p nfa with the steps from the initial states.
+     *
+     * @param[out] image The image to construct, or @c nullptr to stop at the first final state of the product.
+     * @return @c true iff a final state of the product is reachable.
+     */
+    bool explore(const nfa::Nfa& nfa, nfa::Nfa* image) const;
+}; // class NftApplier.
+
+} // namespace mata::nft.
+
+#endif // MATA_NFT_APPLIER_HH_.
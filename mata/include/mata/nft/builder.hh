@@ -100,6 +100,18 @@ Nft parse_from_mata(const std::string& nft_in_mata);
  */
 Nft parse_from_mata(const std::filesystem::path& nft_file);
 
+/**
+ * Load NFT from a file in the binary format, see @c Nft::save_binary().
+ *
+ * The file is mapped into memory and the transducer is constructed directly from the mapped transitions and levels,
+ *  without any parsing.
+ * @param path Path to the file containing NFT in the binary format.
+ * @param alphabet If specified and the file contains an alphabet, the symbols of the alphabet are added to
+ *  @p alphabet, which is set as the alphabet of the NFT.
+ * @throws std::runtime_error @p path is not a file with an NFT in the binary format.
+ */
+Nft mmap_binary(const std::filesystem::path& path, OnTheFlyAlphabet* alphabet = nullptr);
+
 /**
  * Create NFT from NFA.
  * @param nfa_state NFA to create NFT from.
@@ -408,6 +408,16 @@ public:
      */
     void print_to_mata(std::ostream &output) const;
 
+    /**
+     * @brief Save the transducer to the file @p path in the binary format, including its levels.
+     *
+     * Load the transducer with @c builder::mmap_binary(). See @c Nfa::save_binary(). States without a level (beyond
+     *  the end of @c levels) are saved with @c DEFAULT_LEVEL.
+     * @param[in] path File to save the transducer to.
+     * @param[in] alphabet If specified, the names of the symbols of @p alphabet are saved with the transducer.
+     */
+    void save_binary(const std::filesystem::path& path, const Alphabet* alphabet = nullptr) const;
+
     /// Is the language of the automaton universal?
     bool is_universal(const Alphabet& alphabet, Run* cex = nullptr,
                       const ParameterMap& params = {{ "algorithm", "antichains" }}) const;
@@ -654,6 +664,16 @@ Nft minimize(const Nft &aut, const ParameterMap& params = {{ "algorithm", "brzoz
  */
 Nft determinize(const Nft& aut, std::unordered_map<StateSet, State> *subset_map = nullptr);
 
+/**
+ * @brief Determinize automaton, interning the macrostates in @p macrostates.
+ *
+ * @param[in] aut Automaton to determinize.
+ * @param[out] macrostates Store of macrostates of @p aut, where macrostate @c q is represented by state @c q of the
+ *  determinized automaton. If @c nullptr, a local store is used.
+ * @return Determinized automaton.
+ */
+Nft determinize(const Nft& aut, MacrostateStore* macrostates);
+
 /**
  * @brief Reduce the size of the automaton.
  *
@@ -7,6 +7,7 @@
 #include "mata/parser/parser.hh"
 
 #include "mata/nfa/types.hh"
+#include "mata/nfa/macrostate-store.hh"
 
 #include <limits>
 
@@ -23,6 +24,9 @@ using Run = mata::nfa::Run;
 
 using StateRenaming = mata::nfa::StateRenaming;
 
+using MacrostateId = mata::nfa::MacrostateId;
+using MacrostateStore = mata::nfa::MacrostateStore;
+
 /**
  * @brief Map of additional parameter name and value pairs.
  *
@@ -0,0 +1,111 @@
+/* lexer.hh -- Tokenizer of the Mata Format (MF) over a buffer in memory.
+ */
+
+#ifndef MATA_PARSER_LEXER_HH_
+#define MATA_PARSER_LEXER_HH_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mata::parser {
+
+/// Classes of characters of the Mata Format, combined as bit flags in @c CHAR_CLASSES.
+enum CharClass : uint8_t {
+    /// Whitespace, as @c std::isspace() in the "C" locale.
+    WHITESPACE = 1 << 0,
+    /// Character ending the name of a type in @c @TYPE.
+    TYPE_END = 1 << 1,
+    /// Logical operator (&, |, !), a token on its own.
+    LOGICAL_OPERATOR = 1 << 2,
+    /// Character ending an unquoted token: whitespace, a parenthesis, or the start of a comment.
+    TOKEN_END = 1 << 3,
+};
+
+namespace detail {
+    constexpr std::array<uint8_t, 256> create_char_classes() {
+        std::array<uint8_t, 256> classes{};
+        for (const char ch: { ' ', '\t', '\n', '\v', '\f', '\r' }) {
+            classes[static_cast<unsigned char>(ch)] |= WHITESPACE | TOKEN_END;
+        }
+        for (const char ch: { ' ', '\t', '"', '(', ')', '#', '%', '@', '\\' }) {
+            classes[static_cast<unsigned char>(ch)] |= TYPE_END;
+        }
+        for (const char ch: { '&', '|', '!' }) { classes[static_cast<unsigned char>(ch)] |= LOGICAL_OPERATOR; }
+        for (const char ch: { '(', ')', '#' }) { classes[static_cast<unsigned char>(ch)] |= TOKEN_END; }
+        return classes;
+    }
+} // namespace detail.
+
+/// Classes of all characters, indexed by the character (as an unsigned char).
+inline constexpr std::array<uint8_t, 256> CHAR_CLASSES{ detail::create_char_classes() };
+
+/// Check whether @p ch belongs to any of the classes @p char_class.
+constexpr bool is_char_class(const char ch, const uint8_t char_class) {
+    return (CHAR_CLASSES[static_cast<unsigned char>(ch)] & char_class) != 0;
+}
+
+/// Token of a line in the Mata Format, a view into the tokenized buffer.
+struct Token {
+    /// Text of the token. For a quoted token, the text between the quotes (with the escape sequences kept).
+    std::string_view text{};
+    bool quoted{ false };
+    /// Whether the quoted token contains an escape sequence, i.e., the text differs from @c to_string().
+    bool escaped{ false };
+
+    /// Get the text of the token with the escaped quotes (\") replaced by quotes.
+    std::string to_string() const;
+};
+
+/**
+ * @brief Tokenizer of the Mata Format over a buffer in memory (e.g., a whole file read at once or mapped).
+ *
+ * The lexer does not copy the input: lines and tokens are views into the buffer, which must outlive them. Classes of
+ *  characters are looked up in a static table, hence tokenizing a line performs no allocation (except for growing
+ *  the vector of tokens, which can be reused across lines).
+ */
+class Lexer {
+public:
+    explicit Lexer(const std::string_view input): input_{ input } {}
+
+    /// Position in the input, i.e., the number of characters consumed so far.
+    size_t position() const { return position_; }
+
+    /**
+     * @brief Skip whitespace (including empty lines) and peek at the first character of the next line.
+     *
+     * @return The first character of the next line, or @c '\0' at the end of the input.
+     */
+    char peek_line() {
+        while (position_ < input_.size() && is_char_class(input_[position_], WHITESPACE)) { ++position_; }
+        return position_ < input_.size() ? input_[position_] : '\0';
+    }
+
+    /// Get the rest of the current line (without the newline) and move to the next line.
+    std::string_view next_line() {
+        const size_t end{ std::min(input_.find('\n', position_), input_.size()) };
+        const std::string_view line{ input_.substr(position_, end - position_) };
+        position_ = end < input_.size() ? end + 1 : end;
+        return line;
+    }
+
+    /**
+     * @brief Append tokens of @p line to @p tokens.
+     *
+     * Tokens are separated by whitespace. Parentheses and logical operators outside quoted tokens are tokens on their
+     *  own. Comments (from @c # to the end of the line) are skipped.
+     * @throws std::runtime_error Misplaced or unterminated quotes, or a misplaced @c @TYPE or @c %KEY.
+     */
+    static void tokenize_line(std::string_view line, std::vector<Token>& tokens);
+
+private:
+    std::string_view input_;
+    size_t position_{ 0 };
+}; // class Lexer.
+
+} // namespace mata::parser.
+
+#endif // MATA_PARSER_LEXER_HH_.
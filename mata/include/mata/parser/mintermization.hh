@@ -6,12 +6,94 @@
 #ifndef MATA_MINTERM_HH
 #define MATA_MINTERM_HH
 
+#include <limits>
+
 #include "mata/cudd/cuddObj.hh"
+#include "mata/alphabet.hh"
 
 #include "inter-aut.hh"
 
 namespace mata {
 
+/**
+ * Transforms a graph representing a bitvector formula over symbol variables to a BDD.
+ * @param graph Graph to be transformed
+ * @param bdd_mng Manager to create the BDD with
+ * @param symbol_to_bddvar BDD variables of the symbol names, new names are assigned fresh variables
+ * @return Resulting BDD
+ */
+BDD formula_to_bdd(const FormulaGraph& graph, const Cudd& bdd_mng, std::unordered_map<std::string, BDD>& symbol_to_bddvar);
+
+/**
+ * @brief Partition of all bitvector letters into minterms, refined incrementally by added guards.
+ *
+ * The minterms are leaves of a binary tree whose inner nodes are the past minterms split by the guards. Adding a guard
+ *  descends only into the nodes the guard intersects and splits only the leaves the guard partially overlaps, hence
+ *  minterms unrelated to the guard are not touched. Each guard is a union of minterms, see @c get_minterms_of().
+ *
+ * Minterms are identified by consecutive symbols from 0 (the whole space before any guard is added). When a minterm is
+ *  split, its part inside the guard keeps the symbol and its part outside gets a new symbol. Results computed over
+ *  the minterms before the split remain valid when the new symbol is handled the same as the one it was split from,
+ *  see @c get_splits(). The tree can therefore be shared by automata mintermized one after another.
+ */
+class MintermTree {
+public:
+    /// Identifier of a guard added to the tree, guards are numbered consecutively from 0.
+    using GuardId = size_t;
+
+    explicit MintermTree(const Cudd& bdd_mng);
+
+    /**
+     * @brief Add @p guard, refining the minterms it partially overlaps.
+     *
+     * @return Identifier of the guard. Adding the same guard again returns the same identifier.
+     */
+    GuardId add(const BDD& guard);
+
+    size_t num_of_minterms() const { return leaves_.size(); }
+    size_t num_of_guards() const { return guards_.size(); }
+    /// Letters of the minterm @p minterm.
+    const BDD& get_minterm(const Symbol minterm) const { return nodes_[leaves_[minterm]].region; }
+    const BDD& get_guard(const GuardId guard) const { return guards_[guard]; }
+
+    /**
+     * @brief Get the minterms whose union is @p guard, in an ascending order.
+     *
+     * @p guard must be a union of the minterms, e.g., a guard already added to the tree.
+     */
+    std::vector<Symbol> get_minterms_of(const BDD& guard) const;
+
+    /// Get the guards including the minterm @p minterm (the minterm is disjoint with all other guards).
+    const std::vector<GuardId>& get_guards_of(const Symbol minterm) const { return guards_of_[minterm]; }
+
+    /**
+     * @brief Get the splits of minterms in the order they happened.
+     *
+     * Each split is a pair of the new minterm and the minterm it was split from.
+     */
+    const std::vector<std::pair<Symbol, Symbol>>& get_splits() const { return splits_; }
+
+private:
+    static constexpr size_t NO_CHILD = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        BDD region; ///< Letters of the node, the union of the regions of the children.
+        size_t inside{ NO_CHILD }; ///< Child inside the guard splitting the node.
+        size_t outside{ NO_CHILD }; ///< Child outside the guard splitting the node.
+        Symbol minterm{}; ///< Minterm of a leaf.
+
+        bool is_leaf() const { return inside == NO_CHILD; }
+    };
+
+    Cudd bdd_mng;
+    std::vector<Node> nodes_{}; ///< Nodes of the tree, the root at index 0.
+    std::vector<size_t> leaves_{}; ///< Leaf node of each minterm.
+    std::vector<BDD> guards_{};
+    std::unordered_map<BDD, GuardId> guard_ids_{};
+    std::vector<std::vector<GuardId>> guards_of_{};
+    std::vector<std::pair<Symbol, Symbol>> splits_{};
+}; // class MintermTree.
+
 class Mintermization {
 private: // data types
     struct OptionalBdd {
@@ -38,10 +120,14 @@ private: // private data members
     std::unordered_map<const FormulaGraph*, BDD> trans_to_bddvar{};
     std::unordered_map<const FormulaNode*, std::vector<DisjunctStatesPair>> lhs_to_disjuncts_and_states{};
     std::unordered_set<BDD> bdds{}; // bdds created from transitions
+    MintermTree minterm_tree{ bdd_mng }; // Minterms of all bdds created from transitions, shared by all calls.
 
 private:
     void trans_to_bdd_nfa(const IntermediateAut& aut);
     void trans_to_bdd_afa(const IntermediateAut& aut);
+    /// Mintermize @p aut into @p res over the minterms of the minterm tree.
+    void minterm_tree_to_aut_nfa(mata::IntermediateAut& res, const mata::IntermediateAut& aut);
+    void minterm_tree_to_aut_afa(mata::IntermediateAut& res, const mata::IntermediateAut& aut);
 
 public:
     /**
@@ -68,10 +154,18 @@ public:
      */
     OptionalBdd graph_to_bdd_afa(const FormulaGraph& graph);
 
+    /**
+     * Minterms of the BDDs of transitions of all automata mintermized so far. Symbols of the mintermized automata
+     * are the minterms of the tree.
+     */
+    const MintermTree& get_minterm_tree() const { return minterm_tree; }
+
     /**
      * Method mintermizes given automaton which has bitvector alphabet.
-     * It transforms its transitions to BDDs, then build a minterm tree over the BDDs
+     * It transforms its transitions to BDDs, refines the shared minterm tree by the BDDs
      * and finally transforms automaton to explicit one.
+     * Automata mintermized by earlier calls stay valid when each transition over a minterm split later (see
+     * MintermTree::get_splits()) is duplicated over the new minterm.
      * @param aut Automaton to be mintermized.
      * @return Mintermized automaton
      */
@@ -79,7 +173,7 @@ public:
 
     /**
      * Methods mintermize given automata which have bitvector alphabet.
-     * It transforms transitions of all automata to BDDs, then build a minterm tree over the BDDs
+     * It transforms transitions of all automata to BDDs, refines the shared minterm tree by the BDDs
      * and finally transforms automata to explicit one (sharing the same minterms).
      * @param auts Automata to be mintermized.
      * @return Mintermized automata corresponding to the input autamata
@@ -87,26 +181,6 @@ public:
     std::vector<mata::IntermediateAut> mintermize(const std::vector<const mata::IntermediateAut *> &auts);
     std::vector<mata::IntermediateAut> mintermize(const std::vector<mata::IntermediateAut> &auts);
 
-    /**
-     * The method performs the mintermization over @aut with given @minterms.
-     * It is method specialized for NFA.
-     * @param res The resulting mintermized automaton
-     * @param aut Automaton to be mintermized
-     * @param minterms Set of minterms for mintermization
-     */
-    void minterms_to_aut_nfa(mata::IntermediateAut& res, const mata::IntermediateAut& aut,
-                             const std::unordered_set<BDD>& minterms);
-
-    /**
-     * The method for mintermization of alternating finite automaton using
-     * a given set of minterms
-     * @param res The resulting mintermized automaton
-     * @param aut Automaton to be mintermized
-     * @param minterms Set of minterms for mintermization
-     */
-    void minterms_to_aut_afa(mata::IntermediateAut& res, const mata::IntermediateAut& aut,
-                             const std::unordered_set<BDD>& minterms);
-
     Mintermization() : bdd_mng(0), symbol_to_bddvar{}, trans_to_bddvar() {}
 }; // class Mintermization.
 
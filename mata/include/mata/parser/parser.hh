@@ -9,6 +9,7 @@
 #include <map>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "mata/utils/utils.hh"
@@ -48,17 +49,21 @@ struct ParsedSection {
 /** Parsed data */
 using Parsed = std::vector<ParsedSection>;
 
-/** Parses a string into an intermediary structure */
-Parsed parse_mf(const std::string& input, bool keepQuotes = false);
+/**
+ * Parses a string into an intermediary structure
+ *
+ * The string is tokenized in place by a @c Lexer, pass a whole file read into memory for the fastest parsing.
+ */
+Parsed parse_mf(std::string_view input, bool keepQuotes = false);
 
-/** Parses a stream into an intermediary structure */
+/** Parses a stream into an intermediary structure (reading the whole stream into memory first) */
 Parsed parse_mf(std::istream& input, bool keepQuotes = false);
 
 /** Parses one section from a stream into an intermediary structure */
 ParsedSection parse_mf_section(std::istream& input, bool keepQuotes = false);
 
 /** Parses one section from a string into an intermediary structure */
-ParsedSection parse_mf_section(const std::string& input, bool keepQuotes = false);
+ParsedSection parse_mf_section(std::string_view input, bool keepQuotes = false);
 
 /// registers dispatcher
 void init();
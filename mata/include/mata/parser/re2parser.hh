@@ -23,8 +23,23 @@ enum class Encoding {
  * Currently supported automata types are NFA and AFA.
  */
 namespace mata::parser {
+    /**
+     * Construction of the NFA from the parsed regex.
+     */
+    enum class RegexConstruction {
+        /// Through the program compiled by RE2, removing its nop and capture states.
+        Prog,
+        /// Glushkov (position) automaton built from the parsed regex: epsilon-free, one state per occurrence of
+        ///  a character in the regex and the initial state. Supports only the Latin1 encoding.
+        Glushkov,
+        /// Thompson automaton built from the parsed regex: epsilon transitions and the size linear in the size of the
+        ///  regex. Supports only the Latin1 encoding.
+        Thompson,
+    };
+
     void create_nfa(nfa::Nfa* nfa, const std::string &pattern, bool use_epsilon = false, mata::Symbol epsilon_value = 306,
-                    bool use_reduce = true, const Encoding encoding = Encoding::Latin1);
+                    bool use_reduce = true, const Encoding encoding = Encoding::Latin1,
+                    RegexConstruction construction = RegexConstruction::Prog);
 }
 
 #endif // MATA_RE2PARSER_HH
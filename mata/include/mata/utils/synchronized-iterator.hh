@@ -125,6 +125,7 @@ public:
             // If some positions has nowhere to go, then sync is not possible.
             if (this->positions[i] == this->ends[i]) { return false; }
 
+            bool first_position_advanced{ false };
             //  Advance position[i] and position[0] to the closest equal values.
             while (*this->positions[i] != *this->positions[0]) {
 
@@ -137,17 +138,14 @@ public:
                 // Advance position[0] to or beyond position[i].
                 while (*this->positions[i] > *this->positions[0]) {
                     ++this->positions[0];
+                    first_position_advanced = true;
                     if (this->positions[0] == this->ends[0]) { return false; }
                 }
-
-                // If position[0] changed, start from position 1 again.
-                // (note that
-                // i gets incremented at the end of the for-loop body,
-                // and that,
-                // since we are inside the for, there are at least two positions
-                // as the for starts with i=1.)
-                if (this->positions[0] > this->positions[1]) { i=0; }
             }
+
+            // If position[0] changed, positions 1 to i-1 are no longer synchronized with it, start from position 1
+            //  again (i gets incremented at the end of the for-loop body).
+            if (first_position_advanced && i > 1) { i = 0; }
         }
         this->synchronized_at_current_minimum = true;
         return true;
@@ -264,6 +262,11 @@ public:
     explicit SynchronizedExistentialIterator(const size_t size=0) : SynchronizedIterator<Iterator>(size) {
         this->currently_synchronized.reserve(size);
     }
+    // Positions may be raw pointers (e.g., into @c FrozenDelta), the iterator is still copied member-wise.
+    SynchronizedExistentialIterator(const SynchronizedExistentialIterator&) = default;
+    SynchronizedExistentialIterator(SynchronizedExistentialIterator&&) noexcept = default;
+    SynchronizedExistentialIterator& operator=(const SynchronizedExistentialIterator&) = default;
+    SynchronizedExistentialIterator& operator=(SynchronizedExistentialIterator&&) noexcept = default;
 
     void reset(const size_t size = 0) {
         SynchronizedIterator<Iterator>::reset(size);
@@ -0,0 +1,99 @@
+/* lexer.cc -- Tokenizer of the Mata Format (MF) over a buffer in memory.
+ */
+
+#include <stdexcept>
+
+#include "mata/parser/lexer.hh"
+
+using mata::parser::Lexer;
+using mata::parser::Token;
+
+std::string Token::to_string() const {
+    if (!escaped) { return std::string{ text }; }
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i{ 0 }; i < text.size(); ++i) {
+        if (text[i] == '\\' && i + 1 < text.size()) {
+            if (text[i + 1] != '"') { result += '\\'; }
+            result += text[++i];
+        } else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+void Lexer::tokenize_line(const std::string_view line, std::vector<Token>& tokens) {
+    const size_t size{ line.size() };
+    bool first{ true };
+    size_t i{ 0 };
+    while (i < size) {
+        const char ch{ line[i] };
+        if (is_char_class(ch, WHITESPACE)) {
+            ++i;
+            continue;
+        }
+        if ('#' == ch) { return; } // The rest of the line is a comment.
+
+        if ('"' == ch) {
+            size_t end{ i + 1 };
+            bool escaped{ false };
+            while (end < size && line[end] != '"') {
+                if (line[end] == '\\') {
+                    escaped = true;
+                    ++end;
+                }
+                ++end;
+            }
+            if (end >= size) {
+                throw std::runtime_error("missing ending quotes: " + std::string{ line.substr(i + 1) });
+            }
+            const std::string_view text{ line.substr(i + 1, end - i - 1) };
+            const size_t next{ end + 1 };
+            if (next < size && !is_char_class(line[next], WHITESPACE) && '#' != line[next] && ')' != line[next]) {
+                throw std::runtime_error("misplaced quotes: \"" + Token{ text, true, escaped }.to_string() + "_\"_" +
+                                         std::string{ line.substr(next) });
+            }
+            tokens.push_back({ text, true, escaped });
+            i = next;
+        } else if ('(' == ch || ')' == ch) {
+            tokens.push_back({ line.substr(i, 1) });
+            ++i;
+        } else {
+            size_t end{ i + 1 };
+            while (end < size && !is_char_class(line[end], TOKEN_END)) {
+                const char token_ch{ line[end] };
+                if ('"' == token_ch) {
+                    throw std::runtime_error("misplaced quotes: " + std::string{ line.substr(i, end - i) } + "_\"_" +
+                                             std::string{ line.substr(end + 1) });
+                } else if ('@' == token_ch || '%' == token_ch) {
+                    throw std::runtime_error("misplaced character \'" + std::string(1, token_ch) +
+                                             "\' in string \"" + std::string{ line.substr(i, end - i + 1) } +
+                                             std::string{ line.substr(end + 1) } + "\"");
+                }
+                ++end;
+            }
+            const std::string_view token{ line.substr(i, end - i) };
+            if (!first) {
+                if ('@' == token[0]) {
+                    throw std::runtime_error("invalid position of @TYPE: " + std::string{ line });
+                } else if ('%' == token[0]) {
+                    throw std::runtime_error("invalid position of %KEY: " + std::string{ line });
+                }
+            }
+
+            // Logical operators are tokens on their own, split them from the rest of the token.
+            size_t last_operator{ 0 };
+            for (size_t j{ 0 }; j < token.size(); ++j) {
+                if (is_char_class(token[j], LOGICAL_OPERATOR)) {
+                    if (j > last_operator) { tokens.push_back({ token.substr(last_operator, j - last_operator) }); }
+                    tokens.push_back({ token.substr(j, 1) });
+                    last_operator = j + 1;
+                }
+            }
+            if (last_operator < token.size()) { tokens.push_back({ token.substr(last_operator) }); }
+            i = end;
+        }
+        first = false;
+    }
+}
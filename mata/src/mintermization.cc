@@ -4,6 +4,9 @@
  * It transforms an automaton with a bitvector formula used a symbol to mintermized version of the automaton.
  */
 
+#include <algorithm>
+#include <cassert>
+
 #include "mata/parser/mintermization.hh"
 
 namespace {
@@ -56,6 +59,7 @@ void mata::Mintermization::trans_to_bdd_nfa(const IntermediateAut &aut)
         if (bdd.IsZero())
             continue;
         bdds.insert(bdd);
+        minterm_tree.add(bdd);
         trans_to_bddvar[&symbol_part] = bdd;
     }
 }
@@ -102,8 +106,79 @@ void mata::Mintermization::trans_to_bdd_afa(const IntermediateAut &aut)
                 continue;
             trans_to_bddvar[ds_pair.first] = bdd.val;
             bdds.insert(bdd.val);
+            minterm_tree.add(bdd.val);
+        }
+    }
+}
+
+mata::MintermTree::MintermTree(const Cudd& bdd_mng): bdd_mng{ bdd_mng } {
+    nodes_.push_back({ this->bdd_mng.bddOne() });
+    leaves_.push_back(0);
+    guards_of_.emplace_back();
+}
+
+mata::MintermTree::GuardId mata::MintermTree::add(const BDD& guard) {
+    const auto [it, inserted]{ guard_ids_.emplace(guard, guards_.size()) };
+    if (!inserted) { return it->second; }
+    const GuardId guard_id{ it->second };
+    guards_.push_back(guard);
+
+    std::vector<size_t> stack{ 0 };
+    while (!stack.empty()) {
+        const size_t node{ stack.back() };
+        stack.pop_back();
+        const BDD inside{ nodes_[node].region * guard };
+        if (inside.IsZero()) { continue; } // The whole subtree is outside the guard.
+
+        if (nodes_[node].region.Leq(guard)) { // The whole subtree is inside the guard.
+            std::vector<size_t> subtree{ node };
+            while (!subtree.empty()) {
+                const Node& current{ nodes_[subtree.back()] };
+                subtree.pop_back();
+                if (current.is_leaf()) {
+                    guards_of_[current.minterm].push_back(guard_id);
+                } else {
+                    subtree.push_back(current.inside);
+                    subtree.push_back(current.outside);
+                }
+            }
+        } else if (nodes_[node].is_leaf()) { // The guard partially overlaps the minterm: split it.
+            const Symbol minterm{ nodes_[node].minterm };
+            const Symbol new_minterm{ static_cast<Symbol>(leaves_.size()) };
+            const BDD outside{ nodes_[node].region * !guard };
+            nodes_[node].inside = nodes_.size();
+            nodes_[node].outside = nodes_.size() + 1;
+            nodes_.push_back({ inside, NO_CHILD, NO_CHILD, minterm });
+            nodes_.push_back({ outside, NO_CHILD, NO_CHILD, new_minterm });
+            leaves_[minterm] = nodes_[node].inside;
+            leaves_.push_back(nodes_[node].outside);
+            guards_of_.push_back(guards_of_[minterm]);
+            guards_of_[minterm].push_back(guard_id);
+            splits_.emplace_back(new_minterm, minterm);
+        } else {
+            stack.push_back(nodes_[node].inside);
+            stack.push_back(nodes_[node].outside);
+        }
+    }
+    return guard_id;
+}
+
+std::vector<mata::Symbol> mata::MintermTree::get_minterms_of(const BDD& guard) const {
+    std::vector<Symbol> minterms{};
+    std::vector<size_t> stack{ 0 };
+    while (!stack.empty()) {
+        const Node& node{ nodes_[stack.back()] };
+        stack.pop_back();
+        if (node.is_leaf()) {
+            assert(node.region.Leq(guard) || (node.region * guard).IsZero());
+            if (node.region.Leq(guard)) { minterms.push_back(node.minterm); }
+        } else if (!(node.region * guard).IsZero()) {
+            stack.push_back(node.inside);
+            stack.push_back(node.outside);
         }
     }
+    std::sort(minterms.begin(), minterms.end());
+    return minterms;
 }
 
 std::unordered_set<BDD> mata::Mintermization::compute_minterms(const std::unordered_set<BDD>& source_bdds)
@@ -170,7 +245,8 @@ mata::Mintermization::OptionalBdd mata::Mintermization::graph_to_bdd_afa(const F
     return {};
 }
 
-BDD mata::Mintermization::graph_to_bdd_nfa(const FormulaGraph &graph)
+BDD mata::formula_to_bdd(const FormulaGraph& graph, const Cudd& bdd_mng,
+                         std::unordered_map<std::string, BDD>& symbol_to_bddvar)
 {
     const FormulaNode& node = graph.node;
 
@@ -186,17 +262,17 @@ BDD mata::Mintermization::graph_to_bdd_nfa(const FormulaGraph &graph)
     } else if (node.is_operator()) {
         if (node.operator_type == FormulaNode::OperatorType::AND) {
             assert(graph.children.size() == 2);
-            const BDD op1 = graph_to_bdd_nfa(graph.children[0]);
-            const BDD op2 = graph_to_bdd_nfa(graph.children[1]);
+            const BDD op1 = formula_to_bdd(graph.children[0], bdd_mng, symbol_to_bddvar);
+            const BDD op2 = formula_to_bdd(graph.children[1], bdd_mng, symbol_to_bddvar);
             return op1 * op2;
         } else if (node.operator_type == FormulaNode::OperatorType::OR) {
             assert(graph.children.size() == 2);
-            const BDD op1 = graph_to_bdd_nfa(graph.children[0]);
-            const BDD op2 = graph_to_bdd_nfa(graph.children[1]);
+            const BDD op1 = formula_to_bdd(graph.children[0], bdd_mng, symbol_to_bddvar);
+            const BDD op2 = formula_to_bdd(graph.children[1], bdd_mng, symbol_to_bddvar);
             return op1 + op2;
         } else if (node.operator_type == FormulaNode::OperatorType::NEG) {
             assert(graph.children.size() == 1);
-            const BDD op1 = graph_to_bdd_nfa(graph.children[0]);
+            const BDD op1 = formula_to_bdd(graph.children[0], bdd_mng, symbol_to_bddvar);
             return !op1;
         } else
             assert(false);
@@ -206,58 +282,42 @@ BDD mata::Mintermization::graph_to_bdd_nfa(const FormulaGraph &graph)
     return {};
 }
 
-void mata::Mintermization::minterms_to_aut_nfa(mata::IntermediateAut& res, const mata::IntermediateAut& aut,
-                                               const std::unordered_set<BDD>& minterms)
+BDD mata::Mintermization::graph_to_bdd_nfa(const FormulaGraph &graph)
+{
+    return formula_to_bdd(graph, bdd_mng, symbol_to_bddvar);
+}
+
+void mata::Mintermization::minterm_tree_to_aut_nfa(mata::IntermediateAut& res, const mata::IntermediateAut& aut)
 {
     for (const auto& trans : aut.transitions) {
-            // for each t=(q1,s,q2)
         const auto &symbol_part = trans.second.children[0];
-
-        size_t symbol = 0;
-        if(trans_to_bddvar.count(&symbol_part) == 0)
+        if (trans_to_bddvar.count(&symbol_part) == 0)
             continue; // Transition had zero bdd so it was not added to map
-        const BDD &bdd = trans_to_bddvar[&symbol_part];
-
-        for (const auto &minterm: minterms) {
-            // for each minterm x:
-            if (!((bdd * minterm).IsZero())) {
-                // if for symbol s of t is BDD_s < x
-                // add q1,x,q2 to transitions
-                IntermediateAut::parse_transition(res, {trans.first.raw, std::to_string(symbol),
-                                                        trans.second.children[1].node.raw});
-            }
-            symbol++;
+
+        // for each minterm x of the bdd of t=(q1,s,q2), add q1,x,q2 to transitions
+        for (const Symbol minterm: minterm_tree.get_minterms_of(trans_to_bddvar[&symbol_part])) {
+            IntermediateAut::parse_transition(res, {trans.first.raw, std::to_string(minterm),
+                                                    trans.second.children[1].node.raw});
         }
     }
 }
 
-void mata::Mintermization::minterms_to_aut_afa(mata::IntermediateAut& res, const mata::IntermediateAut& aut,
-                                               const std::unordered_set<BDD>& minterms)
+void mata::Mintermization::minterm_tree_to_aut_afa(mata::IntermediateAut& res, const mata::IntermediateAut& aut)
 {
     for (const auto& trans : aut.transitions) {
         for (const auto& ds_pair : lhs_to_disjuncts_and_states[&trans.first]) {
-            // for each t=(q1,s,q2)
             const auto disjunct = ds_pair.first;
-
             if (!trans_to_bddvar.count(disjunct))
                 continue; // Transition had zero bdd so it was not added to map
-            const BDD &bdd = trans_to_bddvar[disjunct];
-
-            size_t symbol = 0;
-            for (const auto &minterm: minterms) {
-                // for each minterm x:
-                if (!((bdd * minterm).IsZero())) {
-                    // if for symbol s of t is BDD_s < x
-                    // add q1,x,q2 to transitions
-                    const auto str_symbol = std::to_string(symbol);
-                    FormulaNode node_symbol(FormulaNode::Type::OPERAND, str_symbol, str_symbol,
-                                            mata::FormulaNode::OperandType::SYMBOL);
-                    if (ds_pair.second != nullptr)
-                        res.add_transition(trans.first, node_symbol, *ds_pair.second);
-                    else // transition without state on the right handed side
-                        res.add_transition(trans.first, node_symbol);
-                }
-                ++symbol;
+
+            for (const Symbol minterm: minterm_tree.get_minterms_of(trans_to_bddvar[disjunct])) {
+                const auto str_symbol = std::to_string(minterm);
+                FormulaNode node_symbol(FormulaNode::Type::OPERAND, str_symbol, str_symbol,
+                                        mata::FormulaNode::OperandType::SYMBOL);
+                if (ds_pair.second != nullptr)
+                    res.add_transition(trans.first, node_symbol, *ds_pair.second);
+                else // transition without state on the right handed side
+                    res.add_transition(trans.first, node_symbol);
             }
         }
     }
@@ -277,9 +337,6 @@ std::vector<mata::IntermediateAut> mata::Mintermization::mintermize(const std::v
         aut->is_nfa() ? trans_to_bdd_nfa(*aut) : trans_to_bdd_afa(*aut);
     }
 
-    // Build minterm tree over BDDs
-    auto minterms = compute_minterms(bdds);
-
     std::vector<mata::IntermediateAut> res;
     for (const mata::IntermediateAut *aut : auts) {
         IntermediateAut mintermized_aut = *aut;
@@ -287,9 +344,9 @@ std::vector<mata::IntermediateAut> mata::Mintermization::mintermize(const std::v
         mintermized_aut.transitions.clear();
 
         if (aut->is_nfa())
-            minterms_to_aut_nfa(mintermized_aut, *aut, minterms);
+            minterm_tree_to_aut_nfa(mintermized_aut, *aut);
         else if (aut->is_afa())
-            minterms_to_aut_afa(mintermized_aut, *aut, minterms);
+            minterm_tree_to_aut_afa(mintermized_aut, *aut);
 
         res.push_back(mintermized_aut);
     }
@@ -0,0 +1,310 @@
+/* binary-format.cc -- Binary, memory-mappable format of automata.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mata/nfa/binary-format.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::nfa;
+using namespace mata::nfa::binary;
+using mata::Symbol;
+
+namespace {
+    constexpr char MAGIC[8]{ 'M', 'A', 'T', 'A', 'B', 'I', 'N', '\0' };
+    constexpr uint32_t BYTE_ORDER_MARK{ 0x01020304 };
+    constexpr size_t ALIGNMENT{ 8 };
+
+    size_t num_of_bitset_words(const size_t num_of_states) { return num_of_states / 64 + (num_of_states % 64 != 0); }
+
+    /**
+     * @brief Offsets of the sections of the file in bytes, in the order of the sections in the file.
+     *
+     * The offsets are computed from the header of an untrusted file, hence all arithmetic is checked for overflows.
+     */
+    struct Layout {
+        size_t initial{ 0 }, final{ 0 }, state_offsets{ 0 }, target_offsets{ 0 }, targets{ 0 }, levels{ 0 },
+               alphabet_symbols{ 0 }, alphabet_name_offsets{ 0 }, symbols{ 0 }, alphabet_names{ 0 }, end{ 0 };
+        /// Whether some offset does not fit into @\c size_t. The offsets are meaningless then.
+        bool overflows{ false };
+
+        explicit Layout(const Header& header) {
+            const size_t bitset_size{ multiply(num_of_bitset_words(header.num_of_states), sizeof(uint64_t)) };
+            initial = sizeof(Header);
+            final = add(initial, bitset_size);
+            state_offsets = add(final, bitset_size);
+            target_offsets = add(state_offsets, multiply(add(header.num_of_states, 1), sizeof(uint64_t)));
+            targets = add(target_offsets, multiply(add(header.num_of_symbol_posts, 1), sizeof(uint64_t)));
+            levels = add(targets, multiply(header.num_of_transitions, sizeof(State)));
+            alphabet_symbols = add(
+                levels, multiply(header.num_of_levels == 0 ? 0 : header.num_of_states, sizeof(uint64_t)));
+            alphabet_name_offsets = add(alphabet_symbols, multiply(header.num_of_alphabet_symbols, sizeof(uint64_t)));
+            symbols = add(alphabet_name_offsets,
+                          multiply(header.num_of_alphabet_symbols == 0 ? 0 : add(header.num_of_alphabet_symbols, 1),
+                                   sizeof(uint64_t)));
+            alphabet_names = add(symbols, aligned(multiply(header.num_of_symbol_posts, sizeof(Symbol))));
+            end = add(alphabet_names, aligned(header.alphabet_names_size));
+        }
+
+    private:
+        size_t add(const size_t lhs, const size_t rhs) {
+            overflows = overflows || lhs > std::numeric_limits<size_t>::max() - rhs;
+            return lhs + rhs;
+        }
+        size_t multiply(const size_t lhs, const size_t rhs) {
+            overflows = overflows || (rhs != 0 && lhs > std::numeric_limits<size_t>::max() / rhs);
+            return lhs * rhs;
+        }
+        size_t aligned(const size_t size) { return multiply(add(size, ALIGNMENT - 1) / ALIGNMENT, ALIGNMENT); }
+    };
+
+    /// Write the contents of @p values into @p output, padded to the alignment.
+    template<typename T>
+    void write_section(std::ofstream& output, const std::span<const T> values) {
+        const size_t size{ values.size() * sizeof(T) };
+        output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(size));
+        constexpr char padding[ALIGNMENT]{};
+        output.write(padding, static_cast<std::streamsize>((ALIGNMENT - size % ALIGNMENT) % ALIGNMENT));
+    }
+
+    std::vector<uint64_t> create_bitset(const mata::utils::SparseSet<State>& states, const size_t num_of_states) {
+        std::vector<uint64_t> bitset(num_of_bitset_words(num_of_states), 0);
+        for (const State state: states) { bitset[state / 64] |= uint64_t{ 1 } << (state % 64); }
+        return bitset;
+    }
+} // namespace.
+
+void mata::nfa::binary::save(const std::filesystem::path& path, const Nfa& aut, const AutomatonKind kind,
+                             const std::span<const uint64_t> levels, const size_t num_of_levels,
+                             const Alphabet* alphabet) {
+    const size_t num_of_states{ aut.num_of_states() };
+    if (kind == AutomatonKind::NFT && levels.size() != num_of_states) {
+        throw std::runtime_error("Levels of " + std::to_string(levels.size()) + " states given for a transducer with "
+                                 + std::to_string(num_of_states) + " states");
+    }
+
+    // Transitions in the CSR format.
+    std::vector<uint64_t> state_offsets{ 0 };
+    std::vector<Symbol> symbols{};
+    std::vector<uint64_t> target_offsets{ 0 };
+    std::vector<State> targets{};
+    state_offsets.reserve(num_of_states + 1);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        for (const SymbolPost& symbol_post: aut.delta[state]) {
+            symbols.push_back(symbol_post.symbol);
+            targets.insert(targets.end(), symbol_post.targets.begin(), symbol_post.targets.end());
+            target_offsets.push_back(targets.size());
+        }
+        state_offsets.push_back(symbols.size());
+    }
+
+    // Alphabet as a string table.
+    std::vector<uint64_t> alphabet_symbols{};
+    std::vector<uint64_t> alphabet_name_offsets{};
+    std::string alphabet_names{};
+    if (alphabet != nullptr) {
+        for (const Symbol symbol: alphabet->get_alphabet_symbols()) {
+            if (alphabet_name_offsets.empty()) { alphabet_name_offsets.push_back(0); }
+            alphabet_symbols.push_back(symbol);
+            alphabet_names += alphabet->reverse_translate_symbol(symbol);
+            alphabet_name_offsets.push_back(alphabet_names.size());
+        }
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byte_order = BYTE_ORDER_MARK;
+    header.version = FORMAT_VERSION;
+    header.kind = static_cast<uint32_t>(kind);
+    header.state_size = sizeof(State);
+    header.symbol_size = sizeof(Symbol);
+    header.num_of_states = num_of_states;
+    header.num_of_symbol_posts = symbols.size();
+    header.num_of_transitions = targets.size();
+    header.num_of_levels = kind == AutomatonKind::NFT ? num_of_levels : 0;
+    header.num_of_alphabet_symbols = alphabet_symbols.size();
+    header.alphabet_names_size = alphabet_names.size();
+
+    std::ofstream output{ path, std::ios::binary | std::ios::trunc };
+    if (!output) { throw std::runtime_error("Could not open file '" + path.string() + "' for writing"); }
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    write_section<uint64_t>(output, create_bitset(aut.initial, num_of_states));
+    write_section<uint64_t>(output, create_bitset(aut.final, num_of_states));
+    write_section<uint64_t>(output, state_offsets);
+    write_section<uint64_t>(output, target_offsets);
+    write_section<State>(output, targets);
+    if (kind == AutomatonKind::NFT) { write_section<uint64_t>(output, levels); }
+    write_section<uint64_t>(output, alphabet_symbols);
+    write_section<uint64_t>(output, alphabet_name_offsets);
+    write_section<Symbol>(output, symbols);
+    write_section<char>(output, alphabet_names);
+    if (!output) { throw std::runtime_error("Could not write file '" + path.string() + "'"); }
+}
+
+MappedAutomaton::MappedAutomaton(const std::filesystem::path& path) {
+    const int file_descriptor{ ::open(path.c_str(), O_RDONLY) };
+    if (file_descriptor < 0) { throw std::runtime_error("Could not open file '" + path.string() + "'"); }
+    struct stat file_status{};
+    if (::fstat(file_descriptor, &file_status) != 0 || static_cast<size_t>(file_status.st_size) < sizeof(Header)) {
+        ::close(file_descriptor);
+        throw std::runtime_error("File '" + path.string() + "' is not an automaton in the binary format");
+    }
+    size_ = static_cast<size_t>(file_status.st_size);
+    data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    ::close(file_descriptor);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Could not map file '" + path.string() + "' into memory");
+    }
+
+    const auto* const bytes{ static_cast<const char*>(data_) };
+    header_ = reinterpret_cast<const Header*>(bytes);
+    auto fail = [&](const std::string& reason) {
+        unmap();
+        throw std::runtime_error("File '" + path.string() + "' is not an automaton in the binary format: " + reason);
+    };
+    if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0) { fail("wrong magic number"); }
+    if (header_->byte_order != BYTE_ORDER_MARK) { fail("different byte order"); }
+    if (header_->version != FORMAT_VERSION) {
+        fail("unsupported version " + std::to_string(header_->version) + ", supported is "
+             + std::to_string(FORMAT_VERSION));
+    }
+    if (header_->kind > static_cast<uint32_t>(AutomatonKind::NFT)) { fail("unknown kind of automaton"); }
+    if (header_->state_size != sizeof(State) || header_->symbol_size != sizeof(Symbol)) {
+        fail("different sizes of states or symbols");
+    }
+    const Layout layout{ *header_ };
+    if (layout.overflows || layout.end != size_) { fail("wrong size of the file"); }
+
+    auto section = [&]<typename T>(const size_t offset, const size_t size) {
+        if (offset > size_ || size > (size_ - offset) / sizeof(T)) { fail("section out of the file"); }
+        return std::span<const T>{ reinterpret_cast<const T*>(bytes + offset), size };
+    };
+    const size_t num_of_states{ header_->num_of_states };
+    const size_t num_of_alphabet_symbols{ header_->num_of_alphabet_symbols };
+    initial_ = section.operator()<uint64_t>(layout.initial, num_of_bitset_words(num_of_states));
+    final_ = section.operator()<uint64_t>(layout.final, num_of_bitset_words(num_of_states));
+    state_offsets_ = section.operator()<uint64_t>(layout.state_offsets, num_of_states + 1);
+    target_offsets_ = section.operator()<uint64_t>(layout.target_offsets, header_->num_of_symbol_posts + 1);
+    targets_ = section.operator()<State>(layout.targets, header_->num_of_transitions);
+    levels_ = section.operator()<uint64_t>(layout.levels, header_->num_of_levels == 0 ? 0 : num_of_states);
+    alphabet_symbols_ = section.operator()<uint64_t>(layout.alphabet_symbols, num_of_alphabet_symbols);
+    alphabet_name_offsets_ = section.operator()<uint64_t>(
+        layout.alphabet_name_offsets, num_of_alphabet_symbols == 0 ? 0 : num_of_alphabet_symbols + 1);
+    symbols_ = section.operator()<Symbol>(layout.symbols, header_->num_of_symbol_posts);
+    alphabet_names_ = section.operator()<char>(layout.alphabet_names, header_->alphabet_names_size);
+
+    if (state_offsets_.back() != symbols_.size() || target_offsets_.back() != targets_.size()
+        || (!alphabet_name_offsets_.empty() && alphabet_name_offsets_.back() != alphabet_names_.size())) {
+        fail("inconsistent offsets");
+    }
+    // Bits of the initial and final states beyond the number of states in the last words of the bitsets.
+    if (num_of_states % 64 != 0 && !initial_.empty()
+        && ((initial_.back() | final_.back()) >> (num_of_states % 64)) != 0) {
+        fail("initial or final states out of range");
+    }
+    if (std::any_of(levels_.begin(), levels_.end(), [&](const uint64_t level) {
+            return level >= header_->num_of_levels; })) {
+        fail("levels out of range");
+    }
+}
+
+MappedAutomaton::MappedAutomaton(MappedAutomaton&& other) noexcept { *this = std::move(other); }
+
+MappedAutomaton& MappedAutomaton::operator=(MappedAutomaton&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        header_ = other.header_;
+        initial_ = other.initial_;
+        final_ = other.final_;
+        state_offsets_ = other.state_offsets_;
+        target_offsets_ = other.target_offsets_;
+        targets_ = other.targets_;
+        levels_ = other.levels_;
+        alphabet_symbols_ = other.alphabet_symbols_;
+        alphabet_name_offsets_ = other.alphabet_name_offsets_;
+        symbols_ = other.symbols_;
+        alphabet_names_ = other.alphabet_names_;
+    }
+    return *this;
+}
+
+MappedAutomaton::~MappedAutomaton() { unmap(); }
+
+void MappedAutomaton::unmap() {
+    if (data_ != nullptr) { ::munmap(data_, size_); }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void MappedAutomaton::fill_alphabet(OnTheFlyAlphabet& alphabet) const {
+    for (size_t i{ 0 }, num_of_symbols{ alphabet_symbols_.size() }; i < num_of_symbols; ++i) {
+        const std::string name{ alphabet_names_.data() + alphabet_name_offsets_[i],
+                                alphabet_names_.data() + alphabet_name_offsets_[i + 1] };
+        const auto symbol{ static_cast<Symbol>(alphabet_symbols_[i]) };
+        const OnTheFlyAlphabet::StringToSymbolMap& symbol_map{ alphabet.get_symbol_map() };
+        if (const auto it{ symbol_map.find(name) }; it != symbol_map.end()) {
+            if (it->second != symbol) {
+                throw std::runtime_error("Symbol '" + name + "' is already in the alphabet with a different value");
+            }
+            continue;
+        }
+        alphabet.add_new_symbol(name, symbol);
+    }
+}
+
+Delta MappedAutomaton::get_delta() const {
+    const size_t num_of_states{ this->num_of_states() };
+    Delta delta(num_of_states);
+    auto fail = [](const std::string& reason) {
+        throw std::runtime_error("Invalid transitions in the binary format: " + reason);
+    };
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        const size_t symbol_posts_begin{ state_offsets_[state] };
+        const size_t symbol_posts_end{ state_offsets_[state + 1] };
+        if (symbol_posts_begin == symbol_posts_end) { continue; }
+        if (symbol_posts_begin > symbol_posts_end || symbol_posts_end > symbols_.size()) { fail("wrong offsets"); }
+        StatePost& state_post{ delta.mutable_state_post(state) };
+        state_post.reserve(symbol_posts_end - symbol_posts_begin);
+        for (size_t symbol_post{ symbol_posts_begin }; symbol_post < symbol_posts_end; ++symbol_post) {
+            const size_t targets_begin{ target_offsets_[symbol_post] };
+            const size_t targets_end{ target_offsets_[symbol_post + 1] };
+            if (targets_begin >= targets_end || targets_end > targets_.size()) { fail("wrong offsets"); }
+            if (!state_post.empty() && state_post.back().symbol >= symbols_[symbol_post]) {
+                fail("symbols are not sorted");
+            }
+            StateSet targets{ StateSet::with_reserved(targets_end - targets_begin) };
+            for (size_t target{ targets_begin }; target < targets_end; ++target) {
+                if (targets_[target] >= num_of_states || (!targets.empty() && targets.back() >= targets_[target])) {
+                    fail("targets are not sorted or out of range");
+                }
+                targets.push_back(targets_[target]);
+            }
+            state_post.push_back(SymbolPost{ symbols_[symbol_post], std::move(targets) });
+        }
+    }
+    return delta;
+}
+
+mata::utils::SparseSet<State> MappedAutomaton::get_states(const std::span<const uint64_t> bitset) const {
+    mata::utils::SparseSet<State> states{};
+    for (size_t word{ 0 }, num_of_words{ bitset.size() }; word < num_of_words; ++word) {
+        for (uint64_t bits{ bitset[word] }; bits != 0; bits &= bits - 1) {
+            states.insert(word * 64 + static_cast<size_t>(std::countr_zero(bits)));
+        }
+    }
+    return states;
+}
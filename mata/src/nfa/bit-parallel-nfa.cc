@@ -0,0 +1,171 @@
+/* bit-parallel-nfa.cc -- Bit-parallel simulation of small NFAs.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "mata/nfa/bit-parallel-nfa.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::nfa;
+using mata::Symbol;
+
+template<size_t Width>
+BitParallelNfa<Width>::BitParallelNfa(const Nfa& aut, const Symbol epsilon) {
+    Nfa nfa{ remove_epsilon(aut, epsilon) };
+    nfa.trim();
+    const size_t num_of_states{ nfa.num_of_states() };
+
+    // Edges entering each state as pairs of a symbol and a source.
+    std::vector<std::vector<std::pair<Symbol, State>>> incoming_edges(num_of_states);
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const SymbolPost& symbol_post: nfa.delta[source]) {
+            for (const State target: symbol_post.targets) { incoming_edges[target].emplace_back(symbol_post.symbol, source); }
+        }
+    }
+
+    // Positions of initial states (not entered over any symbol) come first. Then, each state has a position for each
+    //  group of symbols over which it is entered from the same set of sources, such as a character class. All edges
+    //  entering a position from a source are then over all symbols of the group, hence they can be merged. The masks
+    //  are set only after the positions are counted and checked to fit into Width bits.
+    std::vector<size_t> final_positions{};
+    for (const State state: nfa.initial) {
+        if (nfa.final.contains(state)) { final_positions.push_back(num_of_positions_); }
+        ++num_of_positions_;
+    }
+    const size_t num_of_initial_positions{ num_of_positions_ };
+    // Position of each state entered over each symbol, sorted by the symbols.
+    std::vector<std::vector<std::pair<Symbol, size_t>>> positions_of_state(num_of_states);
+    std::map<std::vector<State>, size_t> position_of_sources{};
+    std::vector<State> sources{};
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        std::vector<std::pair<Symbol, State>>& edges{ incoming_edges[state] };
+        std::sort(edges.begin(), edges.end());
+        position_of_sources.clear();
+        for (auto edge_it{ edges.begin() }; edge_it != edges.end();) {
+            const Symbol symbol{ edge_it->first };
+            sources.clear();
+            for (; edge_it != edges.end() && edge_it->first == symbol; ++edge_it) { sources.push_back(edge_it->second); }
+            const auto [position_it, inserted]{ position_of_sources.emplace(sources, num_of_positions_) };
+            if (inserted) {
+                if (nfa.final.contains(state)) { final_positions.push_back(num_of_positions_); }
+                ++num_of_positions_;
+            }
+            positions_of_state[state].emplace_back(symbol, position_it->second);
+        }
+    }
+    if (num_of_positions_ > Width) {
+        throw std::runtime_error("BitParallelNfa of width " + std::to_string(Width) + " cannot represent "
+                                 + std::to_string(num_of_positions_) + " positions of the automaton");
+    }
+    for (size_t position{ 0 }; position < num_of_initial_positions; ++position) { initial_.set(position); }
+    for (const size_t position: final_positions) { final_.set(position); }
+
+    // Successors of each position over any symbol, and positions entered over each symbol.
+    std::vector<Mask> follow(num_of_positions_);
+    auto set_successors = [&](const size_t position, const State state) {
+        for (const SymbolPost& symbol_post: nfa.delta[state]) {
+            for (const State target: symbol_post.targets) {
+                const std::vector<std::pair<Symbol, size_t>>& positions{ positions_of_state[target] };
+                const auto position_it{ std::lower_bound(positions.begin(), positions.end(),
+                                                         std::pair<Symbol, size_t>{ symbol_post.symbol, 0 }) };
+                follow[position].set(position_it->second);
+            }
+        }
+    };
+    size_t initial_position{ 0 };
+    for (const State state: nfa.initial) { set_successors(initial_position++, state); }
+    // Each position is visited for each of its symbols, but its successors are set only once.
+    std::vector<bool> has_successors(num_of_positions_, false);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        for (const auto& [symbol, position]: positions_of_state[state]) {
+            if (!has_successors[position]) {
+                set_successors(position, state);
+                has_successors[position] = true;
+            }
+            (symbol < NUM_OF_BYTES ? byte_masks_[symbol] : symbol_masks_[symbol]).set(position);
+        }
+    }
+
+    // Successors of all subsets of each byte of positions, each subset extending a smaller one by its lowest position.
+    num_of_used_bytes_ = (num_of_positions_ + 7) / 8;
+    byte_follow_.resize(num_of_used_bytes_ * NUM_OF_BYTES);
+    for (size_t byte_index{ 0 }; byte_index < num_of_used_bytes_; ++byte_index) {
+        Mask* const byte_follow{ byte_follow_.data() + byte_index * NUM_OF_BYTES };
+        for (size_t byte{ 1 }; byte < NUM_OF_BYTES; ++byte) {
+            const size_t position{ byte_index * 8 + static_cast<size_t>(std::countr_zero(byte)) };
+            byte_follow[byte] = byte_follow[byte & (byte - 1)];
+            if (position < num_of_positions_) { byte_follow[byte] |= follow[position]; }
+        }
+    }
+}
+
+template<size_t Width>
+template<typename Symbols>
+bool BitParallelNfa<Width>::is_in_lang_impl(const Symbols& word) const {
+    Mask current{ initial_ };
+    for (const auto symbol: word) {
+        current = step(current, to_symbol(symbol));
+        if (!current.any()) { return false; }
+    }
+    return current.intersects_with(final_);
+}
+
+template<size_t Width>
+template<typename Symbols>
+bool BitParallelNfa<Width>::is_prfx_in_lang_impl(const Symbols& word) const {
+    Mask current{ initial_ };
+    for (const auto symbol: word) {
+        if (current.intersects_with(final_)) { return true; }
+        current = step(current, to_symbol(symbol));
+        if (!current.any()) { return false; }
+    }
+    return current.intersects_with(final_);
+}
+
+template<size_t Width>
+template<typename Symbols>
+std::optional<size_t> BitParallelNfa<Width>::find_first_match_impl(const Symbols& word) const {
+    if (initial_.intersects_with(final_)) { return 0; }
+    // A match may begin at each position of the word, hence the initial positions are added before each step.
+    Mask current{};
+    size_t end{ 0 };
+    for (const auto symbol: word) {
+        current |= initial_;
+        current = step(current, to_symbol(symbol));
+        ++end;
+        if (current.intersects_with(final_)) { return end; }
+    }
+    return std::nullopt;
+}
+
+template<size_t Width>
+bool BitParallelNfa<Width>::is_in_lang(const std::span<const Symbol> word) const { return is_in_lang_impl(word); }
+
+template<size_t Width>
+bool BitParallelNfa<Width>::is_in_lang(const std::string_view bytes) const { return is_in_lang_impl(bytes); }
+
+template<size_t Width>
+bool BitParallelNfa<Width>::is_prfx_in_lang(const std::span<const Symbol> word) const {
+    return is_prfx_in_lang_impl(word);
+}
+
+template<size_t Width>
+bool BitParallelNfa<Width>::is_prfx_in_lang(const std::string_view bytes) const { return is_prfx_in_lang_impl(bytes); }
+
+template<size_t Width>
+std::optional<size_t> BitParallelNfa<Width>::find_first_match(const std::span<const Symbol> word) const {
+    return find_first_match_impl(word);
+}
+
+template<size_t Width>
+std::optional<size_t> BitParallelNfa<Width>::find_first_match(const std::string_view bytes) const {
+    return find_first_match_impl(bytes);
+}
+
+template class mata::nfa::BitParallelNfa<64>;
+template class mata::nfa::BitParallelNfa<128>;
+template class mata::nfa::BitParallelNfa<256>;
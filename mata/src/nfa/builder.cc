@@ -1,9 +1,14 @@
 // TODO: Insert header file.
 
 #include "mata/nfa/builder.hh"
+#include "mata/nfa/binary-format.hh"
 #include "mata/parser/mintermization.hh"
+#include "mata/parser/lexer.hh"
 
 #include <fstream>
+#include <optional>
+#include <tuple>
+#include <sstream>
 #include <random>
 #include <cmath>
 
@@ -96,16 +101,23 @@ Nfa builder::construct(const mata::parser::ParsedSection& parsec, mata::Alphabet
     return aut;
 } // construct().
 
-Nfa builder::construct(const mata::IntermediateAut& inter_aut, mata::Alphabet* alphabet, NameStateMap* state_map) {
-    Nfa aut;
-    assert(nullptr != alphabet);
-
+namespace {
+/**
+ * Construct the states, initial and final states, and transitions of @p aut from @p inter_aut.
+ *
+ * @param add_transition Callback adding a transition from a source state over a symbol part (a formula graph) of
+ *  a transition to a target state.
+ */
+template<class Aut, class AddTransition>
+void construct_from_intermediate(
+    Aut& aut, const mata::IntermediateAut& inter_aut, builder::NameStateMap* state_map,
+    const std::string& function_name, AddTransition add_transition
+) {
     if (!inter_aut.is_nfa()) {
-        throw std::runtime_error(std::string(__FUNCTION__) + ": expecting type \"" +
-                                 TYPE_NFA + "\"");
+        throw std::runtime_error(function_name + ": expecting type \"" + TYPE_NFA + "\"");
     }
 
-    NameStateMap tmp_state_map;
+    builder::NameStateMap tmp_state_map;
     if (nullptr == state_map) {
         state_map = &tmp_state_map;
     }
@@ -142,10 +154,9 @@ Nfa builder::construct(const mata::IntermediateAut& inter_aut, mata::Alphabet* a
         }
 
         State src_state = get_state_name(trans.first.name);
-        Symbol symbol = alphabet->translate_symb(trans.second.children[0].node.name);
         State tgt_state = get_state_name(trans.second.children[1].node.name);
 
-        aut.delta.add(src_state, symbol, tgt_state);
+        add_transition(src_state, trans.second.children[0], tgt_state);
     }
 
     std::unordered_set<std::string> final_formula_nodes;
@@ -171,10 +182,43 @@ Nfa builder::construct(const mata::IntermediateAut& inter_aut, mata::Alphabet* a
             aut.final.insert(state);
         }
     }
+}
+} // namespace.
+
+Nfa builder::construct(const mata::IntermediateAut& inter_aut, mata::Alphabet* alphabet, NameStateMap* state_map) {
+    Nfa aut;
+    assert(nullptr != alphabet);
+
+    construct_from_intermediate(aut, inter_aut, state_map, __FUNCTION__,
+        [&](const State src_state, const mata::FormulaGraph& symbol_part, const State tgt_state) {
+            Symbol symbol = alphabet->translate_symb(symbol_part.node.name);
+            aut.delta.add(src_state, symbol, tgt_state);
+        });
 
     return aut;
 } // construct().
 
+SymbolicNfa builder::construct_symbolic(
+    const mata::IntermediateAut& inter_aut, const Cudd& manager,
+    std::unordered_map<std::string, BDD>* symbol_to_bddvar, NameStateMap* state_map
+) {
+    if (!inter_aut.is_bitvector()) {
+        throw std::runtime_error(std::string(__FUNCTION__) + ": expecting a bitvector alphabet");
+    }
+    std::unordered_map<std::string, BDD> tmp_symbol_to_bddvar;
+    if (nullptr == symbol_to_bddvar) {
+        symbol_to_bddvar = &tmp_symbol_to_bddvar;
+    }
+
+    SymbolicNfa aut{ manager };
+    construct_from_intermediate(aut, inter_aut, state_map, __FUNCTION__,
+        [&](const State src_state, const mata::FormulaGraph& symbol_part, const State tgt_state) {
+            aut.add_transition(src_state, mata::formula_to_bdd(symbol_part, manager, *symbol_to_bddvar), tgt_state);
+        });
+
+    return aut;
+} // construct_symbolic().
+
 void builder::construct(
         mata::nfa::Nfa *result,
         const mata::IntermediateAut &inter_aut,
@@ -220,6 +264,13 @@ Nfa builder::create_sigma_star_nfa(mata::Alphabet* alphabet) {
 }
 
 Nfa builder::create_random_nfa_tabakov_vardi(const size_t num_of_states, const size_t alphabet_size, const double states_trans_ratio_per_symbol, const double final_state_density) {
+    // Initialize the random number generator
+    std::random_device rd;  // Seed for the random number engine
+    std::mt19937 gen(rd()); // Mersenne Twister engine
+    return create_random_nfa_tabakov_vardi(num_of_states, alphabet_size, states_trans_ratio_per_symbol, final_state_density, gen);
+}
+
+Nfa builder::create_random_nfa_tabakov_vardi(const size_t num_of_states, const size_t alphabet_size, const double states_trans_ratio_per_symbol, const double final_state_density, std::mt19937& gen) {
     if (num_of_states == 0) {
         return Nfa();
     }
@@ -234,10 +285,6 @@ Nfa builder::create_random_nfa_tabakov_vardi(const size_t num_of_states, const s
 
     Nfa nfa{ num_of_states, { 0 }, { 0 }, new OnTheFlyAlphabet{} };
 
-    // Initialize the random number generator
-    std::random_device rd;  // Seed for the random number engine
-    std::mt19937 gen(rd()); // Mersenne Twister engine
-
     // Unique final state generator
     std::vector<State> states(num_of_states);
     std::iota(states.begin(), states.end(), 0);
@@ -268,9 +315,104 @@ Nfa builder::create_random_nfa_tabakov_vardi(const size_t num_of_states, const s
     return nfa;
 }
 
-Nfa builder::parse_from_mata(std::istream& nfa_stream) {
+namespace {
+/**
+ * Build an automaton of type @c NFA-explicit directly from the tokens of @p input, without @c IntermediateAut.
+ *
+ * States are numbered as by @c construct(): initial states first, then the states of the transitions in the order of
+ *  the transitions, and the remaining final states last. Only multiple initial states are numbered in the order of the
+ *  input, whereas @c construct() numbers them in an unspecified order.
+ * @return The automaton, or nothing when @p input uses a feature handled only by @c IntermediateAut (other types,
+ *  other naming of states, formulae for initial or final states, multiple sections, etc.).
+ */
+std::optional<Nfa> parse_explicit_nfa(const std::string_view input, mata::Alphabet& alphabet) {
+    constexpr std::string_view TYPE_LINE{ "@NFA-explicit" };
+    mata::parser::Lexer lexer{ input };
+    std::string_view line{};
+    do {
+        if (lexer.peek_line() == '\0') { return std::nullopt; }
+        line = lexer.next_line();
+    } while (line[0] == '#');
+    if (!line.starts_with(TYPE_LINE) || line.back() == '\\') { return std::nullopt; }
+    for (const char ch: line.substr(TYPE_LINE.size())) {
+        if (ch == '#') { break; }
+        if (!mata::parser::is_char_class(ch, mata::parser::WHITESPACE)) { return std::nullopt; }
+    }
+
+    Nfa aut{};
+    // States are named by the marker 'q', the name of a state is the rest of the token.
+    std::unordered_map<std::string_view, State> states{};
+    std::unordered_map<std::string_view, Symbol> symbols{};
+    auto is_state = [](const mata::parser::Token& token) { return !token.quoted && token.text[0] == 'q'; };
+    auto get_state = [&](const mata::parser::Token& token) {
+        const auto [it, inserted]{ states.try_emplace(token.text.substr(1), 0) };
+        if (inserted) { it->second = aut.add_state(); }
+        return it->second;
+    };
+
+    // Initial and final states are numbered after the whole input is read.
+    std::vector<mata::parser::Token> initial_states{};
+    std::vector<mata::parser::Token> final_states{};
+    std::vector<std::tuple<mata::parser::Token, Symbol, mata::parser::Token>> transitions{};
+    std::vector<mata::parser::Token> tokens{};
+    while (lexer.peek_line() != '\0') {
+        line = lexer.next_line();
+        if (line.back() == '\\') { return std::nullopt; }
+        tokens.clear();
+        mata::parser::Lexer::tokenize_line(line, tokens);
+        if (tokens.empty()) { continue; }
+
+        const std::string_view first{ tokens[0].text };
+        if (tokens[0].quoted) { return std::nullopt; }
+        if (first[0] == '@') { return std::nullopt; } // Another section.
+        if (first[0] == '%') {
+            const std::string_view key{ first.substr(1) };
+            const bool is_initial{ key.starts_with("Initial") };
+            if (is_initial || key.starts_with("Final")) {
+                if (tokens.size() == 1) { return std::nullopt; }
+                for (size_t i{ 1 }; i < tokens.size(); ++i) {
+                    if (!is_state(tokens[i])) { return std::nullopt; }
+                    (is_initial ? initial_states : final_states).push_back(tokens[i]);
+                }
+            } else if (key.empty() || key.find("States") != std::string_view::npos
+                       || key.find("Nodes") != std::string_view::npos) {
+                return std::nullopt;
+            }
+            continue;
+        }
+
+        if (tokens.size() != 3 || !is_state(tokens[0]) || !is_state(tokens[2]) || tokens[1].quoted) {
+            return std::nullopt;
+        }
+        const std::string_view symbol_name{ tokens[1].text };
+        if (symbol_name.size() == 1
+            && (mata::parser::is_char_class(symbol_name[0], mata::parser::LOGICAL_OPERATOR)
+                || symbol_name[0] == '(' || symbol_name[0] == ')')) {
+            return std::nullopt;
+        }
+        auto symbol_it{ symbols.find(symbol_name) };
+        if (symbol_it == symbols.end()) {
+            symbol_it = symbols.emplace(symbol_name, alphabet.translate_symb(std::string{ symbol_name })).first;
+        }
+        transitions.emplace_back(tokens[0], symbol_it->second, tokens[2]);
+    }
+
+    for (const mata::parser::Token& state: initial_states) { aut.initial.insert(get_state(state)); }
+    for (const auto& [source_token, symbol, target_token]: transitions) {
+        const State source{ get_state(source_token) };
+        aut.delta.add(source, symbol, get_state(target_token));
+    }
+    for (const mata::parser::Token& state: final_states) { aut.final.insert(get_state(state)); }
+    return aut;
+}
+} // namespace.
+
+Nfa builder::parse_from_mata(const std::string_view nfa_in_mata) {
+    IntAlphabet alphabet;
+    if (std::optional<Nfa> nfa{ parse_explicit_nfa(nfa_in_mata, alphabet) }) { return std::move(*nfa); }
+
     const std::string nfa_str = "NFA";
-    parser::Parsed parsed{ parser::parse_mf(nfa_stream) };
+    mata::parser::Parsed parsed{ mata::parser::parse_mf(nfa_in_mata) };
     if (parsed.size() != 1) {
         throw std::runtime_error("The number of sections in the input file is '" + std::to_string(parsed.size())
             + "'. Required is '1'.\n");
@@ -279,27 +421,41 @@ Nfa builder::parse_from_mata(std::istream& nfa_stream) {
     if (automaton_type.compare(0, nfa_str.length(), nfa_str) != 0) {
         throw std::runtime_error("The type of input automaton is '" + automaton_type + "'. Required is 'NFA'\n");
     }
-    IntAlphabet alphabet;
     return construct(IntermediateAut::parse_from_mf(parsed)[0], &alphabet);
 }
 
+Nfa builder::parse_from_mata(std::istream& nfa_stream) {
+    std::stringstream buffer;
+    buffer << nfa_stream.rdbuf();
+    return parse_from_mata(std::string_view{ buffer.view() });
+}
+
 Nfa builder::parse_from_mata(const std::filesystem::path& nfa_file) {
-    std::ifstream file_stream{ nfa_file };
+    std::ifstream file_stream{ nfa_file, std::ios::binary };
     if (!file_stream) {
         throw std::runtime_error("Could not open file \'" + nfa_file.string() + "'\n");
     }
 
-    Nfa nfa;
-    try {
-        nfa = parse_from_mata(file_stream);
-    } catch (const std::exception& ex) {
-        file_stream.close();
-        throw;
-    }
-    return nfa;
+    // The whole file is read at once and tokenized in place.
+    std::string buffer(std::filesystem::file_size(nfa_file), '\0');
+    file_stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.resize(static_cast<size_t>(file_stream.gcount()));
+    return parse_from_mata(std::string_view{ buffer });
 }
 
 Nfa builder::parse_from_mata(const std::string& nfa_in_mata) {
-    std::istringstream nfa_stream(nfa_in_mata);
-    return parse_from_mata(nfa_stream);
+    return parse_from_mata(std::string_view{ nfa_in_mata });
+}
+
+Nfa builder::mmap_binary(const std::filesystem::path& path, OnTheFlyAlphabet* alphabet) {
+    const binary::MappedAutomaton mapped{ path };
+    if (mapped.kind() != binary::AutomatonKind::NFA) {
+        throw std::runtime_error("The type of automaton in file '" + path.string() + "' is not 'NFA'");
+    }
+    Nfa nfa{ mapped.get_delta(), mapped.get_initial(), mapped.get_final() };
+    if (alphabet != nullptr && mapped.has_alphabet()) {
+        mapped.fill_alphabet(*alphabet);
+        nfa.alphabet = alphabet;
+    }
+    return nfa;
 }
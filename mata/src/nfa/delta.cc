@@ -76,6 +76,7 @@ std::vector<Transition> Delta::get_transitions_to(const State state_to) const {
 }
 
 void Delta::add(const State source, Symbol symbol, const State target) {
+    reverse_delta_cache_.invalidate();
     if (const State max_state{ std::max(source, target) }; max_state >= state_posts_.size()) {
         reserve_on_insert(state_posts_, max_state);
         state_posts_.resize(max_state + 1);
@@ -100,6 +101,7 @@ void Delta::add(const State source, Symbol symbol, const State target) {
 
 void Delta::add(const State source, const Symbol symbol, const StateSet& targets) {
     if(targets.empty()) { return; }
+    reverse_delta_cache_.invalidate();
 
     if (const State max_state{ std::max(source, targets.back()) }; max_state >= state_posts_.size()) {
         reserve_on_insert(state_posts_, max_state + 1);
@@ -126,6 +128,7 @@ void Delta::add(const State source, const Symbol symbol, const StateSet& targets
 
 void Delta::remove(const State source, const Symbol symbol, const State target) {
     if (source >= state_posts_.size()) { return; }
+    reverse_delta_cache_.invalidate();
 
     if (StatePost& state_transitions{ state_posts_[source] }; state_transitions.empty()) {
         throw std::invalid_argument(
@@ -295,6 +298,7 @@ std::vector<StatePost> Delta::renumber_targets(const std::function<State(State)>
 }
 
 StatePost& Delta::mutable_state_post(State q) {
+    reverse_delta_cache_.invalidate();
     if (q >= state_posts_.size()) {
         utils::reserve_on_insert(state_posts_, q);
         const size_t new_size{ q + 1 };
@@ -305,6 +309,7 @@ StatePost& Delta::mutable_state_post(State q) {
 }
 
 void Delta::defragment(const BoolVector& is_staying, const std::vector<State>& renaming) {
+    reverse_delta_cache_.invalidate();
     //TODO: this function seems to be unreadable, should be refactored, maybe into several functions with a clear functionality?
 
     //first, indexes of post are filtered (places of to be removed states are taken by states on their right)
@@ -356,6 +361,16 @@ bool Delta::operator==(const Delta& other) const {
     return other_transitions_it == other_transitions_end;
 }
 
+void StatePost::append_moves(std::vector<std::pair<Symbol, State>>& moves) {
+    std::sort(moves.begin(), moves.end());
+    moves.erase(std::unique(moves.begin(), moves.end()), moves.end());
+    assert(empty() || moves.empty() || back().symbol < moves.front().first);
+    for (const auto& [symbol, target]: moves) {
+        if (empty() || back().symbol != symbol) { emplace_back(symbol); }
+        back().targets.push_back(target);
+    }
+}
+
 ///Returns an iterator to the smallest epsilon, or end() if there is no epsilon
 ///Searches from the end of the vector of SymbolPosts, since epsilons are at the end and they are typically few, mostly 1.
 StatePost::const_iterator StatePost::first_epsilon_it(Symbol first_epsilon) const {
@@ -717,6 +732,20 @@ StateSet SynchronizedExistentialSymbolPostIterator::unify_targets() const {
     return unified_targets;
 }
 
+void SynchronizedExistentialSymbolPostIterator::unify_targets(std::vector<State>& unified_targets) const {
+    unified_targets.clear();
+    const std::vector<StatePost::const_iterator>& current_symbol_post_its{ get_current() };
+    if (current_symbol_post_its.size() == 1) {
+        const StateSet& targets{ current_symbol_post_its.front()->targets };
+        unified_targets.assign(targets.cbegin(), targets.cend());
+        return;
+    }
+    for (const StatePost::const_iterator& symbol_post_it: current_symbol_post_its) {
+        unified_targets.insert(unified_targets.end(), symbol_post_it->cbegin(), symbol_post_it->cend());
+    }
+    utils::sort_and_rmdupl(unified_targets);
+}
+
 bool SynchronizedExistentialSymbolPostIterator::synchronize_with(const Symbol sync_symbol) {
     do {
         if (is_synchronized()) {
@@ -0,0 +1,85 @@
+/* frozen-delta.cc -- Read-only transition relation in the compressed sparse row (CSR) format.
+ */
+
+#include <algorithm>
+
+#include "mata/nfa/frozen-delta.hh"
+#include "mata/utils/utils.hh"
+
+using namespace mata::nfa;
+
+FrozenDelta::FrozenDelta(const Delta& delta) {
+    const size_t num_of_states{ delta.num_of_states() };
+    size_t num_of_symbol_posts{ 0 };
+    size_t num_of_transitions{ 0 };
+    for (const StatePost& state_post: delta) {
+        num_of_symbol_posts += state_post.size();
+        num_of_transitions += state_post.num_of_moves();
+    }
+
+    state_offsets_.reserve(num_of_states + 1);
+    symbols_.reserve(num_of_symbol_posts);
+    target_offsets_.reserve(num_of_symbol_posts + 1);
+    targets_.reserve(num_of_transitions);
+
+    for (const StatePost& state_post: delta) {
+        for (const SymbolPost& symbol_post: state_post) {
+            symbols_.push_back(symbol_post.symbol);
+            targets_.insert(targets_.end(), symbol_post.targets.cbegin(), symbol_post.targets.cend());
+            target_offsets_.push_back(targets_.size());
+        }
+        state_offsets_.push_back(symbols_.size());
+    }
+}
+
+std::span<const State> FrozenDelta::targets(const State source, const Symbol symbol) const {
+    const std::span<const Symbol> source_symbols{ symbols(source) };
+    const auto symbol_it{ std::lower_bound(source_symbols.begin(), source_symbols.end(), symbol) };
+    if (symbol_it == source_symbols.end() || *symbol_it != symbol) { return {}; }
+    return targets(&*symbol_it);
+}
+
+Delta FrozenDelta::thaw() const {
+    Delta delta(num_of_states());
+    for (State source{ 0 }, num_of_states{ this->num_of_states() }; source < num_of_states; ++source) {
+        StatePost& state_post{ delta.mutable_state_post(source) };
+        state_post.reserve(state_offsets_[source + 1] - state_offsets_[source]);
+        for (const auto& [symbol, targets]: (*this)[source]) {
+            StateSet target_set{ StateSet::with_reserved(targets.size()) };
+            for (const State target: targets) { target_set.push_back(target); }
+            state_post.push_back(SymbolPost{ symbol, std::move(target_set) });
+        }
+    }
+    return delta;
+}
+
+StateSet SynchronizedExistentialFrozenSymbolIterator::unify_targets() const {
+    if (!is_synchronized()) { return {}; }
+    std::vector<State> unified_targets{};
+    unify_targets(unified_targets);
+    StateSet unified_target_set{ StateSet::with_reserved(unified_targets.size()) };
+    for (const State target: unified_targets) { unified_target_set.push_back(target); }
+    return unified_target_set;
+}
+
+void SynchronizedExistentialFrozenSymbolIterator::unify_targets(std::vector<State>& unified_targets) const {
+    unified_targets.clear();
+    const std::vector<const Symbol*>& current_symbol_its{ get_current() };
+    if (current_symbol_its.size() == 1) {
+        const std::span<const State> targets{ delta_->targets(current_symbol_its.front()) };
+        unified_targets.assign(targets.begin(), targets.end());
+        return;
+    }
+    for (const Symbol* const symbol_it: current_symbol_its) {
+        const std::span<const State> targets{ delta_->targets(symbol_it) };
+        unified_targets.insert(unified_targets.end(), targets.begin(), targets.end());
+    }
+    utils::sort_and_rmdupl(unified_targets);
+}
+
+bool SynchronizedExistentialFrozenSymbolIterator::synchronize_with(const Symbol sync_symbol) {
+    do {
+        if (is_synchronized() && *get_current_minimum() >= sync_symbol) { break; }
+    } while (advance());
+    return is_synchronized() && *get_current_minimum() == sync_symbol;
+}
@@ -5,9 +5,24 @@
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
 #include "mata/utils/sparse-set.hh"
+#include "mata/nfa/macrostate-store.hh"
+#include "simulation-subsumption.hh"
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 using namespace mata::nfa;
 using namespace mata::utils;
+using mata::Symbol;
+using mata::Word;
+using mata::BoolVector;
+using mata::nfa::internal::for_each_state;
+using mata::nfa::internal::SimulationSubsumption;
 
 /// naive language inclusion check (complementation + intersection + emptiness)
 bool mata::nfa::algorithms::is_included_naive(
@@ -39,32 +54,144 @@ bool mata::nfa::algorithms::is_included_naive(
 } // is_included_naive }}}
 
 
+namespace {
+    // Synchronized iteration over the symbol posts of Delta and FrozenDelta, so that antichains can run over both.
+    SynchronizedExistentialSymbolPostIterator create_sync_iterator(const Nfa&) { return {}; }
+    SynchronizedExistentialFrozenSymbolIterator create_sync_iterator(const FrozenNfa& aut) {
+        return SynchronizedExistentialFrozenSymbolIterator{ aut.delta };
+    }
+    void push_back_state_post(SynchronizedExistentialSymbolPostIterator& sync_iterator, const Nfa& aut, const State q) {
+        mata::utils::push_back(sync_iterator, aut.delta[q]);
+    }
+    void push_back_state_post(SynchronizedExistentialFrozenSymbolIterator& sync_iterator, const FrozenNfa&, const State q) {
+        sync_iterator.push_back(q);
+    }
+
+    // Sets of states of the bigger automaton represented as StateSet or as BitStateSet for small automata.
+    template<typename Aut>
+    StateSet create_bigger_set(const Aut&, const SparseSet<State>& states, StateSet*) { return StateSet(states); }
+    template<typename Aut>
+    BitStateSet create_bigger_set(const Aut& aut, const SparseSet<State>& states, BitStateSet*) {
+        return BitStateSet{ aut.num_of_states(), states };
+    }
+
+    template<typename SyncIterator, typename Aut>
+    void unify_targets(const SyncIterator& sync_iterator, const Aut&, StateSet& targets) {
+        targets = sync_iterator.unify_targets();
+    }
+    void unify_targets(const SynchronizedExistentialSymbolPostIterator& sync_iterator, const Nfa&,
+                       BitStateSet& targets) {
+        targets.clear();
+        for (const auto& symbol_post_it: sync_iterator.get_current()) { targets.insert(symbol_post_it->targets); }
+    }
+    void unify_targets(const SynchronizedExistentialFrozenSymbolIterator& sync_iterator, const FrozenNfa& aut,
+                       BitStateSet& targets) {
+        targets.clear();
+        for (const Symbol* const symbol_it: sync_iterator.get_current()) {
+            targets.insert(aut.delta.targets(symbol_it));
+        }
+    }
+
+    template<typename Aut>
+    bool intersects_with_final(const Aut& aut, const StateSet& states, const StateSet&) {
+        return aut.final.intersects_with(states);
+    }
+    template<typename Aut>
+    bool intersects_with_final(const Aut&, const BitStateSet& states, const BitStateSet& final_states) {
+        return final_states.intersects_with(states);
+    }
+
+    /**
+     * @brief Forward simulation over the disjoint union of the bigger and the smaller automaton, pruning antichains
+     *  up to simulation (Abdulla et al., When Simulation Meets Antichains).
+     *
+     * States of the bigger automaton keep their numbers, states of the smaller automaton are shifted by the number of
+     *  states of the bigger automaton.
+     */
+    class InclusionSimulation {
+    public:
+        InclusionSimulation(const Nfa& smaller, const Nfa& bigger)
+            : smaller_offset_{ bigger.num_of_states() }, subsumption_{ compute_union_simulation(smaller, bigger) },
+              simulating_smaller_(smaller.num_of_states()), simulated_smaller_(smaller.num_of_states()) {
+            const SimulationRelation& relation{ subsumption_.get_relation() };
+            for (State state{ 0 }, num_of_states{ smaller.num_of_states() }; state < num_of_states; ++state) {
+                for (State other{ 0 }; other < num_of_states; ++other) {
+                    if (relation.get(smaller_offset_ + state, smaller_offset_ + other)) {
+                        simulating_smaller_[state].push_back(other);
+                        simulated_smaller_[other].push_back(state);
+                    }
+                }
+            }
+        }
+
+        /// Smaller states simulating @p state, including @p state.
+        const std::vector<State>& get_simulating_smaller(const State state) const { return simulating_smaller_[state]; }
+        /// Smaller states simulated by @p state, including @p state.
+        const std::vector<State>& get_simulated_smaller(const State state) const { return simulated_smaller_[state]; }
+        bool is_smaller_simulated(const State state, const State simulating_state) const {
+            return subsumption_.get_relation().get(smaller_offset_ + state, smaller_offset_ + simulating_state);
+        }
+
+        /// Whether the smaller state @p state is simulated by some bigger state in @p set.
+        template<typename BiggerSet>
+        bool is_simulated_by_some(const State state, const BiggerSet& set) const {
+            return subsumption_.is_simulated_by_some(smaller_offset_ + state, set);
+        }
+
+        /// Whether each state of @p lower is simulated by some state of @p upper, i.e., @c L(lower) <= @c L(upper).
+        template<typename BiggerSet>
+        bool is_set_simulated(const BiggerSet& lower, const BiggerSet& upper) const {
+            return subsumption_.subsumes(lower, upper);
+        }
+
+        /// Remove states of @p set simulated by other states of @p set, keeping the smallest of mutually simulating.
+        template<typename BiggerSet>
+        void minimize(BiggerSet& set) const { subsumption_.minimize(set); }
+
+    private:
+        size_t smaller_offset_;
+        SimulationSubsumption subsumption_;
+        std::vector<std::vector<State>> simulating_smaller_;
+        std::vector<std::vector<State>> simulated_smaller_;
+
+        static SimulationRelation compute_union_simulation(const Nfa& smaller, const Nfa& bigger) {
+            const size_t offset{ bigger.num_of_states() };
+            Nfa disjoint_union{ bigger.delta, {}, bigger.final };
+            disjoint_union.delta.allocate(offset);
+            disjoint_union.delta.append(smaller.delta.renumber_targets([&](const State state) { return state + offset; }));
+            disjoint_union.delta.allocate(offset + smaller.num_of_states());
+            for (const State state: smaller.final) { disjoint_union.final.insert(state + offset); }
+            return algorithms::compute_simulation(disjoint_union, { { "direction", "forward" } });
+        }
+    };
+
 /// language inclusion check using Antichains
 // TODO, what about to construct the separator from this?
-bool mata::nfa::algorithms::is_included_antichains(
-    const Nfa&             smaller,
-    const Nfa&             bigger,
-    const Alphabet* const  alphabet, //TODO: this parameter is not used
-    Run*                   cex)
-{ // {{{
-    (void)alphabet;
-
+// With @p simulation, pairs are pruned up to simulation instead of plain subset subsumption.
+template<typename Aut, typename BiggerSet>
+bool is_included_antichains(const Aut& smaller, const Aut& bigger, Run* cex,
+                            const InclusionSimulation* const simulation = nullptr) { // {{{
     // TODO: Decide what is the best optimization for inclusion.
 
-    using ProdStateType = std::tuple<State, StateSet, size_t>;
+    using ProdStateType = std::tuple<State, BiggerSet, size_t>;
     using ProdStatesType = std::vector<ProdStateType>;
-    // ProcessedType is indexed by states of the smaller nfa
-    // tailored for pure antichain approach ... the simulation-based antichain will not work (without changes).
+    // ProcessedType is indexed by states of the smaller nfa.
+    // With simulation, pairs of a smaller state are subsumed by pairs of the smaller states simulating it.
     using ProcessedType = std::vector<ProdStatesType>;
 
-    auto subsumes = [](const ProdStateType& lhs, const ProdStateType& rhs) {
+    auto subsumes = [&](const ProdStateType& lhs, const ProdStateType& rhs) {
+        const BiggerSet& lhs_bigger = std::get<1>(lhs);
+        const BiggerSet& rhs_bigger = std::get<1>(rhs);
+        if (simulation != nullptr) {
+            // Each counterexample from rhs is a counterexample from lhs.
+            return simulation->is_smaller_simulated(std::get<0>(rhs), std::get<0>(lhs))
+                   && simulation->is_set_simulated(lhs_bigger, rhs_bigger);
+        }
+
         if (std::get<0>(lhs) != std::get<0>(rhs)) {
             return false;
         }
 
-        const StateSet& lhs_bigger = std::get<1>(lhs);
-        const StateSet& rhs_bigger = std::get<1>(rhs);
-
         //TODO: Can this be done faster using more heuristics? E.g., compare the last elements first ...
         //TODO: Try BDDs! What about some abstractions?
         return lhs_bigger.is_subset_of(rhs_bigger);
@@ -102,9 +229,10 @@ bool mata::nfa::algorithms::is_included_antichains(
     //         return distances_smaller[a.first] < distances_smaller[b.first];
     // };
 
-    auto min_dst = [&](const StateSet& set) {
-        if (set.empty()) return Limits::max_state;
-        return distances_bigger[*std::min_element(set.begin(), set.end(), [&](const State a,const State b){return distances_bigger[a] < distances_bigger[b];})];
+    auto min_dst = [&](const BiggerSet& set) {
+        State min_distance{ Limits::max_state };
+        for_each_state(set, [&](const State state) { min_distance = std::min(min_distance, distances_bigger[state]); });
+        return min_distance;
     };
 
     auto lengths_incompatible = [&](const ProdStateType& pair) {
@@ -125,6 +253,8 @@ bool mata::nfa::algorithms::is_included_antichains(
     // 'paths[s] == s' means that 's' is an initial state
     std::map<ProdStateType, std::pair<ProdStateType, Symbol>> paths;
 
+    const BiggerSet bigger_final{ create_bigger_set(bigger, bigger.final, static_cast<BiggerSet*>(nullptr)) };
+
     // check initial states first // TODO: this would be done in the main loop as the first thing anyway?
     for (const auto& state : smaller.initial) {
         if (smaller.final[state] &&
@@ -134,7 +264,13 @@ bool mata::nfa::algorithms::is_included_antichains(
             return false;
         }
 
-        StateSet bigger_state_set{ bigger.initial };
+        BiggerSet bigger_state_set{
+            create_bigger_set(bigger, bigger.initial, static_cast<BiggerSet*>(nullptr)) };
+        if (simulation != nullptr) {
+            simulation->minimize(bigger_state_set);
+            // All words accepted from the smaller state are accepted from the bigger set.
+            if (simulation->is_simulated_by_some(state, bigger_state_set)) { continue; }
+        }
         const ProdStateType st = std::tuple(state, bigger_state_set, min_dst(bigger_state_set));
         insert_to_pairs(worklist, st);
         insert_to_pairs(processed[state],st);
@@ -144,7 +280,7 @@ bool mata::nfa::algorithms::is_included_antichains(
     }
 
     //For synchronised iteration over the set of states
-    SynchronizedExistentialSymbolPostIterator sync_iterator;
+    auto sync_iterator{ create_sync_iterator(bigger) };
 
     // We use DFS strategy for the worklist processing
     while (!worklist.empty()) {
@@ -153,27 +289,26 @@ bool mata::nfa::algorithms::is_included_antichains(
         worklist.pop_back();
 
         const State& smaller_state = std::get<0>(prod_state);
-        const StateSet& bigger_set = std::get<1>(prod_state);
+        const BiggerSet& bigger_set = std::get<1>(prod_state);
 
         sync_iterator.reset();
-        for (State q: bigger_set) {
-            mata::utils::push_back(sync_iterator, bigger.delta[q]);
-        }
+        for_each_state(bigger_set, [&](const State q) { push_back_state_post(sync_iterator, bigger, q); });
 
         // process transitions leaving smaller_state
         for (const auto& smaller_move : smaller.delta[smaller_state]) {
             const Symbol& smaller_symbol = smaller_move.symbol;
 
-            StateSet bigger_succ = {};
-            if(sync_iterator.synchronize_with(smaller_move)) {
-                bigger_succ = sync_iterator.unify_targets();
+            BiggerSet bigger_succ{ create_bigger_set(bigger, {}, static_cast<BiggerSet*>(nullptr)) };
+            if(sync_iterator.synchronize_with(smaller_symbol)) {
+                unify_targets(sync_iterator, bigger, bigger_succ);
+                if (simulation != nullptr) { simulation->minimize(bigger_succ); }
             }
 
             for (const State& smaller_succ : smaller_move.targets) {
                 const ProdStateType succ = {smaller_succ, bigger_succ, min_dst(bigger_succ)};
 
                 if (lengths_incompatible(succ) ||
-                    (smaller.final[smaller_succ] && !bigger.final.intersects_with(bigger_succ)))
+                    (smaller.final[smaller_succ] && !intersects_with_final(bigger, bigger_succ, bigger_final)))
                 {
                     if (cex != nullptr) {
                         cex->word.push_back(smaller_symbol);
@@ -198,22 +333,42 @@ bool mata::nfa::algorithms::is_included_antichains(
                     return false;
                 }
 
+                // All words accepted from smaller_succ are accepted from bigger_succ.
+                if (simulation != nullptr && simulation->is_simulated_by_some(smaller_succ, bigger_succ)) {
+                    continue;
+                }
+
                 bool is_subsumed = false;
-                for (const auto& anti_state : processed[smaller_succ])
-                { // trying to find in processed a smaller state than the newly created succ
-                    // if (smaller_set(succ,anti_state)) {
-                    //     break;
-                    // }
-                    if (subsumes(anti_state, succ)) {
-                        is_subsumed = true;
-                        break;
+                auto is_subsumed_by_processed = [&](const State processed_state) {
+                    for (const auto& anti_state : processed[processed_state])
+                    { // trying to find in processed a smaller state than the newly created succ
+                        // if (smaller_set(succ,anti_state)) {
+                        //     break;
+                        // }
+                        if (subsumes(anti_state, succ)) {
+                            return true;
+                        }
                     }
+                    return false;
+                };
+                if (simulation == nullptr) {
+                    is_subsumed = is_subsumed_by_processed(smaller_succ);
+                } else {
+                    const std::vector<State>& simulating{ simulation->get_simulating_smaller(smaller_succ) };
+                    is_subsumed = std::any_of(simulating.begin(), simulating.end(), is_subsumed_by_processed);
                 }
 
                 if (is_subsumed) {
                     continue;
                 }
 
+                if (simulation != nullptr) {
+                    // Pairs of smaller states simulated by smaller_succ may be subsumed, too.
+                    for (const State simulated_state: simulation->get_simulated_smaller(smaller_succ)) {
+                        if (simulated_state == smaller_succ) { continue; }
+                        std::erase_if(processed[simulated_state], [&](const auto& d){ return subsumes(succ, d); });
+                    }
+                }
                 for (ProdStatesType* ds: {&processed[smaller_succ], &worklist}) {
                     //Pruning of processed and the worklist.
                     //Since they are ordered by the size of the sets, we can iterate from back,
@@ -240,8 +395,498 @@ bool mata::nfa::algorithms::is_included_antichains(
     return true;
 } // }}}
 
+template<typename Aut>
+bool is_included_antichains(const Aut& smaller, const Aut& bigger, Run* cex,
+                            const size_t bit_state_set_threshold = DEFAULT_BIT_STATE_SET_THRESHOLD,
+                            const InclusionSimulation* const simulation = nullptr) {
+    if (use_bit_state_sets(bigger.num_of_states(), bit_state_set_threshold)) {
+        return is_included_antichains<Aut, BitStateSet>(smaller, bigger, cex, simulation);
+    }
+    return is_included_antichains<Aut, StateSet>(smaller, bigger, cex, simulation);
+}
+
+    /// Product state (pair) of the parallel antichain inclusion, also used as a node of the tree of discovered pairs.
+    struct AntichainNode {
+        State smaller_state;
+        StateSet bigger_set;
+        size_t min_distance;
+        /// The node from which this node was discovered, @c nullptr for initial nodes.
+        const AntichainNode* parent;
+        /// Symbol of the transition from @c parent.
+        Symbol symbol;
+        /// Whether the node is still in the antichain (it has not been subsumed by a newer node).
+        std::atomic<bool> in_antichain{ true };
+
+        AntichainNode(State smaller_state, StateSet bigger_set, size_t min_distance, const AntichainNode* parent,
+                      Symbol symbol)
+            : smaller_state{ smaller_state }, bigger_set{ std::move(bigger_set) }, min_distance{ min_distance },
+              parent{ parent }, symbol{ symbol } {}
+        AntichainNode(const AntichainNode&) = delete;
+        AntichainNode& operator=(const AntichainNode&) = delete;
+    };
+
+    /// Part of the antichain for smaller states assigned to the shard, with a lock.
+    struct AntichainShard {
+        std::mutex mutex{};
+        /// Antichain elements for each smaller state assigned to the shard.
+        std::unordered_map<State, std::vector<AntichainNode*>> processed{};
+    };
+
+    /// Worklist of a single worker. The owner takes the newest nodes (DFS), thieves steal the oldest ones.
+    struct WorkerQueue {
+        std::mutex mutex{};
+        std::deque<AntichainNode*> nodes{};
+    };
+
+/// language inclusion check using Antichains, processing the pairs by multiple threads
+template<typename Aut>
+bool is_included_antichains_parallel(const Aut& smaller, const Aut& bigger, const size_t num_of_threads, Run* cex) {
+    assert(num_of_threads > 0);
+    const std::vector<State> distances_smaller = smaller.distances_to_final();
+    const std::vector<State> distances_bigger = bigger.distances_to_final();
+
+    auto min_dst = [&](const StateSet& set) {
+        if (set.empty()) return Limits::max_state;
+        return distances_bigger[*std::min_element(set.begin(), set.end(), [&](const State a,const State b){return distances_bigger[a] < distances_bigger[b];})];
+    };
+
+    const size_t num_of_shards{ 16 * num_of_threads };
+    std::vector<AntichainShard> shards(num_of_shards);
+    std::vector<WorkerQueue> queues(num_of_threads);
+    // Nodes are never freed before the end of the check; parents are needed to reconstruct counterexamples.
+    std::vector<std::deque<AntichainNode>> nodes(num_of_threads);
+    std::deque<AntichainNode> initial_nodes{};
+    // Number of nodes pushed to any worklist which have not been processed yet.
+    std::atomic<size_t> num_of_pending_nodes{ 0 };
+    // Number of nodes in the worklists, i.e., pending nodes not taken by any worker yet.
+    std::atomic<size_t> num_of_queued_nodes{ 0 };
+    std::atomic<bool> cancelled{ false };
+    std::mutex cex_mutex{};
+    // The first exception thrown by a worker, rethrown after all workers finish.
+    std::exception_ptr exception{};
+
+    // Workers without nodes to process wait for new nodes, the end of the check or a cancellation.
+    std::atomic<size_t> num_of_idle_workers{ 0 };
+    std::mutex idle_mutex{};
+    std::condition_variable idle_condition{};
+    auto wake_idle_workers = [&](const bool all) {
+        if (num_of_idle_workers.load() == 0) { return; }
+        // Idle workers check their wait condition under the lock, hence the notification cannot be missed.
+        { const std::lock_guard lock{ idle_mutex }; }
+        if (all) { idle_condition.notify_all(); } else { idle_condition.notify_one(); }
+    };
+    auto cancel = [&] {
+        const bool was_cancelled{ cancelled.exchange(true) };
+        wake_idle_workers(true);
+        return was_cancelled;
+    };
+    auto finish_node = [&] {
+        if (num_of_pending_nodes.fetch_sub(1) == 1) { wake_idle_workers(true); }
+    };
+
+    // Builds the counterexample leading to @p smaller_succ over @p symbol from @p node. The first caller wins.
+    auto report_cex = [&](const AntichainNode* node, const Symbol symbol, const State smaller_succ) {
+        if (cancel() || cex == nullptr) { return; }
+        const std::lock_guard lock{ cex_mutex };
+        cex->word.clear();
+        cex->path.clear();
+        cex->word.push_back(symbol);
+        for (; node != nullptr; node = node->parent) {
+            cex->path.push_back(node->smaller_state);
+            if (node->parent != nullptr) { cex->word.push_back(node->symbol); }
+        }
+        std::reverse(cex->word.begin(), cex->word.end());
+        std::reverse(cex->path.begin(), cex->path.end());
+        Run leftover = smaller.get_shortest_accepting_run_from_state(smaller_succ, distances_smaller);
+        cex->word.insert(cex->word.end(), leftover.word.begin(), leftover.word.end());
+        cex->path.insert(cex->path.end(), leftover.path.begin(), leftover.path.end());
+    };
+
+    // Inserts @p node into the antichain unless it is subsumed. Removes nodes subsumed by @p node.
+    auto insert_to_antichain = [&](AntichainNode* node) {
+        AntichainShard& shard{ shards[node->smaller_state % num_of_shards] };
+        const std::lock_guard lock{ shard.mutex };
+        std::vector<AntichainNode*>& processed{ shard.processed[node->smaller_state] };
+        for (const AntichainNode* anti_node: processed) {
+            if (anti_node->bigger_set.is_subset_of(node->bigger_set)) { return false; }
+        }
+        std::erase_if(processed, [&](AntichainNode* anti_node) {
+            if (node->bigger_set.is_subset_of(anti_node->bigger_set)) {
+                anti_node->in_antichain.store(false, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        });
+        processed.push_back(node);
+        return true;
+    };
+
+    auto push_to_queue = [&](const size_t worker, AntichainNode* node) {
+        num_of_pending_nodes.fetch_add(1);
+        {
+            const std::lock_guard lock{ queues[worker].mutex };
+            queues[worker].nodes.push_back(node);
+        }
+        num_of_queued_nodes.fetch_add(1);
+        wake_idle_workers(false);
+    };
+
+    // Pops the newest node of the own queue, or steals the oldest node from other queues.
+    auto pop_from_queues = [&](const size_t worker) -> AntichainNode* {
+        for (size_t i{ 0 }; i < num_of_threads; ++i) {
+            WorkerQueue& queue{ queues[(worker + i) % num_of_threads] };
+            const std::lock_guard lock{ queue.mutex };
+            if (queue.nodes.empty()) { continue; }
+            AntichainNode* node;
+            if (i == 0) {
+                node = queue.nodes.back();
+                queue.nodes.pop_back();
+            } else {
+                node = queue.nodes.front();
+                queue.nodes.pop_front();
+            }
+            num_of_queued_nodes.fetch_sub(1);
+            return node;
+        }
+        return nullptr;
+    };
+
+    // check initial states first
+    size_t next_worker{ 0 };
+    for (const auto& state : smaller.initial) {
+        if (smaller.final[state] &&
+            are_disjoint(bigger.initial, bigger.final))
+        {
+            if (cex != nullptr) { cex->word.clear(); cex->path = {state}; }
+            return false;
+        }
+
+        StateSet bigger_state_set{ bigger.initial };
+        const size_t min_distance{ min_dst(bigger_state_set) };
+        AntichainNode* node{ &initial_nodes.emplace_back(state, std::move(bigger_state_set), min_distance, nullptr, 0) };
+        if (insert_to_antichain(node)) {
+            push_to_queue(next_worker, node);
+            next_worker = (next_worker + 1) % num_of_threads;
+        }
+    }
+
+    auto process = [&](const size_t worker) {
+        auto sync_iterator{ create_sync_iterator(bigger) };
+        while (!cancelled.load(std::memory_order_relaxed)) {
+            AntichainNode* node{ pop_from_queues(worker) };
+            if (node == nullptr) {
+                std::unique_lock lock{ idle_mutex };
+                num_of_idle_workers.fetch_add(1);
+                idle_condition.wait(lock, [&] {
+                    return cancelled.load() || num_of_queued_nodes.load() > 0 || num_of_pending_nodes.load() == 0;
+                });
+                num_of_idle_workers.fetch_sub(1);
+                if (num_of_pending_nodes.load() == 0) { return; }
+                continue;
+            }
+            if (!node->in_antichain.load(std::memory_order_relaxed)) {
+                // Subsumed by a node discovered after this node was pushed to the worklist.
+                finish_node();
+                continue;
+            }
+
+            sync_iterator.reset();
+            for (State q: node->bigger_set) {
+                push_back_state_post(sync_iterator, bigger, q);
+            }
+
+            for (const auto& smaller_move : smaller.delta[node->smaller_state]) {
+                const Symbol smaller_symbol = smaller_move.symbol;
+
+                StateSet bigger_succ = {};
+                if(sync_iterator.synchronize_with(smaller_symbol)) {
+                    bigger_succ = sync_iterator.unify_targets();
+                }
+                const size_t min_distance{ min_dst(bigger_succ) };
+
+                for (const State& smaller_succ : smaller_move.targets) {
+                    if (distances_smaller[smaller_succ] < min_distance ||
+                        (smaller.final[smaller_succ] && !bigger.final.intersects_with(bigger_succ)))
+                    {
+                        report_cex(node, smaller_symbol, smaller_succ);
+                        return;
+                    }
+
+                    AntichainNode* succ{ &nodes[worker].emplace_back(
+                        smaller_succ, bigger_succ, min_distance, node, smaller_symbol) };
+                    if (insert_to_antichain(succ)) { push_to_queue(worker, succ); }
+                }
+            }
+            finish_node();
+        }
+    };
+
+    // An exception of a worker cancels the check for all workers.
+    auto run_worker = [&](const size_t worker) {
+        try {
+            process(worker);
+        } catch (...) {
+            {
+                const std::lock_guard lock{ cex_mutex };
+                if (exception == nullptr) { exception = std::current_exception(); }
+            }
+            cancel();
+        }
+    };
+    {
+        // Threads are joined when leaving the scope, also when starting some of them fails.
+        std::vector<std::jthread> threads{};
+        threads.reserve(num_of_threads - 1);
+        for (size_t worker{ 1 }; worker < num_of_threads; ++worker) { threads.emplace_back(run_worker, worker); }
+        run_worker(0);
+    }
+    if (exception != nullptr) { std::rethrow_exception(exception); }
+    return !cancelled.load();
+}
+
+} // namespace.
+
+bool mata::nfa::algorithms::is_included_antichains_parallel(
+    const Nfa& smaller, const Nfa& bigger, const size_t num_of_threads, Run* cex) {
+    if (num_of_threads <= 1) { return ::is_included_antichains(smaller, bigger, cex); }
+    return ::is_included_antichains_parallel(smaller, bigger, num_of_threads, cex);
+}
+
+bool mata::nfa::algorithms::is_included_antichains_parallel(
+    const FrozenNfa& smaller, const FrozenNfa& bigger, const size_t num_of_threads, Run* cex) {
+    if (num_of_threads <= 1) { return ::is_included_antichains(smaller, bigger, cex); }
+    return ::is_included_antichains_parallel(smaller, bigger, num_of_threads, cex);
+}
+
+bool mata::nfa::algorithms::is_included_antichains(
+    const Nfa&             smaller,
+    const Nfa&             bigger,
+    const Alphabet* const  alphabet, //TODO: this parameter is not used
+    Run*                   cex,
+    const size_t           bit_state_set_threshold) {
+    (void)alphabet;
+    return ::is_included_antichains(smaller, bigger, cex, bit_state_set_threshold);
+}
+
+bool mata::nfa::algorithms::is_included_antichains(const FrozenNfa& smaller, const FrozenNfa& bigger, Run* cex,
+                                                   const size_t bit_state_set_threshold) {
+    return ::is_included_antichains(smaller, bigger, cex, bit_state_set_threshold);
+}
+
+bool mata::nfa::algorithms::is_included_antichains_simulation(const Nfa& smaller, const Nfa& bigger, Run* cex,
+                                                              const size_t bit_state_set_threshold) {
+    const InclusionSimulation simulation{ smaller, bigger };
+    return ::is_included_antichains(smaller, bigger, cex, bit_state_set_threshold, &simulation);
+}
+
+namespace {
+    /**
+     * @brief Check language equivalence of macrostates by bisimulation up to congruence (HKC) of Bonchi and Pous.
+     *
+     * The macrostates are sets of states of the disjoint union of @p lhs and @p rhs (states of @p rhs are shifted by
+     *  the number of states of @p lhs). Starting from the pair of initial macrostates, pairs of successor macrostates
+     *  over each symbol are explored breadth-first. A pair is skipped when it is in the congruence closure of the
+     *  already explored pairs: first, a union-find over interned macrostates answers the pairs in the equivalence
+     *  closure cheaply, then each macrostate is checked to be included in the normal form of the other w.r.t. the
+     *  explored pairs, used as rewriting rules <tt>X -> X + Y</tt>.
+     *
+     * When @p inclusion is set, the initial pair is <tt>(I_lhs + I_rhs, I_rhs)</tt>, hence the check decides
+     *  @c L(lhs) <= @c L(rhs). Otherwise, the initial pair is <tt>(I_lhs, I_rhs)</tt>.
+     *
+     * @param[out] cex Some shortest word distinguishing the macrostates when they are not equivalent.
+     * @return True iff the initial macrostates are equivalent.
+     */
+    bool check_bisimulation_up_to_congruence(const Nfa& lhs, const Nfa& rhs, const bool inclusion, Word* cex) {
+        const size_t rhs_offset{ lhs.num_of_states() };
+        const size_t num_of_states{ rhs_offset + rhs.num_of_states() };
+        BoolVector is_final(num_of_states, false);
+        for (const State state: lhs.final) { is_final[state] = true; }
+        for (const State state: rhs.final) { is_final[rhs_offset + state] = true; }
+        auto get_state_post = [&](const State state) -> const StatePost& {
+            return state < rhs_offset ? lhs.delta[state] : rhs.delta[state - rhs_offset];
+        };
+        auto get_target = [&](const State source, const State target) {
+            return source < rhs_offset ? target : rhs_offset + target;
+        };
+        auto is_accepting = [&](const std::vector<State>& macrostate) {
+            return std::any_of(macrostate.begin(), macrostate.end(), [&](const State state) { return is_final[state]; });
+        };
+
+        // Macrostates interned in a store, with a union-find over their identifiers.
+        MacrostateStore macrostates{};
+        std::vector<MacrostateId> parent{};
+        auto intern = [&](const std::vector<State>& macrostate) {
+            const auto [id, inserted]{ macrostates.insert(macrostate) };
+            if (inserted) { parent.push_back(id); }
+            return id;
+        };
+        auto find_root = [&](MacrostateId id) {
+            while (parent[id] != id) { id = parent[id] = parent[parent[id]]; }
+            return id;
+        };
+
+        // Explored pairs, used as rewriting rules of the congruence closure.
+        std::vector<std::pair<MacrostateId, MacrostateId>> relation{};
+        std::vector<bool> is_rule_applied{};
+        BoolVector in_normal_form(num_of_states, false);
+        BoolVector in_subset(num_of_states, false);
+        std::vector<State> normal_form{};
+        // Whether @p subset is included in the normal form of @p id. The normal form is saturated only until it
+        //  includes @p subset.
+        auto is_included_in_normal_form = [&](const MacrostateId subset, const MacrostateId id) {
+            for (const State state: normal_form) { in_normal_form[state] = false; }
+            const MacrostateStore::Macrostate macrostate{ macrostates[id] };
+            normal_form.assign(macrostate.begin(), macrostate.end());
+            for (const State state: normal_form) { in_normal_form[state] = true; }
+            size_t num_of_missing{ 0 };
+            for (const State state: macrostates[subset]) {
+                if (!in_normal_form[state]) { in_subset[state] = true; ++num_of_missing; }
+            }
+            auto is_subset = [&](const MacrostateId other) {
+                const MacrostateStore::Macrostate other_macrostate{ macrostates[other] };
+                return std::all_of(other_macrostate.begin(), other_macrostate.end(),
+                                   [&](const State state) { return in_normal_form[state]; });
+            };
+            auto add = [&](const MacrostateId other) {
+                bool changed{ false };
+                for (const State state: macrostates[other]) {
+                    if (in_normal_form[state]) { continue; }
+                    in_normal_form[state] = true;
+                    normal_form.push_back(state);
+                    if (in_subset[state]) { in_subset[state] = false; --num_of_missing; }
+                    changed = true;
+                }
+                return changed;
+            };
+            // Each rule is applied at most once, after which both of its sides are in the normal form.
+            is_rule_applied.assign(relation.size(), false);
+            for (bool changed{ true }; changed && num_of_missing > 0;) {
+                changed = false;
+                for (size_t rule{ 0 }; rule < relation.size() && num_of_missing > 0; ++rule) {
+                    if (is_rule_applied[rule]) { continue; }
+                    const auto [left, right]{ relation[rule] };
+                    if (is_subset(left)) { changed |= add(right); is_rule_applied[rule] = true; }
+                    else if (is_subset(right)) { changed |= add(left); is_rule_applied[rule] = true; }
+                }
+            }
+            if (num_of_missing == 0) { return true; }
+            for (const State state: macrostates[subset]) { in_subset[state] = false; }
+            return false;
+        };
+        auto is_in_congruence = [&](const MacrostateId left, const MacrostateId right) {
+            if (find_root(left) == find_root(right)) { return true; }
+            // For inclusion, the left macrostate is always a superset of the right one, hence of its normal form.
+            return is_included_in_normal_form(left, right)
+                   && (inclusion || is_included_in_normal_form(right, left));
+        };
+
+        // Pairs to explore, with the index of the pair they were reached from and the symbol, to reconstruct words.
+        struct Pair {
+            std::vector<State> left;
+            std::vector<State> right;
+            size_t parent;
+            Symbol symbol;
+        };
+        std::vector<Pair> pairs{};
+        std::vector<State> initial_left{};
+        std::vector<State> initial_right{};
+        for (const State state: lhs.initial) { initial_left.push_back(state); }
+        for (const State state: rhs.initial) {
+            initial_right.push_back(rhs_offset + state);
+            if (inclusion) { initial_left.push_back(rhs_offset + state); }
+        }
+        sort_and_rmdupl(initial_left);
+        sort_and_rmdupl(initial_right);
+        pairs.push_back({ std::move(initial_left), std::move(initial_right), 0, 0 });
+
+        std::vector<Symbol> symbols{};
+        for (size_t pair_index{ 0 }; pair_index < pairs.size(); ++pair_index) {
+            const MacrostateId left{ intern(pairs[pair_index].left) };
+            const MacrostateId right{ intern(pairs[pair_index].right) };
+            if (is_in_congruence(left, right)) { continue; }
+            if (is_accepting(pairs[pair_index].left) != is_accepting(pairs[pair_index].right)) {
+                if (cex != nullptr) {
+                    cex->clear();
+                    for (size_t index{ pair_index }; index != 0; index = pairs[index].parent) {
+                        cex->push_back(pairs[index].symbol);
+                    }
+                    std::reverse(cex->begin(), cex->end());
+                }
+                return false;
+            }
+            relation.emplace_back(left, right);
+            parent[find_root(left)] = find_root(right);
+
+            symbols.clear();
+            for (const std::vector<State>* macrostate: { &pairs[pair_index].left, &pairs[pair_index].right }) {
+                for (const State state: *macrostate) {
+                    for (const SymbolPost& symbol_post: get_state_post(state)) { symbols.push_back(symbol_post.symbol); }
+                }
+            }
+            sort_and_rmdupl(symbols);
+            for (const Symbol symbol: symbols) {
+                auto compute_post = [&](const std::vector<State>& macrostate) {
+                    std::vector<State> post{};
+                    for (const State state: macrostate) {
+                        const StatePost& state_post{ get_state_post(state) };
+                        if (const auto symbol_post_it{ state_post.find(symbol) }; symbol_post_it != state_post.end()) {
+                            for (const State target: symbol_post_it->targets) { post.push_back(get_target(state, target)); }
+                        }
+                    }
+                    sort_and_rmdupl(post);
+                    return post;
+                };
+                std::vector<State> left_post{ compute_post(pairs[pair_index].left) };
+                std::vector<State> right_post{ compute_post(pairs[pair_index].right) };
+                pairs.push_back({ std::move(left_post), std::move(right_post), pair_index, symbol });
+            }
+        }
+        return true;
+    }
+
+    /// Get an accepting run of @p aut over @p word, which must be in the language of @p aut.
+    std::vector<State> get_accepting_path(const Nfa& aut, const Word& word) {
+        // Predecessor of each state reached after each prefix of the word.
+        std::vector<std::unordered_map<State, State>> predecessors(word.size() + 1);
+        for (const State state: aut.initial) { predecessors[0].emplace(state, state); }
+        for (size_t i{ 0 }; i < word.size(); ++i) {
+            for (const auto& [state, predecessor]: predecessors[i]) {
+                const StatePost& state_post{ aut.delta[state] };
+                if (const auto symbol_post_it{ state_post.find(word[i]) }; symbol_post_it != state_post.end()) {
+                    for (const State target: symbol_post_it->targets) { predecessors[i + 1].emplace(target, state); }
+                }
+            }
+        }
+        std::vector<State> path(word.size() + 1);
+        const auto final_it{ std::find_if(predecessors[word.size()].begin(), predecessors[word.size()].end(),
+                                          [&](const auto& item) { return aut.final.contains(item.first); }) };
+        assert(final_it != predecessors[word.size()].end());
+        path[word.size()] = final_it->first;
+        for (size_t i{ word.size() }; i > 0; --i) { path[i - 1] = predecessors[i].at(path[i]); }
+        return path;
+    }
+} // namespace.
+
+bool mata::nfa::algorithms::is_included_hkc(const Nfa& smaller, const Nfa& bigger, const Alphabet* const alphabet,
+                                            Run* cex) {
+    (void)alphabet;
+    Word cex_word{};
+    if (check_bisimulation_up_to_congruence(smaller, bigger, true, cex != nullptr ? &cex_word : nullptr)) {
+        return true;
+    }
+    if (cex != nullptr) {
+        cex->path = get_accepting_path(smaller, cex_word);
+        cex->word = std::move(cex_word);
+    }
+    return false;
+}
+
+bool mata::nfa::algorithms::are_equivalent_hkc(const Nfa& lhs, const Nfa& rhs, Word* cex) {
+    return check_bisimulation_up_to_congruence(lhs, rhs, false, cex);
+}
+
 namespace {
-    using AlgoType = decltype(algorithms::is_included_naive)*;
+    using AlgoType = std::function<bool(const Nfa&, const Nfa&, const mata::Alphabet*, Run*)>;
 
     bool compute_equivalence(const Nfa &lhs, const Nfa &rhs, const mata::Alphabet *const alphabet, const AlgoType &algo) {
         //alphabet should not be needed as input parameter
@@ -254,6 +899,7 @@ namespace {
         return false;
     }
 
+    /// Number of threads set by the "threads" key in @p params, 1 if not set, and all available threads for "0".
     AlgoType set_algorithm(const std::string &function_name, const ParameterMap &params) {
         if (!haskey(params, "algorithm")) {
             throw std::runtime_error(function_name +
@@ -261,12 +907,28 @@ namespace {
                                      "received: " + std::to_string(params));
         }
 
-        decltype(algorithms::is_included_naive) *algo;
+        AlgoType algo;
         const std::string &str_algo = params.at("algorithm");
         if ("naive" == str_algo) {
             algo = algorithms::is_included_naive;
         } else if ("antichains" == str_algo) {
-            algo = algorithms::is_included_antichains;
+            const size_t num_of_threads{ algorithms::get_num_of_threads(function_name, params) };
+            const size_t threshold{ algorithms::get_bit_state_set_threshold(function_name, params) };
+            if (algorithms::use_simulation(function_name, params)) {
+                algo = [threshold](const Nfa& smaller, const Nfa& bigger, const mata::Alphabet*, Run* cex) {
+                    return algorithms::is_included_antichains_simulation(smaller, bigger, cex, threshold);
+                };
+            } else if (num_of_threads > 1) {
+                algo = [num_of_threads](const Nfa& smaller, const Nfa& bigger, const mata::Alphabet*, Run* cex) {
+                    return algorithms::is_included_antichains_parallel(smaller, bigger, num_of_threads, cex);
+                };
+            } else {
+                algo = [threshold](const Nfa& smaller, const Nfa& bigger, const mata::Alphabet* alphabet, Run* cex) {
+                    return algorithms::is_included_antichains(smaller, bigger, alphabet, cex, threshold);
+                };
+            }
+        } else if ("hkc" == str_algo) {
+            algo = algorithms::is_included_hkc;
         } else {
             throw std::runtime_error(std::to_string(__func__) +
                                      " received an unknown value of the \"algorithm\" key: " + str_algo);
@@ -293,6 +955,10 @@ bool mata::nfa::are_equivalent(const Nfa& lhs, const Nfa& rhs, const Alphabet *a
     //TODO: add comment on what this is doing, what is __func__ ...
     AlgoType algo{ set_algorithm(std::to_string(__func__), params) };
 
+    if (params.at("algorithm") == "hkc") {
+        // Bisimulation up to congruence decides equivalence directly, without checking both inclusions.
+        return algorithms::are_equivalent_hkc(lhs, rhs);
+    }
     if (params.at("algorithm") == "naive") {
         if (alphabet == nullptr) {
             const auto computed_alphabet{create_alphabet(lhs, rhs) };
@@ -0,0 +1,121 @@
+/* macrostate-store.cc -- Hash-consed storage of macrostates and tuples of states.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+
+#include "mata/nfa/macrostate-store.hh"
+#include "mata/utils/utils.hh"
+
+using namespace mata::nfa;
+
+namespace {
+    /// Initial number of slots in the index. Has to be a power of two.
+    constexpr size_t INITIAL_INDEX_SIZE{ 16 };
+
+    /// Check whether @p states are sorted in an ascending order without duplicates.
+    [[maybe_unused]] bool is_sorted_set(const std::span<const State> states) {
+        return std::adjacent_find(states.begin(), states.end(), std::greater_equal<>{}) == states.end();
+    }
+}
+
+template<bool SORTED>
+StateSequenceStore<SORTED>::StateSequenceStore(): offsets_{ 0 }, index_(INITIAL_INDEX_SIZE, EMPTY_SLOT) {}
+
+template<bool SORTED>
+StateSet StateSequenceStore<SORTED>::get_state_set(const MacrostateId id) const requires SORTED {
+    StateSet state_set{ StateSet::with_reserved(size_of(id)) };
+    for (const State state: (*this)[id]) { state_set.push_back(state); }
+    return state_set;
+}
+
+template<bool SORTED>
+size_t StateSequenceStore<SORTED>::compute_hash(const Sequence sequence) {
+    return mata::utils::hash_range(sequence.begin(), sequence.end());
+}
+
+template<bool SORTED>
+size_t StateSequenceStore<SORTED>::find_slot(const Sequence sequence, const size_t hash) const {
+    const size_t mask{ index_.size() - 1 };
+    size_t slot{ hash & mask };
+    while (true) {
+        const MacrostateId id{ index_[slot] };
+        if (id == EMPTY_SLOT) { return slot; }
+        if (hashes_[id] == hash && size_of(id) == sequence.size()
+            && std::equal(sequence.begin(), sequence.end(), arena_.begin() + static_cast<long>(offsets_[id]))) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+template<bool SORTED>
+MacrostateId StateSequenceStore<SORTED>::find(const Sequence sequence) const {
+    assert(!SORTED || is_sorted_set(sequence));
+    return index_[find_slot(sequence, compute_hash(sequence))];
+}
+
+template<bool SORTED>
+std::pair<MacrostateId, bool> StateSequenceStore<SORTED>::insert(const Sequence sequence) {
+    assert(!SORTED || is_sorted_set(sequence));
+    const size_t hash{ compute_hash(sequence) };
+    size_t slot{ find_slot(sequence, hash) };
+    if (index_[slot] != EMPTY_SLOT) { return { index_[slot], false }; }
+
+    if (size() >= static_cast<size_t>(NOT_FOUND)) {
+        throw std::runtime_error("state sequence store cannot address more than "
+                                 + std::to_string(NOT_FOUND) + " sequences");
+    }
+    const auto id{ static_cast<MacrostateId>(size()) };
+    arena_.insert(arena_.end(), sequence.begin(), sequence.end());
+    offsets_.push_back(arena_.size());
+    hashes_.push_back(hash);
+    index_[slot] = id;
+    // Keep the load factor at most 1/2 so that the linear probing sequences stay short.
+    if (2 * size() > index_.size()) { rehash(2 * index_.size()); }
+    return { id, true };
+}
+
+template<bool SORTED>
+void StateSequenceStore<SORTED>::rehash(const size_t new_index_size) {
+    assert((new_index_size & (new_index_size - 1)) == 0);
+    index_.assign(new_index_size, EMPTY_SLOT);
+    const size_t mask{ new_index_size - 1 };
+    for (MacrostateId id{ 0 }, num_of_sequences{ static_cast<MacrostateId>(size()) }; id < num_of_sequences; ++id) {
+        size_t slot{ hashes_[id] & mask };
+        while (index_[slot] != EMPTY_SLOT) { slot = (slot + 1) & mask; }
+        index_[slot] = id;
+    }
+}
+
+template<bool SORTED>
+void StateSequenceStore<SORTED>::reserve(const size_t num_of_sequences, const size_t num_of_states) {
+    arena_.reserve(num_of_states);
+    offsets_.reserve(num_of_sequences + 1);
+    hashes_.reserve(num_of_sequences);
+    size_t new_index_size{ index_.size() };
+    while (new_index_size < 2 * num_of_sequences) { new_index_size *= 2; }
+    if (new_index_size != index_.size()) { rehash(new_index_size); }
+}
+
+template<bool SORTED>
+void StateSequenceStore<SORTED>::clear() {
+    arena_.clear();
+    offsets_.assign(1, 0);
+    hashes_.clear();
+    std::fill(index_.begin(), index_.end(), EMPTY_SLOT);
+}
+
+template<bool SORTED>
+void StateSequenceStore<SORTED>::fill_subset_map(std::unordered_map<StateSet, State>& subset_map) const
+    requires SORTED {
+    subset_map.reserve(subset_map.size() + size());
+    for (MacrostateId id{ 0 }, num_of_macrostates{ static_cast<MacrostateId>(size()) }; id < num_of_macrostates; ++id) {
+        subset_map[get_state_set(id)] = id;
+    }
+}
+
+template class mata::nfa::StateSequenceStore<true>;
+template class mata::nfa::StateSequenceStore<false>;
@@ -0,0 +1,117 @@
+/* matcher.cc -- Streaming matcher of words against an NFA determinized lazily.
+ */
+
+#include <algorithm>
+
+#include "mata/nfa/matcher.hh"
+#include "mata/nfa/nfa.hh"
+
+using namespace mata::nfa;
+using mata::Symbol;
+
+Matcher::Matcher(const Nfa& aut, const size_t max_cached_states)
+    : aut_{ aut }, max_cached_states_{ std::max<size_t>(max_cached_states, 2) },
+      column_of_byte_(NUM_OF_BYTES, OTHER_SYMBOL), symbol_of_column_{ 0 } {
+    // Column 0 is reserved for all symbols not used in the automaton.
+    for (const Symbol symbol: aut_.delta.get_used_symbols()) {
+        const size_t column{ symbol_of_column_.size() };
+        if (symbol < NUM_OF_BYTES) {
+            column_of_byte_[symbol] = column;
+        } else {
+            column_of_symbol_.emplace(symbol, column);
+        }
+        symbol_of_column_.push_back(symbol);
+    }
+    initial_states_.assign(aut_.initial.begin(), aut_.initial.end());
+    std::sort(initial_states_.begin(), initial_states_.end());
+    flush();
+    num_of_flushes_ = 0;
+    current_ = initial_;
+}
+
+MacrostateId Matcher::intern(const std::span<const State> macrostate) {
+    const auto [id, inserted]{ macrostates_.insert(macrostate) };
+    if (inserted) {
+        is_final_.push_back(std::any_of(macrostate.begin(), macrostate.end(), [&](const State state) {
+            return aut_.final.contains(state);
+        }));
+        // The dead macrostate (interned first) has no transitions, other macrostates have none over unused symbols.
+        transitions_.resize(transitions_.size() + symbol_of_column_.size(), id == DEAD ? DEAD : UNKNOWN);
+        transitions_[id * symbol_of_column_.size() + OTHER_SYMBOL] = DEAD;
+    }
+    return id;
+}
+
+void Matcher::flush() {
+    macrostates_.clear();
+    is_final_.clear();
+    transitions_.clear();
+    intern({});
+    initial_ = intern(initial_states_);
+    ++num_of_flushes_;
+}
+
+MacrostateId Matcher::compute_step(const MacrostateId macrostate, const size_t column) {
+    const Symbol symbol{ symbol_of_column_[column] };
+    targets_buffer_.clear();
+    for (const State state: macrostates_[macrostate]) {
+        const StatePost& state_post{ aut_.delta[state] };
+        if (const auto symbol_post_it{ state_post.find(symbol) }; symbol_post_it != state_post.end()) {
+            targets_buffer_.insert(targets_buffer_.end(), symbol_post_it->targets.begin(), symbol_post_it->targets.end());
+        }
+    }
+    utils::sort_and_rmdupl(targets_buffer_);
+
+    if (macrostates_.size() >= max_cached_states_ && macrostates_.find(targets_buffer_) == MacrostateStore::NOT_FOUND) {
+        // The cache is full. Start again from the target, the transition from the flushed source is not cached.
+        flush();
+        return intern(targets_buffer_);
+    }
+    const MacrostateId target{ intern(targets_buffer_) };
+    transitions_[macrostate * symbol_of_column_.size() + column] = target;
+    return target;
+}
+
+void Matcher::feed(const std::span<const Symbol> word) {
+    for (const Symbol symbol: word) { current_ = step(current_, symbol); }
+}
+
+void Matcher::feed(const std::string_view bytes) {
+    for (const char byte: bytes) { current_ = step(current_, static_cast<unsigned char>(byte)); }
+}
+
+bool Matcher::match(const std::span<const Symbol> word) {
+    reset();
+    for (const Symbol symbol: word) {
+        current_ = step(current_, symbol);
+        if (current_ == DEAD) { return false; }
+    }
+    return accepts();
+}
+
+bool Matcher::match(const std::string_view bytes) {
+    reset();
+    for (const char byte: bytes) {
+        current_ = step(current_, static_cast<unsigned char>(byte));
+        if (current_ == DEAD) { return false; }
+    }
+    return accepts();
+}
+
+bool Matcher::match_prefix(const std::span<const Symbol> word) {
+    reset();
+    for (const Symbol symbol: word) {
+        if (accepts()) { return true; }
+        current_ = step(current_, symbol);
+        if (current_ == DEAD) { return false; }
+    }
+    return accepts();
+}
+
+mata::BoolVector Matcher::match_all(const std::span<const Word> words) {
+    BoolVector results(words.size(), false);
+    for (size_t i{ 0 }, num_of_words{ words.size() }; i < num_of_words; ++i) {
+        results[i] = match(words[i]);
+    }
+    return results;
+}
@@ -13,6 +13,7 @@
 #include "mata/utils/sparse-set.hh"
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/nfa/binary-format.hh"
 #include <mata/simlib/explicit_lts.hh>
 
 using namespace mata::utils;
@@ -21,8 +22,6 @@ using mata::Symbol;
 using mata::Word;
 using mata::BoolVector;
 
-using StateBoolArray = std::vector<bool>; ///< Bool array for states in the automaton.
-
 const std::string mata::nfa::TYPE_NFA = "NFA";
 
 const State Limits::min_state;
@@ -30,57 +29,33 @@ const State Limits::max_state;
 const Symbol Limits::min_symbol;
 const Symbol Limits::max_symbol;
 
-namespace {
-    /**
-     * Compute reachability of states considering only specified states.
-     *
-     * @param[in] nfa NFA to compute reachability for.
-     * @param[in] states_to_consider State to consider as potentially reachable. If @c std::nullopt is used, all states
-     *  are considered as potentially reachable.
-     * @return Bool array for reachable states (from initial states): true for reachable, false for unreachable states.
-     */
-    StateBoolArray reachable_states(const Nfa& nfa,
-                                       const std::optional<const StateBoolArray>& states_to_consider = std::nullopt) {
-        std::vector<State> worklist{};
-        StateBoolArray reachable(nfa.num_of_states(), false);
-        for (const State state: nfa.initial) {
-            if (!states_to_consider.has_value() || states_to_consider.value()[state]) {
-                worklist.push_back(state);
-                reachable.at(state) = true;
-            }
-        }
-
-        State state;
-        while (!worklist.empty()) {
-            state = worklist.back();
-            worklist.pop_back();
-            for (const SymbolPost& move: nfa.delta[state]) {
-                for (const State target_state: move.targets) {
-                    if (!reachable[target_state] &&
-                        (!states_to_consider.has_value() || states_to_consider.value()[target_state])) {
-                        worklist.push_back(target_state);
-                        reachable[target_state] = true;
-                    }
-                }
-            }
-        }
-        return reachable;
-    }
-}
-
 void Nfa::remove_epsilon(const Symbol epsilon)
 {
     *this = mata::nfa::remove_epsilon(*this, epsilon);
 }
 
-StateSet Nfa::get_reachable_states() const {
-    StateBoolArray reachable_bool_array{ reachable_states(*this) };
+StateSet Nfa::get_reachable_states(TraversalWorkspace* workspace) const {
+    TraversalWorkspace local_workspace{};
+    TraversalWorkspace& traversal{ workspace != nullptr ? *workspace : local_workspace };
+    const size_t num_of_states{ this->num_of_states() };
+    traversal.start(num_of_states);
+    for (const State state: initial) {
+        if (traversal.visit(state)) { traversal.stack.push_back(state); }
+    }
+    while (!traversal.stack.empty()) {
+        const State state{ traversal.stack.back() };
+        traversal.stack.pop_back();
+        for (const SymbolPost& move: delta[state]) {
+            for (const State target_state: move.targets) {
+                if (traversal.visit(target_state)) { traversal.stack.push_back(target_state); }
+            }
+        }
+    }
 
     StateSet reachable_states{};
-    const size_t num_of_states{ this->num_of_states() };
     for (State original_state{ 0 }; original_state < num_of_states; ++original_state)
     {
-        if (reachable_bool_array[original_state])
+        if (traversal.is_visited(original_state))
         {
             reachable_states.insert(original_state);
         }
@@ -91,28 +66,46 @@ StateSet Nfa::get_reachable_states() const {
 
 StateSet Nfa::get_terminating_states() const
 {
-    return revert(*this).get_reachable_states();
+    const std::shared_ptr<const ReverseDelta> reverse_delta{ delta.get_reverse_delta() };
+    TraversalWorkspace traversal{};
+    const size_t num_of_states{ this->num_of_states() };
+    traversal.start(num_of_states);
+    for (const State state: final) {
+        if (traversal.visit(state)) { traversal.stack.push_back(state); }
+    }
+    while (!traversal.stack.empty()) {
+        const State state{ traversal.stack.back() };
+        traversal.stack.pop_back();
+        for (const IncomingTransition& transition: (*reverse_delta)[state]) {
+            if (traversal.visit(transition.source)) { traversal.stack.push_back(transition.source); }
+        }
+    }
+
+    StateSet terminating_states{};
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        if (traversal.is_visited(state)) { terminating_states.insert(state); }
+    }
+    return terminating_states;
 }
 
-std::vector<State> Nfa::distances_from_initial() const {
+std::vector<State> Nfa::distances_from_initial(TraversalWorkspace* workspace) const {
+    TraversalWorkspace local_workspace{};
+    TraversalWorkspace& traversal{ workspace != nullptr ? *workspace : local_workspace };
+    traversal.start(num_of_states()+1);
     std::vector<State> distances(num_of_states()+1, Limits::max_state);
-    BoolVector visited(num_of_states()+1, false);
-    std::deque<State> que;
 
     for (State qi: initial) {
-        visited[qi] = true;
+        traversal.visit(qi);
         distances[qi] = 0;
-        que.push_back(qi);
+        traversal.queue.push(qi);
     }
 
-    while (!que.empty()) {
-        State src = que.front();
-        que.pop_front();
+    while (!traversal.queue.empty()) {
+        State src = traversal.queue.pop();
         for (Move move : delta[src].moves()) {
-            if (!visited[move.target]) {
-                visited[move.target] = true;
+            if (traversal.visit(move.target)) {
                 distances[move.target] = distances[src] +1;
-                que.push_back(move.target);
+                traversal.queue.push(move.target);
             }
         }
     }
@@ -121,7 +114,24 @@ std::vector<State> Nfa::distances_from_initial() const {
 }
 
 std::vector<State> Nfa::distances_to_final() const {
-    return revert(*this).distances_from_initial();
+    const std::shared_ptr<const ReverseDelta> reverse_delta{ delta.get_reverse_delta() };
+    std::vector<State> distances(num_of_states()+1, Limits::max_state);
+    std::deque<State> que;
+    for (const State qf: final) {
+        distances[qf] = 0;
+        que.push_back(qf);
+    }
+    while (!que.empty()) {
+        const State tgt = que.front();
+        que.pop_front();
+        for (const IncomingTransition& transition: (*reverse_delta)[tgt]) {
+            if (distances[transition.source] == Limits::max_state) {
+                distances[transition.source] = distances[tgt] + 1;
+                que.push_back(transition.source);
+            }
+        }
+    }
+    return distances;
 }
 
 Run Nfa::get_shortest_accepting_run_from_state(State q, const std::vector<State>& distances_to_final) const {
@@ -139,13 +149,67 @@ Run Nfa::get_shortest_accepting_run_from_state(State q, const std::vector<State>
     return result;
 }
 
-Nfa& Nfa::trim(StateRenaming* state_renaming) {
+std::vector<State> FrozenNfa::distances_to_final() const {
+    // Reverse the transitions (without symbols) into a CSR of predecessors first.
+    const size_t num_of_states{ this->num_of_states() };
+    std::vector<size_t> predecessor_offsets(num_of_states + 1, 0);
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const State target: delta.successors(source)) { ++predecessor_offsets[target + 1]; }
+    }
+    for (size_t i{ 1 }; i <= num_of_states; ++i) { predecessor_offsets[i] += predecessor_offsets[i - 1]; }
+    std::vector<State> predecessors(predecessor_offsets.back());
+    std::vector<size_t> next_predecessor(predecessor_offsets.begin(), predecessor_offsets.end() - 1);
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const State target: delta.successors(source)) { predecessors[next_predecessor[target]++] = source; }
+    }
+
+    std::vector<State> distances(num_of_states + 1, Limits::max_state);
+    std::deque<State> que;
+    for (const State qf: final) {
+        distances[qf] = 0;
+        que.push_back(qf);
+    }
+    while (!que.empty()) {
+        const State tgt = que.front();
+        que.pop_front();
+        for (size_t i{ predecessor_offsets[tgt] }, end{ predecessor_offsets[tgt + 1] }; i < end; ++i) {
+            const State src{ predecessors[i] };
+            if (distances[src] == Limits::max_state) {
+                distances[src] = distances[tgt] + 1;
+                que.push_back(src);
+            }
+        }
+    }
+    return distances;
+}
+
+Run FrozenNfa::get_shortest_accepting_run_from_state(State q, const std::vector<State>& distances_to_final) const {
+    Run result{{}, {q}};
+    while (!final[q]) {
+        bool moved{ false };
+        for (const auto& [symbol, targets]: delta[q]) {
+            for (const State target: targets) {
+                if (distances_to_final[target] < distances_to_final[q]) {
+                    result.word.push_back(symbol);
+                    result.path.push_back(target);
+                    q = target;
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) { break; }
+        }
+    }
+    return result;
+}
+
+Nfa& Nfa::trim(StateRenaming* state_renaming, TraversalWorkspace* workspace) {
 #ifdef _STATIC_STRUCTURES_
     BoolVector useful_states{ useful_states() };
     useful_states.clear();
     useful_states = useful_states();
 #else
-    BoolVector useful_states{ get_useful_states() };
+    BoolVector useful_states{ get_useful_states(workspace) };
 #endif
     const size_t useful_states_size{ useful_states.size() };
     std::vector<State> renaming(useful_states_size);
@@ -182,29 +246,13 @@ namespace {
     // A structure to store metadata related to each state/node during the computation
     // of useful states. It contains Tarjan's metadata and the state of the
     // iteration through the successors.
-    struct TarjanNodeData {
-        StatePost::Moves::const_iterator current_move{};
-        StatePost::Moves::const_iterator end_move{};
-        // index of a node (corresponds to the time of discovery)
-        unsigned long index{ 0 };
-        // index of a lower node in the same SCC
-        unsigned long lowlink{ 0 };
-        // was the node already initialized (=the initial phase of the Tarjan's recursive call was executed)
-        bool initilized{ false };
-        // is node on Tarjan's stack?
-        bool on_stack{ false };
-
-        TarjanNodeData() = default;
-
-        TarjanNodeData(State q, const Delta& delta, unsigned long index)
-            : index(index), lowlink(index), initilized(true), on_stack(true) {
-            const StatePost::Moves moves{ delta[q].moves() };
-            current_move = moves.begin();
-            end_move = moves.end();
-        };
-    };
-};
+    State target_of(const StatePost::Moves::const_iterator& move_it) { return move_it->target; }
+    State target_of(const std::span<const State>::iterator& target_it) { return *target_it; }
 
+    /// Successors of @p q in @c Delta, iterated as moves.
+    StatePost::Moves successors_of(const Nfa& aut, const State q) { return aut.delta[q].moves(); }
+    /// Successors of @p q in @c FrozenDelta, stored in a single contiguous span.
+    std::span<const State> successors_of(const FrozenNfa& aut, const State q) { return aut.delta.successors(q); }
 /**
  * @brief This function employs non-recursive version of Tarjan's algorithm for finding SCCs
  * (see https://en.wikipedia.org/wiki/Tarjan%27s_strongly_connected_components_algorithm, in particular strongconnect(v))
@@ -240,19 +288,25 @@ namespace {
  *    in @p tarjan_stack as it contains states that can reach this closed SCC.
  *
  */
-void Nfa::tarjan_scc_discover(const TarjanDiscoverCallback& callback) const {
-    std::vector<TarjanNodeData> node_info(this->num_of_states());
-    std::vector<State> program_stack;
-    std::vector<State> tarjan_stack;
+template<typename Aut>
+using TarjanBuffersOf = TarjanBuffers<decltype(successors_of(std::declval<const Aut&>(), State{}).begin())>;
+
+template<typename Aut>
+void tarjan_scc_discover(const Aut& aut, const Nfa::TarjanDiscoverCallback& callback, TarjanBuffersOf<Aut>& buffers) {
+    using SuccessorIterator = decltype(successors_of(aut, State{}).begin());
+    buffers.start(aut.num_of_states());
+    std::vector<TarjanNodeData<SuccessorIterator>>& node_info{ buffers.node_info };
+    std::vector<State>& program_stack{ buffers.program_stack };
+    std::vector<State>& tarjan_stack{ buffers.tarjan_stack };
     unsigned long index_cnt = 0;
 
-    for(const State& q0 : initial) {
+    for(const State& q0 : aut.initial) {
         program_stack.push_back(q0);
     }
 
     while(!program_stack.empty()) {
         State act_state = program_stack.back();
-        TarjanNodeData& act_state_data = node_info[act_state];
+        TarjanNodeData<SuccessorIterator>& act_state_data = node_info[act_state];
 
         // if a node is initialized and is not on stack --> skip it; this state was
         // already processed (=this state is initial and was reachable from another initial).
@@ -264,14 +318,14 @@ void Nfa::tarjan_scc_discover(const TarjanDiscoverCallback& callback) const {
         // node has not been initialized yet --> corresponds to the first call of strongconnect(act_state)
         if(!act_state_data.initilized) {
             // initialize node
-            act_state_data = TarjanNodeData(act_state, this->delta, index_cnt++);
+            act_state_data = TarjanNodeData<SuccessorIterator>(successors_of(aut, act_state), index_cnt++);
             tarjan_stack.push_back(act_state);
 
             if(callback.state_discover && callback.state_discover(act_state)) {
                 return;
             }
         } else { // return from the recursive call
-            State act_succ = act_state_data.current_move->target;
+            State act_succ = target_of(act_state_data.current_move);
             act_state_data.lowlink = std::min(act_state_data.lowlink, node_info[act_succ].lowlink);
             // act_succ is the state that cased the recursive call. Move to another successor.
             ++act_state_data.current_move;
@@ -283,7 +337,7 @@ void Nfa::tarjan_scc_discover(const TarjanDiscoverCallback& callback) const {
         // multiple loops, we use rec_call to jump to the main loop
         bool rec_call = false;
         for(; act_state_data.current_move != act_state_data.end_move; ++act_state_data.current_move) {
-            next_state = act_state_data.current_move->target;
+            next_state = target_of(act_state_data.current_move);
             if(callback.succ_state_discover) {
                 callback.succ_state_discover(act_state, next_state);
             }
@@ -300,7 +354,8 @@ void Nfa::tarjan_scc_discover(const TarjanDiscoverCallback& callback) const {
         // check if we have the root of a SCC
         if(act_state_data.lowlink == act_state_data.index) {
             State st;
-            std::vector<State> scc;
+            std::vector<State>& scc{ buffers.scc };
+            scc.clear();
             do {
                 st = tarjan_stack.back();
                 tarjan_stack.pop_back();
@@ -320,13 +375,14 @@ void Nfa::tarjan_scc_discover(const TarjanDiscoverCallback& callback) const {
     }
 }
 
-BoolVector Nfa::get_useful_states() const {
-    BoolVector useful(this->num_of_states(), false);
+template<typename Aut>
+BoolVector get_useful_states(const Aut& aut, TarjanBuffersOf<Aut>& buffers) {
+    BoolVector useful(aut.num_of_states(), false);
     bool final_scc = false;
 
-    TarjanDiscoverCallback callback {};
+    Nfa::TarjanDiscoverCallback callback {};
     callback.state_discover = [&](State state) -> bool {
-        if(this->final.contains(state)) {
+        if(aut.final.contains(state)) {
             useful[state] = true;
         }
         return false;
@@ -356,30 +412,101 @@ BoolVector Nfa::get_useful_states() const {
         }
     };
 
-    tarjan_scc_discover(callback);
+    tarjan_scc_discover(aut, callback, buffers);
     return useful;
 }
 
-bool Nfa::is_lang_empty_scc() const {
+template<typename Aut>
+bool is_lang_empty_scc(const Aut& aut) {
     bool accepting_state = false;
 
-    TarjanDiscoverCallback callback {};
+    Nfa::TarjanDiscoverCallback callback {};
     callback.state_discover = [&](State state) -> bool {
-        if(this->final.contains(state)) {
+        if(aut.final.contains(state)) {
             accepting_state = true;
             return true;
         }
         return false;
     };
 
-    tarjan_scc_discover(callback);
+    TarjanBuffersOf<Aut> buffers{};
+    tarjan_scc_discover(aut, callback, buffers);
     return !accepting_state;
 }
+} // namespace.
+
+void Nfa::tarjan_scc_discover(const TarjanDiscoverCallback& callback) const {
+    TarjanBuffersOf<Nfa> buffers{};
+    ::tarjan_scc_discover(*this, callback, buffers);
+}
+
+BoolVector Nfa::get_useful_states(TraversalWorkspace* workspace) const {
+    if (workspace != nullptr) { return ::get_useful_states(*this, workspace->tarjan); }
+    TarjanBuffersOf<Nfa> buffers{};
+    return ::get_useful_states(*this, buffers);
+}
+
+bool Nfa::is_lang_empty_scc() const { return ::is_lang_empty_scc(*this); }
+
+void FrozenNfa::tarjan_scc_discover(const Nfa::TarjanDiscoverCallback& callback) const {
+    TarjanBuffersOf<FrozenNfa> buffers{};
+    ::tarjan_scc_discover(*this, callback, buffers);
+}
+
+BoolVector FrozenNfa::get_useful_states() const {
+    TarjanBuffersOf<FrozenNfa> buffers{};
+    return ::get_useful_states(*this, buffers);
+}
+
+bool FrozenNfa::is_lang_empty(Run* cex) const {
+    if (cex == nullptr) { return ::is_lang_empty_scc(*this); }
+
+    // 'paths[s] == t' denotes that state 's' was accessed from state 't' over 'symbols[s]',
+    // 'paths[s] == s' means that 's' is an initial state
+    const size_t num_of_states{ this->num_of_states() };
+    std::vector<State> paths(num_of_states, Limits::max_state);
+    std::vector<Symbol> symbols(num_of_states);
+    std::deque<State> worklist{};
+    for (const State q0: initial) {
+        paths[q0] = q0;
+        worklist.push_back(q0);
+    }
+
+    while (!worklist.empty()) {
+        State state{ worklist.front() };
+        worklist.pop_front();
+
+        if (final[state]) {
+            cex->path.clear();
+            cex->word.clear();
+            cex->path.push_back(state);
+            while (paths[state] != state) {
+                cex->word.push_back(symbols[state]);
+                state = paths[state];
+                cex->path.push_back(state);
+            }
+            std::reverse(cex->path.begin(), cex->path.end());
+            std::reverse(cex->word.begin(), cex->word.end());
+            return false;
+        }
+
+        for (const auto& [symbol, targets]: delta[state]) {
+            for (const State target: targets) {
+                if (paths[target] == Limits::max_state) {
+                    paths[target] = state;
+                    symbols[target] = symbol;
+                    worklist.push_back(target);
+                }
+            }
+        }
+    }
+    return true;
+}
 
 bool Nfa::is_acyclic() const {
     bool acyclic = true;
 
-    TarjanDiscoverCallback callback {};
+    Nfa::TarjanDiscoverCallback callback {};
     callback.scc_discover = [&](const std::vector<State>& scc, const std::vector<State>& tarjan_stack) -> bool {
         (void)tarjan_stack;
         if(scc.size() > 1) {
@@ -525,6 +652,10 @@ void Nfa::print_to_mata(const std::string& filename, const Alphabet* alphabet) c
     print_to_mata(output, alphabet);
 }
 
+void Nfa::save_binary(const std::filesystem::path& path, const Alphabet* alphabet) const {
+    binary::save(path, *this, binary::AutomatonKind::NFA, {}, 0, alphabet);
+}
+
 Nfa Nfa::get_one_letter_aut(Symbol abstract_symbol) const {
     Nfa digraph{num_of_states(), initial, final };
     // Add directed transitions for digraph.
@@ -576,10 +707,11 @@ StateSet Nfa::post(const StateSet& states, const Symbol& symbol) const {
 void Nfa::unify_final() {
     if (final.empty() || final.size() == 1) { return; }
     const State new_final_state{ add_state() };
+    // The index describes the transitions before adding the transitions to the new final state.
+    const std::shared_ptr<const ReverseDelta> reverse_delta{ delta.get_reverse_delta() };
     for (const auto& orig_final_state: final) {
-        const auto transitions_to{ delta.get_transitions_to(orig_final_state) };
-        for (const auto& transitions: transitions_to) {
-            delta.add(transitions.source, transitions.symbol, new_final_state);
+        for (const IncomingTransition& transition: (*reverse_delta)[orig_final_state]) {
+            delta.add(transition.source, transition.symbol, new_final_state);
         }
         if (initial[orig_final_state]) { initial.insert(new_final_state); }
     }
@@ -642,6 +774,14 @@ State Nfa::insert_word(const State source, const Word &word, const State target)
 
 State Nfa::insert_word(const State source, const Word &word) { return insert_word(source, word, add_state()); }
 
+size_t FrozenNfa::num_of_states() const {
+    return std::max({
+        static_cast<size_t>(initial.domain_size()),
+        static_cast<size_t>(final.domain_size()),
+        static_cast<size_t>(delta.num_of_states())
+    });
+}
+
 size_t Nfa::num_of_states() const {
     return std::max({
         static_cast<size_t>(initial.domain_size()),
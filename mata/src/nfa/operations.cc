@@ -5,14 +5,19 @@
 #include <list>
 #include <unordered_set>
 #include <iterator>
+#include <numeric>
+#include <thread>
+#include <barrier>
+#include <functional>
+#include <optional>
 
 // MATA headers
 #include "mata/nfa/delta.hh"
 #include "mata/utils/sparse-set.hh"
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/nfa/product.hh"
 #include "mata/nfa/builder.hh"
-#include <mata/simlib/explicit_lts.hh>
 
 using std::tie;
 
@@ -23,50 +28,15 @@ using mata::Symbol;
 using StateBoolArray = std::vector<bool>; ///< Bool array for states in the automaton.
 
 namespace {
-    Simlib::Util::BinaryRelation compute_fw_direct_simulation(const Nfa& aut) {
-        OrdVector<mata::Symbol> used_symbols = aut.delta.get_used_symbols();
-        mata::Symbol unused_symbol = 0;
-        if (!used_symbols.empty() && *used_symbols.begin() == 0) {
-            auto it = used_symbols.begin();
-            unused_symbol = *it + 1;
-            ++it;
-            const auto used_symbols_end = used_symbols.end();
-            while (it != used_symbols_end && unused_symbol == *it) {
-                unused_symbol = *it + 1;
-                ++it;
-            }
-            if (unused_symbol == 0) { // sanity check to see if we did not use the full range of mata::Symbol
-                throw std::runtime_error("all symbols are used, we cannot compute simulation reduction");
-            }
-        }
-
-        const size_t state_num{ aut.num_of_states() };
-        Simlib::ExplicitLTS lts_for_simulation(state_num);
-
-        for (const Transition& transition : aut.delta.transitions()) {
-            lts_for_simulation.add_transition(transition.source, transition.symbol, transition.target);
-        }
-
-        // final states cannot be simulated by nonfinal -> we add new selfloops over final states with new symbol in LTS
-        for (State final_state : aut.final) {
-            lts_for_simulation.add_transition(final_state, unused_symbol, final_state);
-        }
-
-        lts_for_simulation.init();
-        return lts_for_simulation.compute_simulation();
-    }
+    /// Minimal number of states of a DFA for which Hopcroft minimization uses multiple threads, if requested.
+    constexpr size_t HOPCROFT_PARALLEL_MIN_STATES{ 1'000'000 };
 
     Nfa reduce_size_by_simulation(const Nfa& aut, StateRenaming &state_renaming) {
         Nfa result;
-        const auto sim_relation = algorithms::compute_relation(
-                aut, ParameterMap{{ "relation", "simulation"}, { "direction", "forward"}});
-
-        auto sim_relation_symmetric = sim_relation;
-        sim_relation_symmetric.restrict_to_symmetric();
+        const SimulationRelation sim_relation = algorithms::compute_simulation(aut, {{ "direction", "forward" }});
 
         // for State q, quot_proj[q] should be the representative state representing the symmetric class of states in simulation
-        std::vector<size_t> quot_proj;
-        sim_relation_symmetric.get_quotient_projection(quot_proj);
+        const std::vector<size_t> quot_proj = sim_relation.get_quotient_projection();
 
         const size_t num_of_states = aut.num_of_states();
 
@@ -323,7 +293,7 @@ namespace {
                                     std::vector <bool>& covered,                    // flags of covered states
                                     std::vector <bool>& visited,                    // flags fo visited states
                                     size_t start_index,                      // starting index for covering_indexes vec
-                                    std::unordered_map<StateSet, State> *subset_map,    // mapping of indexes to macrostates
+                                    const std::vector <State>& macrostate_states,   // mapping of indexes to states
                                     Nfa& nfa) {
 
         StateSet check_state = macrostate_vec[covering_indexes[start_index]];
@@ -352,21 +322,17 @@ namespace {
 
                 visited[sub_covering_indexes[k]] = true;
 
-                residual_recurse_coverable(macrostate_vec, sub_covering_indexes, covered, visited, k, subset_map, nfa);
+                residual_recurse_coverable(macrostate_vec, sub_covering_indexes, covered, visited, k, macrostate_states, nfa);
             }
 
             covering_set.clear();                 // clear variable to store only needed macrostates
             for (auto index : sub_covering_indexes) {
                 if (covered[index] == 0) {
-                    auto macrostate_ptr = subset_map->find(macrostate_vec[index]);
-                        if (macrostate_ptr == subset_map->end())        // should never happen
-                             throw std::runtime_error(std::to_string(__func__) + " couldn't find expected element in a map.");
-
-                    covering_set.insert(macrostate_ptr->second);
+                    covering_set.insert(macrostate_states[index]);
                 }
             }
 
-            remove_covered_state(covering_set, subset_map->find(check_state)->second, nfa);
+            remove_covered_state(covering_set, macrostate_states[covering_indexes[start_index]], nfa);
             covered[covering_indexes[start_index]] = true;
         }
 
@@ -374,19 +340,26 @@ namespace {
     }
 
     Nfa residual_after(const Nfa&  aut) {
-        std::unordered_map<StateSet, State> subset_map{};
+        MacrostateStore macrostates{};
         Nfa result;
-        result = determinize(aut, &subset_map);
-
+        result = determinize(aut, &macrostates);
+
+        // Macrostate identifiers are the states of the determinized automaton.
+        std::vector <State> macrostate_states(macrostates.size());     // states of macrostates in macrostate_vec
+        std::iota(macrostate_states.begin(), macrostate_states.end(), 0);
+        std::stable_sort(macrostate_states.begin(), macrostate_states.end(),   // order by size from largest to smallest
+                         [&macrostates](const State a, const State b) {
+                             return macrostates.size_of(static_cast<MacrostateId>(a))
+                                    > macrostates.size_of(static_cast<MacrostateId>(b));
+                         });
         std::vector <StateSet> macrostate_vec;              // ordered vector of macrostates
-        macrostate_vec.reserve(subset_map.size());
-        for (const auto& pair: subset_map) {                   // order by size from largest to smallest
-            macrostate_vec.insert(std::upper_bound(macrostate_vec.begin(), macrostate_vec.end(), pair.first,
-                                [](const StateSet & a, const StateSet & b){ return a.size() > b.size(); }), pair.first);
+        macrostate_vec.reserve(macrostates.size());
+        for (const State state: macrostate_states) {
+            macrostate_vec.push_back(macrostates.get_state_set(static_cast<MacrostateId>(state)));
         }
 
-        std::vector <bool> covered(subset_map.size(), false);          // flag of covered states, removed from nfa
-        std::vector <bool> visited(subset_map.size(), false);          // flag of processed state
+        std::vector <bool> covered(macrostates.size(), false);          // flag of covered states, removed from nfa
+        std::vector <bool> visited(macrostates.size(), false);          // flag of processed state
 
         StateSet covering_set;                // doesn't contain duplicates
         std::vector<State> covering_indexes;        // indexes of covering states
@@ -423,21 +396,17 @@ namespace {
 
                     visited[covering_indexes[k]] = true;
 
-                    residual_recurse_coverable(macrostate_vec, covering_indexes, covered, visited, k, &subset_map, result);
+                    residual_recurse_coverable(macrostate_vec, covering_indexes, covered, visited, k, macrostate_states, result);
                 }
 
                 covering_set.clear();                 // clear variable to store only needed macrostates
                 for (auto index : covering_indexes) {
                     if (covered[index] == 0) {
-                        auto macrostate_ptr = subset_map.find(macrostate_vec[index]);
-                        if (macrostate_ptr == subset_map.end())        // should never happen
-                             throw std::runtime_error(std::to_string(__func__) + " couldn't find expected element in a map.");
-
-                        covering_set.insert(macrostate_ptr->second);
+                        covering_set.insert(macrostate_states[index]);
                     }
                 }
 
-                remove_covered_state(covering_set, subset_map.find(macrostate_vec[i])->second, result);
+                remove_covered_state(covering_set, macrostate_states[i], result);
                 covered[i] = true;
             }
         }
@@ -525,65 +494,86 @@ bool mata::nfa::Nfa::make_complete(const OrdVector<Symbol>& symbols, const std::
     return transition_added;
 }
 
-//TODO: based on the comments inside, this function needs to be rewritten in a more optimal way.
-Nfa mata::nfa::remove_epsilon(const Nfa& aut, Symbol epsilon) {
-    // cannot use multimap, because it can contain multiple occurrences of (a -> a), (a -> a)
-    std::unordered_map<State, StateSet> eps_closure;
-
-    // TODO: grossly inefficient
-    // first we compute the epsilon closure
-    const size_t num_of_states{aut.num_of_states() };
-    for (size_t i{ 0 }; i < num_of_states; ++i)
-    {
-        for (const auto& trans: aut.delta[i])
-        { // initialize
-            const auto it_ins_pair = eps_closure.insert({i, {i}});
-            if (trans.symbol == epsilon)
-            {
-                StateSet& closure = it_ins_pair.first->second;
-                // TODO: Fix possibly insert to OrdVector. Create list already ordered, then merge (do not need to resize each time);
-                closure.insert(trans.targets);
+void mata::nfa::algorithms::remove_epsilon(const Nfa& aut, const Symbol epsilon, Nfa& result) {
+    const size_t num_of_states{ aut.num_of_states() };
+    result.delta = Delta{ num_of_states };
+    result.final = aut.final;
+
+    // The graph of epsilon transitions. Its SCCs are discovered from all states with an epsilon transition.
+    Nfa epsilon_graph{ num_of_states };
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        const StatePost& state_post{ aut.delta[state] };
+        const auto epsilon_post_it{ state_post.find(epsilon) };
+        if (epsilon_post_it == state_post.end()) {
+            // Without epsilon transitions, the state keeps its transitions.
+            result.delta.mutable_state_post(state) = state_post;
+            continue;
+        }
+        epsilon_graph.delta.mutable_state_post(state).push_back(*epsilon_post_it);
+        epsilon_graph.initial.insert(state);
+    }
+    if (epsilon_graph.initial.empty()) { return; }
+
+    // Tarjan's algorithm discovers SCCs in a reverse topological order: when an SCC is discovered, all SCCs reachable
+    //  from it were already discovered, and their closure was already propagated into the transitions of their states
+    //  in the result. All states of an SCC share the same epsilon closure, hence the same transitions in the result.
+    constexpr size_t NO_SCC{ std::numeric_limits<size_t>::max() };
+    std::vector<size_t> scc_of_state(num_of_states, NO_SCC);
+    size_t num_of_sccs{ 0 };
+    SynchronizedExistentialSymbolPostIterator synchronized_iterator{};
+    std::vector<State> targets{};
+    std::vector<State> successors{};
+    Nfa::TarjanDiscoverCallback callback{};
+    callback.scc_discover = [&](const std::vector<State>& scc, const std::vector<State>&) -> bool {
+        const size_t scc_id{ num_of_sccs++ };
+        for (const State state: scc) { scc_of_state[state] = scc_id; }
+        if (scc.size() == 1 && !epsilon_graph.initial.contains(scc.front())) { return false; }
+
+        // Merge the transitions of the states in the SCC with the transitions (in the result) of the SCCs reachable
+        //  over a single epsilon transition.
+        synchronized_iterator.reset();
+        bool is_final{ false };
+        successors.clear();
+        for (const State state: scc) {
+            const StatePost& state_post{ aut.delta[state] };
+            synchronized_iterator.push_back(state_post.cbegin(), state_post.cend());
+            is_final = is_final || aut.final.contains(state);
+            for (const State target: epsilon_graph.delta[state].front().targets) {
+                if (scc_of_state[target] != scc_id) { successors.push_back(target); }
             }
         }
-    }
+        // A single state from each successor SCC is enough.
+        std::sort(successors.begin(), successors.end(), [&](const State lhs, const State rhs) {
+            return scc_of_state[lhs] < scc_of_state[rhs];
+        });
+        successors.erase(std::unique(successors.begin(), successors.end(), [&](const State lhs, const State rhs) {
+            return scc_of_state[lhs] == scc_of_state[rhs];
+        }), successors.end());
+        for (const State successor: successors) {
+            const StatePost& state_post{ result.delta[successor] };
+            synchronized_iterator.push_back(state_post.cbegin(), state_post.cend());
+            is_final = is_final || result.final.contains(successor);
+        }
+        StatePost closure_post{};
+        while (synchronized_iterator.advance()) {
+            const Symbol symbol{ synchronized_iterator.get_current_minimum()->symbol };
+            if (symbol == epsilon) { continue; }
+            synchronized_iterator.unify_targets(targets);
+            closure_post.push_back(SymbolPost{ symbol, StateSet{ targets } });
+        }
 
-    bool changed = true;
-    while (changed) { // Compute the fixpoint.
-        changed = false;
-        for (size_t i = 0; i < num_of_states; ++i) {
-            const StatePost& post{ aut.delta[i] };
-            const auto eps_move_it { post.find(epsilon) };//TODO: make faster if default epsilon
-            if (eps_move_it != post.end()) {
-                StateSet& src_eps_cl = eps_closure[i];
-                for (const State tgt: eps_move_it->targets) {
-                    const StateSet& tgt_eps_cl = eps_closure[tgt];
-                    for (const State st: tgt_eps_cl) {
-                        if (src_eps_cl.count(st) == 0) {
-                            changed = true;
-                            break;
-                        }
-                    }
-                    src_eps_cl.insert(tgt_eps_cl);
-                }
-            }
+        for (const State state: scc) {
+            result.delta.mutable_state_post(state) = closure_post;
+            if (is_final) { result.final.insert(state); }
         }
-    }
+        return false;
+    };
+    epsilon_graph.tarjan_scc_discover(callback);
+}
 
-    // Construct the automaton without epsilon transitions.
+Nfa mata::nfa::remove_epsilon(const Nfa& aut, Symbol epsilon) {
     Nfa result{ Delta{}, aut.initial, aut.final, aut.alphabet };
-    for (const auto& state_closure_pair : eps_closure) { // For every state.
-        State src_state = state_closure_pair.first;
-        for (State eps_cl_state : state_closure_pair.second) { // For every state in its epsilon closure.
-            if (aut.final[eps_cl_state]) result.final.insert(src_state);
-            for (const SymbolPost& move : aut.delta[eps_cl_state]) {
-                if (move.symbol == epsilon) continue;
-                // TODO: this could be done more efficiently if we had a better add method
-                for (State tgt_state : move.targets) {
-                    result.delta.add(src_state, move.symbol, tgt_state);
-                }
-            }
-        }
-    }
+    algorithms::remove_epsilon(aut, epsilon, result);
     return result;
 }
 
@@ -767,9 +757,20 @@ Nfa mata::nfa::somewhat_simple_revert(const Nfa& aut) {
 }
 
 Nfa mata::nfa::revert(const Nfa& aut) {
-    return simple_revert(aut);
-    //return fragile_revert(aut);
-    //return somewhat_simple_revert(aut);
+    // The predecessors of each state are sorted by the symbol and then by the source, hence they form the state post
+    //  of the state in the reverted automaton directly.
+    const std::shared_ptr<const ReverseDelta> reverse_delta{ aut.delta.get_reverse_delta() };
+    Delta reverted_delta(aut.num_of_states());
+    for (State target{ 0 }, num_of_states{ reverse_delta->num_of_states() }; target < num_of_states; ++target) {
+        StatePost& state_post{ reverted_delta.mutable_state_post(target) };
+        for (const IncomingTransition& transition: (*reverse_delta)[target]) {
+            if (state_post.empty() || state_post.back().symbol != transition.symbol) {
+                state_post.push_back(SymbolPost(transition.symbol));
+            }
+            state_post.back().targets.push_back(transition.source);
+        }
+    }
+    return Nfa{ std::move(reverted_delta), aut.final, aut.initial };
 }
 
 bool mata::nfa::Nfa::is_deterministic() const {
@@ -869,55 +870,34 @@ bool mata::nfa::Nfa::is_prfx_in_lang(const Run& run) const {
     return this->final.intersects_with(current_post);
 }
 
-bool mata::nfa::Nfa::is_lang_empty(Run* cex) const {
-    //TOOD: hot fix for performance reasons for TACAS.
-    // Perhaps make the get_useful_states return a witness on demand somehow.
-    if (!cex) {
-        return is_lang_empty_scc();
-    }
-
-    std::list<State> worklist(initial.begin(), initial.end());
-    std::unordered_set<State> processed(initial.begin(), initial.end());
-
-    // 'paths[s] == t' denotes that state 's' was accessed from state 't',
-    // 'paths[s] == s' means that 's' is an initial state
-    std::map<State, State> paths;
-    // Initialize paths.
-    for (const State s: worklist) { paths[s] = s; }
-
-    State state;
-    while (!worklist.empty()) {
-        state = worklist.front();
-        worklist.pop_front();
+bool mata::nfa::Nfa::is_lang_empty(Run* cex, TraversalWorkspace* workspace) const {
+    TraversalWorkspace local_workspace{};
+    TraversalWorkspace& traversal{ workspace != nullptr ? *workspace : local_workspace };
+    traversal.start(num_of_states());
 
-        if (final[state]) {
-            if (nullptr != cex) {
-                cex->path.clear();
-                cex->path.push_back(state);
-                while (paths[state] != state) {
-                    state = paths[state];
-                    cex->path.push_back(state);
-                }
-                std::reverse(cex->path.begin(), cex->path.end());
-                cex->word = this->get_word_for_path(*cex).first.word;
-            }
+    // Final states are checked when discovered, hence the run to the first discovered final state is the shortest.
+    for (const State initial_state: initial) {
+        if (!traversal.visit_root(initial_state)) { continue; }
+        if (final[initial_state]) {
+            if (nullptr != cex) { traversal.get_run_to(initial_state, *cex); }
             return false;
         }
+        traversal.queue.push(initial_state);
+    }
 
-        if (delta.empty()) { continue; }
-
+    while (!traversal.queue.empty()) {
+        const State state{ traversal.queue.pop() };
         for (const SymbolPost& symbol_post: delta[state]) {
-            for (const State& target: symbol_post.targets) {
-                bool inserted;
-                tie(std::ignore, inserted) = processed.insert(target);
-                if (inserted) {
-                    worklist.push_back(target);
-                    // Also set that tgt_state was accessed from state.
-                    paths[target] = state;
-                } else { assert(haskey(paths, target)); /* Invariant. */ }
+            for (const State target: symbol_post.targets) {
+                if (!traversal.visit(target, state, symbol_post.symbol)) { continue; }
+                if (final[target]) {
+                    if (nullptr != cex) { traversal.get_run_to(target, *cex); }
+                    return false;
+                }
+                traversal.queue.push(target);
             }
         }
-    } // while (!worklist.empty()).
+    } // while (!traversal.queue.empty()).
     return true;
 } // is_lang_empty().
 
@@ -927,13 +907,48 @@ Nfa mata::nfa::algorithms::minimize_brzozowski(const Nfa& aut) {
     return determinize(revert(determinize(revert(aut))));
 }
 
+size_t mata::nfa::algorithms::get_num_of_threads(const std::string& function_name, const ParameterMap& params) {
+    if (!haskey(params, "threads")) { return 1; }
+    const std::string& str_threads = params.at("threads");
+    size_t num_of_threads;
+    try {
+        num_of_threads = std::stoul(str_threads);
+    } catch (const std::logic_error&) {
+        throw std::runtime_error(function_name + " received an invalid value of the \"threads\" key: " + str_threads);
+    }
+    if (num_of_threads == 0) { num_of_threads = std::max(std::thread::hardware_concurrency(), 1U); }
+    return num_of_threads;
+}
+
+size_t mata::nfa::algorithms::get_bit_state_set_threshold(const std::string& function_name,
+                                                          const ParameterMap& params) {
+    if (!haskey(params, "bit_state_set_threshold")) { return DEFAULT_BIT_STATE_SET_THRESHOLD; }
+    const std::string& str_threshold = params.at("bit_state_set_threshold");
+    try {
+        return std::stoul(str_threshold);
+    } catch (const std::logic_error&) {
+        throw std::runtime_error(function_name + " received an invalid value of the \"bit_state_set_threshold\" key: "
+                                 + str_threshold);
+    }
+}
+
+bool mata::nfa::algorithms::use_simulation(const std::string& function_name, const ParameterMap& params) {
+    if (!haskey(params, "simulation")) { return false; }
+    const std::string& str_simulation = params.at("simulation");
+    if ("forward" != str_simulation) {
+        throw std::runtime_error(function_name + " received an unknown value of the \"simulation\" key: " +
+                                 str_simulation);
+    }
+    return true;
+}
+
 Nfa mata::nfa::minimize(
                 const Nfa& aut,
                 const ParameterMap& params)
 {
     Nfa result;
     // setting the default algorithm
-    decltype(algorithms::minimize_brzozowski)* algo = algorithms::minimize_brzozowski;
+    std::function<Nfa(const Nfa&)> algo = algorithms::minimize_brzozowski;
     if (!haskey(params, "algorithm")) {
         throw std::runtime_error(std::to_string(__func__) +
             " requires setting the \"algorithm\" key in the \"params\" argument; "
@@ -942,7 +957,17 @@ Nfa mata::nfa::minimize(
 
     const std::string& str_algo = params.at("algorithm");
     if ("brzozowski" == str_algo) {  /* default */ }
-    else {
+    else if ("hopcroft" == str_algo) {
+        const size_t num_of_threads{ algorithms::get_num_of_threads(std::to_string(__func__), params) };
+        algo = [num_of_threads](const Nfa& aut) {
+            Nfa dfa{ aut.is_deterministic() ? aut : determinize(aut) };
+            dfa.trim();
+            if (num_of_threads > 1 && dfa.num_of_states() > HOPCROFT_PARALLEL_MIN_STATES) {
+                return algorithms::minimize_hopcroft_parallel(dfa, num_of_threads);
+            }
+            return algorithms::minimize_hopcroft(dfa);
+        };
+    } else {
         throw std::runtime_error(std::to_string(__func__) +
             " received an unknown value of the \"algorithm\" key: " + str_algo);
     }
@@ -1172,10 +1197,109 @@ public:
         }
     }
 };
-} // namespace
 
+/// Minimal number of elements to mark for which the marking is distributed among multiple threads.
+constexpr size_t PARALLEL_MARKING_MIN_ELEMENTS{ 1 << 14 };
 
-Nfa mata::nfa::algorithms::minimize_hopcroft(const Nfa& dfa_trimmed) {
+/**
+ * @brief Threads running a task together, created once and reused for each task.
+ *
+ * The pool has @c num_of_threads - 1 worker threads, the calling thread takes part in each task as the worker with
+ *  index 0. The workers wait on a barrier between the tasks, hence running a task does not create any thread.
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(const size_t num_of_threads)
+        : task_started_{ static_cast<std::ptrdiff_t>(num_of_threads) },
+          task_finished_{ static_cast<std::ptrdiff_t>(num_of_threads) } {
+        threads_.reserve(num_of_threads - 1);
+        for (size_t thread_idx = 1; thread_idx < num_of_threads; ++thread_idx) {
+            threads_.emplace_back([this, thread_idx]() {
+                while (true) {
+                    task_started_.arrive_and_wait();
+                    if (stopped_) { return; }
+                    task_(thread_idx);
+                    task_finished_.arrive_and_wait();
+                }
+            });
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        stopped_ = true;
+        task_started_.arrive_and_wait();
+        // The threads are joined by the destructors of std::jthread.
+    }
+
+    size_t num_of_threads() const { return threads_.size() + 1; }
+
+    /// Run @p task with indices <tt>0, ..., num_of_threads() - 1</tt>, each in its own thread, and wait for all.
+    void run(std::function<void(size_t)> task) {
+        task_ = std::move(task);
+        task_started_.arrive_and_wait();
+        task_(0);
+        task_finished_.arrive_and_wait();
+    }
+
+private:
+    std::function<void(size_t)> task_{};
+    /// Set before the last start of a task, which makes the workers exit. Synchronized by @c task_started_.
+    bool stopped_{ false };
+    std::barrier<> task_started_;
+    std::barrier<> task_finished_;
+    /// Declared last so that the threads are joined before the barriers are destroyed.
+    std::vector<std::jthread> threads_{};
+};
+
+/**
+ * @brief Mark elements of @p partition using multiple threads.
+ *
+ * The elements enumerated by @p for_each_element are split into equal ranges, one for each thread. Each thread
+ *  distributes the elements of its range into buckets by the threads owning their sets (by the set index modulo the
+ *  number of threads). After all threads finish the distribution, each thread marks the elements of its buckets.
+ *  Marking modifies only the part of the partition belonging to the set of the marked element, hence the threads
+ *  never modify the same memory.
+ *
+ * @param[in] workers Threads to mark with.
+ * @param[in] for_each_element Callable which calls its argument on each element to mark.
+ * @param[out] touched_sets Sets with no marks before the marking, for each thread of @p workers.
+ */
+template<typename T, typename ForEachElement>
+void mark_in_parallel(WorkerPool& workers, RefinablePartition<T>& partition, const ForEachElement& for_each_element,
+                      std::vector<std::vector<size_t>>& touched_sets) {
+    const size_t num_of_threads = workers.num_of_threads();
+    assert(touched_sets.size() == num_of_threads);
+    // The elements of a set are linked one after another, hence they are enumerated by a single thread.
+    std::vector<T> elements{};
+    for_each_element([&](const T e) { elements.push_back(e); });
+    // Bucket of the elements for the owning thread (first index) from the range of a thread (second index).
+    std::vector<std::vector<std::vector<T>>> buckets(num_of_threads, std::vector<std::vector<T>>(num_of_threads));
+    std::barrier distributed{ static_cast<std::ptrdiff_t>(num_of_threads) };
+    workers.run([&](const size_t thread_idx) {
+        const size_t range_begin{ elements.size() * thread_idx / num_of_threads };
+        const size_t range_end{ elements.size() * (thread_idx + 1) / num_of_threads };
+        for (size_t element_idx{ range_begin }; element_idx < range_end; ++element_idx) {
+            const T e = elements[element_idx];
+            buckets[partition.set_idx[e] % num_of_threads][thread_idx].push_back(e);
+        }
+        distributed.arrive_and_wait();
+
+        std::vector<size_t>& thread_touched_sets = touched_sets[thread_idx];
+        for (const std::vector<T>& bucket : buckets[thread_idx]) {
+            for (const T e : bucket) {
+                const size_t e_set = partition.set_idx[e];
+                if (partition.has_no_marks(e_set)) { thread_touched_sets.push_back(e_set); }
+                partition.mark(e);
+            }
+        }
+    });
+}
+
+Nfa minimize_hopcroft(const Nfa& dfa_trimmed, const size_t num_of_threads) {
+    assert(num_of_threads > 0);
     if (dfa_trimmed.delta.num_of_transitions() == 0) {
         // The automaton is trivially minimal.
         return Nfa{ dfa_trimmed };
@@ -1193,19 +1317,29 @@ Nfa mata::nfa::algorithms::minimize_hopcroft(const Nfa& dfa_trimmed) {
     // Initialize vector of incoming transitions for each state. Transitions
     // are represented only by their indices in the (flattened) delta.
     // Initialize mapping from transition index to its source state.
+    // Incoming transitions of states are taken from the reverse index of delta, which numbers the transitions in the
+    //  same order.
     std::vector<State> trans_source_map(trp.size());
-    std::vector<std::vector<size_t>> incomming_trans_idxs(brp.size(), std::vector<size_t>());
-    size_t trans_idx = 0;
-    for (const auto &trans : dfa_trimmed.delta.transitions()) {
-        trans_source_map[trans_idx] = trans.source;
-        incomming_trans_idxs[trans.target].push_back(trans_idx);
-        ++trans_idx;
+    const std::shared_ptr<const ReverseDelta> reverse_delta{ dfa_trimmed.delta.get_reverse_delta() };
+    for (State q{ 0 }, num_of_states{ reverse_delta->num_of_states() }; q < num_of_states; ++q) {
+        for (const IncomingTransition& trans : (*reverse_delta)[q]) { trans_source_map[trans.index] = trans.source; }
     }
 
     // Worklists for the Hopcroft algorithm.
     std::stack<size_t> unready_spls;    // Splitters that will be used in the backpropagation.
     std::stack<size_t> touched_blocks;  // Blocks (equivalence classes) touched during backpropagation.
     std::stack<size_t> touched_spls;    // Splitters touched (in the split_block function) as a result of backpropagation.
+    // Threads for the parallel marking, created once for all marking rounds.
+    std::optional<WorkerPool> workers{};
+    if (num_of_threads > 1) { workers.emplace(num_of_threads); }
+    // Blocks or splitters touched by each thread during parallel marking.
+    std::vector<std::vector<size_t>> touched_sets(num_of_threads);
+    auto push_touched_sets = [&](std::stack<size_t>& touched) {
+        for (std::vector<size_t>& thread_touched_sets : touched_sets) {
+            for (const size_t set_idx : thread_touched_sets) { touched.push(set_idx); }
+            thread_touched_sets.clear();
+        }
+    };
 
     /**
      * @brief Split the block (equivalence class) according to the marked states.
@@ -1226,14 +1360,24 @@ Nfa mata::nfa::algorithms::minimize_hopcroft(const Nfa& dfa_trimmed) {
         }
         // Split the transitions of the splitters according to the new partitioning.
         // Transitions in one splitter must have the same symbol and go to the same block.
-        for (State q = brp.get_first(b_prime); q != RefinablePartition<State>::NO_MORE_ELEMENTS; q = brp.get_next(q)) {
-            for (const size_t trans_idx : incomming_trans_idxs[q]) {
-                const size_t splitter_idx = trp.set_idx[trans_idx];
-                if (trp.has_no_marks(splitter_idx)) {
-                    touched_spls.push(splitter_idx);
+        if (num_of_threads > 1 && brp.size_of_set(b_prime) >= PARALLEL_MARKING_MIN_ELEMENTS) {
+            mark_in_parallel(*workers, trp, [&](const auto& mark) {
+                for (State q = brp.get_first(b_prime); q != RefinablePartition<State>::NO_MORE_ELEMENTS; q = brp.get_next(q)) {
+                    for (const IncomingTransition& trans : (*reverse_delta)[q]) { mark(trans.index); }
+                }
+            }, touched_sets);
+            push_touched_sets(touched_spls);
+        } else {
+            for (State q = brp.get_first(b_prime); q != RefinablePartition<State>::NO_MORE_ELEMENTS; q = brp.get_next(q)) {
+                for (const IncomingTransition& trans : (*reverse_delta)[q]) {
+                    const size_t trans_idx{ trans.index };
+                    const size_t splitter_idx = trp.set_idx[trans_idx];
+                    if (trp.has_no_marks(splitter_idx)) {
+                        touched_spls.push(splitter_idx);
+                    }
+                    // Mark the transition in the splitter and move it to the first half of the set.
+                    trp.mark(trans_idx);
                 }
-                // Mark the transition in the splitter and move it to the first half of the set.
-                trp.mark(trans_idx);
             }
         }
         // Refine all splitters where some transitions were marked.
@@ -1266,13 +1410,22 @@ Nfa mata::nfa::algorithms::minimize_hopcroft(const Nfa& dfa_trimmed) {
         // Backpropagation.
         // Fire back all transitions of the splitter. (Transitions over the same
         // symbol that go to the same block.) Mark the source states of these transitions.
-        for (size_t trans_idx = trp.get_first(splitter_idx); trans_idx != RefinablePartition<size_t>::NO_MORE_ELEMENTS; trans_idx = trp.get_next(trans_idx)) {
-            const State q = trans_source_map[trans_idx];
-            const size_t b_prime = brp.set_idx[q];
-            if (brp.has_no_marks(b_prime)) {
-                touched_blocks.push(b_prime);
+        if (num_of_threads > 1 && trp.size_of_set(splitter_idx) >= PARALLEL_MARKING_MIN_ELEMENTS) {
+            mark_in_parallel(*workers, brp, [&](const auto& mark) {
+                for (size_t trans_idx = trp.get_first(splitter_idx); trans_idx != RefinablePartition<size_t>::NO_MORE_ELEMENTS; trans_idx = trp.get_next(trans_idx)) {
+                    mark(trans_source_map[trans_idx]);
+                }
+            }, touched_sets);
+            push_touched_sets(touched_blocks);
+        } else {
+            for (size_t trans_idx = trp.get_first(splitter_idx); trans_idx != RefinablePartition<size_t>::NO_MORE_ELEMENTS; trans_idx = trp.get_next(trans_idx)) {
+                const State q = trans_source_map[trans_idx];
+                const size_t b_prime = brp.set_idx[q];
+                if (brp.has_no_marks(b_prime)) {
+                    touched_blocks.push(b_prime);
+                }
+                brp.mark(q);
             }
-            brp.mark(q);
         }
         // Try to split the blocks touched during the backpropagation.
         // The block will be split only if some states (not all) were touched (marked).
@@ -1301,6 +1454,15 @@ Nfa mata::nfa::algorithms::minimize_hopcroft(const Nfa& dfa_trimmed) {
 
     return result;
 }
+} // namespace
+
+Nfa mata::nfa::algorithms::minimize_hopcroft(const Nfa& dfa_trimmed) {
+    return ::minimize_hopcroft(dfa_trimmed, 1);
+}
+
+Nfa mata::nfa::algorithms::minimize_hopcroft_parallel(const Nfa& dfa_trimmed, const size_t num_of_threads) {
+    return ::minimize_hopcroft(dfa_trimmed, num_of_threads);
+}
 
 
 Nfa mata::nfa::intersection(const Nfa& lhs, const Nfa& rhs, const Symbol first_epsilon, std::unordered_map<std::pair<State, State>, State>  *prod_map) {
@@ -1312,7 +1474,25 @@ Nfa mata::nfa::intersection(const Nfa& lhs, const Nfa& rhs, const Symbol first_e
     if (lhs.final.empty() || lhs.initial.empty() || rhs.initial.empty() || rhs.final.empty())
         return Nfa{};
 
-    return algorithms::product(lhs, rhs, both_final, first_epsilon, prod_map);
+    return algorithms::compute_product(lhs, rhs, both_final, prod_map, algorithms::SingleLevel{},
+                                       algorithms::FirstEpsilon{ first_epsilon });
+}
+
+Nfa mata::nfa::intersection(const std::span<const Nfa> automata, const Symbol first_epsilon) {
+    if (automata.empty()) {
+        throw std::runtime_error(std::to_string(__func__) + " requires at least one automaton");
+    }
+    for (const Nfa& aut: automata) {
+        if (aut.initial.empty() || aut.final.empty()) { return Nfa{}; }
+    }
+
+    auto all_final = [&](const std::span<const State> tuple) {
+        for (size_t operand{ 0 }, num_of_operands{ automata.size() }; operand < num_of_operands; ++operand) {
+            if (!automata[operand].final.contains(tuple[operand])) { return false; }
+        }
+        return true;
+    };
+    return algorithms::product(automata, all_final, first_epsilon);
 }
 
 Nfa mata::nfa::union_product(const Nfa &lhs, const Nfa &rhs, const Symbol first_epsilon, std::unordered_map<std::pair<State,State>,State> *prod_map) {
@@ -1322,7 +1502,8 @@ Nfa mata::nfa::union_product(const Nfa &lhs, const Nfa &rhs, const Symbol first_
 
     if (lhs.final.empty() || lhs.initial.empty()) { return rhs; }
     if (rhs.final.empty() || rhs.initial.empty()) { return lhs; }
-    return algorithms::product(lhs, rhs, one_final, first_epsilon, prod_map);
+    return algorithms::compute_product(lhs, rhs, one_final, prod_map, algorithms::SingleLevel{},
+                                       algorithms::FirstEpsilon{ first_epsilon });
 }
 
 Nfa mata::nfa::union_nondet(const Nfa &lhs, const Nfa &rhs) { return Nfa{ lhs }.unite_nondet_with(rhs); }
@@ -1340,9 +1521,8 @@ Simlib::Util::BinaryRelation mata::nfa::algorithms::compute_relation(const Nfa&
     }
 
     const std::string& relation = params.at("relation");
-    const std::string& direction = params.at("direction");
-    if ("simulation" == relation && direction == "forward") {
-        return compute_fw_direct_simulation(aut);
+    if ("simulation" == relation) {
+        return compute_simulation(aut, params).to_binary_relation();
     }
     else {
         throw std::runtime_error(std::to_string(__func__) +
@@ -1396,12 +1576,25 @@ Nfa mata::nfa::reduce(const Nfa &aut, StateRenaming *state_renaming, const Param
 Nfa mata::nfa::determinize(
     const Nfa&  aut, std::unordered_map<StateSet, State>* subset_map,
     std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover
+) {
+    if (subset_map == nullptr) { return determinize(aut, static_cast<MacrostateStore*>(nullptr), macrostate_discover); }
+    MacrostateStore macrostates{};
+    Nfa result{ determinize(aut, &macrostates, macrostate_discover) };
+    macrostates.fill_subset_map(*subset_map);
+    return result;
+}
+
+Nfa mata::nfa::determinize(
+    const Nfa&  aut, MacrostateStore* macrostates,
+    std::optional<std::function<bool(const Nfa&, const State, const StateSet&)>> macrostate_discover,
+    const size_t bit_state_set_threshold
 ) {
     Nfa result{};
-    //assuming all sets targets are non-empty
-    std::vector<std::pair<State, StateSet>> worklist{};
-    std::unordered_map<StateSet, State> subset_map_local{};
-    if (subset_map == nullptr) { subset_map = &subset_map_local; }
+    MacrostateStore macrostates_local{};
+    if (macrostates == nullptr) { macrostates = &macrostates_local; }
+    macrostates->clear();
+    // Macrostate identifiers are the states of the result, hence the worklist holds only the identifiers.
+    std::vector<MacrostateId> worklist{};
 
     const StateSet S0{ aut.initial };
     const State S0id{ result.add_state() };
@@ -1410,51 +1603,102 @@ Nfa mata::nfa::determinize(
     if (aut.final.intersects_with(S0)) {
         result.final.insert(S0id);
     }
-    worklist.emplace_back(S0id, S0);
-    (*subset_map)[mata::utils::OrdVector<State>(S0)] = S0id;
+    worklist.push_back(macrostates->insert(S0).first);
+    assert(worklist.back() == S0id);
     if (aut.delta.empty()) { return result; }
     if (macrostate_discover.has_value() && !(*macrostate_discover)(result, S0id, S0)) { return result; }
 
-    using Iterator = mata::utils::OrdVector<SymbolPost>::const_iterator;
     SynchronizedExistentialSymbolPostIterator synchronized_iterator;
+    std::vector<State> T{}; // Buffer for the targets of the current symbol, reused for all symbols.
+    // For small automata, targets of multiple symbol posts are united in a bitset instead of being sorted.
+    const bool use_bits{ use_bit_state_sets(aut.num_of_states(), bit_state_set_threshold) };
+    BitStateSet T_bits{ use_bits ? aut.num_of_states() : 0 };
 
     while (!worklist.empty()) {
-        const auto Spair = worklist.back();
+        const State Sid{ worklist.back() };
         worklist.pop_back();
-        const StateSet S = Spair.second;
-        const State Sid = Spair.first;
-        if (S.empty()) {
+        if (macrostates->size_of(static_cast<MacrostateId>(Sid)) == 0) {
             // This should not happen assuming all sets targets are non-empty.
             break;
         }
 
         // add moves of S to the sync ex iterator
+        // The view of S is invalidated by insertions into the store below, but it is needed only here.
         synchronized_iterator.reset();
-        for (State q: S) {
+        for (State q: (*macrostates)[static_cast<MacrostateId>(Sid)]) {
             mata::utils::push_back(synchronized_iterator, aut.delta[q]);
         }
 
         while (synchronized_iterator.advance()) {
             // extract post from the synchronized_iterator iterator
-            const std::vector<Iterator>& symbol_posts = synchronized_iterator.get_current();
-            Symbol currentSymbol = (*symbol_posts.begin())->symbol;
-            StateSet T = synchronized_iterator.unify_targets();
-
-            const auto existingTitr = subset_map->find(T);
-            State Tid;
-            if (existingTitr != subset_map->end()) {
-                Tid = existingTitr->second;
+            const std::vector<StatePost::const_iterator>& symbol_posts{ synchronized_iterator.get_current() };
+            const Symbol currentSymbol = (*symbol_posts.begin())->symbol;
+            if (use_bits && symbol_posts.size() > 1) {
+                for (const StatePost::const_iterator& symbol_post_it: symbol_posts) {
+                    T_bits.insert(symbol_post_it->targets);
+                }
+                T_bits.to_vector(T);
+                for (const State state: T) { T_bits.erase(state); } // Cheaper than clearing all blocks.
             } else {
-                Tid = result.add_state();
-                (*subset_map)[mata::utils::OrdVector<State>(T)] = Tid;
+                synchronized_iterator.unify_targets(T);
+            }
+
+            const auto [Tid, is_new_macrostate] = macrostates->insert(T);
+            if (is_new_macrostate) {
+                [[maybe_unused]] const State new_state{ result.add_state() };
+                assert(new_state == Tid);
+                if (aut.final.intersects_with(T)) {
+                    result.final.insert(Tid);
+                }
+                worklist.push_back(Tid);
+            }
+            // Symbols are advanced to in an ascending order, the symbol post can be appended.
+            result.delta.mutable_state_post(Sid).emplace_back(currentSymbol, Tid);
+            if (macrostate_discover.has_value() && is_new_macrostate
+                && !(*macrostate_discover)(result, Tid, StateSet{ T })) { return result; }
+        }
+    }
+    return result;
+}
+
+Nfa mata::nfa::determinize(const FrozenNfa& aut, MacrostateStore* macrostates) {
+    Nfa result{};
+    MacrostateStore macrostates_local{};
+    if (macrostates == nullptr) { macrostates = &macrostates_local; }
+    macrostates->clear();
+    std::vector<MacrostateId> worklist{};
+
+    const StateSet S0{ aut.initial };
+    const State S0id{ result.add_state() };
+    result.initial.insert(S0id);
+    if (aut.final.intersects_with(S0)) {
+        result.final.insert(S0id);
+    }
+    worklist.push_back(macrostates->insert(S0).first);
+    if (aut.delta.empty()) { return result; }
+
+    SynchronizedExistentialFrozenSymbolIterator synchronized_iterator{ aut.delta };
+    std::vector<State> T{};
+    while (!worklist.empty()) {
+        const State Sid{ worklist.back() };
+        worklist.pop_back();
+
+        synchronized_iterator.reset();
+        for (State q: (*macrostates)[static_cast<MacrostateId>(Sid)]) { synchronized_iterator.push_back(q); }
+
+        while (synchronized_iterator.advance()) {
+            const Symbol currentSymbol{ synchronized_iterator.get_current_symbol() };
+            synchronized_iterator.unify_targets(T);
+
+            const auto [Tid, is_new_macrostate] = macrostates->insert(T);
+            if (is_new_macrostate) {
+                result.add_state();
                 if (aut.final.intersects_with(T)) {
                     result.final.insert(Tid);
                 }
-                worklist.emplace_back(Tid, T);
+                worklist.push_back(Tid);
             }
-            result.delta.mutable_state_post(Sid).insert(SymbolPost(currentSymbol, Tid));
-            if (macrostate_discover.has_value() && existingTitr == subset_map->end()
-                && !(*macrostate_discover)(result, Tid, T)) { return result; }
+            result.delta.mutable_state_post(Sid).emplace_back(currentSymbol, Tid);
         }
     }
     return result;
@@ -0,0 +1,224 @@
+/* product-view.cc -- Lazy (on-the-fly) product of NFAs.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#include "mata/nfa/product-view.hh"
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/utils/utils.hh"
+
+using namespace mata::nfa;
+using mata::Symbol;
+
+ProductView::ProductView(std::vector<const Nfa*> operands): operands_{ std::move(operands) } {
+    if (operands_.empty()) {
+        throw std::runtime_error(std::to_string(__func__) + " requires at least one operand");
+    }
+
+    // Discover all tuples of initial states.
+    std::vector<State> tuple(operands_.size());
+    std::vector<State> initial_states{};
+    auto discover_initial = [&](auto& self, const size_t operand) -> void {
+        if (operand == operands_.size()) {
+            initial_states.push_back(intern(tuple));
+            return;
+        }
+        for (const State state: operands_[operand]->initial) {
+            tuple[operand] = state;
+            self(self, operand + 1);
+        }
+    };
+    discover_initial(discover_initial, 0);
+    mata::utils::sort_and_rmdupl(initial_states);
+    initial_ = StateSet{ initial_states };
+}
+
+State ProductView::intern(const std::span<const State> tuple) {
+    const auto [id, inserted]{ tuples_.insert(tuple) };
+    if (inserted) { post_index_.push_back(NO_POST); }
+    return id;
+}
+
+bool ProductView::is_final(const State state) const {
+    const std::span<const State> tuple{ get_tuple(state) };
+    for (size_t operand{ 0 }, num_of_operands{ operands_.size() }; operand < num_of_operands; ++operand) {
+        if (!operands_[operand]->final.contains(tuple[operand])) { return false; }
+    }
+    return true;
+}
+
+const StatePost& ProductView::post(const State state) {
+    if (post_index_[state] != NO_POST) { return posts_[post_index_[state]]; }
+
+    const size_t num_of_operands{ operands_.size() };
+    // Copy the tuple out of the store, new tuples are interned below.
+    const std::span<const State> state_tuple{ get_tuple(state) };
+    const std::vector<State> source_tuple(state_tuple.begin(), state_tuple.end());
+
+    StatePost state_post{};
+    std::vector<const StateSet*> operand_targets(num_of_operands);
+    std::vector<State> target_tuple(num_of_operands);
+    std::vector<State> targets{};
+    auto discover_targets = [&](auto& self, const size_t operand) -> void {
+        if (operand == num_of_operands) {
+            targets.push_back(intern(target_tuple));
+            return;
+        }
+        for (const State target: *operand_targets[operand]) {
+            target_tuple[operand] = target;
+            self(self, operand + 1);
+        }
+    };
+    for (const SymbolPost& symbol_post: operands_[0]->delta[source_tuple[0]]) {
+        operand_targets[0] = &symbol_post.targets;
+        bool is_synchronized{ true };
+        for (size_t operand{ 1 }; operand < num_of_operands; ++operand) {
+            const StatePost& operand_post{ operands_[operand]->delta[source_tuple[operand]] };
+            const auto operand_symbol_post_it{ operand_post.find(symbol_post.symbol) };
+            if (operand_symbol_post_it == operand_post.end()) { is_synchronized = false; break; }
+            operand_targets[operand] = &operand_symbol_post_it->targets;
+        }
+        if (!is_synchronized) { continue; }
+
+        targets.clear();
+        discover_targets(discover_targets, 0);
+        mata::utils::sort_and_rmdupl(targets);
+        state_post.push_back(SymbolPost{ symbol_post.symbol, StateSet{ targets } });
+    }
+
+    post_index_[state] = posts_.size();
+    posts_.push_back(std::move(state_post));
+    return posts_.back();
+}
+
+bool ProductView::is_lang_empty(Run* cex) {
+    // Breadth-first search, remembering for each reached state the state and the symbol it was reached from.
+    std::unordered_map<State, std::pair<State, Symbol>> predecessors{};
+    std::deque<State> worklist{};
+    for (const State state: initial_) {
+        predecessors.emplace(state, std::make_pair(state, Symbol{ 0 }));
+        worklist.push_back(state);
+    }
+    while (!worklist.empty()) {
+        const State state{ worklist.front() };
+        worklist.pop_front();
+        if (is_final(state)) {
+            if (cex != nullptr) {
+                cex->word.clear();
+                cex->path = { state };
+                for (State current{ state }; predecessors.at(current).first != current;) {
+                    const auto& [predecessor, symbol]{ predecessors.at(current) };
+                    cex->word.push_back(symbol);
+                    cex->path.push_back(predecessor);
+                    current = predecessor;
+                }
+                std::reverse(cex->word.begin(), cex->word.end());
+                std::reverse(cex->path.begin(), cex->path.end());
+            }
+            return false;
+        }
+        for (const SymbolPost& symbol_post: post(state)) {
+            for (const State target: symbol_post.targets) {
+                if (predecessors.emplace(target, std::make_pair(state, symbol_post.symbol)).second) {
+                    worklist.push_back(target);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+std::optional<mata::Word> ProductView::get_shortest_word() {
+    Run run{};
+    if (is_lang_empty(&run)) { return std::nullopt; }
+    return run.word;
+}
+
+bool mata::nfa::algorithms::is_included_antichains(ProductView& smaller, ProductView& bigger, Run* cex) {
+    /// Parent of initial nodes.
+    constexpr size_t NO_PARENT{ std::numeric_limits<size_t>::max() };
+    // Product state of the inclusion check: a state of the smaller view and a set of states of the bigger view.
+    struct Node {
+        State smaller_state;
+        StateSet bigger_set;
+        /// Node from which this node was discovered, @c NO_PARENT for initial nodes.
+        size_t parent;
+        Symbol symbol;
+        /// Whether the node was removed from the antichain by a smaller node.
+        bool is_subsumed;
+    };
+    std::vector<Node> nodes{};
+    std::vector<size_t> worklist{};
+    // Antichain of nodes for each discovered state of the smaller view.
+    std::unordered_map<State, std::vector<size_t>> processed{};
+
+    auto intersects_final = [&](const StateSet& bigger_set) {
+        return std::any_of(bigger_set.begin(), bigger_set.end(), [&](const State state) { return bigger.is_final(state); });
+    };
+    auto report_cex = [&](size_t node) {
+        if (cex == nullptr) { return; }
+        cex->word.clear();
+        cex->path = { nodes[node].smaller_state };
+        for (; nodes[node].parent != NO_PARENT; node = nodes[node].parent) {
+            cex->word.push_back(nodes[node].symbol);
+            cex->path.push_back(nodes[nodes[node].parent].smaller_state);
+        }
+        std::reverse(cex->word.begin(), cex->word.end());
+        std::reverse(cex->path.begin(), cex->path.end());
+    };
+    // Adds the node unless it is subsumed by a node in the antichain. Returns false for counterexamples.
+    auto add_node = [&](Node node) {
+        const size_t node_idx{ nodes.size() };
+        const bool is_cex{ smaller.is_final(node.smaller_state) && !intersects_final(node.bigger_set) };
+        std::vector<size_t>& antichain{ processed[node.smaller_state] };
+        if (!is_cex && std::any_of(antichain.begin(), antichain.end(), [&](const size_t other) {
+                return nodes[other].bigger_set.is_subset_of(node.bigger_set); })) {
+            return true;
+        }
+        std::erase_if(antichain, [&](const size_t other) {
+            if (!node.bigger_set.is_subset_of(nodes[other].bigger_set)) { return false; }
+            nodes[other].is_subsumed = true;
+            return true;
+        });
+        antichain.push_back(node_idx);
+        worklist.push_back(node_idx);
+        nodes.push_back(std::move(node));
+        if (is_cex) { report_cex(node_idx); }
+        return !is_cex;
+    };
+
+    for (const State smaller_state: smaller.initial()) {
+        if (!add_node({ smaller_state, bigger.initial(), NO_PARENT, 0, false })) { return false; }
+    }
+
+    std::vector<State> bigger_targets{};
+    while (!worklist.empty()) {
+        const size_t node_idx{ worklist.back() };
+        worklist.pop_back();
+        if (nodes[node_idx].is_subsumed) { continue; }
+        const State smaller_state{ nodes[node_idx].smaller_state };
+        const StateSet bigger_set{ nodes[node_idx].bigger_set };
+
+        for (const SymbolPost& smaller_symbol_post: smaller.post(smaller_state)) {
+            bigger_targets.clear();
+            for (const State bigger_state: bigger_set) {
+                const StatePost& bigger_post{ bigger.post(bigger_state) };
+                const auto bigger_symbol_post_it{ bigger_post.find(smaller_symbol_post.symbol) };
+                if (bigger_symbol_post_it == bigger_post.end()) { continue; }
+                bigger_targets.insert(bigger_targets.end(), bigger_symbol_post_it->targets.begin(),
+                                      bigger_symbol_post_it->targets.end());
+            }
+            mata::utils::sort_and_rmdupl(bigger_targets);
+            const StateSet bigger_succ{ bigger_targets };
+            for (const State smaller_succ: smaller_symbol_post.targets) {
+                if (!add_node({ smaller_succ, bigger_succ, node_idx, smaller_symbol_post.symbol, false })) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
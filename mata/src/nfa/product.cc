@@ -4,225 +4,168 @@
 // MATA headers
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
+#include "mata/nfa/product.hh"
 #include <cassert>
 #include <functional>
+#include <numeric>
 
 
 using namespace mata::nfa;
+using mata::Symbol;
 
 namespace {
 
-using ProductMap = std::unordered_map<std::pair<State,State>,State>;
-using MatrixProductStorage = std::vector<std::vector<State>>;
-using VecMapProductStorage = std::vector<std::unordered_map<State,State>>;
-using InvertedProductStorage = std::vector<State>;
-//Unordered map seems to be faster than ordered map here, but still very much slower than matrix.
-
-} // Anonymous namespace.
-
-namespace mata::nfa {
-
-//TODO: move this method to nfa.hh? It is something one might want to use (e.g. for union, inclusion, equivalence of DFAs).
-Nfa mata::nfa::algorithms::product(
-        const Nfa& lhs, const Nfa& rhs, const std::function<bool(State,State)>&& final_condition,
-        const Symbol first_epsilon, ProductMap *product_map) {
-
-    Nfa product{}; // The product automaton.
-
-    // Set of product states to process.
-    std::deque<State> worklist{};
-
-    //The largest matrix (product_matrix) of pairs of states we are brave enough to allocate.
-    // Let's say we are fine with allocating large_product * (about 8 Bytes) space.
-    // So ten million cells is close to 100 MB.
-    // If the number is larger, then we do not allocate a matrix, but use a vector of unordered maps (product_vec_map).
-    // The unordered_map seems to be about twice slower.
-    constexpr size_t MAX_PRODUCT_MATRIX_SIZE = 50'000'000;
-    //constexpr size_t MAX_PRODUCT_MATRIX_SIZE = 0;
-    const bool large_product = lhs.num_of_states() * rhs.num_of_states() > MAX_PRODUCT_MATRIX_SIZE;
-    assert(lhs.num_of_states() < Limits::max_state);
-    assert(rhs.num_of_states() < Limits::max_state);
-
-    //Two variants of storage for the mapping from pairs of lhs and rhs states to product state, for large and non-large products.
-    MatrixProductStorage matrix_product_storage;
-    VecMapProductStorage vec_map_product_storage;
-    InvertedProductStorage product_to_lhs(lhs.num_of_states()+rhs.num_of_states());
-    InvertedProductStorage product_to_rhs(lhs.num_of_states()+rhs.num_of_states());
-
-
-    //Initialize the storage, according to the number of possible state pairs.
-    if (!large_product)
-        matrix_product_storage = MatrixProductStorage(lhs.num_of_states(), std::vector<State>(rhs.num_of_states(), Limits::max_state));
-    else
-        vec_map_product_storage = VecMapProductStorage(lhs.num_of_states());
-
-    /// Give me the product state for the pair of lhs and rhs states.
-    /// Returns Limits::max_state if not found.
-    auto get_state_from_product_storage = [&](State lhs_state, State rhs_state) {
-        if (!large_product)
-            return matrix_product_storage[lhs_state][rhs_state];
-        else {
-            auto it = vec_map_product_storage[lhs_state].find(rhs_state);
-            if (it == vec_map_product_storage[lhs_state].end())
-                return Limits::max_state;
-            else
-                return it->second;
-        }
-    };
-
-    /// Insert new mapping lhs rhs state pair to product state.
-    auto insert_to_product_storage = [&](State lhs_state, State rhs_state, State product_state) {
-        if (!large_product)
-            matrix_product_storage[lhs_state][rhs_state] = product_state;
-        else
-            vec_map_product_storage[lhs_state][rhs_state] = product_state;
-
-        product_to_lhs.resize(product_state+1);
-        product_to_rhs.resize(product_state+1);
-        product_to_lhs[product_state] = lhs_state;
-        product_to_rhs[product_state] = rhs_state;
-
-        //this thing is not used internally. It is only used if we want to return the mapping. But it is expensive.
-        if (product_map != nullptr)
-            (*product_map)[std::pair<State,State>(lhs_state,rhs_state)] = product_state;
-    };
-
 /**
- * Add symbol_post for the product state (lhs,rhs) to the product, used for epsilons only (it is simpler for normal symbols).
- * @param[in] pair_to_process Currently processed pair of original states.
- * @param[in] new_product_symbol_post State transitions to add to the product.
+ * Call @p process for each tuple in the Cartesian product of @p sets, in the lexicographic order.
+ * @param[in] sets Sets of states (without duplicates), one set for each position of the tuples.
+ * @param[out] tuple Buffer for the tuples, passed to @p process.
  */
-    auto add_product_e_post = [&](const State lhs_source, const State rhs_source, SymbolPost& new_product_symbol_post)
-    {
-        if (new_product_symbol_post.empty()) { return; }
-
-        State product_source = get_state_from_product_storage(lhs_source, rhs_source);
-
-        StatePost &product_state_post{product.delta.mutable_state_post(product_source)};
-
-        if (product_state_post.empty() || new_product_symbol_post.symbol > product_state_post.back().symbol) {
-            product_state_post.push_back(std::move(new_product_symbol_post));
-        }
-        else {
-            auto symbol_post_it = product_state_post.find(new_product_symbol_post.symbol);
-            if (symbol_post_it == product_state_post.end()) {
-                product_state_post.insert(std::move(new_product_symbol_post));
-            }
-            //Epsilons are not inserted in order, we insert all lhs epsilons and then all rhs epsilons.
-            // It can happen that we insert an e-transition from lhs and then another with the same e from rhs.
-            else {
-                symbol_post_it->insert(new_product_symbol_post.targets);
-            }
+template<typename Process>
+void for_each_tuple(const std::vector<std::span<const State>>& sets, std::vector<State>& tuple, Process&& process) {
+    const size_t tuple_size{ sets.size() };
+    for (const std::span<const State> set: sets) {
+        if (set.empty()) { return; }
+    }
+    std::vector<size_t> positions(tuple_size, 0);
+    for (size_t i{ 0 }; i < tuple_size; ++i) { tuple[i] = sets[i][0]; }
+    while (true) {
+        process(tuple);
+        // Advance the positions as an odometer, the last position being the fastest one.
+        size_t i{ tuple_size };
+        for (; i > 0; --i) {
+            std::span<const State> set{ sets[i - 1] };
+            size_t& position{ positions[i - 1] };
+            if (++position != set.size()) { tuple[i - 1] = set[position]; break; }
+            position = 0;
+            tuple[i - 1] = set[0];
         }
-    };
-
-/**
- * Create product state if it does not exist in storage yet and fill in its symbol_post from lhs and rhs targets.
- * @param[in] lhs_target Target state in NFA @c lhs.
- * @param[in] rhs_target Target state in NFA @c rhs.
- * @param[out] product_symbol_post New SymbolPost of the product state.
- */
-    auto create_product_state_and_symbol_post = [&](const State lhs_target, const State rhs_target, SymbolPost& product_symbol_post)
-    {
-        State product_target = get_state_from_product_storage(lhs_target, rhs_target );
-
-        if ( product_target == Limits::max_state )
-        {
-            product_target = product.add_state();
-            assert(product_target < Limits::max_state);
-
-            insert_to_product_storage(lhs_target,rhs_target, product_target);
-
-            worklist.push_back(product_target);
-
-            if (final_condition(lhs_target,rhs_target)) {
-                product.final.insert(product_target);
+        if (i == 0) { return; }
+    }
+}
+
+Nfa product(const std::span<const Nfa> automata, const std::function<bool(std::span<const State>)>& final_condition,
+            const Symbol first_epsilon) {
+    const size_t num_of_operands{ automata.size() };
+
+    // Operands with fewer states first: the first operand drives the synchronized iteration over symbols, and the
+    //  tuples of the product are enumerated with the first operands in the outermost loops.
+    std::vector<size_t> order(num_of_operands);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const size_t lhs, const size_t rhs) {
+        return automata[lhs].num_of_states() < automata[rhs].num_of_states();
+    });
+
+    Nfa product{};
+    // Tuples of product states, in the order of the operands given by @c order. The identifier of a tuple in the
+    //  store is the product state.
+    TupleStore tuples{};
+    std::vector<State> worklist{};
+    std::vector<State> original_tuple(num_of_operands);
+
+    /// Give me the product state for @p tuple, creating it if it does not exist yet.
+    auto get_product_state = [&](const std::span<const State> tuple) -> State {
+        const auto [product_state, inserted]{ tuples.insert(tuple) };
+        if (inserted) {
+            product.add_state(product_state);
+            worklist.push_back(product_state);
+            for (size_t operand{ 0 }; operand < num_of_operands; ++operand) {
+                original_tuple[order[operand]] = tuple[operand];
             }
+            if (final_condition(original_tuple)) { product.final.insert(product_state); }
         }
-        //TODO: Push_back all of them and sort at the could be faster.
-        product_symbol_post.insert(product_target);
+        return product_state;
     };
 
-    // Initialize pairs to process with initial state pairs.
-    for (const State lhs_initial_state : lhs.initial) {
-        for (const State rhs_initial_state : rhs.initial) {
-            // Update product with initial state pairs.
-            const State product_initial_state = product.add_state();
-            insert_to_product_storage(lhs_initial_state,rhs_initial_state,product_initial_state);
-            worklist.push_back(product_initial_state);
-            product.initial.insert(product_initial_state);
-            if (final_condition(lhs_initial_state,rhs_initial_state)) {
-                product.final.insert(product_initial_state);
-            }
-        }
+    std::vector<std::span<const State>> operand_states(num_of_operands);
+    std::vector<State> tuple(num_of_operands);
+    for (size_t operand{ 0 }; operand < num_of_operands; ++operand) {
+        const mata::utils::SparseSet<State>& initial{ automata[order[operand]].initial };
+        operand_states[operand] = { initial.begin(), initial.end() };
     }
-
+    for_each_tuple(operand_states, tuple, [&](const std::span<const State> initial_tuple) {
+        product.initial.insert(get_product_state(initial_tuple));
+    });
+
+    std::vector<State> source_tuple(num_of_operands);
+    std::vector<State> targets{};
+    std::vector<std::pair<Symbol, State>> epsilon_moves{};
+    mata::utils::SynchronizedUniversalIterator<StatePost::const_iterator> sync_iterator(num_of_operands);
     while (!worklist.empty()) {
-        State product_source = worklist.back();;
+        const State product_source{ worklist.back() };
         worklist.pop_back();
-        State lhs_source =  product_to_lhs[product_source];
-        State rhs_source =  product_to_rhs[product_source];
-        // Compute classic product for current state pair.
-
-        mata::utils::SynchronizedUniversalIterator<mata::utils::OrdVector<SymbolPost>::const_iterator> sync_iterator(2);
-        mata::utils::push_back(sync_iterator, lhs.delta[lhs_source]);
-        mata::utils::push_back(sync_iterator, rhs.delta[rhs_source]);
+        const TupleStore::Tuple stored_tuple{ tuples[static_cast<MacrostateId>(product_source)] };
+        source_tuple.assign(stored_tuple.begin(), stored_tuple.end());
 
+        sync_iterator.reset();
+        for (size_t operand{ 0 }; operand < num_of_operands; ++operand) {
+            mata::utils::push_back(sync_iterator, automata[order[operand]].delta[source_tuple[operand]]);
+        }
         while (sync_iterator.advance()) {
             const std::vector<StatePost::const_iterator>& same_symbol_posts{ sync_iterator.get_current() };
-            assert(same_symbol_posts.size() == 2); // One move per state in the pair.
-
-            // Compute product for state transitions with same symbols.
-            // Find all transitions that have the same symbol for first and the second state in the pair_to_process.
-            // Create transition from the pair_to_process to all pairs between states to which first transition goes
-            //  and states to which second one goes.
-            Symbol symbol = same_symbol_posts[0]->symbol;
-            if (symbol < first_epsilon) {
-                SymbolPost product_symbol_post{ symbol };
-                for (const State lhs_target: same_symbol_posts[0]->targets) {
-                    for (const State rhs_target: same_symbol_posts[1]->targets) {
-                        create_product_state_and_symbol_post(lhs_target, rhs_target, product_symbol_post);
-                    }
-                }
-                StatePost &product_state_post{product.delta.mutable_state_post(product_source)};
-                //Here we are sure that we are working with the largest symbol so far, since we iterate through
-                //the symbol posts of the lhs and rhs in order. So we can just push_back (not insert).
-                product_state_post.push_back(std::move(product_symbol_post));
+            const Symbol symbol{ same_symbol_posts[0]->symbol };
+            if (symbol >= first_epsilon) { break; }
+            for (size_t operand{ 0 }; operand < num_of_operands; ++operand) {
+                operand_states[operand] = same_symbol_posts[operand]->targets.to_vector();
             }
-            else
-                break;
+            targets.clear();
+            for_each_tuple(operand_states, tuple, [&](const std::span<const State> target_tuple) {
+                targets.push_back(get_product_state(target_tuple));
+            });
+            mata::utils::sort_and_rmdupl(targets);
+            // Symbols are iterated in order, the symbol post can be pushed back.
+            product.delta.mutable_state_post(product_source).push_back(SymbolPost{ symbol, StateSet{ targets } });
         }
 
-        // Add epsilon transitions, from lhs e-transitions.
-        const StatePost& lhs_state_post{lhs.delta[lhs_source] };
-
-        //TODO: handling of epsilons might not be ideal, don't know, it would need some brain cycles to improve.
-        // (handling of normal symbols is ok though)
-        auto lhs_first_epsilon_it = lhs_state_post.first_epsilon_it(first_epsilon);
-        if (lhs_first_epsilon_it != lhs_state_post.end()) {
-            for (auto lhs_symbol_post = lhs_first_epsilon_it; lhs_symbol_post < lhs_state_post.end(); ++lhs_symbol_post) {
-                SymbolPost prod_symbol_post{lhs_symbol_post->symbol };
-                for (const State lhs_target: lhs_symbol_post->targets) {
-                    create_product_state_and_symbol_post(lhs_target, rhs_source, prod_symbol_post);
+        // Epsilon transitions are taken by each operand on its own, the other operands stay in their states.
+        epsilon_moves.clear();
+        for (size_t operand{ 0 }; operand < num_of_operands; ++operand) {
+            const StatePost& state_post{ automata[order[operand]].delta[source_tuple[operand]] };
+            for (auto symbol_post_it{ state_post.first_epsilon_it(first_epsilon) }; symbol_post_it != state_post.end();
+                 ++symbol_post_it) {
+                tuple = source_tuple;
+                for (const State target: symbol_post_it->targets) {
+                    tuple[operand] = target;
+                    epsilon_moves.emplace_back(symbol_post_it->symbol, get_product_state(tuple));
                 }
-                add_product_e_post(lhs_source, rhs_source, prod_symbol_post);
             }
         }
-
-        // Add epsilon transitions, from rhs e-transitions.
-        const StatePost& rhs_state_post{rhs.delta[rhs_source] };
-        auto rhs_first_epsilon_it = rhs_state_post.first_epsilon_it(first_epsilon);
-        if (rhs_first_epsilon_it != rhs_state_post.end()) {
-            for (auto rhs_symbol_post = rhs_first_epsilon_it; rhs_symbol_post < rhs_state_post.end(); ++rhs_symbol_post) {
-                SymbolPost prod_symbol_post{rhs_symbol_post->symbol };
-                for (const State rhs_target: rhs_symbol_post->targets) {
-                    create_product_state_and_symbol_post(lhs_source, rhs_target, prod_symbol_post);
-                }
-                add_product_e_post(lhs_source, rhs_source, prod_symbol_post);
+        mata::utils::sort_and_rmdupl(epsilon_moves);
+        for (auto move_it{ epsilon_moves.begin() }; move_it != epsilon_moves.end();) {
+            SymbolPost epsilon_post{ move_it->first };
+            for (const Symbol epsilon{ move_it->first }; move_it != epsilon_moves.end() && move_it->first == epsilon;
+                 ++move_it) {
+                epsilon_post.targets.push_back(move_it->second);
             }
+            product.delta.mutable_state_post(product_source).push_back(std::move(epsilon_post));
         }
     }
     return product;
-} // intersection().
+} // product().
+
+} // Anonymous namespace.
+
+namespace mata::nfa {
+
+//TODO: move this method to nfa.hh? It is something one might want to use (e.g. for union, inclusion, equivalence of DFAs).
+Nfa mata::nfa::algorithms::product(
+        const Nfa& lhs, const Nfa& rhs, const std::function<bool(State,State)>&& final_condition,
+        const Symbol first_epsilon, ProductMap *product_map) {
+    return compute_product(lhs, rhs, final_condition, product_map, SingleLevel{}, FirstEpsilon{ first_epsilon });
+}
+
+Nfa mata::nfa::algorithms::product(
+        const FrozenNfa& lhs, const FrozenNfa& rhs, const std::function<bool(State,State)>&& final_condition,
+        const Symbol first_epsilon, ProductMap *product_map) {
+    return compute_product(lhs, rhs, final_condition, product_map, SingleLevel{}, FirstEpsilon{ first_epsilon });
+}
+
+Nfa mata::nfa::algorithms::product(
+        const std::span<const Nfa> automata, const std::function<bool(std::span<const State>)>&& final_condition,
+        const Symbol first_epsilon) {
+    if (automata.empty()) {
+        throw std::runtime_error(std::to_string(__func__) + " requires at least one automaton");
+    }
+    return ::product(automata, final_condition, first_epsilon);
+}
 
 } // namespace mata::nfa.
@@ -0,0 +1,49 @@
+/* reverse-delta.cc -- Index of transitions incoming to states (predecessors).
+ */
+
+#include <algorithm>
+
+#include "mata/nfa/reverse-delta.hh"
+#include "mata/nfa/delta.hh"
+
+using namespace mata::nfa;
+
+ReverseDelta::ReverseDelta(const Delta& delta) {
+    const size_t num_of_states{ delta.num_of_states() };
+    offsets_.assign(num_of_states + 1, 0);
+    for (const StatePost& state_post: delta) {
+        for (const SymbolPost& symbol_post: state_post) {
+            for (const State target: symbol_post.targets) { ++offsets_[target + 1]; }
+        }
+    }
+    for (size_t i{ 1 }; i <= num_of_states; ++i) { offsets_[i] += offsets_[i - 1]; }
+
+    // Transitions are distributed in the order of Delta::transitions(), hence the transitions incoming to each state
+    //  are ordered by the source and then by the symbol.
+    transitions_.resize(offsets_.back());
+    std::vector<size_t> next_position(offsets_.begin(), offsets_.end() - 1);
+    size_t index{ 0 };
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const SymbolPost& symbol_post: delta[source]) {
+            for (const State target: symbol_post.targets) {
+                transitions_[next_position[target]++] = { symbol_post.symbol, source, index++ };
+            }
+        }
+    }
+
+    for (State target{ 0 }; target < num_of_states; ++target) {
+        const auto begin{ transitions_.begin() + static_cast<std::ptrdiff_t>(offsets_[target]) };
+        const auto end{ transitions_.begin() + static_cast<std::ptrdiff_t>(offsets_[target + 1]) };
+        if (end - begin > 1) {
+            std::sort(begin, end, [](const IncomingTransition& lhs, const IncomingTransition& rhs) {
+                return lhs.symbol < rhs.symbol || (lhs.symbol == rhs.symbol && lhs.source < rhs.source);
+            });
+        }
+    }
+}
+
+std::shared_ptr<const ReverseDelta> ReverseDeltaCache::get(const Delta& delta) const {
+    const std::lock_guard lock{ mutex_ };
+    if (reverse_delta_ == nullptr) { reverse_delta_ = std::make_shared<const ReverseDelta>(delta); }
+    return reverse_delta_;
+}
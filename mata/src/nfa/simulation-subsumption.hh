@@ -0,0 +1,94 @@
+/* simulation-subsumption.hh -- Subsumption of macrostates up to simulation in antichain algorithms.
+ *
+ * Internal header shared by the implementations of inclusion and universality checking, not installed.
+ */
+
+#ifndef MATA_SRC_NFA_SIMULATION_SUBSUMPTION_HH_
+#define MATA_SRC_NFA_SIMULATION_SUBSUMPTION_HH_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/nfa/bit-state-set.hh"
+#include "mata/nfa/simulation.hh"
+
+namespace mata::nfa::internal {
+
+/// Call @p function for each state of @p states.
+template<typename Function>
+void for_each_state(const StateSet& states, Function&& function) {
+    for (const State state: states) { function(state); }
+}
+template<typename Function>
+void for_each_state(const BitStateSet& states, Function&& function) { states.for_each(function); }
+
+/// Replace the states of @p set by @p states.
+inline void assign_states(StateSet& set, const std::vector<State>& states) { set = StateSet(states); }
+inline void assign_states(BitStateSet& set, const std::vector<State>& states) {
+    set.clear();
+    for (const State state: states) { set.insert(state); }
+}
+
+/**
+ * @brief Subsumption of macrostates (represented as @c StateSet or @c BitStateSet) up to a forward simulation
+ *  (Abdulla et al., When Simulation Meets Antichains).
+ *
+ * Macrostates are minimized in place and compared without copying, using buffers kept between calls. Hence, one
+ *  instance must not be used by multiple threads at once.
+ */
+class SimulationSubsumption {
+public:
+    /// Subsumption up to the maximal forward simulation on the states of @p aut.
+    explicit SimulationSubsumption(const Nfa& aut)
+        : relation_{ algorithms::compute_simulation(aut, { { "direction", "forward" } }) } {}
+    explicit SimulationSubsumption(SimulationRelation relation): relation_{ std::move(relation) } {}
+
+    const SimulationRelation& get_relation() const { return relation_; }
+
+    /// Whether @p state is simulated by some state in @p set.
+    template<typename MacroState>
+    bool is_simulated_by_some(const State state, const MacroState& set) const {
+        bool simulated{ false };
+        for_each_state(set, [&](const State upper_state) {
+            simulated = simulated || relation_.get(state, upper_state);
+        });
+        return simulated;
+    }
+
+    /// Whether each state of @p lower is simulated by some state of @p upper, i.e., @c L(lower) <= @c L(upper).
+    template<typename MacroState>
+    bool subsumes(const MacroState& lower, const MacroState& upper) const {
+        bool simulated{ true };
+        for_each_state(lower, [&](const State state) {
+            simulated = simulated && is_simulated_by_some(state, upper);
+        });
+        return simulated;
+    }
+
+    /// Remove states of @p set simulated by other states of @p set, keeping the smallest of mutually simulating.
+    template<typename MacroState>
+    void minimize(MacroState& set) const {
+        states_.clear();
+        for_each_state(set, [&](const State state) { states_.push_back(state); });
+        kept_states_.clear();
+        for (const State state: states_) {
+            const bool is_dominated{ std::any_of(states_.begin(), states_.end(), [&](const State other) {
+                return other != state && relation_.get(state, other) && (!relation_.get(other, state) || other < state);
+            }) };
+            if (!is_dominated) { kept_states_.push_back(state); }
+        }
+        if (kept_states_.size() != states_.size()) { assign_states(set, kept_states_); }
+    }
+
+private:
+    SimulationRelation relation_;
+    mutable std::vector<State> states_{};
+    mutable std::vector<State> kept_states_{};
+}; // class SimulationSubsumption.
+
+} // namespace mata::nfa::internal.
+
+#endif // MATA_SRC_NFA_SIMULATION_SUBSUMPTION_HH_.
@@ -0,0 +1,436 @@
+/* simulation.cc -- Simulation preorder over states of an automaton.
+ */
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "mata/nfa/simulation.hh"
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/utils/utils.hh"
+
+using namespace mata::nfa;
+using mata::Symbol;
+using mata::BoolVector;
+
+SimulationRelation::SimulationRelation(std::vector<size_t> block_of_state, std::vector<std::vector<size_t>> blocks_above)
+    : block_of_state_{ std::move(block_of_state) }, blocks_above_{ std::move(blocks_above) },
+      representatives_(blocks_above_.size(), Limits::max_state) {
+    for (State state{ block_of_state_.size() }; state > 0; --state) {
+        if (const size_t block{ block_of_state_[state - 1] }; block != NO_BLOCK) { representatives_[block] = state - 1; }
+    }
+}
+
+bool SimulationRelation::is_block_below(const size_t lower_block, const size_t upper_block) const {
+    const std::vector<size_t>& blocks_above{ blocks_above_[lower_block] };
+    return std::binary_search(blocks_above.begin(), blocks_above.end(), upper_block);
+}
+
+bool SimulationRelation::get(const State state, const State simulating_state) const {
+    if (state == simulating_state) { return true; }
+    const size_t block{ get_block(state) };
+    const size_t simulating_block{ get_block(simulating_state) };
+    if (block == NO_BLOCK || simulating_block == NO_BLOCK) { return false; }
+    return is_block_below(block, simulating_block);
+}
+
+std::vector<size_t> SimulationRelation::get_quotient_projection() const {
+    std::vector<size_t> quotient_projection(num_of_states());
+    for (State state{ 0 }, num_of_states{ this->num_of_states() }; state < num_of_states; ++state) {
+        quotient_projection[state] = get_representative(state);
+    }
+    return quotient_projection;
+}
+
+Simlib::Util::BinaryRelation SimulationRelation::to_binary_relation() const {
+    const size_t num_of_states{ this->num_of_states() };
+    Simlib::Util::BinaryRelation relation{ num_of_states, false, std::max<size_t>(num_of_states, 1) };
+    std::vector<std::vector<State>> states_of_block(num_of_blocks());
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        if (const size_t block{ block_of_state_[state] }; block != NO_BLOCK) { states_of_block[block].push_back(state); }
+        relation.set(state, state, true);
+    }
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        if (block_of_state_[state] == NO_BLOCK) { continue; }
+        for (const size_t block_above: blocks_above_[block_of_state_[state]]) {
+            for (const State simulating_state: states_of_block[block_above]) { relation.set(state, simulating_state, true); }
+        }
+    }
+    return relation;
+}
+
+namespace {
+    /**
+     * @brief Computation of the maximal simulation over transitions by the partition-relation refinement of Ranzato
+     *  and Tapparo in its version for labelled transition systems by Holík and Šimáček (the algorithm of simlib).
+     *
+     * The relation is kept as a partition of states into blocks and, for each block, the sorted blocks above it. For
+     *  each block @c B and label @c a, @c Count_a(q, B) is the number of @c a-successors of @c q in blocks above @c B.
+     *  @c Remove_a(B) collects states with an @c a-transition whose count dropped to zero, i.e., states which cannot
+     *  simulate any @c a-predecessor of @c B. Processing @c Remove_a(B) splits blocks by it and removes pairs of blocks
+     *  intersecting @c a-predecessors of @c B and blocks inside @c Remove_a(B). Only the counts of predecessors of the
+     *  blocks removed from the relation are updated. Unlike in simlib, the counts of each block are kept sparse, only
+     *  for states with a successor above the block.
+     */
+    class SimulationRefinement {
+    public:
+        /**
+         * @param[in] delta Transitions to compute the simulation over.
+         * @param[in] accepting States which can be simulated only by accepting states.
+         * @param[in] in_domain States to compute the simulation over. Transitions to other states are ignored.
+         */
+        SimulationRefinement(const Delta& delta, const BoolVector& accepting, const BoolVector& in_domain);
+
+        /// Refine the relation to the maximal simulation and return it.
+        SimulationRelation compute();
+
+    private:
+        struct Block {
+            /// States of the block are @c elements_[begin, end).
+            size_t begin{ 0 };
+            size_t end{ 0 };
+            /// Blocks above the block (including the block itself), in an ascending order.
+            std::vector<size_t> above{};
+            /// Blocks which were below the block when they were related, checked against @c above when splitting.
+            std::vector<size_t> below{};
+            /// Non-zero counts @c Count_a(q, B) as pairs of @c count_key(a,q) and the count, sorted by the keys.
+            std::vector<std::pair<size_t, size_t>> counts{};
+            /// Pending @c Remove_a(B) for labels @c a.
+            std::map<size_t, std::vector<State>> remove{};
+            /// Number of states moved to the beginning of the block by @c split().
+            size_t num_of_marked{ 0 };
+        };
+
+        size_t count_key(const size_t label, const State state) const { return label * num_of_states_ + state; }
+
+        size_t add_block(const std::vector<State>& states);
+        /**
+         * @brief Split blocks by @p states, moving the states into new blocks.
+         *
+         * The new blocks inherit relations, counts and pending removes of their original blocks.
+         * @param[out] blocks_inside Blocks which are subsets of @p states after the split.
+         */
+        void split(const std::vector<State>& states, std::vector<size_t>& blocks_inside);
+        void add_to_remove(size_t block, size_t label, State state);
+        void init_counts_and_removes(size_t block);
+        /// Update the counts of @p block after removing @p removed_block from the blocks above @p block.
+        void decrement_counts(size_t block, size_t removed_block);
+        void process_remove(size_t block, size_t label);
+        SimulationRelation build_relation() const;
+
+        const size_t num_of_states_;
+        /// States with an @c a-transition, for each label @c a.
+        std::vector<std::vector<State>> states_with_label_{};
+        /// Labels of transitions from each state, in an ascending order.
+        std::vector<std::vector<size_t>> labels_of_state_{};
+        /// Pairs of a label and a predecessor over the label of each state, sorted.
+        std::vector<std::vector<std::pair<size_t, State>>> predecessors_{};
+
+        std::vector<State> elements_{};
+        std::vector<size_t> position_{};
+        std::vector<size_t> block_of_state_{};
+        std::vector<Block> blocks_{};
+        /// Pending pairs of a block and a label to process @c Remove_a(B) for.
+        std::vector<std::pair<size_t, size_t>> queue_{};
+        BoolVector is_block_marked_{};
+    };
+
+    SimulationRefinement::SimulationRefinement(const Delta& delta, const BoolVector& accepting,
+                                               const BoolVector& in_domain)
+        : num_of_states_{ in_domain.size() }, labels_of_state_(num_of_states_), predecessors_(num_of_states_),
+          position_(num_of_states_), block_of_state_(num_of_states_, SimulationRelation::NO_BLOCK) {
+        auto is_in_domain = [&](const State state) { return state < num_of_states_ && in_domain[state]; };
+        std::vector<Symbol> symbols{};
+        for (State state{ 0 }; state < num_of_states_ && state < delta.num_of_states(); ++state) {
+            if (!in_domain[state]) { continue; }
+            for (const SymbolPost& symbol_post: delta[state]) { symbols.push_back(symbol_post.symbol); }
+        }
+        mata::utils::sort_and_rmdupl(symbols);
+        states_with_label_.resize(symbols.size());
+        for (State state{ 0 }; state < num_of_states_ && state < delta.num_of_states(); ++state) {
+            if (!in_domain[state]) { continue; }
+            for (const SymbolPost& symbol_post: delta[state]) {
+                const size_t label{ static_cast<size_t>(
+                    std::lower_bound(symbols.begin(), symbols.end(), symbol_post.symbol) - symbols.begin()) };
+                bool has_transition{ false };
+                for (const State target: symbol_post.targets) {
+                    if (is_in_domain(target)) {
+                        predecessors_[target].emplace_back(label, state);
+                        has_transition = true;
+                    }
+                }
+                if (has_transition) {
+                    labels_of_state_[state].push_back(label);
+                    states_with_label_[label].push_back(state);
+                }
+            }
+        }
+        for (std::vector<std::pair<size_t, State>>& predecessors: predecessors_) {
+            std::sort(predecessors.begin(), predecessors.end());
+        }
+
+        // The initial relation: non-accepting states are simulated by all states, accepting states only by accepting.
+        std::vector<State> non_accepting_states{};
+        std::vector<State> accepting_states{};
+        for (State state{ 0 }; state < num_of_states_; ++state) {
+            if (in_domain[state]) { (accepting[state] ? accepting_states : non_accepting_states).push_back(state); }
+        }
+        const size_t non_accepting_block{ add_block(non_accepting_states) };
+        const size_t accepting_block{ add_block(accepting_states) };
+        if (non_accepting_block != SimulationRelation::NO_BLOCK && accepting_block != SimulationRelation::NO_BLOCK) {
+            blocks_[non_accepting_block].above.push_back(accepting_block);
+            blocks_[accepting_block].below.push_back(non_accepting_block);
+        }
+
+        // States with a transition over a label cannot be simulated by states without one.
+        std::vector<size_t> blocks_inside{};
+        for (const std::vector<State>& states: states_with_label_) { split(states, blocks_inside); }
+        for (Block& block: blocks_) {
+            const std::vector<size_t>& labels{ labels_of_state_[elements_[block.begin]] };
+            std::erase_if(block.above, [&](const size_t block_above) {
+                const std::vector<size_t>& labels_above{ labels_of_state_[elements_[blocks_[block_above].begin]] };
+                return !std::includes(labels_above.begin(), labels_above.end(), labels.begin(), labels.end());
+            });
+        }
+        for (size_t block{ 0 }; block < blocks_.size(); ++block) { init_counts_and_removes(block); }
+    }
+
+    size_t SimulationRefinement::add_block(const std::vector<State>& states) {
+        if (states.empty()) { return SimulationRelation::NO_BLOCK; }
+        const size_t block{ blocks_.size() };
+        Block& new_block{ blocks_.emplace_back() };
+        new_block.begin = elements_.size();
+        for (const State state: states) {
+            position_[state] = elements_.size();
+            elements_.push_back(state);
+            block_of_state_[state] = block;
+        }
+        new_block.end = elements_.size();
+        new_block.above.push_back(block);
+        new_block.below.push_back(block);
+        return block;
+    }
+
+    void SimulationRefinement::split(const std::vector<State>& states, std::vector<size_t>& blocks_inside) {
+        blocks_inside.clear();
+        std::vector<size_t> marked_blocks{};
+        for (const State state: states) {
+            Block& block{ blocks_[block_of_state_[state]] };
+            if (block.num_of_marked == 0) { marked_blocks.push_back(block_of_state_[state]); }
+            const size_t marked_position{ block.begin + block.num_of_marked };
+            if (position_[state] < marked_position) { continue; }
+            std::swap(elements_[position_[state]], elements_[marked_position]);
+            position_[elements_[position_[state]]] = position_[state];
+            position_[state] = marked_position;
+            ++block.num_of_marked;
+        }
+
+        for (const size_t block: marked_blocks) {
+            const size_t num_of_marked{ std::exchange(blocks_[block].num_of_marked, 0) };
+            if (num_of_marked == blocks_[block].end - blocks_[block].begin) {
+                blocks_inside.push_back(block);
+                continue;
+            }
+            const size_t new_block{ blocks_.size() };
+            blocks_.emplace_back();
+            Block& original{ blocks_[block] };
+            Block& split_block{ blocks_.back() };
+            split_block.begin = original.begin;
+            split_block.end = original.begin + num_of_marked;
+            original.begin = split_block.end;
+            for (size_t position{ split_block.begin }; position < split_block.end; ++position) {
+                block_of_state_[elements_[position]] = new_block;
+            }
+
+            // The new block is related to the same blocks as the original block, including the original block.
+            split_block.above = original.above;
+            std::erase_if(original.below, [&](const size_t block_below) {
+                return !std::binary_search(blocks_[block_below].above.begin(), blocks_[block_below].above.end(), block);
+            });
+            for (const size_t block_below: original.below) { blocks_[block_below].above.push_back(new_block); }
+            split_block.below = original.below;
+            for (const size_t block_above: split_block.above) { blocks_[block_above].below.push_back(new_block); }
+            split_block.above.push_back(new_block);
+            split_block.below.push_back(new_block);
+
+            split_block.counts = original.counts;
+            split_block.remove = original.remove;
+            for (const auto& [label, remove]: split_block.remove) { queue_.emplace_back(new_block, label); }
+            blocks_inside.push_back(new_block);
+        }
+    }
+
+    void SimulationRefinement::add_to_remove(const size_t block, const size_t label, const State state) {
+        std::vector<State>& remove{ blocks_[block].remove[label] };
+        if (remove.empty()) { queue_.emplace_back(block, label); }
+        remove.push_back(state);
+    }
+
+    void SimulationRefinement::init_counts_and_removes(const size_t block) {
+        std::vector<size_t> labels{};
+        for (size_t position{ blocks_[block].begin }; position < blocks_[block].end; ++position) {
+            for (const auto& [label, predecessor]: predecessors_[elements_[position]]) { labels.push_back(label); }
+        }
+        mata::utils::sort_and_rmdupl(labels);
+
+        std::vector<size_t> keys{};
+        for (const size_t block_above: blocks_[block].above) {
+            for (size_t position{ blocks_[block_above].begin }; position < blocks_[block_above].end; ++position) {
+                for (const auto& [label, predecessor]: predecessors_[elements_[position]]) {
+                    if (std::binary_search(labels.begin(), labels.end(), label)) {
+                        keys.push_back(count_key(label, predecessor));
+                    }
+                }
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        std::vector<std::pair<size_t, size_t>>& counts{ blocks_[block].counts };
+        for (const size_t key: keys) {
+            if (counts.empty() || counts.back().first != key) { counts.emplace_back(key, 0); }
+            ++counts.back().second;
+        }
+
+        for (const size_t label: labels) {
+            auto count_it{ counts.begin() };
+            for (const State state: states_with_label_[label]) {
+                const size_t key{ count_key(label, state) };
+                while (count_it != counts.end() && count_it->first < key) { ++count_it; }
+                if (count_it == counts.end() || count_it->first != key) { add_to_remove(block, label, state); }
+            }
+        }
+    }
+
+    void SimulationRefinement::decrement_counts(const size_t block, const size_t removed_block) {
+        std::vector<std::pair<size_t, size_t>>& counts{ blocks_[block].counts };
+        for (size_t position{ blocks_[removed_block].begin }; position < blocks_[removed_block].end; ++position) {
+            for (const auto& [label, predecessor]: predecessors_[elements_[position]]) {
+                const size_t key{ count_key(label, predecessor) };
+                const auto count_it{ std::lower_bound(counts.begin(), counts.end(), std::make_pair(key, size_t{ 0 })) };
+                if (count_it == counts.end() || count_it->first != key) { continue; }
+                if (--count_it->second == 0) { add_to_remove(block, label, predecessor); }
+            }
+        }
+    }
+
+    void SimulationRefinement::process_remove(const size_t block, const size_t label) {
+        const auto remove_it{ blocks_[block].remove.find(label) };
+        if (remove_it == blocks_[block].remove.end()) { return; }
+        const std::vector<State> remove{ std::move(remove_it->second) };
+        blocks_[block].remove.erase(remove_it);
+
+        // Blocks with a predecessor of the block over the label keep the same numbers after the split as the
+        //  predecessors are not in the remove set.
+        std::vector<size_t> predecessor_blocks{};
+        is_block_marked_.resize(blocks_.size());
+        for (size_t position{ blocks_[block].begin }; position < blocks_[block].end; ++position) {
+            const std::vector<std::pair<size_t, State>>& predecessors{ predecessors_[elements_[position]] };
+            for (auto it{ std::lower_bound(predecessors.begin(), predecessors.end(), std::make_pair(label, State{ 0 })) };
+                 it != predecessors.end() && it->first == label; ++it) {
+                const size_t predecessor_block{ block_of_state_[it->second] };
+                if (!is_block_marked_[predecessor_block]) {
+                    is_block_marked_[predecessor_block] = true;
+                    predecessor_blocks.push_back(predecessor_block);
+                }
+            }
+        }
+        for (const size_t predecessor_block: predecessor_blocks) { is_block_marked_[predecessor_block] = false; }
+
+        std::vector<size_t> blocks_inside{};
+        split(remove, blocks_inside);
+        is_block_marked_.resize(blocks_.size());
+        for (const size_t block_inside: blocks_inside) { is_block_marked_[block_inside] = true; }
+        std::vector<size_t> removed_blocks{};
+        for (const size_t predecessor_block: predecessor_blocks) {
+            removed_blocks.clear();
+            std::erase_if(blocks_[predecessor_block].above, [&](const size_t block_above) {
+                if (!is_block_marked_[block_above]) { return false; }
+                removed_blocks.push_back(block_above);
+                return true;
+            });
+            for (const size_t removed_block: removed_blocks) { decrement_counts(predecessor_block, removed_block); }
+        }
+        for (const size_t block_inside: blocks_inside) { is_block_marked_[block_inside] = false; }
+    }
+
+    SimulationRelation SimulationRefinement::compute() {
+        while (!queue_.empty()) {
+            const auto [block, label]{ queue_.back() };
+            queue_.pop_back();
+            process_remove(block, label);
+        }
+        return build_relation();
+    }
+
+    SimulationRelation SimulationRefinement::build_relation() const {
+        // Mutually similar states may end up in different blocks. Merge such blocks into the smallest one.
+        std::vector<size_t> merged_block(blocks_.size());
+        for (size_t block{ 0 }; block < blocks_.size(); ++block) {
+            const std::vector<size_t>& above{ blocks_[block].above };
+            merged_block[block] = *std::find_if(above.begin(), above.end(), [&](const size_t block_above) {
+                const std::vector<size_t>& above_above{ blocks_[block_above].above };
+                return std::binary_search(above_above.begin(), above_above.end(), block);
+            });
+        }
+
+        // Number the merged blocks by their smallest states.
+        std::vector<size_t> block_of_state(num_of_states_, SimulationRelation::NO_BLOCK);
+        std::vector<size_t> new_block(blocks_.size(), SimulationRelation::NO_BLOCK);
+        std::vector<size_t> merged_blocks{};
+        for (State state{ 0 }; state < num_of_states_; ++state) {
+            if (block_of_state_[state] == SimulationRelation::NO_BLOCK) { continue; }
+            const size_t block{ merged_block[block_of_state_[state]] };
+            if (new_block[block] == SimulationRelation::NO_BLOCK) {
+                new_block[block] = merged_blocks.size();
+                merged_blocks.push_back(block);
+            }
+            block_of_state[state] = new_block[block];
+        }
+        std::vector<std::vector<size_t>> blocks_above(merged_blocks.size());
+        for (size_t block{ 0 }; block < merged_blocks.size(); ++block) {
+            for (const size_t block_above: blocks_[merged_blocks[block]].above) {
+                blocks_above[block].push_back(new_block[merged_block[block_above]]);
+            }
+            mata::utils::sort_and_rmdupl(blocks_above[block]);
+        }
+        return SimulationRelation{ std::move(block_of_state), std::move(blocks_above) };
+    }
+
+    SimulationRelation compute_simulation(const Delta& delta, const BoolVector& accepting, const BoolVector& in_domain) {
+        return SimulationRefinement{ delta, accepting, in_domain }.compute();
+    }
+} // namespace.
+
+SimulationRelation mata::nfa::algorithms::compute_simulation(const Nfa& aut, const ParameterMap& params,
+                                                             const StateSet* states) {
+    if (!utils::haskey(params, "direction")) {
+        throw std::runtime_error(std::to_string(__func__) +
+                                 " requires setting the \"direction\" key in the \"params\" argument; "
+                                 "received: " + std::to_string(params));
+    }
+    const std::string& direction = params.at("direction");
+    if (direction != "forward" && direction != "backward") {
+        throw std::runtime_error(std::to_string(__func__) +
+                                 " received an unknown value of the \"direction\" key: " + direction);
+    }
+
+    const size_t num_of_states{ aut.num_of_states() };
+    BoolVector in_domain(num_of_states, states == nullptr);
+    if (states != nullptr) {
+        for (const State state: *states) {
+            if (state < num_of_states) { in_domain[state] = true; }
+        }
+    }
+
+    if (direction == "forward") {
+        BoolVector accepting(num_of_states, false);
+        for (const State state: aut.final) { accepting[state] = true; }
+        return ::compute_simulation(aut.delta, accepting, in_domain);
+    }
+
+    // Backward simulation is the forward simulation over the reverted automaton.
+    const Nfa reverted{ revert(aut) };
+    BoolVector accepting(num_of_states, false);
+    for (const State state: reverted.final) { accepting[state] = true; }
+    return ::compute_simulation(reverted.delta, accepting, in_domain);
+}
@@ -0,0 +1,361 @@
+/* symbolic-nfa.cc -- NFA with transitions guarded by BDDs over bitvector variables.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include "mata/nfa/symbolic-nfa.hh"
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/macrostate-store.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+/// Set of letters leaving a macrostate together with the (sorted) targets reached over each of the letters.
+struct Block {
+    BDD letters;
+    std::vector<State> targets;
+};
+
+void check_shared_manager(const SymbolicNfa& lhs, const SymbolicNfa& rhs, const std::string& function_name) {
+    if (lhs.manager.getManager() != rhs.manager.getManager()) {
+        throw std::runtime_error(function_name + ": automata do not share the BDD manager");
+    }
+}
+
+/**
+ * Compute the local minterms of the moves leaving @p macrostate.
+ *
+ * The guards of the moves to the same target are disjoined first, the merged guards are then used to split the
+ *  letters into blocks with the same set of targets.
+ * @return Pairwise disjoint blocks, each with a nonempty set of targets. Letters outside the blocks lead nowhere.
+ */
+std::vector<Block> compute_blocks(const SymbolicNfa& aut, const std::span<const State> macrostate) {
+    std::vector<std::pair<State, BDD>> guard_of_target{};
+    for (const State state: macrostate) {
+        for (const SymbolicMove& move: aut.moves(state)) { guard_of_target.emplace_back(move.target, move.guard); }
+    }
+    std::stable_sort(guard_of_target.begin(), guard_of_target.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    std::vector<Block> blocks{};
+    std::vector<Block> refined{};
+    BDD covered{ aut.manager.bddZero() };
+    for (auto it{ guard_of_target.begin() }; it != guard_of_target.end();) {
+        const State target{ it->first };
+        BDD guard{ it->second };
+        for (++it; it != guard_of_target.end() && it->first == target; ++it) { guard += it->second; }
+
+        // Targets are processed in an ascending order, hence appending keeps the targets of each block sorted.
+        refined.clear();
+        for (Block& block: blocks) {
+            const BDD inside{ block.letters * guard };
+            if (inside.IsZero()) {
+                refined.push_back(std::move(block));
+                continue;
+            }
+            const BDD outside{ block.letters * !guard };
+            if (!outside.IsZero()) { refined.push_back({ outside, block.targets }); }
+            block.targets.push_back(target);
+            refined.push_back({ inside, std::move(block.targets) });
+        }
+        const BDD uncovered{ guard * !covered };
+        if (!uncovered.IsZero()) { refined.push_back({ uncovered, { target } }); }
+        covered += guard;
+        std::swap(blocks, refined);
+    }
+    return blocks;
+}
+
+} // namespace.
+
+size_t SymbolicNfa::num_of_states() const {
+    return std::max({
+        static_cast<size_t>(initial.domain_size()),
+        static_cast<size_t>(final.domain_size()),
+        posts_.size()
+    });
+}
+
+void SymbolicNfa::add_transition(const State source, const BDD& guard, const State target) {
+    if (guard.IsZero()) { return; }
+    if (posts_.size() <= std::max(source, target)) { posts_.resize(std::max(source, target) + 1); }
+    std::vector<SymbolicMove>& moves{ posts_[source] };
+    const auto it{ std::lower_bound(moves.begin(), moves.end(), target,
+                                    [](const SymbolicMove& move, const State state) { return move.target < state; }) };
+    if (it != moves.end() && it->target == target) {
+        it->guard += guard;
+    } else {
+        moves.insert(it, { guard, target });
+    }
+}
+
+size_t SymbolicNfa::num_of_transitions() const {
+    size_t num_of_transitions{ 0 };
+    for (const std::vector<SymbolicMove>& moves: posts_) { num_of_transitions += moves.size(); }
+    return num_of_transitions;
+}
+
+bool SymbolicNfa::is_deterministic() const {
+    if (initial.size() > 1) { return false; }
+    for (const std::vector<SymbolicMove>& moves: posts_) {
+        for (auto lhs{ moves.begin() }; lhs != moves.end(); ++lhs) {
+            for (auto rhs{ lhs + 1 }; rhs != moves.end(); ++rhs) {
+                if (!(lhs->guard * rhs->guard).IsZero()) { return false; }
+            }
+        }
+    }
+    return true;
+}
+
+bool SymbolicNfa::is_lang_empty(std::vector<BDD>* cex) const {
+    const size_t num_of_states{ this->num_of_states() };
+    std::vector<bool> visited(num_of_states, false);
+    // Parent of each visited state with the guard of the move from the parent, for the counterexample.
+    std::vector<std::pair<State, BDD>> parents(num_of_states);
+    std::vector<State> queue{};
+    for (const State state: initial) {
+        visited[state] = true;
+        parents[state].first = state;
+        queue.push_back(state);
+    }
+    for (size_t head{ 0 }; head < queue.size(); ++head) {
+        State state{ queue[head] };
+        if (final.contains(state)) {
+            if (cex != nullptr) {
+                cex->clear();
+                for (; parents[state].first != state; state = parents[state].first) {
+                    cex->push_back(parents[state].second);
+                }
+                std::reverse(cex->begin(), cex->end());
+            }
+            return false;
+        }
+        for (const SymbolicMove& move: moves(state)) {
+            if (!visited[move.target]) {
+                visited[move.target] = true;
+                parents[move.target] = { state, move.guard };
+                queue.push_back(move.target);
+            }
+        }
+    }
+    return true;
+}
+
+bool SymbolicNfa::is_in_lang(const std::span<const BDD> letters) const {
+    std::vector<State> current(initial.begin(), initial.end());
+    std::sort(current.begin(), current.end());
+    std::vector<State> next{};
+    for (const BDD& letter: letters) {
+        next.clear();
+        for (const State state: current) {
+            for (const SymbolicMove& move: moves(state)) {
+                if (!(move.guard * letter).IsZero()) { next.push_back(move.target); }
+            }
+        }
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        std::swap(current, next);
+        if (current.empty()) { return false; }
+    }
+    return std::any_of(current.begin(), current.end(), [&](const State state) { return final.contains(state); });
+}
+
+SymbolicNfa mata::nfa::intersection(const SymbolicNfa& lhs, const SymbolicNfa& rhs) {
+    check_shared_manager(lhs, rhs, __func__);
+    SymbolicNfa product{ lhs.manager };
+    // Pairs of states are interned as tuples, the identifier of a pair is the product state.
+    TupleStore pairs{};
+    std::vector<State> worklist{};
+    auto get_product_state = [&](const State lhs_state, const State rhs_state) {
+        const State pair[2]{ lhs_state, rhs_state };
+        const auto [product_state, inserted]{ pairs.insert(TupleStore::Tuple{ pair }) };
+        if (inserted) {
+            product.add_state();
+            if (lhs.final.contains(lhs_state) && rhs.final.contains(rhs_state)) { product.final.insert(product_state); }
+            worklist.push_back(product_state);
+        }
+        return static_cast<State>(product_state);
+    };
+
+    for (const State lhs_initial: lhs.initial) {
+        for (const State rhs_initial: rhs.initial) {
+            product.initial.insert(get_product_state(lhs_initial, rhs_initial));
+        }
+    }
+    while (!worklist.empty()) {
+        const State product_state{ worklist.back() };
+        worklist.pop_back();
+        const State lhs_state{ pairs[static_cast<MacrostateId>(product_state)][0] };
+        const State rhs_state{ pairs[static_cast<MacrostateId>(product_state)][1] };
+        for (const SymbolicMove& lhs_move: lhs.moves(lhs_state)) {
+            for (const SymbolicMove& rhs_move: rhs.moves(rhs_state)) {
+                const BDD guard{ lhs_move.guard * rhs_move.guard };
+                if (guard.IsZero()) { continue; }
+                product.add_transition(product_state, guard, get_product_state(lhs_move.target, rhs_move.target));
+            }
+        }
+    }
+    return product;
+}
+
+SymbolicNfa mata::nfa::determinize(const SymbolicNfa& aut) {
+    SymbolicNfa result{ aut.manager };
+    MacrostateStore macrostates{};
+    std::vector<MacrostateId> worklist{};
+    auto get_macrostate = [&](const std::span<const State> macrostate) {
+        const auto [id, inserted]{ macrostates.insert(macrostate) };
+        if (inserted) {
+            result.add_state();
+            if (std::any_of(macrostate.begin(), macrostate.end(),
+                            [&](const State state) { return aut.final.contains(state); })) {
+                result.final.insert(id);
+            }
+            worklist.push_back(id);
+        }
+        return static_cast<State>(id);
+    };
+
+    std::vector<State> initial(aut.initial.begin(), aut.initial.end());
+    if (initial.empty()) { return result; }
+    std::sort(initial.begin(), initial.end());
+    result.initial.insert(get_macrostate(initial));
+    std::vector<State> macrostate{};
+    while (!worklist.empty()) {
+        const MacrostateId id{ worklist.back() };
+        worklist.pop_back();
+        // Copy the macrostate out of the store, the view is invalidated by the insertions below.
+        macrostate.assign(macrostates[id].begin(), macrostates[id].end());
+        for (const Block& block: compute_blocks(aut, macrostate)) {
+            result.add_transition(id, block.letters, get_macrostate(block.targets));
+        }
+    }
+    return result;
+}
+
+bool mata::nfa::is_included(const SymbolicNfa& smaller, const SymbolicNfa& bigger, std::vector<BDD>* cex) {
+    check_shared_manager(smaller, bigger, __func__);
+
+    /// Pair of a state of the smaller automaton and a macrostate of the bigger one, discovered from the pair @c parent
+    ///  over (a letter of) @c letters.
+    struct Node {
+        State state;
+        MacrostateId macrostate;
+        size_t parent;
+        BDD letters;
+    };
+
+    MacrostateStore macrostates{};
+    // Blocks of each macrostate, computed when the macrostate is first expanded.
+    std::vector<std::vector<Block>> blocks_of{};
+    std::vector<bool> is_blocks_computed{};
+    std::vector<bool> is_accepting{};
+    // Visited pairs of a smaller state and a macrostate. Only the discovered pairs are stored, there are usually far
+    //  fewer of them than all the pairs of the discovered macrostates with all the smaller states.
+    std::unordered_set<std::pair<State, MacrostateId>> visited{};
+    auto get_macrostate = [&](const std::span<const State> macrostate) {
+        const auto [id, inserted]{ macrostates.insert(macrostate) };
+        if (inserted) {
+            blocks_of.emplace_back();
+            is_blocks_computed.push_back(false);
+            is_accepting.push_back(std::any_of(macrostate.begin(), macrostate.end(),
+                                               [&](const State state) { return bigger.final.contains(state); }));
+        }
+        return id;
+    };
+
+    std::vector<Node> nodes{};
+    auto visit = [&](const State state, const MacrostateId macrostate, const size_t parent, const BDD& letters) {
+        if (!visited.emplace(state, macrostate).second) { return; }
+        nodes.push_back({ state, macrostate, parent, letters });
+    };
+
+    std::vector<State> initial(bigger.initial.begin(), bigger.initial.end());
+    std::sort(initial.begin(), initial.end());
+    const MacrostateId initial_macrostate{ get_macrostate(initial) };
+    for (const State state: smaller.initial) { visit(state, initial_macrostate, nodes.size(), smaller.manager.bddOne()); }
+
+    std::vector<State> macrostate{};
+    for (size_t head{ 0 }; head < nodes.size(); ++head) {
+        const State state{ nodes[head].state };
+        const MacrostateId id{ nodes[head].macrostate };
+        if (smaller.final.contains(state) && !is_accepting[id]) {
+            if (cex != nullptr) {
+                cex->clear();
+                for (size_t node{ head }; nodes[node].parent != node; node = nodes[node].parent) {
+                    cex->push_back(nodes[node].letters);
+                }
+                std::reverse(cex->begin(), cex->end());
+            }
+            return false;
+        }
+        if (!is_blocks_computed[id]) {
+            macrostate.assign(macrostates[id].begin(), macrostates[id].end());
+            blocks_of[id] = compute_blocks(bigger, macrostate);
+            is_blocks_computed[id] = true;
+        }
+
+        for (const SymbolicMove& move: smaller.moves(state)) {
+            BDD uncovered{ move.guard };
+            // Iterate by index: interning new macrostates reallocates blocks_of.
+            for (size_t i{ 0 }; i < blocks_of[id].size(); ++i) {
+                const BDD letters{ move.guard * blocks_of[id][i].letters };
+                if (letters.IsZero()) { continue; }
+                uncovered -= letters;
+                const std::vector<State> targets{ blocks_of[id][i].targets };
+                visit(move.target, get_macrostate(targets), head, letters);
+            }
+            if (!uncovered.IsZero()) { visit(move.target, get_macrostate({}), head, uncovered); }
+        }
+    }
+    return true;
+}
+
+Nfa mata::nfa::mintermize(const SymbolicNfa& aut, std::vector<BDD>* minterms) {
+    const size_t num_of_states{ aut.num_of_states() };
+    // Guards in the order of their first occurrence, so that the symbols of the minterms do not depend on hashing.
+    std::vector<BDD> guards{};
+    std::unordered_set<BDD> seen_guards{};
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const SymbolicMove& move: aut.moves(source)) {
+            if (seen_guards.insert(move.guard).second) { guards.push_back(move.guard); }
+        }
+    }
+
+    // Refine the set of all letters by each of the guards, keeping only the minterms within some guard.
+    std::vector<BDD> refined{};
+    std::vector<BDD> next{};
+    if (!guards.empty()) { refined.push_back(aut.manager.bddOne()); }
+    for (const BDD& guard: guards) {
+        next.clear();
+        for (const BDD& minterm: refined) {
+            const BDD inside{ minterm * guard };
+            if (!inside.IsZero()) { next.push_back(inside); }
+            const BDD outside{ minterm * !guard };
+            if (!outside.IsZero()) { next.push_back(outside); }
+        }
+        std::swap(refined, next);
+    }
+    std::vector<BDD> symbols{};
+    for (const BDD& minterm: refined) {
+        if (std::any_of(guards.begin(), guards.end(), [&](const BDD& guard) { return minterm.Leq(guard); })) {
+            symbols.push_back(minterm);
+        }
+    }
+
+    Nfa result{ num_of_states };
+    for (const State state: aut.initial) { result.initial.insert(state); }
+    for (const State state: aut.final) { result.final.insert(state); }
+    for (State source{ 0 }; source < num_of_states; ++source) {
+        for (const SymbolicMove& move: aut.moves(source)) {
+            for (Symbol symbol{ 0 }; symbol < symbols.size(); ++symbol) {
+                if (symbols[symbol].Leq(move.guard)) { result.delta.add(source, symbol, move.target); }
+            }
+        }
+    }
+    if (minterms != nullptr) { *minterms = std::move(symbols); }
+    return result;
+}
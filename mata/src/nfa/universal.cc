@@ -5,6 +5,7 @@
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/algorithms.hh"
 #include "mata/utils/sparse-set.hh"
+#include "simulation-subsumption.hh"
 
 using namespace mata::nfa;
 using namespace mata::utils;
@@ -25,23 +26,57 @@ bool mata::nfa::algorithms::is_universal_naive(
 } // is_universal_naive }}}
 
 
-/// universality check using Antichains
-bool mata::nfa::algorithms::is_universal_antichains(
-	const Nfa&         aut,
-	const Alphabet&    alphabet,
-	Run*               cex)
-{ // {{{
+using mata::Symbol;
+using mata::Alphabet;
+using mata::nfa::internal::SimulationSubsumption;
+
+namespace {
+	// Operations on macrostates represented as StateSet or as BitStateSet for small automata.
+	StateSet create_macrostate(const Nfa&, const SparseSet<State>& states, StateSet*) { return StateSet(states); }
+	BitStateSet create_macrostate(const Nfa& aut, const SparseSet<State>& states, BitStateSet*) {
+		return BitStateSet{ aut.num_of_states(), states };
+	}
 
-	using WorklistType = std::list<StateSet>;
-	using ProcessedType = std::list<StateSet>;
+	StateSet post_of(const Nfa& aut, const StateSet& states, const Symbol symbol) { return aut.post(states, symbol); }
+	BitStateSet post_of(const Nfa& aut, const BitStateSet& states, const Symbol symbol) {
+		BitStateSet post{ aut.num_of_states() };
+		states.for_each([&](const State state) {
+			const StatePost& state_post{ aut.delta[state] };
+			if (const auto symbol_post_it{ state_post.find(symbol) }; symbol_post_it != state_post.end()) {
+				post.insert(symbol_post_it->targets);
+			}
+		});
+		return post;
+	}
 
-	auto subsumes = [](const StateSet& lhs, const StateSet& rhs) {
+	bool subsumes(const StateSet& lhs, const StateSet& rhs) {
 		if (lhs.size() > rhs.size()) { // bigger set cannot be subset
 			return false;
 		}
 
 		return std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
-	};
+	}
+	bool subsumes(const BitStateSet& lhs, const BitStateSet& rhs) { return lhs.is_subset_of(rhs); }
+
+	bool intersects_with_final(const Nfa& aut, const StateSet& states, const StateSet&) {
+		return aut.final.intersects_with(states);
+	}
+	bool intersects_with_final(const Nfa&, const BitStateSet& states, const BitStateSet& final_states) {
+		return final_states.intersects_with(states);
+	}
+
+/// universality check using Antichains
+/// With @p simulation, macrostates are minimized and subsumed up to simulation instead of by inclusion.
+template<typename MacroState>
+bool is_universal_antichains(
+	const Nfa&         aut,
+	const Alphabet&    alphabet,
+	Run*               cex,
+	const SimulationSubsumption* simulation = nullptr)
+{ // {{{
+
+	using WorklistType = std::list<MacroState>;
+	using ProcessedType = std::list<MacroState>;
 
 	// process parameters
 	// TODO: set correctly!!!!
@@ -53,19 +88,29 @@ bool mata::nfa::algorithms::is_universal_antichains(
 		return false;
 	}
 
+	// A final state is simulated only by final states, hence minimization keeps some final state in each macrostate
+	//  intersecting with final states.
+	auto minimize = [&](MacroState& macrostate) { if (simulation != nullptr) { simulation->minimize(macrostate); } };
+	auto is_subsumed_by = [&](const MacroState& lhs, const MacroState& rhs) {
+		return simulation != nullptr ? simulation->subsumes(lhs, rhs) : subsumes(lhs, rhs);
+	};
+
 	// initialize
-	WorklistType worklist = { StateSet(aut.initial) };
-	ProcessedType processed = { StateSet(aut.initial) };
+	MacroState initial{ create_macrostate(aut, aut.initial, static_cast<MacroState*>(nullptr)) };
+	minimize(initial);
+	const MacroState final_states{ create_macrostate(aut, aut.final, static_cast<MacroState*>(nullptr)) };
+	WorklistType worklist = { initial };
+	ProcessedType processed = { initial };
 	mata::utils::OrdVector<Symbol> alph_symbols = alphabet.get_alphabet_symbols();
 
 	// 'paths[s] == t' denotes that state 's' was accessed from state 't',
 	// 'paths[s] == s' means that 's' is an initial state
-	std::map<StateSet, std::pair<StateSet, Symbol>> paths =
-		{ {StateSet(aut.initial), {StateSet(aut.initial), 0}} };
+	std::map<MacroState, std::pair<MacroState, Symbol>> paths =
+		{ {initial, {initial, 0}} };
 
 	while (!worklist.empty()) {
 		// get a next state
-		StateSet state;
+		MacroState state;
 		if (is_dfs) {
 			state = *worklist.rbegin();
 			worklist.pop_back();
@@ -76,12 +121,13 @@ bool mata::nfa::algorithms::is_universal_antichains(
 
 		// process it
 		for (Symbol symb : alph_symbols) {
-			StateSet succ = aut.post(state, symb);
-			if (!aut.final.intersects_with(succ)) {
+			MacroState succ = post_of(aut, state, symb);
+			minimize(succ);
+			if (!intersects_with_final(aut, succ, final_states)) {
 				if (nullptr != cex) {
 					cex->word.clear();
 					cex->word.push_back(symb);
-					StateSet trav = state;
+					MacroState trav = state;
 					while (paths[trav].first != trav)
 					{ // go back until initial state
 						cex->word.push_back(paths[trav].second);
@@ -97,7 +143,7 @@ bool mata::nfa::algorithms::is_universal_antichains(
 			bool is_subsumed = false;
 			for (const auto& anti_state : processed) {
 				// trying to find a smaller state in processed
-				if (subsumes(anti_state, succ)) {
+				if (is_subsumed_by(anti_state, succ)) {
 					is_subsumed = true;
 					break;
 				}
@@ -106,10 +152,10 @@ bool mata::nfa::algorithms::is_universal_antichains(
 			if (is_subsumed) { continue; }
 
 			// prune data structures and insert succ inside
-			for (std::list<StateSet>* ds : {&processed, &worklist}) {
+			for (std::list<MacroState>* ds : {&processed, &worklist}) {
 				auto it = ds->begin();
 				while (it != ds->end()) {
-					if (subsumes(succ, *it)) {
+					if (is_subsumed_by(succ, *it)) {
 						auto to_remove = it;
 						++it;
 						ds->erase(to_remove);
@@ -130,10 +176,34 @@ bool mata::nfa::algorithms::is_universal_antichains(
 	return true;
 } // }}}
 
+} // namespace.
+
+/// universality check using Antichains
+bool mata::nfa::algorithms::is_universal_antichains(
+	const Nfa&         aut,
+	const Alphabet&    alphabet,
+	Run*               cex,
+	const size_t       bit_state_set_threshold)
+{ // {{{
+	if (use_bit_state_sets(aut.num_of_states(), bit_state_set_threshold)) {
+		return ::is_universal_antichains<BitStateSet>(aut, alphabet, cex);
+	}
+	return ::is_universal_antichains<StateSet>(aut, alphabet, cex);
+} // }}}
+
+bool mata::nfa::algorithms::is_universal_antichains_simulation(const Nfa& aut, const Alphabet& alphabet, Run* cex,
+                                                               const size_t bit_state_set_threshold) {
+	const SimulationSubsumption simulation{ aut };
+	if (use_bit_state_sets(aut.num_of_states(), bit_state_set_threshold)) {
+		return ::is_universal_antichains<BitStateSet>(aut, alphabet, cex, &simulation);
+	}
+	return ::is_universal_antichains<StateSet>(aut, alphabet, cex, &simulation);
+}
+
 // The dispatching method that calls the correct one based on parameters.
 bool mata::nfa::Nfa::is_universal(const Alphabet& alphabet, Run* cex, const ParameterMap& params) const {
 	// setting the default algorithm
-	decltype(algorithms::is_universal_naive)* algo = algorithms::is_universal_naive;
+	std::function<bool(const Nfa&, const Alphabet&, Run*)> algo = algorithms::is_universal_naive;
 	if (!haskey(params, "algorithm")) {
 		throw std::runtime_error(std::to_string(__func__) +
 			" requires setting the \"algorithm\" key in the \"params\" argument; "
@@ -143,7 +213,16 @@ bool mata::nfa::Nfa::is_universal(const Alphabet& alphabet, Run* cex, const Para
 	const std::string& str_algo = params.at("algorithm");
 	if ("naive" == str_algo) { /* default */ }
 	else if ("antichains" == str_algo) {
-		algo = algorithms::is_universal_antichains;
+		const size_t threshold{ algorithms::get_bit_state_set_threshold(std::to_string(__func__), params) };
+		if (algorithms::use_simulation(std::to_string(__func__), params)) {
+			algo = [threshold](const Nfa& aut, const Alphabet& alphabet, Run* cex) {
+				return algorithms::is_universal_antichains_simulation(aut, alphabet, cex, threshold);
+			};
+		} else {
+			algo = [threshold](const Nfa& aut, const Alphabet& alphabet, Run* cex) {
+				return algorithms::is_universal_antichains(aut, alphabet, cex, threshold);
+			};
+		}
 	} else {
 		throw std::runtime_error(std::to_string(__func__) +
 			" received an unknown value of the \"algorithm\" key: " + str_algo);
@@ -0,0 +1,223 @@
+/* applier.cc -- Application of an NFT to many NFAs, computing their images.
+ */
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "mata/nft/applier.hh"
+#include "mata/nft/nft.hh"
+
+using namespace mata::nft;
+using mata::nfa::Nfa;
+using mata::nfa::StatePost;
+using mata::nfa::SymbolPost;
+using mata::Symbol;
+
+NftApplier::NftApplier(const Nft& nft, const Level input_level, const Level output_level, const JumpMode jump_mode)
+    : input_level_{ input_level }, output_level_{ output_level } {
+    if (input_level == output_level || input_level >= nft.num_of_levels || output_level >= nft.num_of_levels) {
+        throw std::invalid_argument{ "Applying NFT with " + std::to_string(nft.num_of_levels) + " levels on level " +
+                                     std::to_string(input_level) + " to produce level " +
+                                     std::to_string(output_level) + "." };
+    }
+
+    const size_t num_of_states{ nft.num_of_states() };
+    steps_.resize(num_of_states);
+    is_final_ = BoolVector(num_of_states, false);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        if (nft.levels[state] == 0) { collect_steps(nft, state, jump_mode, steps_[state]); }
+    }
+    for (const State state: nft.final) { is_final_[state] = true; }
+    initial_.assign(nft.initial.begin(), nft.initial.end());
+    fold_epsilon_steps();
+    for (const std::vector<Step>& steps: steps_) { num_of_steps_ += steps.size(); }
+}
+
+void NftApplier::collect_steps(const Nft& nft, const State source, const JumpMode jump_mode,
+                               std::vector<Step>& steps) const {
+    // Partial steps: states on levels other than 0 with the symbols read so far on the input and the output level.
+    //  The expansion of a partial step depends only on the step itself, hence each one is expanded only once. Many
+    //  paths through the levels may lead to the same partial step.
+    std::vector<Step> worklist{ { EPSILON, EPSILON, source } };
+    std::set<Step> visited{ worklist.front() };
+    while (!worklist.empty()) {
+        const Step partial{ worklist.back() };
+        worklist.pop_back();
+        const Level level{ nft.levels[partial.target] };
+        for (const SymbolPost& symbol_post: nft.delta[partial.target]) {
+            for (const State target: symbol_post.targets) {
+                const Level target_level{ nft.levels[target] == 0 ? static_cast<Level>(nft.num_of_levels)
+                                                                  : nft.levels[target] };
+                if (target_level <= level) { continue; }
+                // Symbol of the transition (a jump over levels level, ..., target_level - 1) on the given level.
+                const auto symbol_on = [&](const Level on_level, const Symbol symbol_so_far) {
+                    if (on_level < level || target_level <= on_level) { return symbol_so_far; }
+                    if (on_level == level || jump_mode == JumpMode::RepeatSymbol) { return symbol_post.symbol; }
+                    return DONT_CARE;
+                };
+                const Step next{ symbol_on(input_level_, partial.input), symbol_on(output_level_, partial.output),
+                                 target };
+                if (!visited.insert(next).second) { continue; }
+                if (nft.levels[target] == 0) {
+                    steps.push_back(next);
+                } else {
+                    worklist.push_back(next);
+                }
+            }
+        }
+    }
+    std::sort(steps.begin(), steps.end());
+}
+
+void NftApplier::fold_epsilon_steps() {
+    const auto is_epsilon_step = [](const Step& step) { return step.input == EPSILON && step.output == EPSILON; };
+    const bool has_epsilon_steps{ std::any_of(steps_.begin(), steps_.end(), [&](const std::vector<Step>& steps) {
+        return std::any_of(steps.begin(), steps.end(), is_epsilon_step);
+    }) };
+    if (!has_epsilon_steps) { return; }
+
+    const size_t num_of_states{ steps_.size() };
+    std::vector<std::vector<Step>> folded_steps(num_of_states);
+    BoolVector folded_is_final(num_of_states, false);
+    std::vector<State> closure{};
+    BoolVector in_closure(num_of_states, false);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        if (steps_[state].empty()) {
+            folded_is_final[state] = is_final_[state];
+            continue;
+        }
+        closure.assign({ state });
+        in_closure[state] = true;
+        for (size_t i{ 0 }; i < closure.size(); ++i) {
+            for (const Step& step: steps_[closure[i]]) {
+                if (is_epsilon_step(step) && !in_closure[step.target]) {
+                    in_closure[step.target] = true;
+                    closure.push_back(step.target);
+                }
+            }
+        }
+        std::vector<Step>& steps{ folded_steps[state] };
+        for (const State closure_state: closure) {
+            in_closure[closure_state] = false;
+            if (is_final_[closure_state]) { folded_is_final[state] = true; }
+            std::copy_if(steps_[closure_state].begin(), steps_[closure_state].end(), std::back_inserter(steps),
+                         [&](const Step& step) { return !is_epsilon_step(step); });
+        }
+        std::sort(steps.begin(), steps.end());
+        steps.erase(std::unique(steps.begin(), steps.end()), steps.end());
+    }
+    steps_ = std::move(folded_steps);
+    is_final_ = std::move(folded_is_final);
+}
+
+bool NftApplier::explore(const Nfa& nfa, Nfa* image) const {
+    // States of the product are pairs (state of the NFA, state of the NFT on level 0).
+    std::unordered_map<std::pair<State, State>, State> product_states{};
+    std::vector<std::pair<State, State>> pairs{};
+    std::vector<State> worklist{};
+    bool reached_final{ false };
+    const auto get_state = [&](const State nfa_state, const State nft_state) {
+        const auto [it, inserted]{ product_states.emplace(std::make_pair(nfa_state, nft_state), pairs.size()) };
+        if (inserted) {
+            pairs.emplace_back(nfa_state, nft_state);
+            worklist.push_back(it->second);
+            if (nfa.final.contains(nfa_state) && is_final_[nft_state]) {
+                reached_final = true;
+                if (image != nullptr) { image->final.insert(it->second); }
+            }
+        }
+        return it->second;
+    };
+
+    for (const State nfa_initial: nfa.initial) {
+        for (const State nft_initial: initial_) {
+            const State initial{ get_state(nfa_initial, nft_initial) };
+            if (image != nullptr) { image->initial.insert(initial); }
+        }
+    }
+
+    std::vector<std::pair<Symbol, State>> transitions{};
+    const auto add_transition = [&](const Symbol symbol, const State nfa_target, const State nft_target) {
+        const State target{ get_state(nfa_target, nft_target) };
+        if (image != nullptr) { transitions.emplace_back(symbol, target); }
+    };
+    while (!worklist.empty() && (image != nullptr || !reached_final)) {
+        const State source{ worklist.back() };
+        worklist.pop_back();
+        const auto [nfa_state, nft_state]{ pairs[source] };
+        const std::vector<Step>& steps{ steps_[nft_state] };
+        transitions.clear();
+
+        for (const SymbolPost& symbol_post: nfa.delta[nfa_state]) {
+            if (symbol_post.symbol == EPSILON) {
+                // The NFA moves alone.
+                for (const State nfa_target: symbol_post.targets) { add_transition(EPSILON, nfa_target, nft_state); }
+                continue;
+            }
+            auto first{ steps.begin() };
+            auto last{ steps.end() };
+            if (symbol_post.symbol == DONT_CARE) {
+                // DONT_CARE of the NFA reads any input symbol of the NFT (other than DONT_CARE, handled below), or
+                //  epsilon (the NFA moves alone), as in compose().
+                for (const State nfa_target: symbol_post.targets) { add_transition(EPSILON, nfa_target, nft_state); }
+                last = std::lower_bound(steps.begin(), steps.end(), DONT_CARE,
+                                        [](const Step& step, const Symbol symbol) { return step.input < symbol; });
+            } else {
+                std::tie(first, last) = std::equal_range(
+                    steps.begin(), steps.end(), Step{ symbol_post.symbol, 0, 0 },
+                    [](const Step& lhs, const Step& rhs) { return lhs.input < rhs.input; });
+            }
+            for (auto step{ first }; step != last; ++step) {
+                for (const State nfa_target: symbol_post.targets) {
+                    add_transition(step->output, nfa_target, step->target);
+                }
+            }
+        }
+        // Steps reading DONT_CARE (any symbol of the NFA) and epsilon (the NFT moves alone) are at the end.
+        for (auto step{ std::lower_bound(steps.begin(), steps.end(), Step{ DONT_CARE, 0, 0 }) }; step != steps.end();
+             ++step) {
+            // DONT_CARE reads also epsilon, as in compose().
+            add_transition(step->output, nfa_state, step->target);
+            if (step->input == EPSILON) { continue; }
+            for (const SymbolPost& symbol_post: nfa.delta[nfa_state]) {
+                if (symbol_post.symbol == EPSILON) { continue; }
+                for (const State nfa_target: symbol_post.targets) {
+                    add_transition(step->output, nfa_target, step->target);
+                }
+            }
+        }
+
+        if (image != nullptr) {
+            image->delta.mutable_state_post(source).append_moves(transitions);
+        }
+    }
+    return reached_final;
+}
+
+Nfa NftApplier::apply(const Nfa& nfa) const {
+    Nfa image{};
+    explore(nfa, &image);
+    image.trim();
+    return image;
+}
+
+std::vector<Nfa> NftApplier::apply(const std::span<const Nfa> nfas, size_t num_of_threads) const {
+    std::vector<Nfa> images(nfas.size());
+    if (num_of_threads == 0) { num_of_threads = std::max(std::thread::hardware_concurrency(), 1U); }
+    num_of_threads = std::max<size_t>(std::min(num_of_threads, nfas.size()), 1);
+    // Each thread computes the images of every num_of_threads-th NFA.
+    const auto worker = [&](const size_t thread_idx) {
+        for (size_t i{ thread_idx }; i < nfas.size(); i += num_of_threads) { images[i] = apply(nfas[i]); }
+    };
+    std::vector<std::thread> threads{};
+    threads.reserve(num_of_threads - 1);
+    for (size_t thread_idx{ 1 }; thread_idx < num_of_threads; ++thread_idx) { threads.emplace_back(worker, thread_idx); }
+    worker(0);
+    for (std::thread& thread: threads) { thread.join(); }
+    return images;
+}
+
+bool NftApplier::is_image_empty(const Nfa& nfa) const { return !explore(nfa, nullptr); }
@@ -3,6 +3,7 @@
 #include "mata/utils/utils.hh"
 #include "mata/utils/sparse-set.hh"
 #include "mata/nft/builder.hh"
+#include "mata/nfa/binary-format.hh"
 
 #include <fstream>
 
@@ -279,6 +280,25 @@ Nft builder::parse_from_mata(const std::string& nft_in_mata) {
     return parse_from_mata(nft_stream);
 }
 
+Nft builder::mmap_binary(const std::filesystem::path& path, OnTheFlyAlphabet* alphabet) {
+    const nfa::binary::MappedAutomaton mapped{ path };
+    if (mapped.kind() != nfa::binary::AutomatonKind::NFT) {
+        throw std::runtime_error("The type of automaton in file '" + path.string() + "' is not 'NFT'");
+    }
+    const std::span<const uint64_t> mapped_levels{ mapped.levels() };
+    Levels levels(mapped_levels.size());
+    for (size_t state{ 0 }, num_of_states{ mapped_levels.size() }; state < num_of_states; ++state) {
+        levels[state] = static_cast<Level>(mapped_levels[state]);
+    }
+    Nft nft{ mapped.get_delta(), mapped.get_initial(), mapped.get_final(), std::move(levels),
+             mapped.header().num_of_levels };
+    if (alphabet != nullptr && mapped.has_alphabet()) {
+        mapped.fill_alphabet(*alphabet);
+        nft.alphabet = alphabet;
+    }
+    return nft;
+}
+
 Nft builder::create_from_nfa(const mata::nfa::Nfa& nfa, const size_t num_of_levels, std::optional<Symbol> next_levels_symbol, const std::set<Symbol>& epsilons) {
     const Level num_of_additional_states_per_nfa_trans{ static_cast<Level>(num_of_levels) - 1 };
     Nft nft{};
@@ -23,12 +23,12 @@ Nft mata::nft::algorithms::complement_classical(const Nft& aut, const OrdVector<
             sink_state = result.num_of_states();
         }
     } else {
-        std::unordered_map<StateSet, State> subset_map;
-        result = determinize(aut, &subset_map);
+        MacrostateStore macrostates;
+        result = determinize(aut, &macrostates);
         // check if a sink state was not created during determinization
-        auto sink_state_iter = subset_map.find({});
-        if (sink_state_iter != subset_map.end()) {
-            sink_state = sink_state_iter->second;
+        const MacrostateId sink_macrostate = macrostates.find(StateSet{});
+        if (sink_macrostate != MacrostateStore::NOT_FOUND) {
+            sink_state = sink_macrostate;
         } else {
             sink_state = result.num_of_states();
         }
@@ -3,7 +3,9 @@
 
 // MATA headers
 #include "mata/nft/nft.hh"
+#include "mata/nft/algorithms.hh"
 #include <cassert>
+#include <optional>
 
 
 using namespace mata::utils;
@@ -12,28 +14,19 @@ using namespace mata::utils;
 namespace mata::nft
 {
 
-Nft compose(const Nft& lhs, const Nft& rhs, const OrdVector<Level>& lhs_sync_levels, const OrdVector<Level>& rhs_sync_levels, const JumpMode jump_mode) {
-    assert(!lhs_sync_levels.empty());
-    assert(lhs_sync_levels.size() == rhs_sync_levels.size());
+namespace {
 
-    // Inserts loop into the given Nft for each state with level 0.
-    // The loop word is constructed using the EPSILON symbol for all levels, except for the levels
-    // where is_dcare_on_transition is true, in which case the DONT_CARE symbol is used.
-    auto insert_self_loops = [&](Nft &nft, const BoolVector &is_dcare_on_transition) {
-        Word loop_word(nft.num_of_levels, EPSILON);
-        for (size_t i{ 0 }; i < nft.num_of_levels; i++) {
-            if (is_dcare_on_transition[i]) {
-                loop_word[i] = DONT_CARE;
-            }
-        }
-
-        for (State s{ 0 }; s < nft.num_of_states(); s++) {
-            if (nft.levels[s]== 0) {
-                nft.insert_word(s, loop_word, s);
-            }
-        }
-    };
+/**
+ * Masks of levels inserted into @c lhs and @c rhs to align their synchronization levels, and the synchronization levels
+ *  after the insertion (levels to project out).
+ */
+struct SyncMasks {
+    BoolVector lhs_new_levels_mask{};
+    BoolVector rhs_new_levels_mask{};
+    OrdVector<Level> levels_to_project_out{};
+};
 
+SyncMasks compute_sync_masks(const Nft& lhs, const Nft& rhs, const OrdVector<Level>& lhs_sync_levels, const OrdVector<Level>& rhs_sync_levels) {
     // Calculate new_levels_mask, which is used for inserting levels to match the synchronization
     // transitions in lhs and rhs. It also calculates the vector levels_to_project_out, which contains
     // levels of synchronized transitions. These levels will be projected out from the Nft after the composition.
@@ -81,6 +74,285 @@ Nft compose(const Nft& lhs, const Nft& rhs, const OrdVector<Level>& lhs_sync_lev
     rhs_new_levels_mask.insert(rhs_new_levels_mask.end(), rhs_suffix_len, false);
     lhs_new_levels_mask.insert(lhs_new_levels_mask.end(), biggest_suffix_len - lhs_suffix_len, true);
     rhs_new_levels_mask.insert(rhs_new_levels_mask.end(), biggest_suffix_len - rhs_suffix_len, true);
+    return { std::move(lhs_new_levels_mask), std::move(rhs_new_levels_mask), std::move(levels_to_project_out) };
+}
+
+/**
+ * On-the-fly composition of two NFTs.
+ *
+ * Both operands are read level by level in the common frame of levels given by the masks of @c compute_sync_masks(),
+ *  without materializing the operands with the inserted levels, their self-loops, or the product. Each operand is
+ *  represented by a cursor: a state waiting for its level, a transition (possibly a jump) in progress, or a self-loop
+ *  reading epsilons on the levels of the operand (so that the other operand can read or write without the operand
+ *  moving). Inserted levels read @c DONT_CARE. The synchronization levels are projected out on the fly: only the
+ *  configurations on the first level after the previous non-synchronization level become states of the result, and
+ *  the synchronization levels are folded into the transitions of the result.
+ */
+class Composition {
+public:
+    Composition(const Nft& lhs, const Nft& rhs, const SyncMasks& masks, const JumpMode jump_mode)
+        : lhs_{ lhs, masks.lhs_new_levels_mask }, rhs_{ rhs, masks.rhs_new_levels_mask }, jump_mode_{ jump_mode },
+          num_of_levels_{ static_cast<Level>(masks.lhs_new_levels_mask.size()) },
+          projected_(num_of_levels_, false), levels_before_(num_of_levels_ + 1, 0), moves_(num_of_levels_) {
+        for (const Level level: masks.levels_to_project_out) { projected_[level] = true; }
+        for (Level level{ 0 }; level < num_of_levels_; ++level) {
+            levels_before_[level + 1] = static_cast<Level>(levels_before_[level] + (projected_[level] ? 0 : 1));
+        }
+        result_.num_of_levels = levels_before_[num_of_levels_];
+    }
+
+    /// Number of levels of the result, i.e., the levels not projected out.
+    size_t num_of_result_levels() const { return result_.num_of_levels; }
+
+    Nft compute() {
+        for (const State lhs_initial: lhs_.nft.initial) {
+            for (const State rhs_initial: rhs_.nft.initial) {
+                result_.initial.insert(get_state(0, Cursor{ lhs_initial }, Cursor{ rhs_initial }));
+            }
+        }
+        std::vector<std::pair<Symbol, State>> transitions{};
+        while (!worklist_.empty()) {
+            const State source{ worklist_.back() };
+            worklist_.pop_back();
+            const Configuration configuration{ configurations_[source] };
+            transitions.clear();
+            visited_.clear();
+            expand(configuration.level, configuration.lhs, configuration.rhs, std::nullopt, transitions);
+
+            result_.delta.mutable_state_post(source).append_moves(transitions);
+        }
+        result_.trim();
+        return std::move(result_);
+    }
+
+private:
+    enum class CursorKind : uint8_t {
+        Waiting, ///< In a state, waiting for its level.
+        Moving, ///< On a transition (possibly a jump) to the state.
+        Looping, ///< On the self-loop of a state on level 0 reading epsilons.
+    };
+
+    struct Cursor {
+        State state;
+        Symbol symbol{ 0 };
+        CursorKind kind{ CursorKind::Waiting };
+
+        bool operator==(const Cursor&) const = default;
+    };
+
+    struct Move {
+        Symbol symbol;
+        Cursor next;
+        bool is_loop;
+    };
+
+    struct Configuration {
+        Level level;
+        Cursor lhs;
+        Cursor rhs;
+
+        bool operator==(const Configuration&) const = default;
+    };
+
+    struct ConfigurationHash {
+        size_t operator()(const Configuration& configuration) const {
+            size_t hash{ std::hash<Level>{}(configuration.level) };
+            for (const Cursor& cursor: { configuration.lhs, configuration.rhs }) {
+                hash = hash_combine(hash, cursor.state);
+                hash = hash_combine(hash, cursor.symbol);
+                hash = hash_combine(hash, static_cast<uint8_t>(cursor.kind));
+            }
+            return hash;
+        }
+    };
+
+    struct VisitedHash {
+        size_t operator()(const std::pair<Configuration, Symbol>& visited) const {
+            return hash_combine(ConfigurationHash{}(visited.first), visited.second);
+        }
+    };
+
+    /// Operand with the position of each of its levels in the common frame of levels.
+    struct Operand {
+        const Nft& nft;
+        /// Whether the operand reads on each level of the common frame (false for the inserted levels).
+        BoolVector is_own_level;
+        /// Level in the common frame of each level of the operand.
+        std::vector<Level> position{};
+
+        Operand(const Nft& nft, const BoolVector& new_levels_mask)
+            : nft{ nft }, is_own_level(new_levels_mask.size(), false) {
+            for (Level level{ 0 }; level < new_levels_mask.size(); ++level) {
+                is_own_level[level] = !new_levels_mask[level];
+                if (is_own_level[level]) { position.push_back(level); }
+            }
+        }
+
+        /// Level in the common frame at which a transition (or the self-loop) to @p target ends.
+        Level get_end(const State target, const Level num_of_levels) const {
+            const Level level{ nft.levels[target] };
+            return level == 0 ? num_of_levels : position[level];
+        }
+    };
+
+    const Operand lhs_;
+    const Operand rhs_;
+    const JumpMode jump_mode_;
+    /// Number of levels in the common frame.
+    const Level num_of_levels_;
+    /// Whether each level of the common frame is projected out.
+    BoolVector projected_;
+    /// Number of levels of the common frame lower than each level which are not projected out.
+    std::vector<Level> levels_before_;
+    /// Buffers for moves of both operands on each level of the common frame.
+    std::vector<std::pair<std::vector<Move>, std::vector<Move>>> moves_;
+
+    Nft result_{};
+    std::unordered_map<Configuration, State, ConfigurationHash> states_{};
+    std::vector<Configuration> configurations_{};
+    std::vector<State> worklist_{};
+    /// Configurations visited during the expansion of a state of the result, with the symbol read so far.
+    std::unordered_set<std::pair<Configuration, Symbol>, VisitedHash> visited_{};
+
+    State get_state(const Level level, const Cursor& lhs, const Cursor& rhs) {
+        const Configuration configuration{ level, lhs, rhs };
+        const auto [it, inserted]{ states_.try_emplace(configuration, 0) };
+        if (inserted) {
+            it->second = result_.add_state_with_level(levels_before_[level]);
+            configurations_.push_back(configuration);
+            worklist_.push_back(it->second);
+            if (level == 0 && lhs_.nft.final.contains(lhs.state) && rhs_.nft.final.contains(rhs.state)) {
+                result_.final.insert(it->second);
+            }
+        }
+        return it->second;
+    }
+
+    /// Move @p cursor over @p level. Returns nothing for a transition not ending after @p level.
+    std::optional<Cursor> advance(const Operand& operand, const Cursor& cursor, const Level level) const {
+        const Level end{ operand.get_end(cursor.state, num_of_levels_) };
+        if (end <= level) { return std::nullopt; }
+        if (end == level + 1) { return Cursor{ cursor.state }; }
+        return cursor;
+    }
+
+    /// Compute moves of @p operand at @p cursor over @p level into @p moves, sorted by their symbols.
+    void get_moves(const Operand& operand, const Cursor& cursor, const Level level, std::vector<Move>& moves) const {
+        moves.clear();
+        const bool is_own_level{ operand.is_own_level[level] != 0 };
+        switch (cursor.kind) {
+            case CursorKind::Waiting: {
+                const Level state_level{ operand.nft.levels[cursor.state] };
+                if (level < operand.position[state_level]) {
+                    // Inserted levels before the first level of the operand.
+                    moves.push_back({ DONT_CARE, cursor, false });
+                    return;
+                }
+                for (const SymbolPost& symbol_post: operand.nft.delta[cursor.state]) {
+                    for (const State target: symbol_post.targets) {
+                        const std::optional<Cursor> next{
+                            advance(operand, Cursor{ target, symbol_post.symbol, CursorKind::Moving }, level) };
+                        if (next.has_value()) { moves.push_back({ symbol_post.symbol, *next, false }); }
+                    }
+                }
+                if (state_level == 0) {
+                    const std::optional<Cursor> next{
+                        advance(operand, Cursor{ cursor.state, EPSILON, CursorKind::Looping }, level) };
+                    if (next.has_value()) { moves.push_back({ EPSILON, *next, true }); }
+                }
+                return;
+            }
+            case CursorKind::Moving: {
+                const Symbol symbol{ (is_own_level && jump_mode_ == JumpMode::RepeatSymbol) ? cursor.symbol : DONT_CARE };
+                moves.push_back({ symbol, *advance(operand, cursor, level), false });
+                return;
+            }
+            case CursorKind::Looping:
+                moves.push_back({ is_own_level ? EPSILON : DONT_CARE, *advance(operand, cursor, level), true });
+                return;
+        }
+    }
+
+    /// Expand the configuration at @p level with @p symbol read so far, collecting the reached states of the result
+    ///  into @p transitions.
+    void expand(const Level level, const Cursor& lhs, const Cursor& rhs, const std::optional<Symbol> symbol,
+                std::vector<std::pair<Symbol, State>>& transitions) {
+        if (symbol.has_value()) {
+            if (level == num_of_levels_) {
+                transitions.emplace_back(*symbol, get_state(0, lhs, rhs));
+                return;
+            }
+            if (levels_before_[level] < result_.num_of_levels) {
+                transitions.emplace_back(*symbol, get_state(level, lhs, rhs));
+                return;
+            }
+        }
+        if (!visited_.emplace(Configuration{ level, lhs, rhs }, symbol.value_or(EPSILON)).second) { return; }
+
+        auto& [lhs_moves, rhs_moves]{ moves_[level] };
+        get_moves(lhs_, lhs, level, lhs_moves);
+        get_moves(rhs_, rhs, level, rhs_moves);
+        auto process_pair = [&](const Symbol product_symbol, const Move& lhs_move, const Move& rhs_move) {
+            // Both operands can not wait in their self-loops at the same time.
+            if (lhs_move.is_loop && rhs_move.is_loop) { return; }
+            expand(level + 1, lhs_move.next, rhs_move.next, projected_[level] ? symbol : product_symbol, transitions);
+        };
+
+        // Moves over the same symbols.
+        for (auto lhs_it{ lhs_moves.begin() }, rhs_it{ rhs_moves.begin() };
+             lhs_it != lhs_moves.end() && rhs_it != rhs_moves.end();) {
+            if (lhs_it->symbol < rhs_it->symbol) { ++lhs_it; continue; }
+            if (rhs_it->symbol < lhs_it->symbol) { ++rhs_it; continue; }
+            const Symbol current{ lhs_it->symbol };
+            auto rhs_end{ rhs_it };
+            while (rhs_end != rhs_moves.end() && rhs_end->symbol == current) { ++rhs_end; }
+            for (; lhs_it != lhs_moves.end() && lhs_it->symbol == current; ++lhs_it) {
+                for (auto it{ rhs_it }; it != rhs_end; ++it) { process_pair(current, *lhs_it, *it); }
+            }
+            rhs_it = rhs_end;
+        }
+        // Moves over DONT_CARE with moves over specific symbols.
+        for (const Move& lhs_move: lhs_moves) {
+            if (lhs_move.symbol != DONT_CARE) { continue; }
+            for (const Move& rhs_move: rhs_moves) {
+                if (rhs_move.symbol != DONT_CARE) { process_pair(rhs_move.symbol, lhs_move, rhs_move); }
+            }
+        }
+        for (const Move& rhs_move: rhs_moves) {
+            if (rhs_move.symbol != DONT_CARE) { continue; }
+            for (const Move& lhs_move: lhs_moves) {
+                if (lhs_move.symbol != DONT_CARE) { process_pair(lhs_move.symbol, lhs_move, rhs_move); }
+            }
+        }
+    }
+}; // class Composition.
+
+} // namespace.
+
+Nft algorithms::compose_naive(const Nft& lhs, const Nft& rhs, const OrdVector<Level>& lhs_sync_levels, const OrdVector<Level>& rhs_sync_levels, const JumpMode jump_mode) {
+    assert(!lhs_sync_levels.empty());
+    assert(lhs_sync_levels.size() == rhs_sync_levels.size());
+
+    // Inserts loop into the given Nft for each state with level 0.
+    // The loop word is constructed using the EPSILON symbol for all levels, except for the levels
+    // where is_dcare_on_transition is true, in which case the DONT_CARE symbol is used.
+    auto insert_self_loops = [&](Nft &nft, const BoolVector &is_dcare_on_transition) {
+        Word loop_word(nft.num_of_levels, EPSILON);
+        for (size_t i{ 0 }; i < nft.num_of_levels; i++) {
+            if (is_dcare_on_transition[i]) {
+                loop_word[i] = DONT_CARE;
+            }
+        }
+
+        for (State s{ 0 }; s < nft.num_of_states(); s++) {
+            if (nft.levels[s]== 0) {
+                nft.insert_word(s, loop_word, s);
+            }
+        }
+    };
+
+    const auto [lhs_new_levels_mask, rhs_new_levels_mask, levels_to_project_out]{
+        compute_sync_masks(lhs, rhs, lhs_sync_levels, rhs_sync_levels) };
 
     Nft lhs_synced = insert_levels(lhs, lhs_new_levels_mask, jump_mode);
     Nft rhs_synced = insert_levels(rhs, rhs_new_levels_mask, jump_mode);
@@ -97,6 +369,19 @@ Nft compose(const Nft& lhs, const Nft& rhs, const OrdVector<Level>& lhs_sync_lev
     return result;
 }
 
+Nft compose(const Nft& lhs, const Nft& rhs, const OrdVector<Level>& lhs_sync_levels, const OrdVector<Level>& rhs_sync_levels, const JumpMode jump_mode) {
+    assert(!lhs_sync_levels.empty());
+    assert(lhs_sync_levels.size() == rhs_sync_levels.size());
+
+    const SyncMasks masks{ compute_sync_masks(lhs, rhs, lhs_sync_levels, rhs_sync_levels) };
+    Composition composition{ lhs, rhs, masks, jump_mode };
+    if (composition.num_of_result_levels() == 0) {
+        // All levels are synchronized, the result has no levels to construct on the fly.
+        return algorithms::compose_naive(lhs, rhs, lhs_sync_levels, rhs_sync_levels, jump_mode);
+    }
+    return composition.compute();
+}
+
 Nft compose(const Nft& lhs, const Nft& rhs, const Level lhs_sync_level, const Level rhs_sync_level, const JumpMode jump_mode) {
     return compose(lhs, rhs, OrdVector{ lhs_sync_level }, OrdVector{ rhs_sync_level }, jump_mode);
 }
@@ -10,6 +10,7 @@
 #include "mata/utils/sparse-set.hh"
 #include "mata/nft/nft.hh"
 #include "mata/nft/algorithms.hh"
+#include "mata/nfa/binary-format.hh"
 #include <mata/simlib/explicit_lts.hh>
 
 using namespace mata::utils;
@@ -146,6 +147,13 @@ std::string Nft::print_to_mata() const {
     return output.str();
 }
 
+void Nft::save_binary(const std::filesystem::path& path, const Alphabet* alphabet) const {
+    // Levels are not required to be set for all states, the missing ones are the default level.
+    std::vector<uint64_t> state_levels(num_of_states(), DEFAULT_LEVEL);
+    std::copy_n(levels.begin(), std::min(levels.size(), state_levels.size()), state_levels.begin());
+    nfa::binary::save(path, *this, nfa::binary::AutomatonKind::NFT, state_levels, num_of_levels, alphabet);
+}
+
 void Nft::print_to_mata(std::ostream &output) const {
     output << "@NFT-explicit" << std::endl
            << "%Alphabet-auto" << std::endl;
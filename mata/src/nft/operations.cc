@@ -12,9 +12,9 @@
 #include "mata/utils/sparse-set.hh"
 #include "mata/nft/nft.hh"
 #include "mata/nft/algorithms.hh"
+#include "mata/nfa/algorithms.hh"
 #include "mata/nft/builder.hh"
 #include "mata/nft/strings.hh"
-#include <mata/simlib/explicit_lts.hh>
 
 using std::tie;
 
@@ -27,35 +27,13 @@ using mata::Symbol;
 using StateBoolArray = std::vector<bool>; ///< Bool array for states in the automaton.
 
 namespace {
-    Simlib::Util::BinaryRelation compute_fw_direct_simulation(const Nft& aut) {
-        Symbol maxSymbol{ aut.delta.get_max_symbol() };
-        const size_t state_num{ aut.num_of_states() };
-        Simlib::ExplicitLTS LTSforSimulation(state_num);
-
-        for (const Transition& transition : aut.delta.transitions()) {
-            LTSforSimulation.add_transition(transition.source, transition.symbol, transition.target);
-        }
-
-        // final states cannot be simulated by nonfinal -> we add new selfloops over final states with new symbol in LTS
-        for (State finalState : aut.final) {
-            LTSforSimulation.add_transition(finalState, maxSymbol + 1, finalState);
-        }
-
-        LTSforSimulation.init();
-        return LTSforSimulation.compute_simulation();
-    }
-
     Nft reduce_size_by_simulation(const Nft& aut, StateRenaming &state_renaming) {
         Nft result;
-        const auto sim_relation = algorithms::compute_relation(
-                aut, ParameterMap{{ "relation", "simulation"}, { "direction", "forward"}});
-
-        auto sim_relation_symmetric = sim_relation;
-        sim_relation_symmetric.restrict_to_symmetric();
+        const nfa::SimulationRelation sim_relation = nfa::algorithms::compute_simulation(
+                aut, {{ "direction", "forward" }});
 
         // for State q, quot_proj[q] should be the representative state representing the symmetric class of states in simulation
-        std::vector<size_t> quot_proj;
-        sim_relation_symmetric.get_quotient_projection(quot_proj);
+        const std::vector<size_t> quot_proj = sim_relation.get_quotient_projection();
 
         const size_t num_of_states = aut.num_of_states();
 
@@ -118,65 +96,9 @@ namespace {
     }
 }
 
-//TODO: based on the comments inside, this function needs to be rewritten in a more optimal way.
 Nft mata::nft::remove_epsilon(const Nft& aut, Symbol epsilon) {
-    // cannot use multimap, because it can contain multiple occurrences of (a -> a), (a -> a)
-    std::unordered_map<State, StateSet> eps_closure;
-
-    // TODO: grossly inefficient
-    // first we compute the epsilon closure
-    const size_t num_of_states{aut.num_of_states() };
-    for (size_t i{ 0 }; i < num_of_states; ++i)
-    {
-        for (const auto& trans: aut.delta[i])
-        { // initialize
-            const auto it_ins_pair = eps_closure.insert({i, {i}});
-            if (trans.symbol == epsilon)
-            {
-                StateSet& closure = it_ins_pair.first->second;
-                // TODO: Fix possibly insert to OrdVector. Create list already ordered, then merge (do not need to resize each time);
-                closure.insert(trans.targets);
-            }
-        }
-    }
-
-    bool changed = true;
-    while (changed) { // Compute the fixpoint.
-        changed = false;
-        for (size_t i = 0; i < num_of_states; ++i) {
-            const StatePost& post{ aut.delta[i] };
-            const auto eps_move_it { post.find(epsilon) };//TODO: make faster if default epsilon
-            if (eps_move_it != post.end()) {
-                StateSet& src_eps_cl = eps_closure[i];
-                for (const State tgt: eps_move_it->targets) {
-                    const StateSet& tgt_eps_cl = eps_closure[tgt];
-                    for (const State st: tgt_eps_cl) {
-                        if (src_eps_cl.count(st) == 0) {
-                            changed = true;
-                            break;
-                        }
-                    }
-                    src_eps_cl.insert(tgt_eps_cl);
-                }
-            }
-        }
-    }
-
-    // Construct the automaton without epsilon transitions.
     Nft result{ Delta{}, aut.initial, aut.final, aut.levels, aut.num_of_levels, aut.alphabet };
-    for (const auto& state_closure_pair : eps_closure) { // For every state.
-        State src_state = state_closure_pair.first;
-        for (State eps_cl_state : state_closure_pair.second) { // For every state in its epsilon closure.
-            if (aut.final[eps_cl_state]) result.final.insert(src_state);
-            for (const SymbolPost& move : aut.delta[eps_cl_state]) {
-                if (move.symbol == epsilon) continue;
-                // TODO: this could be done more efficiently if we had a better add method
-                for (State tgt_state : move.targets) {
-                    result.delta.add(src_state, move.symbol, tgt_state);
-                }
-            }
-        }
-    }
+    nfa::algorithms::remove_epsilon(aut, epsilon, result);
     return result;
 }
 
@@ -799,9 +721,8 @@ Simlib::Util::BinaryRelation mata::nft::algorithms::compute_relation(const Nft&
     }
 
     const std::string& relation = params.at("relation");
-    const std::string& direction = params.at("direction");
-    if ("simulation" == relation && direction == "forward") {
-        return compute_fw_direct_simulation(aut);
+    if ("simulation" == relation) {
+        return nfa::algorithms::compute_simulation(aut, params).to_binary_relation();
     }
     else {
         throw std::runtime_error(std::to_string(__func__) +
@@ -836,15 +757,20 @@ Nft mata::nft::reduce(const Nft &aut, StateRenaming *state_renaming, const Param
 Nft mata::nft::determinize(
         const Nft&  aut,
         std::unordered_map<StateSet, State> *subset_map) {
+    if (subset_map == nullptr) { return determinize(aut, static_cast<MacrostateStore*>(nullptr)); }
+    MacrostateStore macrostates{};
+    Nft result{ determinize(aut, &macrostates) };
+    macrostates.fill_subset_map(*subset_map);
+    return result;
+}
 
+Nft mata::nft::determinize(const Nft& aut, MacrostateStore* macrostates) {
     Nft result;
+    MacrostateStore macrostates_local{};
+    if (macrostates == nullptr) { macrostates = &macrostates_local; }
+    macrostates->clear();
     //assuming all sets targets are non-empty
-    std::vector<std::pair<State, StateSet>> worklist;
-    bool deallocate_subset_map = false;
-    if (subset_map == nullptr) {
-        subset_map = new std::unordered_map<StateSet,State>();
-        deallocate_subset_map = true;
-    }
+    std::vector<MacrostateId> worklist;
 
     result.clear();
 
@@ -855,57 +781,46 @@ Nft mata::nft::determinize(
     if (aut.final.intersects_with(S0)) {
         result.final.insert(S0id);
     }
-    worklist.emplace_back(S0id, S0);
-
-    (*subset_map)[mata::utils::OrdVector<State>(S0)] = S0id;
+    worklist.push_back(macrostates->insert(S0).first);
 
     if (aut.delta.empty())
         return result;
 
-    using Iterator = mata::utils::OrdVector<SymbolPost>::const_iterator;
     SynchronizedExistentialSymbolPostIterator synchronized_iterator;
+    std::vector<State> T;
 
     while (!worklist.empty()) {
-        const auto Spair = worklist.back();
+        const State Sid = worklist.back();
         worklist.pop_back();
-        const StateSet S = Spair.second;
-        const State Sid = Spair.first;
-        if (S.empty()) {
+        if (macrostates->size_of(static_cast<MacrostateId>(Sid)) == 0) {
             // This should not happen assuming all sets targets are non-empty.
             break;
         }
 
         // add moves of S to the sync ex iterator
-        // TODO: shouldn't we also reset first?
-        for (State q: S) {
+        synchronized_iterator.reset();
+        for (State q: (*macrostates)[static_cast<MacrostateId>(Sid)]) {
             mata::utils::push_back(synchronized_iterator, aut.delta[q]);
         }
 
         while (synchronized_iterator.advance()) {
 
             // extract post from the sychronized_iterator iterator
-            const std::vector<Iterator>& moves = synchronized_iterator.get_current();
-            Symbol currentSymbol = (*moves.begin())->symbol;
-            StateSet T = synchronized_iterator.unify_targets();
-
-            const auto existingTitr = subset_map->find(T);
-            State Tid;
-            if (existingTitr != subset_map->end()) {
-                Tid = existingTitr->second;
-            } else {
-                Tid = result.add_state();
-                (*subset_map)[mata::utils::OrdVector<State>(T)] = Tid;
+            const Symbol currentSymbol = (*synchronized_iterator.get_current().begin())->symbol;
+            synchronized_iterator.unify_targets(T);
+
+            const auto [Tid, is_new_macrostate] = macrostates->insert(T);
+            if (is_new_macrostate) {
+                result.add_state();
                 if (aut.final.intersects_with(T)) {
                     result.final.insert(Tid);
                 }
-                worklist.emplace_back(Tid, T);
+                worklist.push_back(Tid);
             }
-            result.delta.mutable_state_post(Sid).insert(SymbolPost(currentSymbol, Tid));
+            result.delta.mutable_state_post(Sid).emplace_back(currentSymbol, Tid);
         }
     }
 
-    if (deallocate_subset_map) { delete subset_map; }
-
     return result;
 }
 
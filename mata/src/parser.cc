@@ -2,21 +2,17 @@
  */
 
 #include "mata/parser/parser.hh"
+#include "mata/parser/lexer.hh"
 #include "mata/utils/utils.hh"
 
 #include <algorithm>
-#include <cstring>
-#include <sstream>
-
-using std::tie;
+#include <istream>
 
+using mata::parser::BodyLine;
+using mata::parser::Lexer;
 using mata::parser::Parsed;
 using mata::parser::ParsedSection;
-using mata::utils::haskey;
-
-// macro for debug prints in the parser
-// #define PARSER_DEBUG_PRINT_LN(x) { DEBUG_PRINT_LN(x) }
-#define PARSER_DEBUG_PRINT_LN(x) {  }
+using mata::parser::Token;
 
 
 namespace
@@ -32,282 +28,71 @@ void eat_whites(std::istream& input)
 	}
 } // eat_whites(istream) }}}
 
-/// Determines whether the character is a character of a string
-bool is_string_char(char ch)
+/** Reads the whole (rest of the) stream into a string */
+std::string read_stream(std::istream& input)
 { // {{{
-	return !std::isblank(ch) &&
-		!(haskey(std::set<char>{'"', '(', ')', '#', '%', '@', '\\'}, ch));
-} // is_string_char }}}
-
-bool is_logical_operator(char ch)
-{
-    return (haskey(std::set<char>{'&', '|', '!'}, ch));
-}
-
-/**
- * @brief  Gets a token from the input stream
- *
- * The function assumes that the stream does not span lines
- */
-std::string get_token_from_line(std::istream& input, bool* quoted) {
-	assert(nullptr != quoted);
-
-	enum class TokenizerState {
-		INIT,
-		UNQUOTED,
-		QUOTED,
-		QUOTED_ESCAPE
-	};
-
 	std::string result;
-	*quoted = false;
-	TokenizerState state = TokenizerState::INIT;
-	int ch = input.get();
-	while (input.good()) {
-		assert(std::char_traits<char>::eof() != ch);
-
-		switch (state) {
-			case TokenizerState::INIT: {
-				if (std::isspace(ch)) { /* do nothing */ }
-				else if ('"' == ch) {
-					state = TokenizerState::QUOTED;
-					*quoted = true;
-				} else if ('#' == ch) { // clear the rest of the line
-					std::string aux;
-					std::getline(input, aux);
-					return {};
-				} else if ('(' == ch || ')' == ch) {
-					return std::to_string(static_cast<char>(ch));
-				} else {
-					result += static_cast<char>(ch);
-					state = TokenizerState::UNQUOTED;
-				}
-				break;
-			}
-			case TokenizerState::UNQUOTED: {
-				if (std::isspace(ch)) { return result; }
-				else if ('#' == ch) { // clear the rest of the line
-					std::string aux;
-					std::getline(input, aux);
-					return result;
-				} else if ('"' == ch) {
-					std::string context;
-					std::getline(input, context);
-					throw std::runtime_error("misplaced quotes: " + result + "_\"_" + context);
-				} else if ('(' == ch || ')' == ch) {
-					input.unget();
-					return result;
-				} else if ('@' == ch || '%' == ch) {
-					std::string context;
-					std::getline(input, context);
-					throw std::runtime_error(std::to_string("misplaced character \'") +
-						static_cast<char>(ch) + "\' in string \"" + result +
-						static_cast<char>(ch) + context + "\"");
-				} else {
-					result += static_cast<char>(ch);
-				}
-				break;
-			}
-			case TokenizerState::QUOTED: {
-				if ('"' == ch) {
-					ch = input.peek();
-					if (!std::isspace(ch) && ('#' != ch) && (')' != ch) &&
-						std::char_traits<char>::eof() != ch)
-					{
-						std::string context;
-						std::getline(input, context);
-						throw std::runtime_error("misplaced quotes: \"" + result + "_\"_" +
-							context);
-					}
-
-					return result;
-				} else if ('\\' == ch) {
-					state = TokenizerState::QUOTED_ESCAPE;
-				} else { result += static_cast<char>(ch); }
-				break;
-			}
-			case TokenizerState::QUOTED_ESCAPE: {
-				if ('"' != ch) { result += '\\'; }
-				result += static_cast<char>(ch);
-				state = TokenizerState::QUOTED;
-				break;
-			}
-			default: { // LCOV_EXCL_START
-				throw std::runtime_error("Invalid tokenizer state");
-			} // LCOV_EXCL_STOP
-		}
-
-		ch = input.get();
-	}
-
-	if (TokenizerState::QUOTED == state || TokenizerState::QUOTED_ESCAPE == state) {
-		throw std::runtime_error("missing ending quotes: " + result);
+	char buffer[1 << 16];
+	while (input.read(buffer, sizeof(buffer)) || input.gcount() > 0) {
+		result.append(buffer, static_cast<size_t>(input.gcount()));
 	}
-
 	return result;
-} // get_token_new(istream) }}}
-
+} // read_stream(istream) }}}
 
 /**
- * @brief  Transforms a line into a vector of tokens
+ * @brief  Parses one section from the lexer
+ *
+ * Stops at the start of the next section (@TYPE), or at the end of the input.
  */
-std::vector<std::pair<std::string, bool>> tokenize_line(const std::string& line)
-{ // {{{
-	std::vector<std::pair<std::string, bool>> result;
-	std::istringstream stream(line);
-	bool first = true;
-	while (stream.good())
-	{
-		bool quoted;
-		std::string token = get_token_from_line(stream, &quoted);
-		if (!quoted && token.empty()) { break; }
-
-		result.emplace_back(token, quoted);
-
-		if (!first && !quoted)
-		{
-			assert(!token.empty());
-			if ('@' == token[0])
-			{
-				throw std::runtime_error("invalid position of @TYPE: " + line);
-			}
-			else if ('%' == token[0])
-			{
-				throw std::runtime_error("invalid position of %KEY: " + line);
-			}
-		}
-
-		first = false;
-	}
-
-	return result;
-} // tokenize_line(string) }}}
-
-std::vector<std::pair<std::string, bool>> split_tokens(std::vector<std::pair<std::string, bool>> tokens) {
-    std::vector<std::pair<std::string, bool>> result;
-    for (auto& token: tokens) {
-        if (token.second) { // is quoted?
-            result.push_back(std::move(token));
-            continue;
-        }
-
-        const std::string_view token_string{ token.first };
-        size_t last_operator{ 0 };
-        for (size_t i = 0, token_string_size{ token_string.size() }; i < token_string_size; ++i) {
-            if (is_logical_operator(token_string[i])) {
-                const std::string_view token_candidate = token_string.substr(last_operator, i - last_operator);
-
-                // there is token before logical operator (this is case of binary operators, e.g., a&b)
-                if (!token_candidate.empty()) {
-                    result.emplace_back(token_candidate, false);
-								}
-                result.emplace_back(std::string(1,token_string[i]), false);
-                last_operator = i + 1;
-            }
-        }
-
-				const size_t length{ token_string.length() };
-        if (last_operator == 0) {
-            result.emplace_back(std::move(token));
-        } else if (last_operator != length) { // operator was not last, we need parse rest of token
-            result.emplace_back(token_string.substr(last_operator, length-last_operator), false);
-        }
-    }
-
-    return result;
-} // split_tokens(std::vector) }}}
-} // anonymous namespace
-
-
-Parsed mata::parser::parse_mf(
-	const std::string&  input,
-	bool                keepQuotes)
-{ // {{{
-	std::istringstream stream(input);
-	return parse_mf(stream, keepQuotes);
-} // parse_mf(std::string) }}}
-
-
-Parsed mata::parser::parse_mf(
-	std::istream&  input,
-	bool           keepQuotes)
-{ // {{{
-	Parsed result;
-
-	while (input.good()) {
-		ParsedSection parsec = parse_mf_section(input, keepQuotes);
-		if (!parsec.empty())
-		{
-			result.push_back(parsec);
-		}
-	}
-
-	return result;
-} // parse_mf(std::istream) }}}
-
-
-ParsedSection mata::parser::parse_mf_section(
-	std::istream&  input,
-	bool           keepQuotes)
+ParsedSection parse_section(Lexer& lexer, bool keepQuotes)
 { // {{{
 	ParsedSection result;
 
 	bool reading_type = true;
-	std::vector<std::pair<std::string, bool>> token_line{};
+	std::vector<Token> token_line{};
+	std::vector<Token> temp_token_line{};
 	bool append_line = false;
 
-	while (input.good()) {
-		eat_whites(input);
-		int ch = input.peek();
-		if (std::char_traits<char>::eof() == ch) { break; }
+	while (true) {
+		const char ch = lexer.peek_line();
+		if ('\0' == ch) { break; }
 		else if (!reading_type && '@' == ch)
 		{ // another @TYPE declaration
 			break;
 		}
 
-		std::string line;
-		getline(input, line);
+		std::string_view line = lexer.next_line();
 
 		bool backslash_ending = (line.back() == '\\');
 		if (backslash_ending) {
-		    line.pop_back();
+			line.remove_suffix(1);
 		}
 
-		PARSER_DEBUG_PRINT_LN(line);
-
 		if (reading_type) { // we're expecting a @TYPE declaration
-			assert(ch == line[0]);
-			if ('#' == line[0] || '\n' == line[0]) {
+			if ('#' == line[0]) {
 				continue; /* skip the rest of the line */
 			} else if ('@' != line[0]) {
 				throw std::runtime_error("expecting automaton type (@TYPE), got \"" +
-					line + "\" instead");
+					std::string(line) + "\" instead");
 			}
 
-			std::string type;
-			size_t i;
-			for (i = 1; i < line.size(); ++i) {
-				if (!is_string_char(line[i])) {
-					break;
-				}
-
-				type += line[i];
-			}
+			size_t i = 1;
+			while (i < line.size() && !is_char_class(line[i], mata::parser::TYPE_END)) { ++i; }
+			std::string_view type = line.substr(1, i - 1);
 
 			if (type.empty()) {
 				throw std::runtime_error("expecting automaton type (@TYPE), got \"" +
-					line + "\" instead");
+					std::string(line) + "\" instead");
 			}
 
 			while (i < line.size()) {
-				if (std::isspace(line[i])) {
+				if (is_char_class(line[i], mata::parser::WHITESPACE)) {
 					++i;
 				} else if ('#' == line[i]) {
 					break;
 				} else {
-					std::string trailing(line, i);
 					throw std::runtime_error("invalid trailing characters \"" +
-						trailing + "\" on the line \"" + line + "\"");
+						std::string(line.substr(i)) + "\" on the line \"" + std::string(line) + "\"");
 				}
 			}
 
@@ -319,7 +104,8 @@ ParsedSection mata::parser::parse_mf_section(
 		if (result.type == "Regex") // so far we do not support regexs
 			continue;
 
-		std::vector<std::pair<std::string, bool>> temp_token_line = tokenize_line(line);
+		temp_token_line.clear();
+		Lexer::tokenize_line(line, temp_token_line);
 		if (temp_token_line.empty()) {
 			continue;
 		}
@@ -327,7 +113,7 @@ ParsedSection mata::parser::parse_mf_section(
 		if (append_line) {
 		    token_line.insert(token_line.end(), temp_token_line.begin(), temp_token_line.end());
 		} else {
-		    token_line = temp_token_line;
+		    std::swap(token_line, temp_token_line);
 		}
 
 		append_line = backslash_ending;
@@ -335,52 +121,94 @@ ParsedSection mata::parser::parse_mf_section(
 		    continue;
 		}
 
-		token_line = split_tokens(std::move(token_line));
-
-		const std::string& maybe_key = token_line[0].first;
-		const bool& quoted = token_line[0].second;
-		assert(quoted || '@' != maybe_key[0]);
-
-		if (!quoted && '%' == maybe_key[0]) {
-			std::string key = maybe_key.substr(1);
+		const Token& maybe_key = token_line[0];
+		if (!maybe_key.quoted && '%' == maybe_key.text[0]) {
+			std::string key(maybe_key.text.substr(1));
 			if (key.empty()) {
-				throw std::runtime_error("%KEY name missing: " + line);
+				throw std::runtime_error("%KEY name missing: " + std::string(line));
 			}
 
-			auto it = result.dict.find(key);
-			if (result.dict.end() == it) { // insert an empty list
-				tie(it, std::ignore) =
-					result.dict.insert({ key, std::vector<std::string>() });
-			}
-
-			std::vector<std::string>& val_list = it->second;
+			std::vector<std::string>& val_list = result.dict[key];
 			std::transform(token_line.begin() + 1, token_line.end(),
 				std::back_inserter(val_list),
-				[](const std::pair<std::string, bool>& token) { return token.first; });
+				[](const Token& token) { return token.to_string(); });
 		} else {
 			BodyLine stripped_token_line;
+			stripped_token_line.reserve(token_line.size());
 			std::transform(token_line.begin(), token_line.end(),
 				std::back_inserter(stripped_token_line),
-				[&](const std::pair<std::string, bool>& token) {
-					if (keepQuotes && token.second) return "\"" + token.first + "\"";
-					else return token.first;
+				[&](const Token& token) {
+					if (keepQuotes && token.quoted) return "\"" + token.to_string() + "\"";
+					else return token.to_string();
 				});
-			result.body.push_back(stripped_token_line);
+			result.body.push_back(std::move(stripped_token_line));
+		}
+	}
+
+	return result;
+} // parse_section(Lexer) }}}
+} // anonymous namespace
+
+
+Parsed mata::parser::parse_mf(
+	std::string_view  input,
+	bool              keepQuotes)
+{ // {{{
+	Parsed result;
+	Lexer lexer(input);
+
+	while ('\0' != lexer.peek_line()) {
+		ParsedSection parsec = parse_section(lexer, keepQuotes);
+		if (!parsec.empty())
+		{
+			result.push_back(std::move(parsec));
 		}
 	}
 
 	return result;
+} // parse_mf(std::string_view) }}}
+
+
+Parsed mata::parser::parse_mf(
+	std::istream&  input,
+	bool           keepQuotes)
+{ // {{{
+	const std::string buffer = read_stream(input);
+	return parse_mf(std::string_view(buffer), keepQuotes);
+} // parse_mf(std::istream) }}}
+
+
+ParsedSection mata::parser::parse_mf_section(
+	std::istream&  input,
+	bool           keepQuotes)
+{ // {{{
+	// Read only the lines of the section, leaving the next section in the stream.
+	std::string buffer;
+	bool reading_type = true;
+	while (input.good()) {
+		eat_whites(input);
+		int ch = input.peek();
+		if (std::char_traits<char>::eof() == ch) { break; }
+		else if (!reading_type && '@' == ch) { break; }
+
+		std::string line;
+		getline(input, line);
+		if ('#' != line[0]) { reading_type = false; }
+		buffer += line;
+		buffer += '\n';
+	}
+
+	return parse_mf_section(std::string_view(buffer), keepQuotes);
 } // parse_mf_section(std::istream) }}}
 
 
 ParsedSection mata::parser::parse_mf_section(
-	const std::string&  input,
-	bool                keepQuotes)
+	std::string_view  input,
+	bool              keepQuotes)
 { // {{{
-	std::istringstream stream(input);
-	ParsedSection result = parse_mf_section(stream, keepQuotes);
-	return result;
-} // parse_mf_section(std::string) }}}
+	Lexer lexer(input);
+	return parse_section(lexer, keepQuotes);
+} // parse_mf_section(std::string_view) }}}
 
 const std::vector<std::string>& mata::parser::ParsedSection::operator[](const std::string& key) const {
     auto it = this->dict.find(key);
@@ -3,7 +3,9 @@
  * Copyright (c) 2022 Michal Horky
  */
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 
 #include "mata/alphabet.hh"
 #include "mata/nfa/nfa.hh"
@@ -14,6 +16,13 @@
 namespace {
     using namespace mata::nfa;
 
+    /// Deleter of the reference counted RE2 regexes.
+    struct RegexpDecref {
+        void operator()(re2::Regexp* const regex) const { regex->Decref(); }
+    };
+    /// Owner of a reference to an RE2 regex, released even when the construction of an automaton throws.
+    using RegexpReference = std::unique_ptr<re2::Regexp, RegexpDecref>;
+
     class RegexParser {
     private:
         /**
@@ -496,6 +505,304 @@ namespace {
             return mappedStates;
         }
         };
+
+    /**
+     * Gets the Latin1 symbols (bytes) of a single character of the regex, i.e., of @p rune, any character, or
+     *  a character class
+     * @param regexp Regex of the character (kRegexpLiteral, kRegexpAnyChar, kRegexpAnyByte, or kRegexpCharClass)
+     * @param rune Rune of the literal, used only for kRegexpLiteral and kRegexpLiteralString
+     * @return Sorted symbols matched by the character
+     */
+    std::vector<mata::Symbol> get_symbols(re2::Regexp* regexp, const re2::Rune rune = 0) {
+        constexpr mata::Symbol max_symbol = 0xFF;
+        std::vector<mata::Symbol> symbols;
+        switch (regexp->op()) {
+            case re2::kRegexpLiteral:
+            case re2::kRegexpLiteralString:
+                if (static_cast<mata::Symbol>(rune) <= max_symbol) {
+                    symbols.push_back(static_cast<mata::Symbol>(rune));
+                    // The same symbol in lowercase and uppercase is 32 symbols from each other in ASCII
+                    if (regexp->parse_flags() & re2::Regexp::FoldCase) {
+                        if (rune >= 'a' && rune <= 'z') {
+                            symbols.insert(symbols.begin(), static_cast<mata::Symbol>(rune - 32));
+                        } else if (rune >= 'A' && rune <= 'Z') {
+                            symbols.push_back(static_cast<mata::Symbol>(rune + 32));
+                        }
+                    }
+                }
+                break;
+            case re2::kRegexpAnyChar:
+            case re2::kRegexpAnyByte:
+                for (mata::Symbol symbol = 0; symbol <= max_symbol; ++symbol) { symbols.push_back(symbol); }
+                break;
+            case re2::kRegexpCharClass:
+                // Ranges are sorted and do not overlap. Runes above Latin1 are never matched.
+                for (const re2::RuneRange& range: *regexp->cc()) {
+                    const auto hi = std::min(static_cast<mata::Symbol>(range.hi), max_symbol);
+                    for (auto symbol = static_cast<mata::Symbol>(range.lo); symbol <= hi; ++symbol) {
+                        symbols.push_back(symbol);
+                    }
+                }
+                break;
+            default:
+                throw std::runtime_error("create_nfa: unexpected regex operator " + std::to_string(regexp->op()));
+        }
+        return symbols;
+    }
+
+    /**
+     * Glushkov (position) automaton construction walking the parsed regex directly.
+     *
+     * Each occurrence of a character (a position) in the regex becomes a state, together with a single initial state.
+     *  A transition leads to a position over its characters from each position which it can follow. The result has no
+     *  epsilon transitions. Empty-width assertions (^, $, \b, ...) are ignored, as in the construction through RE2
+     *  programs.
+     */
+    class GlushkovConstructor {
+    public:
+        /**
+         * Creates the Glushkov automaton of the regex
+         * @param regexp Simplified regex (without kRegexpRepeat)
+         * @return Nfa with one state for each position and the initial state 0
+         */
+        Nfa construct(re2::Regexp* regexp) {
+            const Fragment fragment = this->visit(regexp);
+            this->follow[0] = fragment.first;
+
+            const size_t num_of_states = this->position_symbols.size();
+            Nfa nfa(num_of_states, { 0 });
+            nfa.final.reserve(num_of_states);
+            for (mata::nfa::State state: fragment.last) { nfa.final.insert(state); }
+            if (fragment.nullable) { nfa.final.insert(0); }
+
+            // Transitions of each state are collected and sorted first, and stored in the order of Delta then.
+            std::vector<std::pair<mata::Symbol, mata::nfa::State>> transitions;
+            for (mata::nfa::State source = 0; source < num_of_states; ++source) {
+                transitions.clear();
+                for (mata::nfa::State target: this->follow[source]) {
+                    for (mata::Symbol symbol: this->position_symbols[target]) {
+                        transitions.emplace_back(symbol, target);
+                    }
+                }
+                nfa.delta.mutable_state_post(source).append_moves(transitions);
+            }
+            return nfa;
+        }
+
+    private:
+        /**
+         * Positions of a subexpression
+         * nullable determines if the subexpression matches the empty word
+         * first holds positions which can start a word of the subexpression, last positions which can end it
+         */
+        struct Fragment {
+            bool nullable{ true };
+            std::vector<mata::nfa::State> first{};
+            std::vector<mata::nfa::State> last{};
+        };
+
+        /// Symbols of each position, position 0 is the initial state
+        std::vector<std::vector<mata::Symbol>> position_symbols{ {} };
+        /// Positions which can follow each position
+        std::vector<std::vector<mata::nfa::State>> follow{ {} };
+
+        Fragment create_position(std::vector<mata::Symbol> symbols) {
+            const auto position = static_cast<mata::nfa::State>(this->position_symbols.size());
+            this->position_symbols.push_back(std::move(symbols));
+            this->follow.emplace_back();
+            return Fragment{ false, { position }, { position } };
+        }
+
+        void link(const std::vector<mata::nfa::State>& last, const std::vector<mata::nfa::State>& first) {
+            for (mata::nfa::State position: last) {
+                this->follow[position].insert(this->follow[position].end(), first.begin(), first.end());
+            }
+        }
+
+        Fragment concatenate(Fragment lhs, Fragment rhs) {
+            this->link(lhs.last, rhs.first);
+            if (lhs.nullable) { lhs.first.insert(lhs.first.end(), rhs.first.begin(), rhs.first.end()); }
+            if (rhs.nullable) { rhs.last.insert(rhs.last.end(), lhs.last.begin(), lhs.last.end()); }
+            return Fragment{ lhs.nullable && rhs.nullable, std::move(lhs.first), std::move(rhs.last) };
+        }
+
+        Fragment visit(re2::Regexp* regexp) {
+            switch (regexp->op()) {
+                case re2::kRegexpNoMatch:
+                    return Fragment{ false, {}, {} };
+                case re2::kRegexpEmptyMatch:
+                case re2::kRegexpHaveMatch:
+                case re2::kRegexpBeginLine:
+                case re2::kRegexpEndLine:
+                case re2::kRegexpWordBoundary:
+                case re2::kRegexpNoWordBoundary:
+                case re2::kRegexpBeginText:
+                case re2::kRegexpEndText:
+                    return Fragment{};
+                case re2::kRegexpLiteral:
+                    return this->create_position(get_symbols(regexp, regexp->rune()));
+                case re2::kRegexpLiteralString: {
+                    Fragment result{};
+                    for (int i = 0; i < regexp->nrunes(); ++i) {
+                        result = this->concatenate(std::move(result),
+                                                   this->create_position(get_symbols(regexp, regexp->runes()[i])));
+                    }
+                    return result;
+                }
+                case re2::kRegexpAnyChar:
+                case re2::kRegexpAnyByte:
+                case re2::kRegexpCharClass:
+                    return this->create_position(get_symbols(regexp));
+                case re2::kRegexpConcat: {
+                    Fragment result{};
+                    for (int i = 0; i < regexp->nsub(); ++i) {
+                        result = this->concatenate(std::move(result), this->visit(regexp->sub()[i]));
+                    }
+                    return result;
+                }
+                case re2::kRegexpAlternate: {
+                    Fragment result{ false, {}, {} };
+                    for (int i = 0; i < regexp->nsub(); ++i) {
+                        Fragment sub = this->visit(regexp->sub()[i]);
+                        result.nullable = result.nullable || sub.nullable;
+                        result.first.insert(result.first.end(), sub.first.begin(), sub.first.end());
+                        result.last.insert(result.last.end(), sub.last.begin(), sub.last.end());
+                    }
+                    return result;
+                }
+                case re2::kRegexpStar:
+                case re2::kRegexpPlus:
+                case re2::kRegexpQuest: {
+                    Fragment result = this->visit(regexp->sub()[0]);
+                    if (regexp->op() != re2::kRegexpQuest) { this->link(result.last, result.first); }
+                    if (regexp->op() != re2::kRegexpPlus) { result.nullable = true; }
+                    return result;
+                }
+                case re2::kRegexpCapture:
+                    return this->visit(regexp->sub()[0]);
+                default:
+                    throw std::runtime_error("create_nfa: unexpected regex operator " + std::to_string(regexp->op()));
+            }
+        }
+    };
+
+    /**
+     * Thompson construction walking the parsed regex directly.
+     *
+     * Each subexpression becomes a fragment with a single start and a single end state, connected to the other
+     *  fragments by epsilon transitions. The number of states and transitions (up to the symbols of the characters)
+     *  is linear in the size of the regex. Empty-width assertions (^, $, \b, ...) are ignored.
+     */
+    class ThompsonConstructor {
+    public:
+        explicit ThompsonConstructor(const mata::Symbol epsilon_value): epsilon{ epsilon_value } {}
+
+        /**
+         * Creates the Thompson automaton of the regex
+         * @param regexp Simplified regex (without kRegexpRepeat)
+         * @return Nfa with epsilon transitions over epsilon_value, one initial and one final state
+         */
+        Nfa construct(re2::Regexp* regexp) {
+            const Fragment fragment = this->visit(regexp);
+            this->nfa.initial.insert(fragment.start);
+            this->nfa.final.insert(fragment.end);
+            return std::move(this->nfa);
+        }
+
+    private:
+        struct Fragment {
+            mata::nfa::State start;
+            mata::nfa::State end;
+        };
+
+        const mata::Symbol epsilon;
+        Nfa nfa{};
+
+        Fragment create_fragment() {
+            const mata::nfa::State start = this->nfa.add_state();
+            return Fragment{ start, this->nfa.add_state() };
+        }
+
+        Fragment create_character(const std::vector<mata::Symbol>& symbols) {
+            const Fragment fragment = this->create_fragment();
+            for (mata::Symbol symbol: symbols) { this->nfa.delta.add(fragment.start, symbol, fragment.end); }
+            return fragment;
+        }
+
+        Fragment visit(re2::Regexp* regexp) {
+            switch (regexp->op()) {
+                case re2::kRegexpNoMatch:
+                    return this->create_fragment();
+                case re2::kRegexpEmptyMatch:
+                case re2::kRegexpHaveMatch:
+                case re2::kRegexpBeginLine:
+                case re2::kRegexpEndLine:
+                case re2::kRegexpWordBoundary:
+                case re2::kRegexpNoWordBoundary:
+                case re2::kRegexpBeginText:
+                case re2::kRegexpEndText: {
+                    const Fragment fragment = this->create_fragment();
+                    this->nfa.delta.add(fragment.start, this->epsilon, fragment.end);
+                    return fragment;
+                }
+                case re2::kRegexpLiteral:
+                    return this->create_character(get_symbols(regexp, regexp->rune()));
+                case re2::kRegexpLiteralString: {
+                    // A chain of states, one more than the runes
+                    const mata::nfa::State start = this->nfa.add_state();
+                    mata::nfa::State end = start;
+                    for (int i = 0; i < regexp->nrunes(); ++i) {
+                        const mata::nfa::State next = this->nfa.add_state();
+                        for (mata::Symbol symbol: get_symbols(regexp, regexp->runes()[i])) {
+                            this->nfa.delta.add(end, symbol, next);
+                        }
+                        end = next;
+                    }
+                    return Fragment{ start, end };
+                }
+                case re2::kRegexpAnyChar:
+                case re2::kRegexpAnyByte:
+                case re2::kRegexpCharClass:
+                    return this->create_character(get_symbols(regexp));
+                case re2::kRegexpConcat: {
+                    const Fragment first = this->visit(regexp->sub()[0]);
+                    mata::nfa::State end = first.end;
+                    for (int i = 1; i < regexp->nsub(); ++i) {
+                        const Fragment next = this->visit(regexp->sub()[i]);
+                        this->nfa.delta.add(end, this->epsilon, next.start);
+                        end = next.end;
+                    }
+                    return Fragment{ first.start, end };
+                }
+                case re2::kRegexpAlternate: {
+                    const Fragment fragment = this->create_fragment();
+                    for (int i = 0; i < regexp->nsub(); ++i) {
+                        const Fragment sub = this->visit(regexp->sub()[i]);
+                        this->nfa.delta.add(fragment.start, this->epsilon, sub.start);
+                        this->nfa.delta.add(sub.end, this->epsilon, fragment.end);
+                    }
+                    return fragment;
+                }
+                case re2::kRegexpStar:
+                case re2::kRegexpPlus:
+                case re2::kRegexpQuest: {
+                    const Fragment fragment = this->create_fragment();
+                    const Fragment sub = this->visit(regexp->sub()[0]);
+                    this->nfa.delta.add(fragment.start, this->epsilon, sub.start);
+                    this->nfa.delta.add(sub.end, this->epsilon, fragment.end);
+                    if (regexp->op() != re2::kRegexpQuest) { this->nfa.delta.add(sub.end, this->epsilon, sub.start); }
+                    if (regexp->op() != re2::kRegexpPlus) {
+                        this->nfa.delta.add(fragment.start, this->epsilon, fragment.end);
+                    }
+                    return fragment;
+                }
+                case re2::kRegexpCapture:
+                    return this->visit(regexp->sub()[0]);
+                default:
+                    throw std::runtime_error("create_nfa: unexpected regex operator " + std::to_string(regexp->op()));
+            }
+        }
+    };
 }
 
  /**
@@ -505,24 +812,42 @@ namespace {
  * @param epsilon_value value, that will represent epsilon on transitions
  * @param use_reduce if set to true the result is trimmed and reduced using simulation reduction
  * @param encoding encoding of the regex, default is Latin1
+ * @param construction construction of the NFA from the parsed regex, default is through the RE2 program
  * @return Nfa corresponding to pattern
  */
-void mata::parser::create_nfa(nfa::Nfa* nfa, const std::string& pattern, bool use_epsilon, mata::Symbol epsilon_value, bool use_reduce, const Encoding encoding) {
+void mata::parser::create_nfa(nfa::Nfa* nfa, const std::string& pattern, bool use_epsilon, mata::Symbol epsilon_value,
+                              bool use_reduce, const Encoding encoding, const RegexConstruction construction) {
     if (nfa == nullptr) {
         throw std::runtime_error("create_nfa: nfa should not be NULL");
     }
+    if (construction != RegexConstruction::Prog && encoding != Encoding::Latin1) {
+        throw std::runtime_error("create_nfa: Glushkov and Thompson constructions support only Latin1 encoding");
+    }
 
     RegexParser regexParser{};
-    auto parsed_regex = regexParser.parse_regex_string(pattern, encoding);
-    auto program = parsed_regex->CompileToProg(regexParser.options.max_mem() * 2 / 3);
-    // FIXME: use_epsilon = false completely breaks the method convert_pro_to_nfa(). Needs fixing before allowing to
-    //  pass the argument use_epsilon to convert_pro_to_nfa().
-    regexParser.convert_pro_to_nfa(nfa, program, true, epsilon_value);
-    delete program;
-    // Decrements reference count and deletes object if the count reaches 0
-    parsed_regex->Decref();
+    const RegexpReference parsed_regex{ regexParser.parse_regex_string(pattern, encoding) };
+    bool has_epsilon = true;
+    if (construction == RegexConstruction::Prog) {
+        const std::unique_ptr<re2::Prog> program{
+            parsed_regex->CompileToProg(regexParser.options.max_mem() * 2 / 3) };
+        // FIXME: use_epsilon = false completely breaks the method convert_pro_to_nfa(). Needs fixing before allowing to
+        //  pass the argument use_epsilon to convert_pro_to_nfa().
+        regexParser.convert_pro_to_nfa(nfa, program.get(), true, epsilon_value);
+    } else {
+        // Simplification expands counted repetitions (x{n,m}) into concatenations and optional subexpressions.
+        const RegexpReference simplified_regex{ parsed_regex->Simplify() };
+        if (simplified_regex == nullptr) {
+            throw std::runtime_error("create_nfa: regex '" + pattern + "' could not be simplified");
+        }
+        if (construction == RegexConstruction::Glushkov) {
+            *nfa = GlushkovConstructor{}.construct(simplified_regex.get());
+            has_epsilon = false;
+        } else {
+            *nfa = ThompsonConstructor{ epsilon_value }.construct(simplified_regex.get());
+        }
+    }
      //TODO: should this really be done implicitly?
-    if(!use_epsilon) {
+    if(!use_epsilon && has_epsilon) {
         *nfa = mata::nfa::remove_epsilon(*nfa, epsilon_value);
     }
     //TODO: in fact, maybe parser should not do trimming and reducing, maybe these operations should be done transparently.
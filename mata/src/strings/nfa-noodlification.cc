@@ -6,112 +6,170 @@
 #include "mata/nfa/strings.hh"
 #include "mata/nfa/algorithms.hh"
 
+#include <atomic>
+#include <thread>
+
 using namespace mata::nfa;
 using namespace mata::strings;
 using namespace mata::nfa::algorithms;
 
-namespace {
-
-/**
- * Get a number of permutations for computed epsilon depths.
- * @param[in] epsilon_depths Computed list of epsilon transitions for each depth.
- * @return Number of permutations.
- */
-size_t get_num_of_permutations(const seg_nfa::Segmentation::EpsilonDepthTransitions& epsilon_depths)
-{
-    size_t num_of_permutations{ 1 };
-    for (const auto& segment: epsilon_depths)
-    {
-        num_of_permutations *= segment.second.size();
+seg_nfa::NoodleGenerator::NoodleGenerator(const SegNfa& aut, const Symbol epsilon, const bool include_empty)
+    : include_empty_{ include_empty }, unused_state_{ aut.num_of_states() } {
+    const Segmentation segmentation{ aut, { epsilon } };
+    const size_t num_of_segments{ segmentation.num_of_segments() };
+    segments_.reserve(num_of_segments);
+    for (size_t segment_idx{ 0 }; segment_idx < num_of_segments; ++segment_idx) {
+        segments_.push_back(segmentation.get_segment_view(segment_idx).to_nfa());
+    }
+    const std::vector<std::vector<Transition>>& epsilon_transitions{ segmentation.get_epsilon_transitions() };
+    epsilon_transitions_.resize(epsilon_transitions.size());
+    for (size_t depth{ 0 }; depth < epsilon_transitions.size(); ++depth) {
+        const Segmentation::SegmentView source_segment{ segmentation.get_segment_view(depth) };
+        const Segmentation::SegmentView target_segment{ segmentation.get_segment_view(depth + 1) };
+        for (const Transition& transition: epsilon_transitions[depth]) {
+            // ε-transitions to states reached on another depth are not a part of any chain.
+            if (!target_segment.contains(transition.target)) { continue; }
+            epsilon_transitions_[depth].emplace_back(source_segment.segment_state(transition.source),
+                                                     transition.symbol,
+                                                     target_segment.segment_state(transition.target));
+        }
     }
-    return num_of_permutations;
 }
 
-} // namespace
-
-std::vector<seg_nfa::Noodle> seg_nfa::noodlify(const SegNfa& aut, const Symbol epsilon, bool include_empty) {
+std::shared_ptr<seg_nfa::SegNfa> seg_nfa::NoodleGenerator::get_segment(
+    const size_t segment_idx, const State initial_state, const State final_state) {
+    const std::tuple<size_t, State, State> key{ segment_idx, initial_state, final_state };
+    {
+        const std::lock_guard lock{ segments_mutex_ };
+        const auto segment_it{ segments_one_initial_final_.find(key) };
+        if (segment_it != segments_one_initial_final_.end()) { return segment_it->second; }
+    }
 
-    const std::set<Symbol> epsilons({epsilon});
-    // return noodlify_reach(aut, epsilons, include_empty);
+    // Computed outside the lock. When two threads compute the same segment, the segment stored first is used.
+    Nfa segment{ segments_[segment_idx] };
+    if (initial_state != unused_state_) { segment.initial = { initial_state }; }
+    if (final_state != unused_state_) { segment.final = { final_state }; }
+    segment = reduce(segment.trim());
+    std::shared_ptr<SegNfa> segment_ptr{};
+    if (segment.num_of_states() > 0 || include_empty_) { segment_ptr = std::make_shared<Nfa>(std::move(segment)); }
+    const std::lock_guard lock{ segments_mutex_ };
+    return segments_one_initial_final_.emplace(key, std::move(segment_ptr)).first->second;
+}
 
-    Segmentation segmentation{ aut, epsilons };
-    const auto& segments{ segmentation.get_untrimmed_segments() };
+std::vector<seg_nfa::NoodleGenerator::Choice> seg_nfa::NoodleGenerator::get_choices(
+    const size_t depth, const State final_state) {
+    std::vector<Choice> choices{};
+    for (const Transition& transition: epsilon_transitions_[depth]) {
+        // Only the ε-transitions connected to the rest of the chain through a non-empty segment.
+        std::shared_ptr<SegNfa> segment{ get_segment(depth + 1, transition.target, final_state) };
+        if (segment) { choices.push_back({ transition.source, std::move(segment) }); }
+    }
+    return choices;
+}
 
-    if (segments.size() == 1) {
-        std::shared_ptr<Nfa> segment = std::make_shared<Nfa>(segments[0]);
-        segment->trim();
-        if (segment->num_of_states() > 0 || include_empty) {
-            return {{ segment }};
-        } else {
-            return {};
+std::optional<seg_nfa::Noodle> seg_nfa::NoodleGenerator::advance(Walk& walk) {
+    const size_t num_of_depths{ epsilon_transitions_.size() };
+    if (!walk.started) {
+        walk.started = true;
+        if (num_of_depths == 0) {
+            std::shared_ptr<Nfa> segment = std::make_shared<Nfa>(segments_[0]);
+            segment->trim();
+            if (segment->num_of_states() > 0 || include_empty_) { return Noodle{ segment }; }
+            return std::nullopt;
         }
+        walk.frames.push_back({ get_choices(num_of_depths - 1, unused_state_) });
     }
 
-    State unused_state = aut.num_of_states(); // get some State not used in aut
-    std::map<std::pair<State, State>, std::shared_ptr<Nfa>> segments_one_initial_final;
-    segs_one_initial_final(segments, include_empty, unused_state, segments_one_initial_final);
-
-    const auto& epsilon_depths{ segmentation.get_epsilon_depths() };
-
-    // Compute number of all combinations of ε-transitions with one ε-transitions from each depth.
-    size_t num_of_permutations{ get_num_of_permutations(epsilon_depths) };
-    size_t epsilon_depths_size{ epsilon_depths.size() };
-
-    std::vector<Noodle> noodles{};
-    // noodle of epsilon transitions (each from different depth)
-    std::vector<Transition> epsilon_noodle(epsilon_depths_size);
-    // for each combination of ε-transitions, create the automaton.
-    // based on https://stackoverflow.com/questions/48270565/create-all-possible-combinations-of-multiple-vectors
-    for (size_t index{ 0 }; index < num_of_permutations; ++index) {
-        size_t temp{ index };
-        for (size_t depth{ 0 }; depth < epsilon_depths_size; ++depth) {
-            size_t num_of_trans_at_cur_depth = epsilon_depths.at(depth).size();
-            size_t computed_index = temp % num_of_trans_at_cur_depth;
-            temp /= num_of_trans_at_cur_depth;
-            epsilon_noodle[depth] = epsilon_depths.at(depth)[computed_index];
+    while (!walk.frames.empty()) {
+        Frame& frame{ walk.frames.back() };
+        if (frame.next_choice == frame.choices.size()) {
+            walk.frames.pop_back();
+            // Each frame but the first one was reached through a choice with its segment in walk.segments.
+            if (!walk.segments.empty()) { walk.segments.pop_back(); }
+            continue;
+        }
+        const Choice& choice{ frame.choices[frame.next_choice++] };
+        const size_t depth{ num_of_depths - walk.frames.size() };
+        if (depth == 0) {
+            std::shared_ptr<SegNfa> first_segment{ get_segment(0, unused_state_, choice.source) };
+            if (!first_segment) { continue; }
+            Noodle noodle{};
+            noodle.reserve(num_of_depths + 1);
+            noodle.push_back(std::move(first_segment));
+            noodle.push_back(choice.segment);
+            noodle.insert(noodle.end(), walk.segments.rbegin(), walk.segments.rend());
+            return noodle;
         }
+        const State source{ choice.source };
+        walk.segments.push_back(choice.segment);
+        walk.frames.push_back({ get_choices(depth - 1, source) });
+    }
+    return std::nullopt;
+}
 
-        Noodle noodle;
+std::optional<seg_nfa::Noodle> seg_nfa::NoodleGenerator::next() { return advance(walk_); }
 
-        // epsilon_noodle[0] for sure exists, as we sorted out the case of only one segment at the beginning
-        auto first_segment_iter = segments_one_initial_final.find(std::make_pair(unused_state, epsilon_noodle[0].source));
-        if (first_segment_iter != segments_one_initial_final.end()) {
-            noodle.push_back(first_segment_iter->second);
-        } else {
-            continue;
+bool seg_nfa::NoodleGenerator::produce(const std::function<bool(Noodle&&)>& consume, size_t num_of_threads) {
+    if (num_of_threads == 0) { num_of_threads = std::max(std::thread::hardware_concurrency(), 1U); }
+    if (num_of_threads == 1 || epsilon_transitions_.empty()) {
+        for (std::optional<Noodle> noodle{ next() }; noodle.has_value(); noodle = next()) {
+            if (!consume(std::move(*noodle))) { return false; }
         }
+        return true;
+    }
 
-        bool all_segments_exist = true;
-        for (auto iter = epsilon_noodle.begin(); iter + 1 != epsilon_noodle.end(); ++iter) {
-            auto next_iter = iter + 1;
-            auto segment_iter = segments_one_initial_final.find(std::make_pair(iter->target, next_iter->source));
-            if (segment_iter != segments_one_initial_final.end()) {
-                noodle.push_back(segment_iter->second);
-            } else {
-                all_segments_exist = false;
-                break;
-            }
-        }
+    // The remaining choices of the last depth are distributed among the threads, the current walk is finished by the
+    //  first thread.
+    std::vector<Choice> roots{};
+    if (!walk_.started) {
+        walk_.started = true;
+        roots = get_choices(epsilon_transitions_.size() - 1, unused_state_);
+    } else if (!walk_.frames.empty()) {
+        Frame& root_frame{ walk_.frames.front() };
+        roots.assign(root_frame.choices.begin() + static_cast<std::ptrdiff_t>(root_frame.next_choice),
+                     root_frame.choices.end());
+        root_frame.next_choice = root_frame.choices.size();
+    }
 
-        if (!all_segments_exist) {
-            continue;
+    std::atomic<size_t> next_root{ 0 };
+    std::atomic<bool> stopped{ false };
+    std::mutex consume_mutex{};
+    const auto produce_from = [&](Walk& walk) {
+        for (std::optional<Noodle> noodle{ advance(walk) }; noodle.has_value() && !stopped; noodle = advance(walk)) {
+            const std::lock_guard lock{ consume_mutex };
+            if (!stopped && !consume(std::move(*noodle))) { stopped = true; }
         }
-
-        auto last_segment_iter = segments_one_initial_final.find(
-                std::make_pair(epsilon_noodle.back().target, unused_state));
-        if (last_segment_iter != segments_one_initial_final.end()) {
-            noodle.push_back(last_segment_iter->second);
-        } else {
-            continue;
+    };
+    const auto worker = [&](const size_t thread_idx) {
+        if (thread_idx == 0) { produce_from(walk_); }
+        for (size_t root{ next_root++ }; root < roots.size() && !stopped; root = next_root++) {
+            Walk walk{};
+            walk.started = true;
+            walk.frames.push_back({ { roots[root] } });
+            produce_from(walk);
         }
+    };
+    num_of_threads = std::max<size_t>(std::min(num_of_threads, roots.size()), 1);
+    std::vector<std::thread> threads{};
+    threads.reserve(num_of_threads - 1);
+    for (size_t thread_idx{ 1 }; thread_idx < num_of_threads; ++thread_idx) { threads.emplace_back(worker, thread_idx); }
+    worker(0);
+    for (std::thread& thread: threads) { thread.join(); }
+    // The walk of the first thread may have been stopped in the middle, no more noodles are produced afterwards.
+    walk_.frames.clear();
+    walk_.segments.clear();
+    return !stopped;
+}
 
-        noodles.push_back(noodle);
+std::vector<seg_nfa::Noodle> seg_nfa::noodlify(const SegNfa& aut, const Symbol epsilon, bool include_empty) {
+    NoodleGenerator generator{ aut, epsilon, include_empty };
+    std::vector<Noodle> noodles{};
+    for (std::optional<Noodle> noodle{ generator.next() }; noodle.has_value(); noodle = generator.next()) {
+        noodles.push_back(std::move(*noodle));
     }
     return noodles;
 }
 
-//todo: is this taking all final times all initial?
-// can it be done more efficiently? (only connected combinations through dfs)
 void seg_nfa::segs_one_initial_final(
     const std::vector<Nfa>& segments,
     bool include_empty,
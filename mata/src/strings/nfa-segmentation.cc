@@ -6,92 +6,170 @@
 using namespace mata::nfa;
 using namespace mata::strings;
 
-void seg_nfa::Segmentation::process_state_depth_pair(const StateDepthTuple& state_depth_pair,
-                                                     std::deque<StateDepthTuple>& worklist) {
-    auto outgoing_post{ automaton.delta[state_depth_pair.state] };
-    for (const SymbolPost& outgoing_move: outgoing_post) {
-        if (this->epsilons.find(outgoing_move.symbol) != this->epsilons.end()) {
-            handle_epsilon_transitions(state_depth_pair, outgoing_move, worklist);
-        } else { // Handle other transitions.
-            add_transitions_to_worklist(state_depth_pair, outgoing_move, worklist);
+void seg_nfa::Segmentation::compute_epsilon_depths() {
+    const size_t num_of_states{ automaton.num_of_states() };
+    const size_t num_of_epsilons{ epsilons.size() };
+    const std::vector<Symbol> epsilon_symbols(epsilons.begin(), epsilons.end());
+    state_depths.assign(num_of_states, UNREACHED_DEPTH);
+    visited_eps_counters.assign(num_of_states * num_of_epsilons, 0);
+
+    // Breadth-first search over the states. A state gets the depth (and the visited epsilons) of its first visit.
+    std::vector<State> worklist{};
+    worklist.reserve(num_of_states);
+    for (const State state: automaton.initial) {
+        state_depths[state] = 0;
+        worklist.push_back(state);
+    }
+    /// Visit @p target from @p source, over the epsilon at the position @p epsilon_position (if any).
+    const auto visit = [&](const State source, const State target, const EpsilonDepth depth,
+                           const size_t epsilon_position) {
+        if (state_depths[target] != UNREACHED_DEPTH) { return; }
+        state_depths[target] = depth;
+        const auto source_counters{ visited_eps_counters.begin()
+                                    + static_cast<std::ptrdiff_t>(source * num_of_epsilons) };
+        const auto target_counters{ visited_eps_counters.begin()
+                                    + static_cast<std::ptrdiff_t>(target * num_of_epsilons) };
+        std::copy_n(source_counters, num_of_epsilons, target_counters);
+        if (epsilon_position != num_of_epsilons) { ++target_counters[static_cast<std::ptrdiff_t>(epsilon_position)]; }
+        worklist.push_back(target);
+    };
+
+    for (size_t worklist_idx{ 0 }; worklist_idx < worklist.size(); ++worklist_idx) {
+        const State source{ worklist[worklist_idx] };
+        const EpsilonDepth depth{ state_depths[source] };
+        for (const SymbolPost& symbol_post: automaton.delta[source]) {
+            const auto epsilon_it{ std::lower_bound(epsilon_symbols.begin(), epsilon_symbols.end(),
+                                                    symbol_post.symbol) };
+            if (epsilon_it == epsilon_symbols.end() || *epsilon_it != symbol_post.symbol) {
+                for (const State target: symbol_post.targets) { visit(source, target, depth, num_of_epsilons); }
+                continue;
+            }
+            const size_t epsilon_position{ static_cast<size_t>(epsilon_it - epsilon_symbols.begin()) };
+            if (depth_epsilon_transitions.size() <= depth) { depth_epsilon_transitions.resize(depth + 1); }
+            for (const State target: symbol_post.targets) {
+                depth_epsilon_transitions[depth].emplace_back(source, symbol_post.symbol, target);
+                visit(source, target, depth + 1, epsilon_position);
+            }
         }
     }
+    group_states_into_segments();
 }
 
-void seg_nfa::Segmentation::handle_epsilon_transitions(const StateDepthTuple& state_depth_pair,
-                                                       const SymbolPost& move,
-                                                       std::deque<StateDepthTuple>& worklist)
-{
-    /// TODO: Maybe we don't need to keep the transitions in both structures
-    this->epsilon_depth_transitions.insert(std::make_pair(state_depth_pair.depth, std::vector<Transition>{}));
-    this->eps_depth_trans_map.insert({ state_depth_pair.depth, {{state_depth_pair.state, std::vector<Transition>{}}} });
-
-    std::map<Symbol, unsigned> visited_eps_aux(state_depth_pair.eps);
-    visited_eps_aux[move.symbol]++;
+void seg_nfa::Segmentation::group_states_into_segments() {
+    const size_t num_of_segments{ depth_epsilon_transitions.size() + 1 };
+    const size_t num_of_states{ state_depths.size() };
+    segment_offsets.assign(num_of_segments + 1, 0);
+    for (const EpsilonDepth depth: state_depths) {
+        if (depth != UNREACHED_DEPTH) { ++segment_offsets[depth + 1]; }
+    }
+    for (size_t segment_idx{ 1 }; segment_idx <= num_of_segments; ++segment_idx) {
+        segment_offsets[segment_idx] += segment_offsets[segment_idx - 1];
+    }
 
-    for (State target_state: move.targets)
-    {
-        // TODO: Use vector indexed by depths instead of a map.
-        this->epsilon_depth_transitions[state_depth_pair.depth].emplace_back(
-                state_depth_pair.state, move.symbol, target_state
-        );
-        this->eps_depth_trans_map[state_depth_pair.depth][state_depth_pair.state].emplace_back(
-             state_depth_pair.state, move.symbol, target_state
-        );
-        worklist.push_back({ target_state, state_depth_pair.depth + 1, visited_eps_aux });
-        this->visited_eps[target_state] = visited_eps_aux;
+    std::vector<size_t> next_positions(segment_offsets.begin(), segment_offsets.end() - 1);
+    segment_states.resize(segment_offsets.back());
+    renamed_states.assign(num_of_states, 0);
+    for (State state{ 0 }; state < num_of_states; ++state) {
+        const EpsilonDepth depth{ state_depths[state] };
+        if (depth == UNREACHED_DEPTH) { continue; }
+        const size_t position{ next_positions[depth]++ };
+        segment_states[position] = state;
+        renamed_states[state] = static_cast<State>(position - segment_offsets[depth]);
     }
 }
 
-void seg_nfa::Segmentation::add_transitions_to_worklist(const StateDepthTuple& state_depth_pair,
-                                                        const SymbolPost& move,
-                                                        std::deque<StateDepthTuple>& worklist)
-{
-    for (State target_state: move.targets)
-    {
-        worklist.push_back(StateDepthTuple{ target_state, state_depth_pair.depth, state_depth_pair.eps });
-        this->visited_eps[target_state] = state_depth_pair.eps;
+Nfa seg_nfa::Segmentation::SegmentView::to_nfa() const {
+    const size_t num_of_segment_states{ num_of_states() };
+    Nfa segment{ num_of_segment_states };
+    for (State state{ 0 }; state < num_of_segment_states; ++state) {
+        StatePost& state_post{ segment.delta.mutable_state_post(state) };
+        for (const SymbolPost& symbol_post: segmentation_.automaton.delta[original_state(state)]) {
+            if (segmentation_.epsilons.contains(symbol_post.symbol)) { continue; }
+            // The renaming preserves the order of states, the renamed targets stay sorted.
+            SymbolPost segment_symbol_post{ symbol_post.symbol };
+            for (const State target: symbol_post.targets) {
+                if (contains(target)) { segment_symbol_post.targets.push_back(segment_state(target)); }
+            }
+            if (!segment_symbol_post.targets.empty()) { state_post.push_back(std::move(segment_symbol_post)); }
+        }
     }
+
+    const std::vector<std::vector<Transition>>& epsilon_transitions{ segmentation_.depth_epsilon_transitions };
+    if (segment_idx_ == 0) {
+        for (const State state: segmentation_.automaton.initial) {
+            if (contains(state)) { segment.initial.insert(segment_state(state)); }
+        }
+    } else {
+        for (const Transition& transition: epsilon_transitions[segment_idx_ - 1]) {
+            if (contains(transition.target)) { segment.initial.insert(segment_state(transition.target)); }
+        }
+    }
+    if (segment_idx_ == epsilon_transitions.size()) {
+        for (const State state: segmentation_.automaton.final) {
+            if (contains(state)) { segment.final.insert(segment_state(state)); }
+        }
+    } else {
+        for (const Transition& transition: epsilon_transitions[segment_idx_]) {
+            segment.final.insert(segment_state(transition.source));
+        }
+    }
+    return segment;
 }
 
-std::deque<seg_nfa::Segmentation::StateDepthTuple> seg_nfa::Segmentation::initialize_worklist() const
-{
-    std::deque<StateDepthTuple> worklist{};
-    std::map<Symbol, unsigned> def_eps_map{};
-    for(const Symbol& e : this->epsilons) {
-        def_eps_map[e] = 0;
+const seg_nfa::Segmentation::EpsilonDepthTransitions& seg_nfa::Segmentation::get_epsilon_depths() const {
+    if (epsilon_depth_transitions.empty()) {
+        for (EpsilonDepth depth{ 0 }; depth < depth_epsilon_transitions.size(); ++depth) {
+            epsilon_depth_transitions.emplace(depth, depth_epsilon_transitions[depth]);
+        }
     }
+    return epsilon_depth_transitions;
+}
 
-    for (State state: automaton.initial)
-    {
-        worklist.push_back(StateDepthTuple{ state, 0, def_eps_map });
+const seg_nfa::Segmentation::EpsilonDepthTransitionMap& seg_nfa::Segmentation::get_epsilon_depth_trans_map() const {
+    if (eps_depth_trans_map.empty()) {
+        for (EpsilonDepth depth{ 0 }; depth < depth_epsilon_transitions.size(); ++depth) {
+            std::unordered_map<State, std::vector<Transition>>& depth_map{ eps_depth_trans_map[depth] };
+            for (const Transition& transition: depth_epsilon_transitions[depth]) {
+                depth_map[transition.source].push_back(transition);
+            }
+        }
     }
-    return worklist;
+    return eps_depth_trans_map;
 }
 
-std::unordered_map<State, bool> seg_nfa::Segmentation::initialize_visited_map() const
-{
-    std::unordered_map<State, bool> visited{};
-    const size_t state_num = automaton.num_of_states();
-    for (State state{ 0 }; state < state_num; ++state)
-    {
-        visited[state] = false;
+const seg_nfa::VisitedEpsMap& seg_nfa::Segmentation::get_visited_eps() const {
+    if (visited_eps.empty()) {
+        const size_t num_of_epsilons{ epsilons.size() };
+        // Initial states have an entry only if some transition leads to them.
+        BoolVector is_target(state_depths.size(), false);
+        for (State state{ 0 }; state < state_depths.size(); ++state) {
+            if (state_depths[state] == UNREACHED_DEPTH) { continue; }
+            for (const SymbolPost& symbol_post: automaton.delta[state]) {
+                for (const State target: symbol_post.targets) { is_target[target] = true; }
+            }
+        }
+        for (State state{ 0 }; state < state_depths.size(); ++state) {
+            if (!is_target[state]) { continue; }
+            std::map<Symbol, unsigned>& state_visited_eps{ visited_eps[state] };
+            size_t epsilon_position{ 0 };
+            for (const Symbol epsilon: epsilons) {
+                state_visited_eps[epsilon] = visited_eps_counters[state * num_of_epsilons + epsilon_position++];
+            }
+        }
     }
-    return visited;
+    return visited_eps;
 }
 
 void seg_nfa::Segmentation::split_aut_into_segments()
 {
-    segments_raw = { epsilon_depth_transitions.size() + 1, automaton };
+    segments_raw = { depth_epsilon_transitions.size() + 1, automaton };
     remove_inner_initial_and_final_states();
 
     // Construct segment automata.
-    std::unique_ptr<const std::vector<Transition>> depth_transitions{};
-    for (size_t depth{ 0 }; depth < epsilon_depth_transitions.size(); ++depth)
+    for (size_t depth{ 0 }; depth < depth_epsilon_transitions.size(); ++depth)
     {
         // Split the left segment from automaton into a new segment.
-        depth_transitions = std::make_unique<const std::vector<Transition>>(epsilon_depth_transitions[depth]);
-        for (const auto& transition: *depth_transitions)
+        for (const auto& transition: depth_epsilon_transitions[depth])
         {
             update_current_segment(depth, transition);
             update_next_segment(depth, transition);
@@ -137,8 +215,11 @@ void seg_nfa::Segmentation::update_next_segment(const size_t current_depth, cons
 const std::vector<Nfa>& seg_nfa::Segmentation::get_segments()
 {
     if (segments.empty()) {
-        get_untrimmed_segments();
-        for (auto& seg_aut: segments_raw) { segments.push_back(nfa::Nfa{ seg_aut }.trim()); }
+        // The views rename the states in their order, as trimming does. The trimmed segments are the same as trimmed
+        //  untrimmed segments.
+        for (size_t segment_idx{ 0 }; segment_idx < num_of_segments(); ++segment_idx) {
+            segments.push_back(get_segment_view(segment_idx).to_nfa().trim());
+        }
     }
 
     return segments;
@@ -150,21 +231,3 @@ const std::vector<Nfa>& seg_nfa::Segmentation::get_untrimmed_segments()
 
     return segments_raw;
 }
-
-void seg_nfa::Segmentation::compute_epsilon_depths()
-{
-    std::unordered_map<State, bool> visited{ initialize_visited_map() };
-    std::deque<StateDepthTuple> worklist{ initialize_worklist() };
-
-    while (!worklist.empty())
-    {
-        StateDepthTuple state_depth_pair{ worklist.front() };
-        worklist.pop_front();
-
-        if (!visited[state_depth_pair.state])
-        {
-            visited[state_depth_pair.state] = true;
-            process_state_depth_pair(state_depth_pair, worklist);
-        }
-    }
-}
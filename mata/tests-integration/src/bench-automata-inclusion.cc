@@ -49,5 +49,22 @@ int main(int argc, char *argv[]) {
     mata::nfa::is_included(lhs, rhs, &alphabet, params);
     TIME_END(automata_inclusion_antichain);
 
+    params["threads"] = "0"; // All hardware threads.
+    TIME_BEGIN(automata_inclusion_antichain_parallel);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_antichain_parallel);
+
+    params.erase("threads");
+    params["simulation"] = "forward";
+    TIME_BEGIN(automata_inclusion_antichain_simulation);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_antichain_simulation);
+
+    params.erase("simulation");
+    params["algorithm"] = "hkc";
+    TIME_BEGIN(automata_inclusion_hkc);
+    mata::nfa::is_included(lhs, rhs, &alphabet, params);
+    TIME_END(automata_inclusion_hkc);
+
     return EXIT_SUCCESS;
 }
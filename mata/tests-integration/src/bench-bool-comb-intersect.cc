@@ -42,5 +42,9 @@ int main(int argc, char *argv[]) {
     result.is_lang_empty();
     TIME_END(intersection_emptiness);
 
+    TIME_BEGIN(intersection_emptiness_single_pass);
+    intersection(automata).is_lang_empty();
+    TIME_END(intersection_emptiness_single_pass);
+
     return EXIT_SUCCESS;
 }
@@ -52,5 +52,16 @@ int main(int argc, char *argv[]) {
     is_included(automata[4], intersect_aut, &alphabet, params);
     TIME_END(automata_inclusion_antichain);
 
+    TIME_BEGIN(automata_inclusion_antichain_nary_intersection);
+    intersect_aut = intersection(std::span<const Nfa>{ automata.data(), 4 });
+    is_included(automata[4], intersect_aut, &alphabet, params);
+    TIME_END(automata_inclusion_antichain_nary_intersection);
+
+    TIME_BEGIN(automata_inclusion_lazy_product);
+    ProductView smaller_view{ automata[4] };
+    ProductView bigger_view{ { &automata[0], &automata[1], &automata[2], &automata[3] } };
+    mata::nfa::algorithms::is_included_antichains(smaller_view, bigger_view);
+    TIME_END(automata_inclusion_lazy_product);
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,79 @@
+/**
+ * Benchmark: Matching lines of a text against a regular expression
+ *
+ * The benchmark program compares matching each line of the input file against an automaton created from a regular
+ *  expression by the re2parser with `Nfa::is_in_lang()` and with the lazily determinizing `Matcher`.
+ *
+ * Usage: bench-matcher <regex> <file with lines to match>
+ */
+
+#include "utils/utils.hh"
+#include "mata/nfa/matcher.hh"
+#include "mata/nfa/bit-parallel-nfa.hh"
+#include "mata/parser/re2parser.hh"
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::cerr << "Regular expression or input file missing\n";
+        return EXIT_FAILURE;
+    }
+
+    Nfa aut;
+    mata::parser::create_nfa(&aut, argv[1]);
+
+    std::ifstream input{ argv[2] };
+    if (!input) {
+        std::cerr << "Could not open file '" << argv[2] << "'\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> lines;
+    std::vector<mata::Word> words;
+    for (std::string line; std::getline(input, line);) {
+        words.emplace_back(line.begin(), line.end());
+        for (mata::Symbol& symbol: words.back()) { symbol = static_cast<unsigned char>(symbol); }
+        lines.push_back(std::move(line));
+    }
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    size_t num_of_matches_is_in_lang{ 0 };
+    TIME_BEGIN(match_is_in_lang);
+    for (const mata::Word& word: words) {
+        if (aut.is_in_lang(Run{ word, {} })) { ++num_of_matches_is_in_lang; }
+    }
+    TIME_END(match_is_in_lang);
+
+    size_t num_of_matches_matcher{ 0 };
+    TIME_BEGIN(match_matcher);
+    Matcher matcher{ aut };
+    for (const std::string& line: lines) {
+        if (matcher.match(line)) { ++num_of_matches_matcher; }
+    }
+    TIME_END(match_matcher);
+
+    TIME_BEGIN(match_all_matcher);
+    const mata::BoolVector results{ Matcher{ aut }.match_all(words) };
+    TIME_END(match_all_matcher);
+
+    size_t num_of_matches_bit_parallel{ num_of_matches_matcher };
+    try {
+        const BitParallelNfa256 bit_parallel{ aut };
+        num_of_matches_bit_parallel = 0;
+        TIME_BEGIN(match_bit_parallel);
+        for (const std::string& line: lines) {
+            if (bit_parallel.is_in_lang(line)) { ++num_of_matches_bit_parallel; }
+        }
+        TIME_END(match_bit_parallel);
+    } catch (const std::runtime_error&) {
+        std::cerr << "Automaton too large for the bit-parallel simulation\n";
+    }
+
+    if (num_of_matches_is_in_lang != num_of_matches_matcher || num_of_matches_matcher != num_of_matches_bit_parallel
+        || num_of_matches_matcher != static_cast<size_t>(std::count(results.begin(), results.end(), true))) {
+        std::cerr << "Matchers disagree\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+/**
+ * Benchmark: Minimization
+ *
+ * The benchmark program compares the Brzozowski and the Hopcroft minimization (including determinization and
+ *  trimming), the latter both sequential and using all hardware threads.
+ *
+ * Optimal Inputs: inputs/single-automata.input
+ *
+ * NOTE: Input automata, that are of type `NFA-bits` are mintermized!
+ *  - If you want to skip mintermization, set the variable `MINTERMIZE_AUTOMATA` below to `false`
+ */
+
+#include "utils/utils.hh"
+
+constexpr bool MINTERMIZE_AUTOMATA{ true };
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::cerr << "Input file missing\n";
+        return EXIT_FAILURE;
+    }
+
+    Nfa aut;
+    mata::OnTheFlyAlphabet alphabet;
+    if (load_automaton(argv[1], aut, alphabet, MINTERMIZE_AUTOMATA) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    ParameterMap params;
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    params["algorithm"] = "brzozowski";
+    TIME_BEGIN(minimize_brzozowski);
+    mata::nfa::minimize(aut, params);
+    TIME_END(minimize_brzozowski);
+
+    params["algorithm"] = "hopcroft";
+    TIME_BEGIN(minimize_hopcroft);
+    mata::nfa::minimize(aut, params);
+    TIME_END(minimize_hopcroft);
+
+    params["threads"] = "0"; // All hardware threads.
+    TIME_BEGIN(minimize_hopcroft_parallel);
+    mata::nfa::minimize(aut, params);
+    TIME_END(minimize_hopcroft_parallel);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/**
+ * Benchmark: Application of an NFT to many NFAs
+ *
+ * The benchmark program applies a reluctant replace transducer to a batch of NFAs (random regular expressions over a
+ *  small alphabet), once by `Nft::apply()` followed by the projection to the output level, and once by the
+ *  `NftApplier` preprocessing the transducer once (sequentially, in parallel, and checking only the emptiness of the
+ *  images). For each method, the total time and the total number of states of the images (or the number of empty
+ *  images) are printed.
+ *
+ * Usage: bench-nft-applier [<number of NFAs>]
+ */
+
+#include <random>
+
+#include "utils/utils.hh"
+#include "mata/nft/nft.hh"
+#include "mata/nft/applier.hh"
+#include "mata/nft/strings.hh"
+#include "mata/parser/re2parser.hh"
+
+namespace {
+    using mata::nft::Nft;
+    using mata::nft::NftApplier;
+
+    std::string create_random_regex(std::mt19937& generator) {
+        const std::vector<std::string> parts{ "a", "b", "c", "d", "(ab)*", "(c|d)+", "[a-d]", "a+b+c", "(a|bc)*d" };
+        std::uniform_int_distribution<size_t> part_distribution(0, parts.size() - 1);
+        std::string regex{};
+        for (size_t i{ 0 }; i < 8; ++i) { regex += parts[part_distribution(generator)]; }
+        return regex;
+    }
+
+    void print_result(const std::string& name, const std::chrono::duration<double> elapsed, const std::string& counter,
+                      const size_t count) {
+        std::cout << name << ": " << elapsed.count() << "\n";
+        std::cout << name << "-" << counter << ": " << count << "\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [<number of NFAs>]\n";
+        return EXIT_FAILURE;
+    }
+    const size_t num_of_nfas{ argc == 2 ? std::stoul(argv[1]) : 2000 };
+
+    mata::EnumAlphabet alphabet{ 'a', 'b', 'c', 'd', 'f' };
+    const Nft nft{ mata::nft::strings::replace_reluctant_regex("a+b+c", { 'f' }, &alphabet) };
+    std::mt19937 generator{ 0 };
+    std::vector<Nfa> nfas(num_of_nfas);
+    for (Nfa& nfa: nfas) { mata::parser::create_nfa(&nfa, create_random_regex(generator)); }
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    auto start = std::chrono::system_clock::now();
+    size_t num_of_states{ 0 };
+    for (const Nfa& nfa: nfas) {
+        num_of_states += project_to(nft.apply(nfa), 1).to_nfa_move().trim().num_of_states();
+    }
+    print_result("apply-compose", std::chrono::system_clock::now() - start, "states", num_of_states);
+
+    start = std::chrono::system_clock::now();
+    const NftApplier applier{ nft };
+    num_of_states = 0;
+    for (const Nfa& image: applier.apply(nfas)) { num_of_states += image.num_of_states(); }
+    print_result("applier", std::chrono::system_clock::now() - start, "states", num_of_states);
+
+    start = std::chrono::system_clock::now();
+    num_of_states = 0;
+    for (const Nfa& image: applier.apply(nfas, 0)) { num_of_states += image.num_of_states(); }
+    print_result("applier-parallel", std::chrono::system_clock::now() - start, "states", num_of_states);
+
+    start = std::chrono::system_clock::now();
+    size_t num_of_empty{ 0 };
+    for (const Nfa& nfa: nfas) {
+        if (applier.is_image_empty(nfa)) { ++num_of_empty; }
+    }
+    print_result("applier-emptiness", std::chrono::system_clock::now() - start, "empty", num_of_empty);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+/**
+ * Benchmark: Composition of NFTs
+ *
+ * The benchmark program composes a chain of reluctant replace transducers (each replacing a literal over a small
+ *  alphabet), once with the on-the-fly composition and once with the composition inserting the levels, building the
+ *  product and projecting out the synchronization levels. For each composition, the total time and the numbers of
+ *  states and transitions of the (trimmed) result are printed.
+ *
+ * Usage: bench-nft-composition [<length of the chain>]
+ */
+
+#include "utils/utils.hh"
+#include "mata/nft/nft.hh"
+#include "mata/nft/algorithms.hh"
+#include "mata/nft/strings.hh"
+
+namespace {
+    using mata::nft::Nft;
+
+    template<class Compose>
+    void compose_chain(const std::vector<Nft>& chain, const Compose& compose, const std::string& name) {
+        const auto start = std::chrono::system_clock::now();
+        Nft result{ chain.front() };
+        for (auto it{ chain.begin() + 1 }; it != chain.end(); ++it) { result = compose(result, *it); }
+        const std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+        std::cout << name << ": " << elapsed.count() << "\n";
+        std::cout << name << "-states: " << result.num_of_states() << "\n";
+        std::cout << name << "-transitions: " << result.delta.num_of_transitions() << "\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [<length of the chain>]\n";
+        return EXIT_FAILURE;
+    }
+    const size_t length{ argc == 2 ? std::stoul(argv[1]) : 6 };
+
+    mata::EnumAlphabet alphabet{ 'a', 'b', 'c', 'd' };
+    const std::vector<mata::Word> literals{ { 'a', 'b' }, { 'b', 'c' }, { 'c', 'd' }, { 'd', 'a' } };
+    std::vector<Nft> chain{};
+    for (size_t i{ 0 }; i < length; ++i) {
+        chain.push_back(mata::nft::strings::replace_reluctant_literal(
+            literals[i % literals.size()], literals[(i + 1) % literals.size()], &alphabet));
+    }
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    const mata::utils::OrdVector<mata::nft::Level> lhs_sync_levels{ 1 };
+    const mata::utils::OrdVector<mata::nft::Level> rhs_sync_levels{ 0 };
+    compose_chain(chain, [&](const Nft& lhs, const Nft& rhs) {
+        return mata::nft::compose(lhs, rhs, lhs_sync_levels, rhs_sync_levels);
+    }, "on-the-fly");
+    compose_chain(chain, [&](const Nft& lhs, const Nft& rhs) {
+        return mata::nft::algorithms::compose_naive(lhs, rhs, lhs_sync_levels, rhs_sync_levels);
+    }, "naive");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/**
+ * Benchmark: Parsing of the Mata Format
+ *
+ * Measures the throughput of tokenizing the input automata with @c parse_mf(), and compares the construction of
+ *  automata of type `NFA-explicit` (the input automata mintermized and printed) directly from the tokens with the
+ *  construction through @c IntermediateAut.
+ *
+ * Optimal Inputs: inputs/bench-double-automata-inclusion.in
+ */
+
+#include <fstream>
+#include <sstream>
+
+#include "utils/utils.hh"
+#include "mata/nfa/builder.hh"
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "Input files missing\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> filenames{ argv + 1, argv + argc };
+    std::vector<std::string> inputs{};
+    size_t num_of_bytes{ 0 };
+    for (const std::string& filename: filenames) {
+        std::ifstream file{ filename };
+        if (!file) {
+            std::cerr << "Could not open file \'" << filename << "'\n";
+            return EXIT_FAILURE;
+        }
+        std::stringstream buffer{};
+        buffer << file.rdbuf();
+        inputs.push_back(buffer.str());
+        num_of_bytes += inputs.back().size();
+    }
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    TIME_BEGIN(tokenization);
+    size_t num_of_lines{ 0 };
+    for (const std::string& input: inputs) {
+        for (const mata::parser::ParsedSection& section: mata::parser::parse_mf(input)) {
+            num_of_lines += section.body.size();
+        }
+    }
+    TIME_END(tokenization);
+    const std::chrono::duration<double> tokenization_elapsed{ std::chrono::system_clock::now() - tokenization_start };
+    std::cout << "throughput (MB/s): " << static_cast<double>(num_of_bytes) / 1e6 / tokenization_elapsed.count()
+              << " (" << num_of_lines << " lines)\n";
+
+    std::vector<Nfa> auts{};
+    mata::OnTheFlyAlphabet alphabet{};
+    if (load_automata(filenames, auts, alphabet) != EXIT_SUCCESS) {
+        std::cerr << "Could not load automata\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> explicit_inputs{};
+    for (const Nfa& aut: auts) { explicit_inputs.push_back(aut.print_to_mata()); }
+
+    TIME_BEGIN(direct_construction);
+    std::vector<Nfa> direct{};
+    for (const std::string& input: explicit_inputs) { direct.push_back(builder::parse_from_mata(input)); }
+    TIME_END(direct_construction);
+
+    TIME_BEGIN(intermediate_construction);
+    std::vector<Nfa> intermediate{};
+    for (const std::string& input: explicit_inputs) {
+        mata::IntAlphabet int_alphabet{};
+        intermediate.push_back(builder::construct(
+            mata::IntermediateAut::parse_from_mf(mata::parser::parse_mf(input))[0], &int_alphabet));
+    }
+    TIME_END(intermediate_construction);
+
+    for (size_t i{ 0 }; i < auts.size(); ++i) {
+        if (direct[i].delta.num_of_transitions() != intermediate[i].delta.num_of_transitions()
+            || direct[i].num_of_states() != intermediate[i].num_of_states()) {
+            std::cerr << "error: automata constructed from '" << filenames[i] << "' differ\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/**
+ * Benchmark: Product construction
+ *
+ * The benchmark program computes intersections of random NFAs and of random NFTs. The product engine is instantiated
+ *  with the final condition as a lambda (as in `intersection()`), and called through `algorithms::product()` taking the
+ *  final condition as a type-erased `std::function`, called indirectly for each new pair of states. For each variant,
+ *  the total time and the total number of states of the products are printed.
+ *
+ * Usage: bench-product [<number of states of the operands>]
+ */
+
+#include <random>
+
+#include "utils/utils.hh"
+#include "mata/nfa/product.hh"
+#include "mata/nft/nft.hh"
+#include "mata/nft/algorithms.hh"
+
+namespace {
+    constexpr size_t NUM_OF_REPETITIONS{ 10 };
+
+    template<class Aut>
+    Aut create_random_automaton(const size_t num_of_states, std::mt19937& generator) {
+        Aut aut{};
+        std::uniform_int_distribution<State> state_distribution(0, num_of_states - 1);
+        std::uniform_int_distribution<mata::Symbol> symbol_distribution(0, 3);
+        aut.initial.insert(0);
+        for (State state{ 0 }; state < num_of_states; ++state) {
+            aut.add_state(state);
+            if (state_distribution(generator) % 4 == 0) { aut.final.insert(state); }
+            for (size_t i{ 0 }; i < 3; ++i) {
+                aut.delta.add(state, symbol_distribution(generator), state_distribution(generator));
+            }
+        }
+        return aut;
+    }
+
+    template<class Product>
+    void compute_products(const Product& product, const std::string& name) {
+        const auto start = std::chrono::system_clock::now();
+        size_t num_of_states{ 0 };
+        for (size_t i{ 0 }; i < NUM_OF_REPETITIONS; ++i) { num_of_states += product().num_of_states(); }
+        const std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+        std::cout << name << ": " << elapsed.count() << "\n";
+        std::cout << name << "-states: " << num_of_states << "\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [<number of states of the operands>]\n";
+        return EXIT_FAILURE;
+    }
+    const size_t num_of_states{ argc == 2 ? std::stoul(argv[1]) : 1000 };
+
+    std::mt19937 generator{ 0 };
+    const Nfa lhs{ create_random_automaton<Nfa>(num_of_states, generator) };
+    const Nfa rhs{ create_random_automaton<Nfa>(num_of_states, generator) };
+    // Random automata with all states on level 0 are NFTs with a single level.
+    mata::nft::Nft lhs_nft{ create_random_automaton<mata::nft::Nft>(num_of_states, generator) };
+    mata::nft::Nft rhs_nft{ create_random_automaton<mata::nft::Nft>(num_of_states, generator) };
+    lhs_nft.num_of_levels = 1;
+    rhs_nft.num_of_levels = 1;
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    const auto both_final = [&](const State lhs_state, const State rhs_state) {
+        return lhs.final.contains(lhs_state) && rhs.final.contains(rhs_state);
+    };
+    compute_products([&]() { return algorithms::compute_product(lhs, rhs, both_final); }, "nfa-template");
+    compute_products([&]() { return algorithms::product(lhs, rhs, both_final); }, "nfa-std-function");
+
+    const auto both_final_nft = [&](const State lhs_state, const State rhs_state) {
+        return lhs_nft.final.contains(lhs_state) && rhs_nft.final.contains(rhs_state);
+    };
+    compute_products([&]() { return mata::nft::intersection(lhs_nft, rhs_nft); }, "nft-template");
+    compute_products([&]() { return mata::nft::algorithms::product(lhs_nft, rhs_nft, both_final_nft); },
+                     "nft-std-function");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+/**
+ * Benchmark: Construction of automata from regular expressions
+ *
+ * The benchmark program compares the constructions of automata from regular expressions by the re2parser: through
+ *  the RE2 program, and the Glushkov and Thompson constructions walking the parsed regular expression. For each
+ *  construction, the total time and the total numbers of states and transitions of the (not reduced) automata without
+ *  epsilon transitions are printed.
+ *
+ * Usage: bench-regex-construction <file with a regular expression on each line>
+ */
+
+#include "utils/utils.hh"
+#include "mata/parser/re2parser.hh"
+
+namespace {
+    using mata::parser::RegexConstruction;
+
+    void construct_all(const std::vector<std::string>& patterns, const RegexConstruction construction,
+                       const std::string& name) {
+        size_t num_of_states{ 0 };
+        size_t num_of_transitions{ 0 };
+        const auto start = std::chrono::system_clock::now();
+        for (const std::string& pattern: patterns) {
+            Nfa aut;
+            mata::parser::create_nfa(&aut, pattern, false, 306, false, Encoding::Latin1, construction);
+            num_of_states += aut.num_of_states();
+            num_of_transitions += aut.delta.num_of_transitions();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+        std::cout << name << ": " << elapsed.count() << "\n";
+        std::cout << name << "-states: " << num_of_states << "\n";
+        std::cout << name << "-transitions: " << num_of_transitions << "\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::cerr << "Input file missing\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input{ argv[1] };
+    if (!input) {
+        std::cerr << "Could not open file '" << argv[1] << "'\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> patterns;
+    for (std::string line; std::getline(input, line);) {
+        if (!line.empty()) { patterns.push_back(std::move(line)); }
+    }
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    construct_all(patterns, RegexConstruction::Prog, "prog");
+    construct_all(patterns, RegexConstruction::Glushkov, "glushkov");
+    construct_all(patterns, RegexConstruction::Thompson, "thompson");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,56 @@
+/**
+ * Benchmark: Simulation
+ *
+ * The benchmark program compares computing the maximal forward simulation by simlib (over an explicit LTS, into a
+ *  dense relation) and by the native partition-relation refinement over Delta, and the simulation reduction.
+ *
+ * Optimal Inputs: inputs/single-automata.input
+ *
+ * NOTE: Input automata, that are of type `NFA-bits` are mintermized!
+ *  - If you want to skip mintermization, set the variable `MINTERMIZE_AUTOMATA` below to `false`
+ */
+
+#include "utils/utils.hh"
+
+#include "mata/nfa/algorithms.hh"
+#include "mata/nfa/simulation.hh"
+#include <mata/simlib/explicit_lts.hh>
+
+constexpr bool MINTERMIZE_AUTOMATA{ true };
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::cerr << "Input file missing\n";
+        return EXIT_FAILURE;
+    }
+
+    Nfa aut;
+    mata::OnTheFlyAlphabet alphabet;
+    if (load_automaton(argv[1], aut, alphabet, MINTERMIZE_AUTOMATA) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    TIME_BEGIN(simulation_simlib);
+    const mata::Symbol final_symbol{ aut.delta.get_max_symbol() + 1 };
+    Simlib::ExplicitLTS lts(aut.num_of_states());
+    for (const Transition& transition: aut.delta.transitions()) {
+        lts.add_transition(transition.source, transition.symbol, transition.target);
+    }
+    for (const State state: aut.final) { lts.add_transition(state, final_symbol, state); }
+    lts.init();
+    const Simlib::Util::BinaryRelation simlib_relation{ lts.compute_simulation() };
+    TIME_END(simulation_simlib);
+
+    TIME_BEGIN(simulation_native);
+    const mata::nfa::SimulationRelation relation{ mata::nfa::algorithms::compute_simulation(aut) };
+    TIME_END(simulation_native);
+
+    TIME_BEGIN(reduce_simulation);
+    mata::nfa::reduce(aut);
+    TIME_END(reduce_simulation);
+
+    return EXIT_SUCCESS;
+}
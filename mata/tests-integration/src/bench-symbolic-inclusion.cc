@@ -0,0 +1,65 @@
+/**
+ * Benchmark: Symbolic Automata Inclusion (b-armc-incl)
+ *
+ * Compares the inclusion checking over BDD-guarded transitions of automata of type `NFA-bits` (without the
+ *  mintermization) with the mintermization followed by the explicit inclusion checking.
+ *
+ * Optimal Inputs: inputs/bench-double-automata-inclusion.in
+ */
+
+#include "utils/utils.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/symbolic-nfa.hh"
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::cerr << "Input files missing\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<mata::IntermediateAut> inter_auts;
+    for (const std::string filename: { argv[1], argv[2] }) {
+        std::vector<mata::IntermediateAut> parsed;
+        if (load_intermediate_automaton(filename, parsed) != EXIT_SUCCESS) {
+            std::cerr << "Could not load intermediate autotomaton from \'" << filename << "'\n";
+            return EXIT_FAILURE;
+        }
+        inter_auts.push_back(parsed[0]);
+    }
+    if (!inter_auts[0].is_bitvector() || !inter_auts[1].is_bitvector()) {
+        std::cerr << "Expecting automata of type NFA-bits\n";
+        return EXIT_FAILURE;
+    }
+
+    // Setting precision of the times to fixed points and 4 decimal places
+    std::cout << std::fixed << std::setprecision(4);
+
+    TIME_BEGIN(symbolic_construction);
+    const Cudd manager{};
+    std::unordered_map<std::string, BDD> symbol_to_bddvar{};
+    const SymbolicNfa lhs{ builder::construct_symbolic(inter_auts[0], manager, &symbol_to_bddvar) };
+    const SymbolicNfa rhs{ builder::construct_symbolic(inter_auts[1], manager, &symbol_to_bddvar) };
+    TIME_END(symbolic_construction);
+
+    TIME_BEGIN(symbolic_inclusion);
+    const bool symbolic_result{ is_included(lhs, rhs) };
+    TIME_END(symbolic_inclusion);
+
+    TIME_BEGIN(mintermization);
+    mata::Mintermization mintermization{};
+    const std::vector<mata::IntermediateAut> mintermized{ mintermization.mintermize(inter_auts) };
+    mata::OnTheFlyAlphabet alphabet{};
+    const Nfa explicit_lhs{ builder::construct(mintermized[0], &alphabet) };
+    const Nfa explicit_rhs{ builder::construct(mintermized[1], &alphabet) };
+    TIME_END(mintermization);
+
+    TIME_BEGIN(explicit_inclusion);
+    const bool explicit_result{ mata::nfa::is_included(explicit_lhs, explicit_rhs, &alphabet) };
+    TIME_END(explicit_inclusion);
+
+    if (symbolic_result != explicit_result) {
+        std::cerr << "error: symbolic and explicit inclusion differ\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -34,6 +34,53 @@ int load_automaton(
     }
 }
 
+void add_split_minterms(
+        Nfa& aut,
+        const mata::MintermTree& minterm_tree,
+        const size_t num_of_known_splits,
+        mata::OnTheFlyAlphabet& alphabet
+) {
+    const auto& splits{ minterm_tree.get_splits() };
+    if (num_of_known_splits == splits.size()) { return; }
+
+    // Minterms split from each minterm known to the automaton, following chains of splits.
+    std::unordered_map<mata::Symbol, std::vector<mata::Symbol>> split_minterms;
+    std::unordered_map<mata::Symbol, mata::Symbol> known_minterm_of;
+    for (size_t i{ num_of_known_splits }; i < splits.size(); ++i) {
+        const auto [new_minterm, minterm] = splits[i];
+        const auto known_minterm_it = known_minterm_of.find(minterm);
+        const mata::Symbol known_minterm = known_minterm_it == known_minterm_of.end() ? minterm
+                                                                                      : known_minterm_it->second;
+        known_minterm_of[new_minterm] = known_minterm;
+        split_minterms[known_minterm].push_back(new_minterm);
+    }
+
+    // Only the minterms split from the minterms used by the automaton are translated, so that the alphabet contains
+    //  only the minterms used by some automaton.
+    std::unordered_map<mata::Symbol, std::vector<mata::Symbol>> split_symbols;
+    for (const mata::Symbol symbol : aut.delta.get_used_symbols()) {
+        const auto minterm = static_cast<mata::Symbol>(std::stoul(alphabet.reverse_translate_symbol(symbol)));
+        const auto split_minterms_it = split_minterms.find(minterm);
+        if (split_minterms_it == split_minterms.end()) { continue; }
+        std::vector<mata::Symbol>& symbols = split_symbols[symbol];
+        for (const mata::Symbol new_minterm : split_minterms_it->second) {
+            symbols.push_back(alphabet.translate_symb(std::to_string(new_minterm)));
+        }
+    }
+
+    std::vector<Transition> new_transitions;
+    for (const Transition& transition : aut.delta.transitions()) {
+        const auto split_symbols_it = split_symbols.find(transition.symbol);
+        if (split_symbols_it == split_symbols.end()) { continue; }
+        for (const mata::Symbol symbol : split_symbols_it->second) {
+            new_transitions.push_back({ transition.source, symbol, transition.target });
+        }
+    }
+    for (const Transition& transition : new_transitions) {
+        aut.delta.add(transition.source, transition.symbol, transition.target);
+    }
+}
+
 int load_automata(
         std::vector<std::string>& filenames,
         std::vector<Nfa>& auts,
@@ -57,13 +104,20 @@ int load_automata(
                 auts.push_back(mata::nfa::builder::construct(inter_aut, &alphabet));
             }
         } else {
+            // Automata are mintermized one by one, refining the minterm tree shared by all of them. Number of splits of
+            //  minterms when each automaton was constructed, to add the minterms split later to the automaton.
             mata::Mintermization mintermization;
+            std::vector<mata::IntermediateAut> mintermized;
+            std::vector<size_t> num_of_splits;
             TIME_BEGIN(mintermization);
-            std::vector<mata::IntermediateAut> mintermized = mintermization.mintermize(inter_auts);
+            for (const mata::IntermediateAut& inter_aut : inter_auts) {
+                mintermized.push_back(mintermization.mintermize(inter_aut));
+                num_of_splits.push_back(mintermization.get_minterm_tree().get_splits().size());
+            }
             TIME_END(mintermization);
-            for (mata::IntermediateAut& inter_aut : mintermized) {
-                assert(inter_aut.alphabet_type == mata::IntermediateAut::AlphabetType::BITVECTOR);
-                auts.push_back(mata::nfa::builder::construct(inter_aut, &alphabet));
+            for (size_t i{ 0 }; i < mintermized.size(); ++i) {
+                auts.push_back(mata::nfa::builder::construct(mintermized[i], &alphabet));
+                add_split_minterms(auts[i], mintermization.get_minterm_tree(), num_of_splits[i], alphabet);
             }
         }
         return EXIT_SUCCESS;
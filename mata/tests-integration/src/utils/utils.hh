@@ -36,6 +36,25 @@ int load_automaton(
         const bool mintermize_automata = true
 );
 
+/**
+ * @brief Add transitions over minterms split after @p aut was mintermized.
+ *
+ * Each transition over a minterm is duplicated over all minterms split from it by the splits of @p minterm_tree after
+ *  the first @p num_of_known_splits splits, which were already known when @p aut was mintermized.
+ *
+ * @param[in,out] aut Mintermized automaton with symbols of the minterms translated by @p alphabet.
+ * @param[in] minterm_tree Minterm tree @p aut was mintermized with.
+ * @param[in] num_of_known_splits Number of splits of @p minterm_tree when @p aut was mintermized.
+ * @param[in,out] alphabet Alphabet translating the minterms to symbols. Only the minterms split from minterms used
+ *  by @p aut are added.
+ */
+void add_split_minterms(
+        Nfa& aut,
+        const mata::MintermTree& minterm_tree,
+        size_t num_of_known_splits,
+        mata::OnTheFlyAlphabet& alphabet
+);
+
 /**
  * @brief Load automata from list of files at @p filename into list of automata @p aut,
  * using @p alphabet for symbols on transitions.
@@ -232,3 +232,81 @@ TEST_CASE("mata::Mintermization::mintermization") {
         REQUIRE(res[1].transitions[1].second.children[1].node.name == "r");
     }
 } // TEST_CASE("mata::Mintermization::mintermization")
+
+TEST_CASE("mata::MintermTree") {
+    const Cudd bdd_mng{};
+    const BDD a{ bdd_mng.bddVar() };
+    const BDD b{ bdd_mng.bddVar() };
+    const BDD c{ bdd_mng.bddVar() };
+
+    SECTION("refinement") {
+        mata::MintermTree tree{ bdd_mng };
+        CHECK(tree.num_of_minterms() == 1);
+        CHECK(tree.get_minterm(0) == bdd_mng.bddOne());
+
+        CHECK(tree.add(a) == 0);
+        CHECK(tree.num_of_minterms() == 2);
+        CHECK(tree.get_minterm(0) == a);
+        CHECK(tree.get_minterm(1) == !a);
+
+        // Only the minterm inside a is split, !a is left untouched.
+        CHECK(tree.add(a * b) == 1);
+        CHECK(tree.num_of_minterms() == 3);
+        CHECK(tree.get_minterm(0) == a * b);
+        CHECK(tree.get_minterm(1) == !a);
+        CHECK(tree.get_minterm(2) == a * !b);
+        CHECK(tree.get_splits() == std::vector<std::pair<mata::Symbol, mata::Symbol>>{ { 1, 0 }, { 2, 0 } });
+
+        CHECK(tree.add(a) == 0);
+        CHECK(tree.num_of_guards() == 2);
+        CHECK(tree.get_minterms_of(a) == std::vector<mata::Symbol>{ 0, 2 });
+        CHECK(tree.get_minterms_of(a * b) == std::vector<mata::Symbol>{ 0 });
+        CHECK(tree.get_guards_of(0) == std::vector<mata::MintermTree::GuardId>{ 0, 1 });
+        CHECK(tree.get_guards_of(1).empty());
+        CHECK(tree.get_guards_of(2) == std::vector<mata::MintermTree::GuardId>{ 0 });
+
+        // Guard including whole minterms does not split anything.
+        CHECK(tree.add(!a) == 2);
+        CHECK(tree.num_of_minterms() == 3);
+        CHECK(tree.get_guards_of(1) == std::vector<mata::MintermTree::GuardId>{ 2 });
+    }
+
+    SECTION("same minterms as refining all minterms") {
+        const std::vector<BDD> bdds{ a + b, b * !c, !a * c, a * b * c, !b };
+        mata::MintermTree tree{ bdd_mng };
+        std::unordered_set<BDD> expected{ bdd_mng.bddOne() };
+        for (const BDD& bdd: bdds) {
+            tree.add(bdd);
+            std::unordered_set<BDD> refined{};
+            for (const BDD& minterm: expected) {
+                if (!(minterm * bdd).IsZero()) { refined.insert(minterm * bdd); }
+                if (!(minterm * !bdd).IsZero()) { refined.insert(minterm * !bdd); }
+            }
+            expected = std::move(refined);
+        }
+        std::unordered_set<BDD> minterms{};
+        for (mata::Symbol minterm{ 0 }; minterm < tree.num_of_minterms(); ++minterm) {
+            minterms.insert(tree.get_minterm(minterm));
+            for (const mata::MintermTree::GuardId guard: tree.get_guards_of(minterm)) {
+                CHECK(tree.get_minterm(minterm).Leq(tree.get_guard(guard)));
+            }
+        }
+        CHECK(minterms == expected);
+    }
+
+    SECTION("incremental mintermization") {
+        mata::Mintermization mintermization{};
+        const std::vector<mata::IntermediateAut> auts = mata::IntermediateAut::parse_from_mf(parse_mf(
+            "@NFA-bits\n%States-enum q r\n%Alphabet-auto\n%Initial q\n%Final r\nq (a1 | a2) r\n"
+            "@NFA-bits\n%States-enum q r\n%Alphabet-auto\n%Initial q\n%Final r\nq (a1 & a3) r\n"));
+        const mata::IntermediateAut first = mintermization.mintermize(auts[0]);
+        CHECK(first.transitions.size() == 1);
+        CHECK(mintermization.get_minterm_tree().num_of_minterms() == 2);
+        const mata::IntermediateAut second = mintermization.mintermize(auts[1]);
+        CHECK(second.transitions.size() == 1);
+        CHECK(mintermization.get_minterm_tree().num_of_minterms() == 3);
+        // The minterm of the first automaton was split by the guard of the second one.
+        REQUIRE(mintermization.get_minterm_tree().get_splits().size() == 2);
+        CHECK(second.transitions[0].second.children[0].node.name == first.transitions[0].second.children[0].node.name);
+    }
+} // TEST_CASE("mata::MintermTree")
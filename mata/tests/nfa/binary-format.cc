@@ -0,0 +1,177 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/binary-format.hh"
+#include "mata/nft/nft.hh"
+#include "mata/nft/builder.hh"
+
+using namespace mata::nfa;
+using mata::Symbol;
+using mata::OnTheFlyAlphabet;
+
+namespace {
+    std::filesystem::path get_temp_path(const std::string& name) {
+        return std::filesystem::temp_directory_path() / ("mata-binary-format-" + name + ".bin");
+    }
+
+    /// Sparse sets compare the order of insertion, hence compare their sorted states instead.
+    StateSet sorted(const mata::utils::SparseSet<State>& states) {
+        return StateSet{ std::vector<State>{ states.begin(), states.end() } };
+    }
+}
+
+TEST_CASE("mata::nfa::Nfa::save_binary() and builder::mmap_binary()") {
+    const std::filesystem::path path{ get_temp_path("nfa") };
+
+    SECTION("empty automaton") {
+        Nfa{}.save_binary(path);
+        const Nfa loaded{ builder::mmap_binary(path) };
+        CHECK(loaded.num_of_states() == 0);
+        CHECK(loaded.initial.empty());
+        CHECK(loaded.final.empty());
+    }
+
+    SECTION("states without transitions") {
+        Nfa aut{ 70 };
+        aut.initial = { 0, 69 };
+        aut.final = { 64 };
+        aut.delta.add(3, 'a', 64);
+        aut.save_binary(path);
+        const Nfa loaded{ builder::mmap_binary(path) };
+        CHECK(loaded.num_of_states() == 70);
+        CHECK(sorted(loaded.initial) == sorted(aut.initial));
+        CHECK(sorted(loaded.final) == sorted(aut.final));
+        CHECK(loaded.delta == aut.delta);
+    }
+
+    SECTION("random automata") {
+        for (size_t i{ 0 }; i < 20; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(100, 5, 2.0, 0.3) };
+            aut.save_binary(path);
+            const Nfa loaded{ builder::mmap_binary(path) };
+            CHECK(loaded.num_of_states() == aut.num_of_states());
+            CHECK(sorted(loaded.initial) == sorted(aut.initial));
+            CHECK(sorted(loaded.final) == sorted(aut.final));
+            CHECK(loaded.delta == aut.delta);
+        }
+    }
+
+    SECTION("alphabet") {
+        OnTheFlyAlphabet alphabet{};
+        Nfa aut{ 2, { 0 }, { 1 }, &alphabet };
+        aut.delta.add(0, alphabet.translate_symb("a"), 1);
+        aut.delta.add(1, alphabet.translate_symb("long symbol name"), 0);
+        aut.save_binary(path, &alphabet);
+
+        OnTheFlyAlphabet loaded_alphabet{};
+        const Nfa loaded{ builder::mmap_binary(path, &loaded_alphabet) };
+        CHECK(loaded.alphabet == &loaded_alphabet);
+        CHECK(loaded_alphabet.get_symbol_map() == alphabet.get_symbol_map());
+        CHECK(loaded.delta == aut.delta);
+
+        // Loading again into the same alphabet keeps the symbols.
+        CHECK_NOTHROW(builder::mmap_binary(path, &loaded_alphabet));
+        OnTheFlyAlphabet conflicting_alphabet{};
+        conflicting_alphabet.add_new_symbol("a", 42);
+        CHECK_THROWS_WITH(builder::mmap_binary(path, &conflicting_alphabet),
+                          Catch::Matchers::ContainsSubstring("different value"));
+
+        // Without an alphabet to fill, the stored alphabet is ignored.
+        CHECK(builder::mmap_binary(path).alphabet == nullptr);
+    }
+
+    SECTION("invalid files") {
+        Nfa aut{ 3, { 0 }, { 2 } };
+        aut.delta.add(0, 0, 1);
+        aut.delta.add(1, 1, 2);
+        aut.save_binary(path);
+        const std::uintmax_t size{ std::filesystem::file_size(path) };
+
+        {
+            // Set a bit of the initial states beyond the number of states.
+            std::fstream file{ path, std::ios::binary | std::ios::in | std::ios::out };
+            file.seekp(sizeof(binary::Header));
+            const uint64_t initial_bits{ 0b1001 };
+            file.write(reinterpret_cast<const char*>(&initial_bits), sizeof(initial_bits));
+        }
+        CHECK_THROWS_WITH(builder::mmap_binary(path),
+                          Catch::Matchers::ContainsSubstring("initial or final states out of range"));
+
+        {
+            // The size of the targets wraps around to the original size.
+            aut.save_binary(path);
+            std::fstream file{ path, std::ios::binary | std::ios::in | std::ios::out };
+            file.seekp(offsetof(binary::Header, num_of_transitions));
+            const uint64_t num_of_transitions{ 2 + (uint64_t{ 1 } << 61) };
+            file.write(reinterpret_cast<const char*>(&num_of_transitions), sizeof(num_of_transitions));
+        }
+        CHECK(std::filesystem::file_size(path) == size);
+        CHECK_THROWS_WITH(builder::mmap_binary(path), Catch::Matchers::ContainsSubstring("wrong size of the file"));
+
+        std::filesystem::resize_file(path, size - 8);
+        CHECK_THROWS_WITH(builder::mmap_binary(path), Catch::Matchers::ContainsSubstring("wrong size of the file"));
+
+        {
+            std::ofstream output{ path, std::ios::binary | std::ios::trunc };
+            output << std::string(256, '\n') << "@NFA-explicit\n%Alphabet-auto\n%Initial q0\n%Final q0\nq0 a q0\n";
+        }
+        CHECK_THROWS_WITH(builder::mmap_binary(path), Catch::Matchers::ContainsSubstring("wrong magic number"));
+
+        std::filesystem::resize_file(path, 4);
+        CHECK_THROWS_WITH(builder::mmap_binary(path),
+                          Catch::Matchers::ContainsSubstring("is not an automaton in the binary format"));
+
+        CHECK_THROWS_WITH(builder::mmap_binary(get_temp_path("missing")),
+                          Catch::Matchers::ContainsSubstring("Could not open file"));
+
+        mata::nft::Nft{ aut }.save_binary(path);
+        CHECK_THROWS_WITH(builder::mmap_binary(path), Catch::Matchers::ContainsSubstring("is not 'NFA'"));
+
+        CHECK_THROWS_WITH(binary::save(path, aut, binary::AutomatonKind::NFT, std::vector<uint64_t>{ 0, 1 }, 2),
+                          Catch::Matchers::ContainsSubstring("given for a transducer with 3 states"));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("mata::nfa::binary::MappedAutomaton") {
+    const std::filesystem::path path{ get_temp_path("mapped") };
+    Nfa aut{ 4, { 0 }, { 2, 3 } };
+    aut.delta.add(0, 'a', 1);
+    aut.delta.add(0, 'a', 2);
+    aut.delta.add(0, 'b', 3);
+    aut.delta.add(2, 'c', 0);
+    aut.save_binary(path);
+
+    binary::MappedAutomaton mapped{ path };
+    CHECK(mapped.kind() == binary::AutomatonKind::NFA);
+    CHECK(mapped.num_of_states() == 4);
+    CHECK(mapped.is_initial(0));
+    CHECK(!mapped.is_initial(1));
+    CHECK(mapped.is_final(3));
+    CHECK(!mapped.is_final(4));
+    CHECK(mapped.header().num_of_transitions == 4);
+    CHECK(!mapped.has_alphabet());
+    CHECK(mapped.levels().empty());
+
+    const std::vector<uint64_t> state_offsets{ mapped.state_offsets().begin(), mapped.state_offsets().end() };
+    CHECK(state_offsets == std::vector<uint64_t>{ 0, 2, 2, 3, 3 });
+    const std::vector<Symbol> symbols{ mapped.symbols().begin(), mapped.symbols().end() };
+    CHECK(symbols == std::vector<Symbol>{ 'a', 'b', 'c' });
+    const std::vector<uint64_t> target_offsets{ mapped.target_offsets().begin(), mapped.target_offsets().end() };
+    CHECK(target_offsets == std::vector<uint64_t>{ 0, 2, 3, 4 });
+    const std::vector<State> targets{ mapped.targets().begin(), mapped.targets().end() };
+    CHECK(targets == std::vector<State>{ 1, 2, 3, 0 });
+
+    const binary::MappedAutomaton moved{ std::move(mapped) };
+    CHECK(moved.num_of_states() == 4);
+    CHECK(moved.get_delta() == aut.delta);
+
+    std::filesystem::remove(path);
+}
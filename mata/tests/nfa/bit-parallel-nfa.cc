@@ -0,0 +1,104 @@
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/bit-parallel-nfa.hh"
+#include "mata/parser/re2parser.hh"
+
+using namespace mata::nfa;
+using mata::Symbol;
+using mata::Word;
+
+namespace {
+    /// The end of the first infix of @p word in the language of @p aut, computed naively.
+    std::optional<size_t> find_first_match_naive(const Nfa& aut, const Word& word) {
+        for (size_t end{ 0 }; end <= word.size(); ++end) {
+            for (size_t begin{ 0 }; begin <= end; ++begin) {
+                if (aut.is_in_lang(Run{ Word(word.begin() + static_cast<std::ptrdiff_t>(begin),
+                                                   word.begin() + static_cast<std::ptrdiff_t>(end)), {} })) { return end; }
+            }
+        }
+        return std::nullopt;
+    }
+}
+
+TEST_CASE("mata::nfa::BitParallelNfa") {
+    SECTION("empty automaton") {
+        const BitParallelNfa64 bit_parallel{ Nfa{} };
+        CHECK(bit_parallel.num_of_positions() == 0);
+        CHECK(!bit_parallel.is_in_lang(Word{}));
+        CHECK(!bit_parallel.is_prfx_in_lang(Word{ 1 }));
+        CHECK(!bit_parallel.find_first_match(Word{ 1 }).has_value());
+    }
+
+    SECTION("positions") {
+        Nfa aut{ 3, { 0 }, { 2 } };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(0, 'b', 1);
+        aut.delta.add(1, 'c', 2);
+        aut.delta.add(1, 'd', 2);
+        aut.delta.add(2, 'c', 2);
+        const BitParallelNfa64 bit_parallel{ aut };
+        // Initial position of 0, a position of 1 over 'a' and 'b' (both from 0), a position of 2 over 'c' (from 1
+        //  and 2) and a position of 2 over 'd' (from 1 only).
+        CHECK(bit_parallel.num_of_positions() == 4);
+        CHECK(bit_parallel.is_in_lang("adc"));
+        CHECK(!bit_parallel.is_in_lang("add"));
+        CHECK(bit_parallel.is_in_lang("ac"));
+        CHECK(bit_parallel.is_in_lang("bccc"));
+        CHECK(!bit_parallel.is_in_lang("a"));
+        CHECK(!bit_parallel.is_in_lang("acb"));
+        CHECK(bit_parallel.is_prfx_in_lang("acb"));
+        CHECK(bit_parallel.find_first_match("xxbcc") == 4);
+        CHECK(!bit_parallel.find_first_match("xxbxc").has_value());
+    }
+
+    SECTION("epsilon transitions") {
+        Nfa aut{ 4, { 0 }, { 3 } };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(1, mata::nfa::EPSILON, 2);
+        aut.delta.add(2, 'b', 3);
+        aut.delta.add(1, mata::nfa::EPSILON, 3);
+        const BitParallelNfa64 bit_parallel{ aut };
+        CHECK(bit_parallel.is_in_lang("a"));
+        CHECK(bit_parallel.is_in_lang("ab"));
+        CHECK(!bit_parallel.is_in_lang("b"));
+    }
+
+    SECTION("too many positions") {
+        Nfa aut{ 70, { 0 }, { 69 } };
+        for (State state{ 0 }; state < 69; ++state) { aut.delta.add(state, 'a', state + 1); }
+        CHECK_THROWS_WITH(BitParallelNfa64{ aut }, Catch::Matchers::ContainsSubstring("cannot represent 70 positions"));
+        CHECK(BitParallelNfa128{ aut }.is_in_lang(std::string(69, 'a')));
+    }
+
+    SECTION("random automata against is_in_lang()") {
+        std::mt19937 generator{ 7 };
+        std::uniform_int_distribution<size_t> length_distribution{ 0, 10 };
+        std::uniform_int_distribution<Symbol> symbol_distribution{ 0, 3 };
+        for (size_t i{ 0 }; i < 20; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(20, 3, 1.5, 0.3) };
+            const BitParallelNfa256 bit_parallel{ aut };
+            for (size_t j{ 0 }; j < 50; ++j) {
+                Word word(length_distribution(generator));
+                for (Symbol& symbol: word) { symbol = symbol_distribution(generator); }
+                CHECK(bit_parallel.is_in_lang(word) == aut.is_in_lang(Run{ word, {} }));
+                CHECK(bit_parallel.is_prfx_in_lang(word) == aut.is_prfx_in_lang(Run{ word, {} }));
+                CHECK(bit_parallel.find_first_match(word) == find_first_match_naive(aut, word));
+            }
+        }
+    }
+
+    SECTION("regular expression") {
+        Nfa aut{};
+        mata::parser::create_nfa(&aut, "[0-9]{3}-[0-9]{4}");
+        const BitParallelNfa64 bit_parallel{ aut };
+        CHECK(bit_parallel.is_in_lang("555-1234"));
+        CHECK(!bit_parallel.is_in_lang("555-12345"));
+        CHECK(bit_parallel.is_prfx_in_lang("555-12345"));
+        CHECK(bit_parallel.find_first_match("call 555-1234 now") == 13);
+    }
+}
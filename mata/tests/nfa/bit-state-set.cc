@@ -0,0 +1,123 @@
+#include "utils.hh"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/bit-state-set.hh"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+using namespace mata::nfa;
+
+using Symbol = mata::Symbol;
+
+TEST_CASE("mata::nfa::BitStateSet") {
+    SECTION("empty set") {
+        const BitStateSet set{ 100 };
+        CHECK(set.empty());
+        CHECK(set.size() == 0);
+        CHECK(set.domain_size() == 128);
+        CHECK(set.to_state_set().empty());
+        CHECK(BitStateSet{}.empty());
+        CHECK(BitStateSet{ 0 }.is_subset_of(BitStateSet{ 0 }));
+    }
+
+    SECTION("insert and erase") {
+        BitStateSet set{ 200, StateSet{ 0, 63, 64, 199 } };
+        CHECK(set.size() == 4);
+        CHECK(set.contains(63));
+        CHECK(set[64]);
+        CHECK(!set.contains(65));
+        set.erase(63);
+        set.insert(130);
+        CHECK(set.to_state_set() == StateSet{ 0, 64, 130, 199 });
+        std::vector<State> states{ 42 };
+        set.to_vector(states);
+        CHECK(states == std::vector<State>{ 0, 64, 130, 199 });
+        set.clear();
+        CHECK(set.empty());
+        CHECK(set.domain_size() == 256);
+    }
+
+    SECTION("binary operations") {
+        const BitStateSet lhs{ 150, StateSet{ 1, 70, 140 } };
+        const BitStateSet rhs{ 150, StateSet{ 1, 2, 70, 71, 140 } };
+        const BitStateSet other{ 150, StateSet{ 3, 149 } };
+        CHECK(lhs.is_subset_of(rhs));
+        CHECK(!rhs.is_subset_of(lhs));
+        CHECK(lhs.is_subset_of(lhs));
+        CHECK(lhs.intersects_with(rhs));
+        CHECK(!lhs.intersects_with(other));
+        CHECK((lhs | other).to_state_set() == StateSet{ 1, 3, 70, 140, 149 });
+        CHECK((lhs & rhs) == lhs);
+        CHECK((lhs & other).empty());
+        BitStateSet set{ lhs };
+        set |= rhs;
+        CHECK(set == rhs);
+        set &= other;
+        CHECK(set.empty());
+        CHECK(lhs != rhs);
+        CHECK(std::hash<BitStateSet>{}(lhs) == std::hash<BitStateSet>{}(BitStateSet{ 150, StateSet{ 1, 70, 140 } }));
+    }
+}
+
+TEST_CASE("mata::nfa::BitStateSet in subset constructions") {
+    // Computes the results with StateSet macrostates (the threshold 0) and with BitStateSet macrostates.
+    auto check_same_results = [&](const Nfa& smaller, const Nfa& bigger) {
+        const mata::OnTheFlyAlphabet alphabet{ create_alphabet(bigger) };
+        REQUIRE(!use_bit_state_sets(bigger.num_of_states(), 0));
+        REQUIRE(use_bit_state_sets(bigger.num_of_states()));
+        const Nfa dfa{ determinize(bigger, static_cast<MacrostateStore*>(nullptr), std::nullopt, 0) };
+        const bool included{ algorithms::is_included_antichains(smaller, bigger, nullptr, nullptr, 0) };
+        const bool universal{ algorithms::is_universal_antichains(bigger, alphabet, nullptr, 0) };
+
+        CHECK(determinize(bigger).is_identical(dfa));
+        Run cex{};
+        CHECK(algorithms::is_included_antichains(smaller, bigger, nullptr, &cex) == included);
+        if (!included) {
+            Nfa smaller_copy{ smaller };
+            Nfa bigger_copy{ bigger };
+            CHECK(smaller_copy.is_in_lang(cex.word));
+            CHECK(!bigger_copy.is_in_lang(cex.word));
+        }
+        CHECK(algorithms::is_included_antichains(FrozenNfa{ smaller }, FrozenNfa{ bigger }) == included);
+        CHECK(algorithms::is_included_antichains(FrozenNfa{ smaller }, FrozenNfa{ bigger }, nullptr, 0) == included);
+        CHECK(is_included(smaller, bigger, &alphabet, { { "algorithm", "antichains" },
+                                                        { "bit_state_set_threshold", "0" } }) == included);
+        cex = {};
+        CHECK(algorithms::is_universal_antichains(bigger, alphabet, &cex) == universal);
+        if (!universal) {
+            Nfa bigger_copy{ bigger };
+            CHECK(!bigger_copy.is_in_lang(cex.word));
+        }
+        CHECK(bigger.is_universal(alphabet, { { "algorithm", "antichains" }, { "bit_state_set_threshold", "0" } })
+              == universal);
+    };
+
+    SECTION("invalid threshold") {
+        const Nfa aut{ 1, { 0 }, { 0 } };
+        CHECK_THROWS_WITH(is_included(aut, aut, nullptr, { { "algorithm", "antichains" },
+                                                          { "bit_state_set_threshold", "many" } }),
+                          Catch::Matchers::ContainsSubstring("invalid value of the \"bit_state_set_threshold\" key"));
+    }
+
+    SECTION("fixed automata") {
+        Nfa a{};
+        Nfa b{};
+        FILL_WITH_AUT_A(a);
+        FILL_WITH_AUT_B(b);
+        check_same_results(a, b);
+        check_same_results(b, a);
+        check_same_results(intersection(a, b), a);
+    }
+
+    SECTION("random automata") {
+        for (size_t i{ 0 }; i < 10; ++i) {
+            const Nfa smaller{ builder::create_random_nfa_tabakov_vardi(20, 3, 1.5, 0.3) };
+            const Nfa bigger{ builder::create_random_nfa_tabakov_vardi(70, 3, 2, 0.5) };
+            check_same_results(smaller, bigger);
+            check_same_results(bigger, smaller);
+        }
+    }
+}
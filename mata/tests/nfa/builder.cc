@@ -9,6 +9,7 @@
 
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/builder.hh"
+#include "mata/parser/inter-aut.hh"
 
 using namespace mata::nfa;
 using Symbol = mata::Symbol;
@@ -143,6 +144,74 @@ TEST_CASE("parse_from_mata()") {
     }
 }
 
+TEST_CASE("parse_from_mata() of NFA-explicit without IntermediateAut") {
+    // Automata parsed directly and through the intermediate representation have to be equal.
+    auto parse_through_intermediate = [](const std::string& input) {
+        mata::IntAlphabet alphabet{};
+        return builder::construct(mata::IntermediateAut::parse_from_mf(mata::parser::parse_mf(input))[0], &alphabet);
+    };
+
+    SECTION("directly constructed") {
+        const std::string input{
+            "# Comment before the type.\n"
+            "@NFA-explicit   # Comment after the type.\n"
+            "%Alphabet-auto\n"
+            "%Initial q3 q1\n"
+            "q1 0 q2\n"
+            "\n"
+            "   q2 1 q3 # Comment.\n"
+            "q3 0 q1\n"
+            "q3 0 q3\n"
+            "%Final q2\n"
+            "%Initial q7\n"
+        };
+        const Nfa parsed{ builder::parse_from_mata(input) };
+        CHECK(parsed.num_of_states() == 4);
+        CHECK(parsed.initial.size() == 3);
+        CHECK(parsed.final.size() == 1);
+        CHECK(parsed.delta.num_of_transitions() == 4);
+        CHECK(are_equivalent(parsed, parse_through_intermediate(input)));
+    }
+
+    SECTION("numbering of states") {
+        // Initial states first, then states of the transitions, then the remaining final states, as construct() does.
+        const std::string input{
+            "@NFA-explicit\n%Alphabet-auto\n%Final q9 q2\n%Initial q5\nq2 0 q5\nq5 1 q2\nq5 0 q7\n"
+        };
+        const Nfa parsed{ builder::parse_from_mata(input) };
+        CHECK(parsed.initial == mata::utils::SparseSet<State>{ 0 });
+        CHECK(parsed.final.size() == 2);
+        CHECK(parsed.final.contains(1));
+        CHECK(parsed.final.contains(3));
+        CHECK(parsed.delta.contains(1, 0, 0));
+        CHECK(parsed.delta.contains(0, 1, 1));
+        CHECK(parsed.delta.contains(0, 0, 2));
+        CHECK(parsed.is_identical(parse_through_intermediate(input)));
+    }
+
+    SECTION("falling back to IntermediateAut") {
+        const std::vector<std::string> inputs{
+            "@NFA-explicit\n%Alphabet-auto\n%Initial q1 | q2\n%Final q2\nq1 0 q2\n",
+            "@NFA-explicit\n%Alphabet-auto\n%Initial q1\n%Final !q1\nq1 0 q2\n",
+            "@NFA-explicit\n%Alphabet-auto\n%Initial q1\n%Final \\true\nq1 0 q2\n",
+            "@NFA-explicit\n%Alphabet-auto\n%Initial q1\n%Final q2\nq1 \\\n0 q2\n",
+            "@NFA-explicit\n%Alphabet-auto\n%States-enum q1 q2\n%Initial q1\n%Final q2\nq1 0 q2\n",
+        };
+        for (const std::string& input: inputs) {
+            CHECK(are_equivalent(builder::parse_from_mata(input), parse_through_intermediate(input)));
+        }
+    }
+
+    SECTION("invalid input") {
+        CHECK_THROWS_AS(builder::parse_from_mata(std::string{ "@NFA-explicit\n%Initial q1\nq1 a q2\n" }),
+                        std::runtime_error);
+        CHECK_THROWS_AS(builder::parse_from_mata(std::string{ "@NFA-explicit\n%Initial q1\n@NFA-explicit\n" }),
+                        std::runtime_error);
+        CHECK_THROWS_AS(builder::parse_from_mata(std::string{ "@NFA-explicit\n%Initial q1\nq1 \"0 q2\n" }),
+                        std::runtime_error);
+    }
+}
+
 TEST_CASE("Create Tabakov-Vardi NFA") {
     size_t num_of_states;
     size_t alphabet_size;
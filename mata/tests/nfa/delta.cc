@@ -424,6 +424,19 @@ TEST_CASE("mata::nfa::StatePost::Moves") {
 
 }
 
+TEST_CASE("mata::nfa::StatePost::append_moves()") {
+    StatePost state_post{};
+    std::vector<std::pair<Symbol, State>> moves{ { 'b', 2 }, { 'a', 3 }, { 'b', 1 }, { 'a', 3 } };
+    state_post.append_moves(moves);
+    const StatePost::Moves appended_moves{ state_post.moves() };
+    CHECK(std::vector<Move>{ appended_moves.begin(), appended_moves.end() }
+          == std::vector<Move>{ { 'a', 3 }, { 'b', 1 }, { 'b', 2 } });
+    moves = { { 'd', 0 }, { 'c', 0 } };
+    state_post.append_moves(moves);
+    CHECK(state_post.num_of_moves() == 5);
+    CHECK(state_post.back().symbol == 'd');
+}
+
 TEST_CASE("mata::nfa::Delta::operator==()") {
     Delta delta{};
     Delta delta2{};
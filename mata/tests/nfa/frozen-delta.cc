@@ -0,0 +1,166 @@
+#include "utils.hh"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/frozen-delta.hh"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace mata::nfa;
+
+using Symbol = mata::Symbol;
+
+TEST_CASE("mata::nfa::FrozenDelta") {
+    Delta delta{};
+    SECTION("empty delta") {
+        const FrozenDelta frozen_delta{ delta };
+        CHECK(frozen_delta.empty());
+        CHECK(frozen_delta.num_of_states() == 0);
+        CHECK(frozen_delta[0].empty());
+        CHECK(frozen_delta.successors(3).empty());
+        CHECK(frozen_delta.thaw() == delta);
+    }
+
+    SECTION("access transitions") {
+        delta.add(0, 'a', 1);
+        delta.add(0, 'a', 2);
+        delta.add(0, 'b', 0);
+        delta.add(2, 'c', 1);
+        delta.allocate(4);
+        const FrozenDelta frozen_delta{ delta };
+        CHECK(!frozen_delta.empty());
+        CHECK(frozen_delta.num_of_states() == 4);
+        CHECK(frozen_delta.num_of_symbol_posts() == 3);
+        CHECK(frozen_delta.num_of_transitions() == 4);
+
+        CHECK(std::vector<Symbol>(frozen_delta.symbols(0).begin(), frozen_delta.symbols(0).end())
+              == std::vector<Symbol>{ 'a', 'b' });
+        CHECK(frozen_delta.symbols(1).empty());
+        CHECK(frozen_delta.symbols(3).empty());
+        CHECK(frozen_delta.symbols(10).empty());
+        const std::span<const State> a_targets{ frozen_delta.targets(0, 'a') };
+        CHECK(std::vector<State>(a_targets.begin(), a_targets.end()) == std::vector<State>{ 1, 2 });
+        CHECK(frozen_delta.targets(0, 'c').empty());
+        CHECK(frozen_delta.targets(1, 'a').empty());
+        const std::span<const State> successors{ frozen_delta.successors(0) };
+        CHECK(std::vector<State>(successors.begin(), successors.end()) == std::vector<State>{ 1, 2, 0 });
+
+        std::vector<Transition> transitions{};
+        for (State source{ 0 }; source < frozen_delta.num_of_states(); ++source) {
+            for (const auto& [symbol, targets]: frozen_delta[source]) {
+                for (const State target: targets) { transitions.emplace_back(source, symbol, target); }
+            }
+        }
+        CHECK(transitions == std::vector<Transition>(delta.transitions().begin(), delta.transitions().end()));
+        CHECK(frozen_delta.thaw() == delta);
+    }
+}
+
+TEST_CASE("mata::nfa::SynchronizedExistentialFrozenSymbolIterator") {
+    Delta delta{};
+    delta.add(0, 'a', 2);
+    delta.add(0, 'b', 1);
+    delta.add(1, 'a', 0);
+    delta.add(1, 'a', 2);
+    delta.add(1, 'c', 1);
+    const FrozenDelta frozen_delta{ delta };
+    SynchronizedExistentialFrozenSymbolIterator sync_iterator{ frozen_delta };
+    sync_iterator.push_back(0);
+    sync_iterator.push_back(1);
+
+    std::vector<State> targets{};
+    REQUIRE(sync_iterator.advance());
+    CHECK(sync_iterator.get_current_symbol() == 'a');
+    sync_iterator.unify_targets(targets);
+    CHECK(targets == std::vector<State>{ 0, 2 });
+    CHECK(sync_iterator.unify_targets() == StateSet{ 0, 2 });
+    CHECK(sync_iterator.synchronize_with('b'));
+    CHECK(sync_iterator.unify_targets() == StateSet{ 1 });
+    CHECK(sync_iterator.synchronize_with('c'));
+    sync_iterator.unify_targets(targets);
+    CHECK(targets == std::vector<State>{ 1 });
+    CHECK(!sync_iterator.advance());
+}
+
+TEST_CASE("mata::nfa::FrozenNfa algorithms") {
+    Nfa lhs{};
+    Nfa rhs{};
+    FILL_WITH_AUT_A(lhs);
+    FILL_WITH_AUT_B(rhs);
+
+    SECTION("thaw") {
+        CHECK(FrozenNfa{ lhs }.thaw().is_identical(lhs));
+        CHECK(FrozenNfa{ rhs }.thaw().is_identical(rhs));
+    }
+
+    SECTION("useful states and emptiness") {
+        for (Nfa aut: { lhs, rhs, Nfa{}, Nfa{ 3, { 0 }, { 2 } } }) {
+            const FrozenNfa frozen{ aut };
+            CHECK(frozen.num_of_states() == aut.num_of_states());
+            CHECK(frozen.get_useful_states() == aut.get_useful_states());
+            CHECK(frozen.is_lang_empty() == aut.is_lang_empty());
+            Run cex{};
+            CHECK(frozen.is_lang_empty(&cex) == aut.is_lang_empty());
+            if (!frozen.is_lang_empty()) {
+                CHECK(aut.is_in_lang(cex.word));
+                CHECK(cex.path.size() == cex.word.size() + 1);
+            }
+            CHECK(frozen.distances_to_final() == aut.distances_to_final());
+        }
+    }
+
+    SECTION("product") {
+        auto both_final = [](State lhs_state, State rhs_state) { (void) lhs_state; (void) rhs_state; return true; };
+        const Nfa product{ algorithms::product(lhs, rhs, [&](State l, State r) {
+            return lhs.final.contains(l) && rhs.final.contains(r); }) };
+        const FrozenNfa lhs_frozen{ lhs };
+        const FrozenNfa rhs_frozen{ rhs };
+        const Nfa frozen_product{ algorithms::product(lhs_frozen, rhs_frozen, [&](State l, State r) {
+            return lhs.final.contains(l) && rhs.final.contains(r); }) };
+        CHECK(frozen_product.is_identical(product));
+        CHECK(algorithms::product(lhs_frozen, rhs_frozen, both_final).is_identical(
+            algorithms::product(lhs, rhs, both_final)));
+
+        Nfa lhs_eps{ lhs };
+        lhs_eps.delta.add(0, EPSILON, 5);
+        lhs_eps.delta.add(5, EPSILON - 1, 1);
+        CHECK(algorithms::product(FrozenNfa{ lhs_eps }, rhs_frozen, both_final, EPSILON - 1).is_identical(
+            algorithms::product(lhs_eps, rhs, both_final, EPSILON - 1)));
+    }
+
+    SECTION("inclusion") {
+        for (auto [smaller, bigger]: std::vector<std::pair<Nfa, Nfa>>{
+                { lhs, rhs }, { rhs, lhs }, { lhs, lhs }, { intersection(lhs, rhs), rhs } }) {
+            Run cex{};
+            const bool included{ algorithms::is_included_antichains(FrozenNfa{ smaller }, FrozenNfa{ bigger }, &cex) };
+            CHECK(included == algorithms::is_included_antichains(smaller, bigger));
+            if (!included) {
+                CHECK(smaller.is_in_lang(cex.word));
+                CHECK(!bigger.is_in_lang(cex.word));
+            }
+        }
+    }
+
+    SECTION("determinize") {
+        MacrostateStore macrostates{};
+        const Nfa dfa{ determinize(FrozenNfa{ lhs }, &macrostates) };
+        CHECK(dfa.is_identical(determinize(lhs)));
+        CHECK(macrostates.size() == dfa.num_of_states());
+        CHECK(determinize(FrozenNfa{ rhs }).is_identical(determinize(rhs)));
+        CHECK(determinize(FrozenNfa{}).is_identical(determinize(Nfa{})));
+    }
+
+    SECTION("random automata") {
+        for (size_t i{ 0 }; i < 10; ++i) {
+            const Nfa smaller{ builder::create_random_nfa_tabakov_vardi(20, 3, 1.5, 0.3) };
+            const Nfa bigger{ builder::create_random_nfa_tabakov_vardi(20, 3, 2, 0.5) };
+            const FrozenNfa smaller_frozen{ smaller };
+            const FrozenNfa bigger_frozen{ bigger };
+            CHECK(algorithms::is_included_antichains(smaller_frozen, bigger_frozen)
+                  == algorithms::is_included_antichains(smaller, bigger));
+            CHECK(smaller_frozen.get_useful_states() == smaller.get_useful_states());
+            CHECK(determinize(smaller_frozen).is_identical(determinize(smaller)));
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/macrostate-store.hh"
+
+#include <algorithm>
+
+using namespace mata::nfa;
+
+TEST_CASE("mata::nfa::MacrostateStore") {
+    MacrostateStore store{};
+    CHECK(store.empty());
+    CHECK(store.find(StateSet{ 1, 2 }) == MacrostateStore::NOT_FOUND);
+
+    SECTION("insert and find") {
+        CHECK(store.insert(StateSet{ 1, 2 }) == std::pair<MacrostateId, bool>{ 0, true });
+        CHECK(store.insert(StateSet{}) == std::pair<MacrostateId, bool>{ 1, true });
+        CHECK(store.insert(StateSet{ 3 }) == std::pair<MacrostateId, bool>{ 2, true });
+        CHECK(store.insert(StateSet{ 1, 2 }) == std::pair<MacrostateId, bool>{ 0, false });
+        const std::vector<State> buffer{ 3 };
+        CHECK(store.insert(buffer) == std::pair<MacrostateId, bool>{ 2, false });
+        CHECK(store.size() == 3);
+        CHECK(store.num_of_stored_states() == 3);
+
+        CHECK(store.find(StateSet{}) == 1);
+        CHECK(store.find(StateSet{ 3 }) == 2);
+        CHECK(store.find(StateSet{ 1 }) == MacrostateStore::NOT_FOUND);
+        CHECK(store.size_of(0) == 2);
+        CHECK(store.size_of(1) == 0);
+        CHECK(store.get_state_set(0) == StateSet{ 1, 2 });
+        CHECK(store[2].size() == 1);
+        CHECK(store[2][0] == 3);
+
+        std::unordered_map<StateSet, State> subset_map{};
+        store.fill_subset_map(subset_map);
+        CHECK(subset_map == std::unordered_map<StateSet, State>{ { { 1, 2 }, 0 }, { {}, 1 }, { { 3 }, 2 } });
+
+        store.clear();
+        CHECK(store.empty());
+        CHECK(store.find(StateSet{ 1, 2 }) == MacrostateStore::NOT_FOUND);
+        CHECK(store.insert(StateSet{ 3 }) == std::pair<MacrostateId, bool>{ 0, true });
+    }
+
+    SECTION("many macrostates") {
+        store.reserve(10);
+        for (State i{ 0 }; i < 1000; ++i) {
+            CHECK(store.insert(StateSet{ i, i + 1, 2 * i + 2 }) == std::pair<MacrostateId, bool>{ i, true });
+        }
+        CHECK(store.size() == 1000);
+        for (State i{ 0 }; i < 1000; ++i) {
+            CHECK(store.find(StateSet{ i, i + 1, 2 * i + 2 }) == i);
+            CHECK(store.get_state_set(static_cast<MacrostateId>(i)) == StateSet{ i, i + 1, 2 * i + 2 });
+        }
+        CHECK(store.find(StateSet{ 0, 1 }) == MacrostateStore::NOT_FOUND);
+    }
+}
+
+TEST_CASE("mata::nfa::TupleStore") {
+    TupleStore store{};
+    const std::vector<State> tuple{ 2, 1 };
+    const std::vector<State> swapped_tuple{ 1, 2 };
+    const std::vector<State> repeated_tuple{ 1, 1 };
+    CHECK(store.insert(tuple) == std::pair<MacrostateId, bool>{ 0, true });
+    CHECK(store.insert(swapped_tuple) == std::pair<MacrostateId, bool>{ 1, true });
+    CHECK(store.insert(repeated_tuple) == std::pair<MacrostateId, bool>{ 2, true });
+    CHECK(store.insert(tuple) == std::pair<MacrostateId, bool>{ 0, false });
+    CHECK(store.find(swapped_tuple) == 1);
+    CHECK(store.find(std::vector<State>{ 2, 2 }) == TupleStore::NOT_FOUND);
+    CHECK(std::ranges::equal(store[0], tuple));
+    CHECK(std::ranges::equal(store[2], repeated_tuple));
+}
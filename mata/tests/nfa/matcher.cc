@@ -0,0 +1,110 @@
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/matcher.hh"
+#include "mata/parser/re2parser.hh"
+
+using namespace mata::nfa;
+using mata::Symbol;
+using mata::Word;
+
+namespace {
+    /// Random words over symbols [0, alphabet_size], including a symbol not used by the automata.
+    std::vector<Word> create_random_words(const size_t num_of_words, const size_t max_length,
+                                          const Symbol alphabet_size, std::mt19937& generator) {
+        std::uniform_int_distribution<size_t> length_distribution{ 0, max_length };
+        std::uniform_int_distribution<Symbol> symbol_distribution{ 0, alphabet_size };
+        std::vector<Word> words(num_of_words);
+        for (Word& word: words) {
+            word.resize(length_distribution(generator));
+            for (Symbol& symbol: word) { symbol = symbol_distribution(generator); }
+        }
+        return words;
+    }
+}
+
+TEST_CASE("mata::nfa::Matcher") {
+    SECTION("empty automaton") {
+        const Nfa aut{};
+        Matcher matcher{ aut };
+        CHECK(matcher.is_dead());
+        CHECK(!matcher.accepts());
+        CHECK(!matcher.match(Word{}));
+        CHECK(!matcher.match(Word{ 1, 2 }));
+        CHECK(!matcher.match_prefix(Word{ 1 }));
+    }
+
+    SECTION("streaming") {
+        Nfa aut{ 3, { 0 }, { 2 } };
+        aut.delta.add(0, 'a', 0);
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(0, 'b', 0);
+        aut.delta.add(1, 'b', 2);
+        Matcher matcher{ aut };
+        CHECK(!matcher.accepts());
+        matcher.feed("bba");
+        CHECK(!matcher.accepts());
+        matcher.feed('b');
+        CHECK(matcher.accepts());
+        matcher.feed(Word{ 'a', 'a' });
+        CHECK(!matcher.accepts());
+        CHECK(!matcher.is_dead());
+        matcher.feed('c');
+        CHECK(matcher.is_dead());
+        matcher.feed("ab");
+        CHECK(!matcher.accepts());
+        matcher.reset();
+        matcher.feed("ab");
+        CHECK(matcher.accepts());
+
+        CHECK(matcher.match("aab"));
+        CHECK(!matcher.match("aba"));
+        CHECK(matcher.match_prefix(Word{ 'a', 'b', 'c', 'c' }));
+        CHECK(!matcher.match_prefix(Word{ 'c', 'a', 'b' }));
+        CHECK(matcher.num_of_flushes() == 0);
+        // Macrostates {}, {0}, {0, 1}, {0, 2}.
+        CHECK(matcher.num_of_cached_states() == 4);
+    }
+
+    SECTION("symbols larger than bytes") {
+        Nfa aut{ 2, { 0 }, { 1 } };
+        aut.delta.add(0, 1000, 1);
+        aut.delta.add(1, 7, 1);
+        Matcher matcher{ aut };
+        CHECK(matcher.match(Word{ 1000, 7, 7 }));
+        CHECK(!matcher.match(Word{ 1001 }));
+        CHECK(!matcher.match(Word{ 7 }));
+    }
+
+    SECTION("random automata against is_in_lang()") {
+        std::mt19937 generator{ 42 };
+        for (size_t i{ 0 }; i < 20; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(30, 4, 1.5, 0.3) };
+            const std::vector<Word> words{ create_random_words(200, 12, 4, generator) };
+            // A small cache is flushed often.
+            for (const size_t max_cached_states: { Matcher::DEFAULT_MAX_CACHED_STATES, size_t{ 3 } }) {
+                Matcher matcher{ aut, max_cached_states };
+                const mata::BoolVector results{ matcher.match_all(words) };
+                REQUIRE(results.size() == words.size());
+                for (size_t j{ 0 }; j < words.size(); ++j) {
+                    CHECK(static_cast<bool>(results[j]) == aut.is_in_lang(Run{ words[j], {} }));
+                    CHECK(matcher.match_prefix(words[j]) == aut.is_prfx_in_lang(Run{ words[j], {} }));
+                }
+                CHECK(matcher.num_of_cached_states() <= std::max<size_t>(max_cached_states, 3));
+            }
+        }
+    }
+
+    SECTION("regular expression") {
+        Nfa aut{};
+        mata::parser::create_nfa(&aut, "(ab|c)*d+");
+        Matcher matcher{ aut };
+        CHECK(matcher.match("abcabdd"));
+        CHECK(matcher.match("d"));
+        CHECK(!matcher.match("abca"));
+        CHECK(!matcher.match("abcaxd"));
+    }
+}
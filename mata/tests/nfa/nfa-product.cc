@@ -8,6 +8,7 @@
 #include <catch2/matchers/catch_matchers_string.hpp>
 
 #include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
 
 using namespace mata::nfa;
 using namespace mata::utils;
@@ -273,6 +274,90 @@ TEST_CASE("mata::nfa::intersection() with preserving epsilon transitions")
     CHECK(result.delta.state_post(prod_map[{ 5, 8 }]).empty());
 }
 
+TEST_CASE("mata::nfa::intersection() of multiple automata")
+{
+    SECTION("no automata") {
+        CHECK_THROWS_WITH(intersection(std::span<const Nfa>{}),
+                          Catch::Matchers::ContainsSubstring("requires at least one automaton"));
+    }
+
+    SECTION("automata without initial or final states") {
+        std::vector<Nfa> automata(3);
+        FILL_WITH_AUT_A(automata[0]);
+        FILL_WITH_AUT_B(automata[1]);
+        FILL_WITH_AUT_A(automata[2]);
+        automata[2].final.clear();
+        Nfa res{ intersection(automata) };
+        CHECK(res.initial.empty());
+        CHECK(res.final.empty());
+        CHECK(res.delta.empty());
+    }
+
+    SECTION("same language as pairwise intersections") {
+        std::vector<Nfa> automata(2);
+        FILL_WITH_AUT_A(automata[0]);
+        FILL_WITH_AUT_B(automata[1]);
+        CHECK(are_equivalent(intersection(automata), intersection(automata[0], automata[1])));
+        CHECK(intersection(automata).num_of_states() == intersection(automata[0], automata[1]).num_of_states());
+        CHECK(are_equivalent(intersection(std::span<const Nfa>{ automata.data(), 1 }), automata[0]));
+
+        for (size_t i{ 0 }; i < 10; ++i) {
+            automata = {
+                builder::create_random_nfa_tabakov_vardi(4, 2, 2, 0.5),
+                builder::create_random_nfa_tabakov_vardi(6, 2, 2, 0.5),
+                builder::create_random_nfa_tabakov_vardi(3, 2, 2, 0.5),
+                builder::create_random_nfa_tabakov_vardi(5, 2, 2, 0.5),
+            };
+            const Nfa expected{
+                intersection(intersection(intersection(automata[0], automata[1]), automata[2]), automata[3]) };
+            const Nfa res{ intersection(automata) };
+            CHECK(are_equivalent(res, expected));
+            std::reverse(automata.begin(), automata.end());
+            CHECK(intersection(automata).num_of_states() == res.num_of_states());
+        }
+    }
+
+    SECTION("preserving epsilon transitions") {
+        Nfa a{ 6 };
+        a.initial.insert(0);
+        a.final.insert({1, 4, 5});
+        a.delta.add(0, EPSILON, 1);
+        a.delta.add(1, 'a', 1);
+        a.delta.add(1, 'b', 1);
+        a.delta.add(1, 'c', 2);
+        a.delta.add(2, 'b', 4);
+        a.delta.add(2, EPSILON, 3);
+        a.delta.add(3, 'a', 5);
+
+        Nfa b{ 10 };
+        b.initial.insert(0);
+        b.final.insert({2, 4, 8, 7});
+        b.delta.add(0, 'b', 1);
+        b.delta.add(0, 'a', 2);
+        b.delta.add(2, 'a', 4);
+        b.delta.add(2, EPSILON, 3);
+        b.delta.add(3, 'b', 4);
+        b.delta.add(0, 'c', 5);
+        b.delta.add(5, 'a', 8);
+        b.delta.add(5, EPSILON, 6);
+        b.delta.add(6, 'a', 9);
+        b.delta.add(6, 'b', 7);
+
+        // The same product as the product of the pair of automata.
+        std::vector<Nfa> automata{ a, b };
+        const Nfa res{ intersection(automata) };
+        CHECK(res.num_of_states() == 13);
+        CHECK(res.final.size() == 4);
+        CHECK(res.delta.num_of_transitions() == 14);
+        CHECK(are_equivalent(remove_epsilon(res), remove_epsilon(intersection(a, b))));
+
+        // The epsilon transitions of all automata, taken by each automaton on its own.
+        automata.push_back(b);
+        const Nfa res3{ intersection(automata) };
+        CHECK(are_equivalent(remove_epsilon(res3), remove_epsilon(intersection(intersection(a, b), b))));
+    }
+}
+
 TEST_CASE("mata::nfa::intersection() for profiling", "[.profiling],[intersection]")
 {
     Nfa a{6};
@@ -519,6 +519,36 @@ TEST_CASE("mata::nfa::determinize()")
         REQUIRE(result.delta.contains(subset_map[{1}], 'a', subset_map[{2}]));
     }
 
+    SECTION("macrostate store")
+    {
+        aut.initial = { 0, 1 };
+        aut.final = { 2 };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(0, 'a', 2);
+        aut.delta.add(1, 'a', 2);
+        aut.delta.add(1, 'b', 0);
+        aut.delta.add(2, 'b', 1);
+        MacrostateStore macrostates{};
+        result = determinize(aut, &macrostates);
+
+        REQUIRE(macrostates.size() == result.num_of_states());
+        CHECK(macrostates.find(StateSet{ 0, 1 }) == 0);
+        CHECK(result.initial[0]);
+        const MacrostateId a_succ{ macrostates.find(StateSet{ 1, 2 }) };
+        const MacrostateId b_succ{ macrostates.find(StateSet{ 0 }) };
+        REQUIRE(a_succ != MacrostateStore::NOT_FOUND);
+        REQUIRE(b_succ != MacrostateStore::NOT_FOUND);
+        CHECK(result.delta.contains(0, 'a', a_succ));
+        CHECK(result.delta.contains(0, 'b', b_succ));
+        CHECK(result.final[a_succ]);
+        CHECK(!result.final[b_succ]);
+        CHECK(are_equivalent(result, aut));
+
+        result = determinize(aut, &subset_map);
+        CHECK(subset_map.size() == macrostates.size());
+        for (const auto& [macrostate, state]: subset_map) { CHECK(macrostates.find(macrostate) == state); }
+    }
+
     SECTION("This broke Delta when delta[q] could cause re-allocation of post")
     {
         Nfa x{};
@@ -1897,6 +1927,7 @@ TEST_CASE("mata::nfa::is_included()")
     const std::unordered_set<std::string> ALGORITHMS = {
         "naive",
         "antichains",
+        "hkc",
     };
 
     SECTION("{} <= {}, empty alphabet")
@@ -2222,8 +2253,114 @@ q10 67 q5
             Catch::Matchers::ContainsSubstring("received an unknown value"));
         CHECK_NOTHROW(is_included(smaller, bigger, &alph));
     }
+
+    SECTION("wrong parameters 3")
+    {
+        OnTheFlyAlphabet alph{};
+        params["algorithm"] = "antichains";
+        params["threads"] = "many";
+
+        CHECK_THROWS_WITH(is_included(smaller, bigger, &alph, params),
+            Catch::Matchers::ContainsSubstring("received an invalid value of the \"threads\" key"));
+    }
 } // }}}
 
+TEST_CASE("mata::nfa::is_included() with multiple threads") {
+    Run cex{};
+    ParameterMap params{ { "algorithm", "antichains" } };
+
+    SECTION("(a+b)* !<= eps + (a+b) + (a+b)(a+b)(a* + b*)") {
+        Nfa smaller{ 2, { 1 }, { 1 } };
+        smaller.delta.add(1, 'a', 1);
+        smaller.delta.add(1, 'b', 1);
+        Nfa bigger{ 16, { 11 }, { 11, 12, 13, 14, 15 } };
+        bigger.delta.add(11, 'a', 12);
+        bigger.delta.add(11, 'b', 12);
+        bigger.delta.add(12, 'a', 13);
+        bigger.delta.add(12, 'b', 13);
+        bigger.delta.add(13, 'a', 14);
+        bigger.delta.add(14, 'a', 14);
+        bigger.delta.add(13, 'b', 15);
+        bigger.delta.add(15, 'b', 15);
+
+        for (const std::string threads: { "2", "4", "0" }) {
+            params["threads"] = threads;
+            cex = {};
+            CHECK(!is_included(smaller, bigger, &cex, nullptr, params));
+            CHECK(cex.word.size() == 4);
+            CHECK(cex.word[2] != cex.word[3]);
+            CHECK(cex.path == std::vector<State>{ 1, 1, 1, 1, 1 });
+            CHECK(is_included(bigger, smaller, nullptr, params));
+            CHECK(are_equivalent(smaller, smaller, params));
+            CHECK(!are_equivalent(smaller, bigger, params));
+        }
+    }
+
+    SECTION("random automata") {
+        params["threads"] = "4";
+        check_inclusion_on_random_automata(params, 30, 20);
+    }
+}
+
+TEST_CASE("mata::nfa::algorithms::is_included_hkc()") {
+    SECTION("random automata, inclusion") {
+        // HKC explores pairs of macrostates breadth-first, hence its counterexamples are the shortest ones.
+        check_inclusion_on_random_automata({ { "algorithm", "hkc" } }, 20, 30,
+                                           [](const Nfa& lhs, const Nfa& rhs, const Run& cex) {
+            Run shortest_cex{};
+            algorithms::is_included_naive(lhs, rhs, nullptr, &shortest_cex);
+            CHECK(cex.word.size() == shortest_cex.word.size());
+        });
+    }
+
+    SECTION("random automata, equivalence") {
+        std::mt19937 generator{ 0 };
+        for (size_t i{ 0 }; i < 30; ++i) {
+            const Nfa lhs{ builder::create_random_nfa_tabakov_vardi(20, 2, 1.5, 0.4, generator) };
+            const Nfa rhs{ builder::create_random_nfa_tabakov_vardi(20, 2, 2.5, 0.6, generator) };
+            Word equivalence_cex{};
+            const bool equivalent{ algorithms::are_equivalent_hkc(lhs, rhs, &equivalence_cex) };
+            CHECK(equivalent == are_equivalent(lhs, rhs));
+            if (!equivalent) {
+                CHECK(lhs.is_in_lang(Run{ equivalence_cex, {} }) != rhs.is_in_lang(Run{ equivalence_cex, {} }));
+            }
+        }
+    }
+}
+
+TEST_CASE("mata::nfa::is_included() and mata::nfa::Nfa::is_universal() with simulation") {
+    const ParameterMap params{ { "algorithm", "antichains" }, { "simulation", "forward" } };
+
+    SECTION("random automata, inclusion") {
+        check_inclusion_on_random_automata(params, 20, 30);
+    }
+
+    SECTION("random automata, universality") {
+        const EnumAlphabet alphabet{ 0, 1 };
+        std::mt19937 generator{ 0 };
+        for (size_t i{ 0 }; i < 30; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(20, 2, 2.5, 0.6, generator) };
+            const Nfa other{ builder::create_random_nfa_tabakov_vardi(10, 2, 1.5, 0.4, generator) };
+            for (const Nfa& checked: { aut, union_nondet(aut, complement(other, alphabet)),
+                                       union_nondet(other, complement(other, alphabet)) }) {
+                Run cex{};
+                const bool universal{ checked.is_universal(alphabet, &cex, params) };
+                CHECK(universal == checked.is_universal(alphabet));
+                if (!universal) { CHECK(!checked.is_in_lang(Run{ cex.word, {} })); }
+            }
+        }
+    }
+
+    SECTION("unknown simulation") {
+        const Nfa aut{ 1, { 0 }, { 0 } };
+        const ParameterMap backward_params{ { "algorithm", "antichains" }, { "simulation", "backward" } };
+        CHECK_THROWS_WITH(is_included(aut, aut, nullptr, backward_params),
+                          Catch::Matchers::ContainsSubstring("unknown value of the \"simulation\" key"));
+        CHECK_THROWS_WITH(aut.is_universal(EnumAlphabet{ 0 }, backward_params),
+                          Catch::Matchers::ContainsSubstring("unknown value of the \"simulation\" key"));
+    }
+}
+
 TEST_CASE("mata::nfa::are_equivalent")
 {
     Nfa smaller(10);
@@ -2234,6 +2371,7 @@ TEST_CASE("mata::nfa::are_equivalent")
     const std::unordered_set<std::string> ALGORITHMS = {
             "naive",
             "antichains",
+            "hkc",
     };
 
     SECTION("{} == {}, empty alphabet")
@@ -2947,6 +3085,57 @@ TEST_CASE("mata::nfa::algorithms::minimize_hopcroft()") {
         CHECK(aut_brz.final.size() == aut_hop.final.size());
     }
 
+    SECTION("parallel") {
+        // Large enough for the splitters to be marked in parallel.
+        const State num_of_states{ 60000 };
+        Nfa aut{ num_of_states };
+        aut.initial.insert(0);
+        for (State q{ 0 }; q < num_of_states; ++q) {
+            aut.delta.add(q, 'a', (q + 1) % num_of_states);
+            aut.delta.add(q, 'b', (q + 3) % num_of_states);
+            if (q % 3 == 0) { aut.final.insert(q); }
+        }
+        const Nfa aut_hop{ minimize_hopcroft(aut) };
+        CHECK(aut_hop.num_of_states() == 3);
+        for (const size_t num_of_threads: { 1UL, 2UL, 4UL }) {
+            const Nfa aut_hop_parallel{ minimize_hopcroft_parallel(aut, num_of_threads) };
+            CHECK(aut_hop_parallel.num_of_states() == 3);
+            CHECK(aut_hop_parallel.delta.num_of_transitions() == aut_hop.delta.num_of_transitions());
+            CHECK(are_equivalent(aut_hop_parallel, aut_hop));
+        }
+    }
+}
+
+TEST_CASE("mata::nfa::minimize()") {
+    SECTION("hopcroft") {
+        Nfa aut{};
+        FILL_WITH_AUT_A(aut);
+        const Nfa aut_brz{ minimize(aut, { { "algorithm", "brzozowski" } }) };
+        const Nfa aut_hop{ minimize(aut, { { "algorithm", "hopcroft" } }) };
+        CHECK(aut_hop.is_deterministic());
+        CHECK(are_equivalent(aut_brz, aut_hop));
+        CHECK(aut_brz.num_of_states() == aut_hop.num_of_states());
+        CHECK(minimize(aut, { { "algorithm", "hopcroft" }, { "threads", "2" } }).is_identical(aut_hop));
+        CHECK(minimize(Nfa{}, { { "algorithm", "hopcroft" } }).is_lang_empty());
+    }
+
+    SECTION("random automata") {
+        for (size_t i{ 0 }; i < 10; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(20, 3, 1.5, 0.5) };
+            const Nfa aut_hop{ minimize(aut, { { "algorithm", "hopcroft" } }) };
+            CHECK(are_equivalent(aut, aut_hop));
+            if (!aut.is_lang_empty()) {
+                CHECK(aut_hop.num_of_states() == minimize(aut, { { "algorithm", "brzozowski" } }).num_of_states());
+            }
+        }
+    }
+
+    SECTION("wrong parameters") {
+        CHECK_THROWS_WITH(minimize(Nfa{}, { { "algorithm", "bogus" } }),
+            Catch::Matchers::ContainsSubstring("received an unknown value of the \"algorithm\" key"));
+        CHECK_THROWS_WITH(minimize(Nfa{}, { { "algorithm", "hopcroft" }, { "threads", "many" } }),
+            Catch::Matchers::ContainsSubstring("received an invalid value of the \"threads\" key"));
+    }
 }
 
 TEST_CASE("mata::nfa::reduce_size_by_residual()") {
@@ -3444,6 +3633,43 @@ TEST_CASE("mata::nfa::remove_epsilon()")
     REQUIRE(aut.delta.contains(5, 'a', 5));
     REQUIRE(!aut.delta.contains(5, 'c', 9));
     REQUIRE(aut.delta.contains(5, 'a', 9));
+
+    SECTION("epsilon cycles") {
+        for (size_t i{ 0 }; i < 20; ++i) {
+            // The symbol 2 is used as epsilon.
+            const Nfa random_aut{ builder::create_random_nfa_tabakov_vardi(30, 3, 2, 0.2) };
+            const Symbol epsilon{ 2 };
+            const Nfa result{ remove_epsilon(random_aut, epsilon) };
+            CHECK(result.initial == random_aut.initial);
+            for (State state{ 0 }; state < random_aut.num_of_states(); ++state) {
+                // Epsilon closure of the state by a plain search.
+                std::vector<State> worklist{ state };
+                std::set<State> closure{ state };
+                while (!worklist.empty()) {
+                    const State closure_state{ worklist.back() };
+                    worklist.pop_back();
+                    const StatePost& state_post{ random_aut.delta[closure_state] };
+                    if (const auto epsilon_post_it{ state_post.find(epsilon) }; epsilon_post_it != state_post.end()) {
+                        for (const State target: epsilon_post_it->targets) {
+                            if (closure.insert(target).second) { worklist.push_back(target); }
+                        }
+                    }
+                }
+                std::set<Transition> expected_transitions{};
+                bool is_final{ false };
+                for (const State closure_state: closure) {
+                    is_final = is_final || random_aut.final.contains(closure_state);
+                    for (const Move& move: random_aut.delta[closure_state].moves()) {
+                        if (move.symbol != epsilon) { expected_transitions.emplace(state, move.symbol, move.target); }
+                    }
+                }
+                std::set<Transition> transitions{};
+                for (const Move& move: result.delta[state].moves()) { transitions.emplace(state, move.symbol, move.target); }
+                CHECK(transitions == expected_transitions);
+                CHECK(result.final.contains(state) == is_final);
+            }
+        }
+    }
 }
 
 TEST_CASE("Profile mata::nfa::remove_epsilon()", "[.profiling]")
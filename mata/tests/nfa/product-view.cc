@@ -0,0 +1,127 @@
+#include "utils.hh"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/product-view.hh"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace mata::nfa;
+
+using Symbol = mata::Symbol;
+
+namespace {
+    /// Materialize the whole product reachable in @p view.
+    Nfa explore(ProductView& view) {
+        Nfa result{};
+        std::vector<State> worklist{ view.initial().begin(), view.initial().end() };
+        std::vector<bool> visited(view.num_of_discovered_states(), true);
+        for (const State state: view.initial()) { result.initial.insert(state); }
+        while (!worklist.empty()) {
+            const State state{ worklist.back() };
+            worklist.pop_back();
+            if (view.is_final(state)) { result.final.insert(state); }
+            for (const SymbolPost& symbol_post: view.post(state)) {
+                for (const State target: symbol_post.targets) {
+                    result.delta.add(state, symbol_post.symbol, target);
+                    if (target >= visited.size()) { visited.resize(target + 1, false); }
+                    if (!visited[target]) { visited[target] = true; worklist.push_back(target); }
+                }
+            }
+        }
+        return result;
+    }
+}
+
+TEST_CASE("mata::nfa::ProductView") {
+    Nfa a{};
+    Nfa b{};
+    FILL_WITH_AUT_A(a);
+    FILL_WITH_AUT_B(b);
+
+    SECTION("tuples") {
+        ProductView view{ a, b };
+        CHECK(view.num_of_operands() == 2);
+        CHECK(view.initial().size() == a.initial.size() * b.initial.size());
+        for (const State state: view.initial()) {
+            const std::span<const State> tuple{ view.get_tuple(state) };
+            REQUIRE(tuple.size() == 2);
+            CHECK(a.initial.contains(tuple[0]));
+            CHECK(b.initial.contains(tuple[1]));
+            CHECK(view.is_final(state) == (a.final.contains(tuple[0]) && b.final.contains(tuple[1])));
+        }
+        const size_t num_of_initial_states{ view.num_of_discovered_states() };
+        const StatePost& post{ view.post(*view.initial().begin()) };
+        CHECK(&view.post(*view.initial().begin()) == &post);
+        CHECK(view.num_of_discovered_states() >= num_of_initial_states);
+        CHECK_THROWS(ProductView{ std::vector<const Nfa*>{} });
+    }
+
+    SECTION("same language as intersection") {
+        ProductView view{ a, b };
+        CHECK(are_equivalent(explore(view), intersection(a, b)));
+        Nfa c{};
+        FILL_WITH_AUT_C(c);
+        ProductView view3{ { &a, &b, &c } };
+        CHECK(are_equivalent(explore(view3), intersection(intersection(a, b), c)));
+        ProductView single{ a };
+        CHECK(are_equivalent(explore(single), a));
+    }
+
+    SECTION("emptiness with early termination") {
+        Nfa lhs{ 2 };
+        lhs.initial = { 0 };
+        lhs.final = { 0, 1 };
+        lhs.delta.add(0, 'a', 1);
+        Nfa rhs{ lhs };
+        ProductView view{ lhs, rhs };
+        Run run{};
+        CHECK(!view.is_lang_empty(&run));
+        CHECK(run.word.empty());
+        CHECK(run.path.size() == 1);
+        // The initial state is final, no transitions were computed.
+        CHECK(view.num_of_discovered_states() == 1);
+        CHECK(view.get_shortest_word() == mata::Word{});
+    }
+
+    SECTION("shortest word") {
+        for (size_t i{ 0 }; i < 10; ++i) {
+            const Nfa lhs{ builder::create_random_nfa_tabakov_vardi(10, 2, 1.5, 0.3) };
+            const Nfa rhs{ builder::create_random_nfa_tabakov_vardi(10, 2, 1.5, 0.3) };
+            const Nfa product{ intersection(lhs, rhs) };
+            ProductView view{ lhs, rhs };
+            const std::optional<mata::Word> word{ view.get_shortest_word() };
+            CHECK(word.has_value() == !product.is_lang_empty());
+            if (!word.has_value()) { continue; }
+            Nfa lhs_copy{ lhs };
+            Nfa rhs_copy{ rhs };
+            CHECK(lhs_copy.is_in_lang(*word));
+            CHECK(rhs_copy.is_in_lang(*word));
+            if (!word->empty()) { CHECK(product.get_words(word->size() - 1).empty()); }
+        }
+    }
+
+    SECTION("inclusion") {
+        for (size_t i{ 0 }; i < 10; ++i) {
+            const Nfa smaller{ builder::create_random_nfa_tabakov_vardi(10, 2, 1.2, 0.5) };
+            const Nfa bigger_lhs{ builder::create_random_nfa_tabakov_vardi(10, 2, 2, 0.6) };
+            const Nfa bigger_rhs{ builder::create_random_nfa_tabakov_vardi(10, 2, 2, 0.6) };
+            ProductView smaller_view{ smaller };
+            ProductView bigger_view{ bigger_lhs, bigger_rhs };
+            const Nfa bigger{ intersection(bigger_lhs, bigger_rhs) };
+            Run cex{};
+            const bool included{ algorithms::is_included_antichains(smaller_view, bigger_view, &cex) };
+            CHECK(included == is_included(smaller, bigger));
+            if (!included) {
+                Nfa smaller_copy{ smaller };
+                Nfa bigger_copy{ bigger };
+                CHECK(smaller_copy.is_in_lang(cex.word));
+                CHECK(!bigger_copy.is_in_lang(cex.word));
+            }
+            ProductView product_view{ bigger_lhs, bigger_rhs };
+            ProductView lhs_view{ bigger_lhs };
+            CHECK(algorithms::is_included_antichains(product_view, lhs_view));
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include <tuple>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/reverse-delta.hh"
+
+using namespace mata::nfa;
+
+namespace {
+    /// Transitions incoming to @p target as the index returns them.
+    std::vector<Transition> get_incoming(const ReverseDelta& reverse_delta, const State target) {
+        std::vector<Transition> transitions{};
+        for (const IncomingTransition& transition: reverse_delta[target]) {
+            transitions.emplace_back(transition.source, transition.symbol, target);
+        }
+        return transitions;
+    }
+}
+
+TEST_CASE("mata::nfa::ReverseDelta") {
+    SECTION("empty delta") {
+        const ReverseDelta reverse_delta{ Delta{} };
+        CHECK(reverse_delta.num_of_states() == 0);
+        CHECK(reverse_delta.num_of_transitions() == 0);
+        CHECK(reverse_delta[5].empty());
+    }
+
+    SECTION("incoming transitions") {
+        Delta delta{};
+        delta.add(0, 'b', 2);
+        delta.add(0, 'a', 2);
+        delta.add(1, 'a', 2);
+        delta.add(2, 'a', 0);
+        delta.add(2, 'c', 2);
+        const ReverseDelta reverse_delta{ delta };
+        CHECK(reverse_delta.num_of_states() == 3);
+        CHECK(reverse_delta.num_of_transitions() == 5);
+        CHECK(get_incoming(reverse_delta, 0) == std::vector<Transition>{ { 2, 'a', 0 } });
+        CHECK(reverse_delta[1].empty());
+        CHECK(get_incoming(reverse_delta, 2)
+              == std::vector<Transition>{ { 0, 'a', 2 }, { 1, 'a', 2 }, { 0, 'b', 2 }, { 2, 'c', 2 } });
+
+        // Indices follow the order of Delta::transitions().
+        std::vector<Transition> transitions{};
+        for (const Transition& transition: delta.transitions()) { transitions.push_back(transition); }
+        for (State target{ 0 }; target < 3; ++target) {
+            for (const IncomingTransition& transition: reverse_delta[target]) {
+                CHECK(transitions[transition.index] == Transition{ transition.source, transition.symbol, target });
+            }
+        }
+    }
+
+    SECTION("random automata") {
+        for (size_t i{ 0 }; i < 20; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(30, 3, 2.0, 0.2) };
+            const std::shared_ptr<const ReverseDelta> reverse_delta{ aut.delta.get_reverse_delta() };
+            for (State target{ 0 }; target < aut.num_of_states(); ++target) {
+                std::vector<Transition> expected{ aut.delta.get_transitions_to(target) };
+                std::sort(expected.begin(), expected.end(), [](const Transition& lhs, const Transition& rhs) {
+                    return std::tie(lhs.symbol, lhs.source) < std::tie(rhs.symbol, rhs.source);
+                });
+                CHECK(get_incoming(*reverse_delta, target) == expected);
+            }
+            CHECK(revert(aut).delta == simple_revert(aut).delta);
+            CHECK(aut.distances_to_final() == simple_revert(aut).distances_from_initial());
+            CHECK(aut.get_terminating_states() == simple_revert(aut).get_reachable_states());
+        }
+    }
+}
+
+TEST_CASE("mata::nfa::Delta::get_reverse_delta()") {
+    Delta delta{};
+    delta.add(0, 'a', 1);
+    const std::shared_ptr<const ReverseDelta> reverse_delta{ delta.get_reverse_delta() };
+    CHECK(delta.get_reverse_delta() == reverse_delta);
+
+    SECTION("copies share the index") {
+        const Delta copy{ delta };
+        CHECK(copy.get_reverse_delta() == reverse_delta);
+        Delta assigned{};
+        assigned = delta;
+        CHECK(assigned.get_reverse_delta() == reverse_delta);
+    }
+
+    SECTION("mutating operations drop the index") {
+        const auto check_rebuilt = [&](const size_t num_of_transitions) {
+            const std::shared_ptr<const ReverseDelta> rebuilt{ delta.get_reverse_delta() };
+            CHECK(rebuilt != reverse_delta);
+            CHECK(rebuilt->num_of_transitions() == num_of_transitions);
+            // The old index still describes the delta before the change.
+            CHECK(reverse_delta->num_of_transitions() == 1);
+        };
+        SECTION("add") {
+            delta.add(1, 'b', 0);
+            check_rebuilt(2);
+        }
+        SECTION("remove") {
+            delta.remove(0, 'a', 1);
+            check_rebuilt(0);
+        }
+        SECTION("mutable_state_post") {
+            delta.mutable_state_post(1).push_back(SymbolPost{ 'a', 1 });
+            check_rebuilt(2);
+        }
+        SECTION("allocate") {
+            delta.allocate(5);
+            check_rebuilt(1);
+            CHECK(delta.get_reverse_delta()->num_of_states() == 5);
+        }
+        SECTION("clear") {
+            delta.clear();
+            check_rebuilt(0);
+        }
+    }
+
+    SECTION("unify_final() uses the predecessors before the change") {
+        Nfa aut{ delta, { 0 }, { 1 } };
+        aut.delta.add(1, 'b', 2);
+        aut.final.insert(2);
+        aut.unify_final();
+        CHECK(aut.final.size() == 1);
+        const State new_final{ *aut.final.begin() };
+        CHECK(aut.delta.contains(0, 'a', new_final));
+        CHECK(aut.delta.contains(1, 'b', new_final));
+        CHECK(aut.delta.get_reverse_delta()->num_of_transitions() == aut.delta.num_of_transitions());
+    }
+}
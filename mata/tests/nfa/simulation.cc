@@ -0,0 +1,148 @@
+#include "utils.hh"
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/algorithms.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/simulation.hh"
+#include <mata/simlib/explicit_lts.hh>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+using namespace mata::nfa;
+
+using Symbol = mata::Symbol;
+
+namespace {
+    /// Forward simulation computed by simlib, as a reference.
+    Simlib::Util::BinaryRelation compute_simlib_simulation(const Nfa& aut) {
+        const Symbol unused_symbol{ aut.delta.get_max_symbol() + 1 };
+        Simlib::ExplicitLTS lts_for_simulation(aut.num_of_states());
+        for (const Transition& transition : aut.delta.transitions()) {
+            lts_for_simulation.add_transition(transition.source, transition.symbol, transition.target);
+        }
+        for (const State final_state : aut.final) {
+            lts_for_simulation.add_transition(final_state, unused_symbol, final_state);
+        }
+        lts_for_simulation.init();
+        return lts_for_simulation.compute_simulation();
+    }
+}
+
+TEST_CASE("mata::nfa::SimulationRelation") {
+    const SimulationRelation relation{ { 1, 0, SimulationRelation::NO_BLOCK, 1, 0 }, { { 0 }, { 0, 1 } } };
+    CHECK(relation.num_of_states() == 5);
+    CHECK(relation.num_of_blocks() == 2);
+    CHECK(relation.get_block(2) == SimulationRelation::NO_BLOCK);
+    CHECK(relation.get_block(7) == SimulationRelation::NO_BLOCK);
+    CHECK(relation.is_block_below(1, 0));
+    CHECK(!relation.is_block_below(0, 1));
+    CHECK(relation.get(0, 1));
+    CHECK(relation.get(0, 3));
+    CHECK(relation.get(3, 0));
+    CHECK(!relation.get(1, 0));
+    CHECK(relation.get(2, 2));
+    CHECK(!relation.get(2, 0));
+    CHECK(relation.get_quotient_projection() == std::vector<size_t>{ 0, 1, 2, 0, 1 });
+
+    const Simlib::Util::BinaryRelation binary_relation{ relation.to_binary_relation() };
+    for (State state{ 0 }; state < 5; ++state) {
+        for (State simulating_state{ 0 }; simulating_state < 5; ++simulating_state) {
+            CHECK(binary_relation.get(state, simulating_state) == relation.get(state, simulating_state));
+        }
+    }
+}
+
+TEST_CASE("mata::nfa::algorithms::compute_simulation()") {
+    SECTION("empty automaton") {
+        const SimulationRelation relation{ algorithms::compute_simulation(Nfa{}) };
+        CHECK(relation.num_of_states() == 0);
+        CHECK(relation.num_of_blocks() == 0);
+    }
+
+    SECTION("blocks") {
+        Nfa aut{ 5 };
+        aut.initial = { 0 };
+        aut.final = { 3, 4 };
+        aut.delta.add(0, 'a', 1);
+        aut.delta.add(0, 'a', 2);
+        aut.delta.add(1, 'b', 3);
+        aut.delta.add(2, 'b', 4);
+        aut.delta.add(2, 'c', 4);
+        const SimulationRelation relation{ algorithms::compute_simulation(aut) };
+        CHECK(relation.get_block(3) == relation.get_block(4));
+        CHECK(relation.get(1, 2));
+        CHECK(!relation.get(2, 1));
+        CHECK(relation.num_of_blocks() == 4);
+        CHECK(relation.get_representative(4) == 3);
+    }
+
+    SECTION("backward") {
+        Nfa aut{ 4 };
+        aut.initial = { 0, 1 };
+        aut.final = { 3 };
+        aut.delta.add(0, 'a', 2);
+        aut.delta.add(1, 'a', 3);
+        aut.delta.add(1, 'b', 3);
+        const SimulationRelation relation{ algorithms::compute_simulation(aut, { { "direction", "backward" } }) };
+        CHECK(relation.get(0, 1));
+        CHECK(relation.get(1, 0));
+        CHECK(relation.get(2, 3));
+        CHECK(!relation.get(3, 2));
+        CHECK(!relation.get(2, 0));
+    }
+
+    SECTION("random automata against simlib") {
+        for (size_t i{ 0 }; i < 20; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(30, 3, 1.5, 0.3) };
+            const SimulationRelation relation{ algorithms::compute_simulation(aut) };
+            const Simlib::Util::BinaryRelation expected{ compute_simlib_simulation(aut) };
+            const Simlib::Util::BinaryRelation backward{
+                algorithms::compute_simulation(aut, { { "direction", "backward" } }).to_binary_relation() };
+            const Nfa reverted{ revert(aut) };
+            REQUIRE(reverted.num_of_states() == aut.num_of_states());
+            const Simlib::Util::BinaryRelation expected_backward{ compute_simlib_simulation(reverted) };
+            for (State state{ 0 }; state < aut.num_of_states(); ++state) {
+                for (State simulating_state{ 0 }; simulating_state < aut.num_of_states(); ++simulating_state) {
+                    CHECK(relation.get(state, simulating_state) == expected.get(state, simulating_state));
+                    CHECK(backward.get(state, simulating_state) == expected_backward.get(state, simulating_state));
+                }
+            }
+            CHECK(are_equivalent(reduce(aut), aut));
+        }
+    }
+
+    SECTION("restricted to useful states") {
+        for (size_t i{ 0 }; i < 10; ++i) {
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(30, 3, 1.2, 0.2) };
+            const mata::BoolVector is_useful{ aut.get_useful_states() };
+            StateSet useful_states{};
+            for (State state{ 0 }; state < is_useful.size(); ++state) {
+                if (is_useful[state]) { useful_states.push_back(state); }
+            }
+            const SimulationRelation relation{ algorithms::compute_simulation(aut, { { "direction", "forward" } },
+                                                                              &useful_states) };
+            Nfa trimmed{ aut };
+            StateRenaming renaming{};
+            trimmed.trim(&renaming);
+            const SimulationRelation trimmed_relation{ algorithms::compute_simulation(trimmed) };
+            for (State state{ 0 }; state < aut.num_of_states(); ++state) {
+                if (!useful_states.contains(state)) {
+                    CHECK(relation.get_block(state) == SimulationRelation::NO_BLOCK);
+                    continue;
+                }
+                for (const State simulating_state: useful_states) {
+                    CHECK(relation.get(state, simulating_state)
+                          == trimmed_relation.get(renaming.at(state), renaming.at(simulating_state)));
+                }
+            }
+        }
+    }
+
+    SECTION("wrong parameters") {
+        CHECK_THROWS_WITH(algorithms::compute_simulation(Nfa{}, { { "direction", "sideways" } }),
+            Catch::Matchers::ContainsSubstring("received an unknown value of the \"direction\" key"));
+        CHECK_THROWS_WITH(algorithms::compute_simulation(Nfa{}, {}),
+            Catch::Matchers::ContainsSubstring("requires setting the \"direction\" key"));
+    }
+}
@@ -0,0 +1,196 @@
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/symbolic-nfa.hh"
+#include "mata/parser/inter-aut.hh"
+
+using namespace mata::nfa;
+
+namespace {
+
+constexpr size_t NUM_OF_VARS{ 3 };
+
+std::vector<BDD> create_vars(const Cudd& manager) {
+    std::vector<BDD> vars{};
+    for (size_t i{ 0 }; i < NUM_OF_VARS; ++i) { vars.push_back(manager.bddVar(static_cast<int>(i))); }
+    return vars;
+}
+
+/// All letters, i.e., conjunctions of literals of all variables.
+std::vector<BDD> create_letters(const Cudd& manager, const std::vector<BDD>& vars) {
+    std::vector<BDD> letters{ manager.bddOne() };
+    for (const BDD& var: vars) {
+        std::vector<BDD> next{};
+        for (const BDD& letter: letters) {
+            next.push_back(letter * var);
+            next.push_back(letter * !var);
+        }
+        letters = std::move(next);
+    }
+    return letters;
+}
+
+SymbolicNfa create_random_symbolic_nfa(const Cudd& manager, const std::vector<BDD>& vars, std::mt19937& generator) {
+    const size_t num_of_states{ 4 };
+    SymbolicNfa aut{ manager, num_of_states };
+    std::uniform_int_distribution<State> state_distribution(0, num_of_states - 1);
+    std::uniform_int_distribution<size_t> literal_distribution(0, 2);
+    aut.initial.insert(0);
+    aut.final.insert(state_distribution(generator));
+    for (size_t i{ 0 }; i < 8; ++i) {
+        // Guard is a conjunction of a positive, a negative, or no literal of each variable.
+        BDD guard{ manager.bddOne() };
+        for (const BDD& var: vars) {
+            const size_t literal{ literal_distribution(generator) };
+            if (literal == 1) { guard *= var; } else if (literal == 2) { guard *= !var; }
+        }
+        aut.add_transition(state_distribution(generator), guard, state_distribution(generator));
+    }
+    return aut;
+}
+
+/// Pick a word from sets of letters of a counterexample.
+std::vector<BDD> pick_word(const std::vector<BDD>& cex, const std::vector<BDD>& vars) {
+    std::vector<BDD> word{};
+    for (const BDD& letters: cex) { word.push_back(letters.PickOneMinterm(vars)); }
+    return word;
+}
+
+/// Mintermize @p lhs and @p rhs over common minterms, returning explicit automata with the same languages.
+std::pair<Nfa, Nfa> mintermize_together(const SymbolicNfa& lhs, const SymbolicNfa& rhs) {
+    // Disjoint union of both automata is mintermized, the explicit automata then differ only in the initial states.
+    const State offset{ lhs.num_of_states() };
+    SymbolicNfa both{ lhs.manager, offset + rhs.num_of_states() };
+    for (State source{ 0 }; source < lhs.num_of_states(); ++source) {
+        for (const SymbolicMove& move: lhs.moves(source)) { both.add_transition(source, move.guard, move.target); }
+    }
+    for (State source{ 0 }; source < rhs.num_of_states(); ++source) {
+        for (const SymbolicMove& move: rhs.moves(source)) {
+            both.add_transition(offset + source, move.guard, offset + move.target);
+        }
+    }
+    for (const State state: lhs.final) { both.final.insert(state); }
+    for (const State state: rhs.final) { both.final.insert(offset + state); }
+
+    Nfa explicit_lhs{ mintermize(both) };
+    Nfa explicit_rhs{ explicit_lhs };
+    for (const State state: lhs.initial) { explicit_lhs.initial.insert(state); }
+    for (const State state: rhs.initial) { explicit_rhs.initial.insert(offset + state); }
+    return { explicit_lhs, explicit_rhs };
+}
+
+} // namespace.
+
+TEST_CASE("mata::nfa::SymbolicNfa") {
+    Cudd manager{};
+    const std::vector<BDD> vars{ create_vars(manager) };
+    const BDD& a{ vars[0] };
+    const BDD& b{ vars[1] };
+
+    SECTION("transitions") {
+        SymbolicNfa aut{ manager };
+        aut.add_transition(0, a, 1);
+        aut.add_transition(0, b, 1);
+        aut.add_transition(0, a * !a, 2);
+        aut.add_transition(0, !a, 0);
+        CHECK(aut.num_of_states() == 2);
+        CHECK(aut.num_of_transitions() == 2);
+        REQUIRE(aut.moves(0).size() == 2);
+        CHECK(aut.moves(0)[0].target == 0);
+        CHECK(aut.moves(0)[1].target == 1);
+        CHECK(aut.moves(0)[1].guard == a + b);
+        CHECK(aut.moves(5).empty());
+        CHECK(!aut.is_deterministic());
+        CHECK(aut.is_lang_empty());
+        aut.initial.insert(0);
+        aut.final.insert(1);
+        std::vector<BDD> cex{};
+        CHECK(!aut.is_lang_empty(&cex));
+        CHECK(cex == std::vector<BDD>{ a + b });
+    }
+
+    SECTION("random automata") {
+        std::mt19937 generator{ 42 };
+        const std::vector<BDD> letters{ create_letters(manager, vars) };
+        std::uniform_int_distribution<size_t> letter_distribution(0, letters.size() - 1);
+        for (size_t i{ 0 }; i < 100; ++i) {
+            const SymbolicNfa lhs{ create_random_symbolic_nfa(manager, vars, generator) };
+            const SymbolicNfa rhs{ create_random_symbolic_nfa(manager, vars, generator) };
+
+            const SymbolicNfa product{ intersection(lhs, rhs) };
+            const SymbolicNfa determinized{ determinize(lhs) };
+            CHECK(determinized.is_deterministic());
+            for (size_t j{ 0 }; j < 20; ++j) {
+                std::vector<BDD> word(j % 5);
+                for (BDD& letter: word) { letter = letters[letter_distribution(generator)]; }
+                CHECK(product.is_in_lang(word) == (lhs.is_in_lang(word) && rhs.is_in_lang(word)));
+                CHECK(determinized.is_in_lang(word) == lhs.is_in_lang(word));
+            }
+
+            auto [explicit_lhs, explicit_rhs]{ mintermize_together(lhs, rhs) };
+            std::vector<BDD> cex{};
+            const bool included{ is_included(lhs, rhs, &cex) };
+            CHECK(included == mata::nfa::is_included(explicit_lhs, explicit_rhs));
+            if (!included) {
+                const std::vector<BDD> word{ pick_word(cex, vars) };
+                CHECK(lhs.is_in_lang(word));
+                CHECK(!rhs.is_in_lang(word));
+            }
+            CHECK(is_included(lhs, determinized));
+            CHECK(is_included(determinized, lhs));
+            CHECK(product.is_lang_empty() == mata::nfa::intersection(explicit_lhs, explicit_rhs).is_lang_empty());
+        }
+    }
+
+    SECTION("different managers") {
+        const SymbolicNfa lhs{ manager };
+        const SymbolicNfa rhs{ Cudd{} };
+        CHECK_THROWS_AS(intersection(lhs, rhs), std::runtime_error);
+        CHECK_THROWS_AS(is_included(lhs, rhs), std::runtime_error);
+    }
+}
+
+TEST_CASE("mata::nfa::builder::construct_symbolic()") {
+    const std::string file =
+        "@NFA-bits\n"
+        "%Initial q0\n"
+        "%Final q1\n"
+        "q0 (a1 & !a2) q1\n"
+        "q0 (a2) q0\n"
+        "q1 (a1 | a2) q1\n";
+    const std::vector<mata::IntermediateAut> auts{
+        mata::IntermediateAut::parse_from_mf(mata::parser::parse_mf(file)) };
+    REQUIRE(auts.size() == 1);
+
+    const Cudd manager{};
+    std::unordered_map<std::string, BDD> symbol_to_bddvar{};
+    builder::NameStateMap state_map{};
+    const SymbolicNfa aut{ builder::construct_symbolic(auts[0], manager, &symbol_to_bddvar, &state_map) };
+    // Names of states and variables are stored without the prefixes ("q" and "a").
+    REQUIRE(symbol_to_bddvar.size() == 2);
+    const BDD& a1{ symbol_to_bddvar.at("1") };
+    const BDD& a2{ symbol_to_bddvar.at("2") };
+    const State q{ state_map.at("0") };
+    const State r{ state_map.at("1") };
+    CHECK(aut.num_of_states() == 2);
+    CHECK(aut.initial.contains(q));
+    CHECK(aut.final.contains(r));
+    CHECK(aut.num_of_transitions() == 3);
+    CHECK(aut.is_in_lang(std::vector<BDD>{ a1 * a2, a1 * !a2, !a1 * a2 }));
+    CHECK(!aut.is_in_lang(std::vector<BDD>{ !a1 * !a2 }));
+
+    std::vector<BDD> minterms{};
+    const Nfa explicit_aut{ mintermize(aut, &minterms) };
+    CHECK(minterms.size() == 2);
+    CHECK(explicit_aut.num_of_states() == 2);
+    // Symbols do not depend on the BDD nodes, the automaton in another manager gets the same symbols.
+    const Cudd other_manager{};
+    CHECK(mintermize(builder::construct_symbolic(auts[0], other_manager)).is_identical(explicit_aut));
+
+    CHECK_THROWS_AS(builder::construct_symbolic(
+        mata::IntermediateAut::parse_from_mf(mata::parser::parse_mf("@NFA-explicit\n%Initial q0\nq0 a q0\n"))[0],
+        manager), std::runtime_error);
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/traversal-workspace.hh"
+
+using namespace mata::nfa;
+
+TEST_CASE("mata::nfa::StateQueue") {
+    StateQueue queue{};
+    CHECK(queue.empty());
+
+    // Interleave pushes and pops so that the queue wraps around and grows while wrapped.
+    State next_pushed{ 0 };
+    State next_popped{ 0 };
+    for (size_t round{ 0 }; round < 10; ++round) {
+        for (size_t i{ 0 }; i < 7 * (round + 1); ++i) { queue.push(next_pushed++); }
+        for (size_t i{ 0 }; i < 5 * (round + 1); ++i) { CHECK(queue.pop() == next_popped++); }
+        CHECK(queue.size() == next_pushed - next_popped);
+    }
+    while (!queue.empty()) { CHECK(queue.pop() == next_popped++); }
+    CHECK(next_popped == next_pushed);
+
+    queue.push(42);
+    queue.clear();
+    CHECK(queue.empty());
+}
+
+TEST_CASE("mata::nfa::TraversalWorkspace") {
+    SECTION("visited marks and parents") {
+        TraversalWorkspace workspace{};
+        workspace.start(3);
+        CHECK(workspace.visit_root(0));
+        CHECK(!workspace.visit_root(0));
+        CHECK(workspace.visit(2, 0, 'a'));
+        CHECK(workspace.visit(1, 2, 'b'));
+        CHECK(!workspace.visit(1, 0, 'c'));
+        CHECK(workspace.is_visited(1));
+        CHECK(workspace.get_parent(1) == 2);
+        CHECK(workspace.get_parent_symbol(1) == 'b');
+
+        Run run{};
+        workspace.get_run_to(1, run);
+        CHECK(run.path == std::vector<State>{ 0, 2, 1 });
+        CHECK(run.word == mata::Word{ 'a', 'b' });
+
+        workspace.start(5);
+        for (State state{ 0 }; state < 5; ++state) { CHECK(!workspace.is_visited(state)); }
+    }
+
+    SECTION("algorithms reusing a workspace") {
+        TraversalWorkspace workspace{};
+        for (size_t i{ 0 }; i < 50; ++i) {
+            // Alternate the sizes so that the workspace is reused for both bigger and smaller automata.
+            const size_t num_of_states{ i % 2 == 0 ? 40UL : 8UL };
+            const Nfa aut{ builder::create_random_nfa_tabakov_vardi(num_of_states, 2, 1.0, 0.1) };
+
+            CHECK(aut.get_reachable_states(&workspace) == aut.get_reachable_states());
+            CHECK(aut.distances_from_initial(&workspace) == aut.distances_from_initial());
+            CHECK(aut.get_useful_states(&workspace) == aut.get_useful_states());
+
+            Run cex{};
+            const bool is_empty{ aut.is_lang_empty(&cex, &workspace) };
+            CHECK(is_empty == aut.is_lang_empty_scc());
+            if (!is_empty) {
+                const std::vector<State> distances{ aut.distances_from_initial() };
+                State shortest_distance{ Limits::max_state };
+                for (const State final_state: aut.final) {
+                    shortest_distance = std::min(shortest_distance, distances[final_state]);
+                }
+                CHECK(cex.word.size() == shortest_distance);
+                CHECK(aut.is_in_lang(Run{ cex.word, {} }));
+                REQUIRE(cex.path.size() == cex.word.size() + 1);
+                CHECK(aut.initial.contains(cex.path.front()));
+                CHECK(aut.final.contains(cex.path.back()));
+                for (size_t j{ 0 }; j < cex.word.size(); ++j) {
+                    CHECK(aut.delta.contains(cex.path[j], cex.word[j], cex.path[j + 1]));
+                }
+            }
+
+            Nfa trimmed{ aut };
+            trimmed.trim(nullptr, &workspace);
+            Nfa expected{ aut };
+            expected.trim();
+            CHECK(trimmed.num_of_states() == expected.num_of_states());
+            CHECK(trimmed.delta == expected.delta);
+        }
+    }
+}
@@ -1,3 +1,16 @@
+#ifndef NFA_UTILS_HH
+#define NFA_UTILS_HH
+
+#include <functional>
+#include <random>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "mata/nfa/nfa.hh"
+#include "mata/nfa/builder.hh"
+#include "mata/nfa/algorithms.hh"
+
 // Automaton A
 #define FILL_WITH_AUT_A(x) \
     x.initial = {1, 3}; \
@@ -96,3 +109,45 @@
 	x.delta.add(2, 'a', 4); \
 	x.delta.add(1, 'a', 3); \
 
+/**
+ * Check inclusion and equivalence decided by the algorithm given by @p params against the plain antichains, on pairs of
+ *  random automata with @p num_of_states states generated from the fixed seed @p seed.
+ *
+ * For each pair of a smaller and a bigger automaton, the pairs (smaller, bigger), (bigger, smaller), (smaller ∩ bigger,
+ *  bigger), (smaller, smaller ∪ bigger) and (smaller, minimized smaller) are checked. A counterexample must be an
+ *  accepting run of the left automaton whose word is rejected by the right one.
+ *
+ * @param[in] check_cex Additional check of each counterexample, called with the checked pair.
+ */
+inline void check_inclusion_on_random_automata(
+    const mata::nfa::ParameterMap& params, const size_t num_of_states, const size_t num_of_pairs,
+    const std::function<void(const mata::nfa::Nfa&, const mata::nfa::Nfa&, const mata::nfa::Run&)>& check_cex = {},
+    const unsigned seed = 0) {
+    using namespace mata::nfa;
+    std::mt19937 generator{ seed };
+    for (size_t i{ 0 }; i < num_of_pairs; ++i) {
+        const Nfa smaller{ builder::create_random_nfa_tabakov_vardi(num_of_states, 2, 1.5, 0.4, generator) };
+        const Nfa bigger{ builder::create_random_nfa_tabakov_vardi(num_of_states, 2, 2.5, 0.6, generator) };
+        for (const auto& [lhs, rhs]: { std::pair{ smaller, bigger }, std::pair{ bigger, smaller },
+                                       std::pair{ intersection(smaller, bigger), bigger },
+                                       std::pair{ smaller, union_nondet(smaller, bigger) },
+                                       std::pair{ smaller, minimize(smaller) } }) {
+            Run cex{};
+            const bool included{ is_included(lhs, rhs, &cex, nullptr, params) };
+            CHECK(included == algorithms::is_included_antichains(lhs, rhs));
+            if (!included) {
+                CHECK(!rhs.is_in_lang(Run{ cex.word, {} }));
+                REQUIRE(cex.path.size() == cex.word.size() + 1);
+                CHECK(lhs.initial.contains(cex.path.front()));
+                CHECK(lhs.final.contains(cex.path.back()));
+                for (size_t j{ 0 }; j < cex.word.size(); ++j) {
+                    CHECK(lhs.delta.contains(cex.path[j], cex.word[j], cex.path[j + 1]));
+                }
+                if (check_cex) { check_cex(lhs, rhs, cex); }
+            }
+            CHECK(are_equivalent(lhs, rhs, params) == are_equivalent(lhs, rhs));
+        }
+    }
+}
+
+#endif // NFA_UTILS_HH
@@ -0,0 +1,126 @@
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "mata/nft/applier.hh"
+#include "mata/nft/nft.hh"
+#include "mata/nft/strings.hh"
+#include "mata/nfa/nfa.hh"
+#include "mata/parser/re2parser.hh"
+
+#include "utils.hh"
+
+using namespace mata::nft;
+using mata::nfa::Nfa;
+using mata::Symbol;
+
+namespace {
+
+const std::vector<Symbol> SYMBOLS{ 'a', 'b', EPSILON, DONT_CARE };
+
+Nfa create_random_nfa(std::mt19937& generator) {
+    const size_t num_of_states{ 4 };
+    std::uniform_int_distribution<State> state_distribution(0, num_of_states - 1);
+    std::uniform_int_distribution<size_t> symbol_distribution(0, SYMBOLS.size() - 1);
+    Nfa nfa{ num_of_states, { 0 }, { state_distribution(generator) } };
+    for (size_t i{ 0 }; i < 6; ++i) {
+        nfa.delta.add(state_distribution(generator), SYMBOLS[symbol_distribution(generator)],
+                      state_distribution(generator));
+    }
+    return nfa;
+}
+
+} // namespace.
+
+TEST_CASE("mata::nft::NftApplier") {
+    SECTION("replace reluctant regex NFT") {
+        Nfa nfa{};
+        mata::parser::create_nfa(&nfa, "da+b+ce");
+        mata::EnumAlphabet alphabet{ 'a', 'b', 'c', 'd', 'e', 'f' };
+        const Nft nft{ strings::replace_reluctant_regex("a+b+c", { 'f' }, &alphabet) };
+        const NftApplier applier{ nft };
+        Nfa result{ applier.apply(nfa) };
+        result.remove_epsilon();
+        Nfa expected{};
+        expected.initial.insert(0);
+        expected.delta.add(0, 'd', 1);
+        expected.delta.add(1, 'f', 2);
+        expected.delta.add(2, 'e', 3);
+        expected.final.insert(3);
+        CHECK(mata::nfa::are_equivalent(result, expected));
+        CHECK(!applier.is_image_empty(nfa));
+
+        // The preimage of "dfe" contains "dabce".
+        Nfa preimage{ NftApplier{ nft, 1, 0 }.apply(expected) };
+        preimage.remove_epsilon();
+        CHECK(preimage.is_in_lang(mata::Word{ 'd', 'a', 'b', 'c', 'e' }));
+        CHECK(preimage.is_in_lang(mata::Word{ 'd', 'f', 'e' }));
+        CHECK(!preimage.is_in_lang(mata::Word{ 'd', 'e' }));
+
+        // All occurrences are replaced, hence no output contains an occurrence.
+        Nfa unmatched{};
+        mata::parser::create_nfa(&unmatched, "dabce");
+        CHECK(NftApplier{ nft, 1, 0 }.is_image_empty(unmatched));
+    }
+
+    SECTION("random NFTs") {
+        std::mt19937 generator{ 42 };
+        for (const JumpMode jump_mode: { JumpMode::RepeatSymbol, JumpMode::AppendDontCares }) {
+            for (size_t i{ 0 }; i < 100; ++i) {
+                const Nft nft{ create_random_nft(2, generator) };
+                std::vector<Nfa> nfas{};
+                for (size_t j{ 0 }; j < 4; ++j) {
+                    nfas.push_back(create_random_nfa(generator));
+                    // create_from_nfa() turns epsilon transitions into jumps, reading DONT_CARE on the next levels
+                    //  with appended DONT_CAREs. Compare only epsilon-free NFAs then.
+                    if (jump_mode == JumpMode::AppendDontCares) { nfas.back().remove_epsilon(); }
+                }
+
+                const NftApplier forward{ nft, 0, 1, jump_mode };
+                const NftApplier backward{ nft, 1, 0, jump_mode };
+                const std::vector<Nfa> images{ forward.apply(nfas, 3) };
+                REQUIRE(images.size() == nfas.size());
+                for (size_t j{ 0 }; j < nfas.size(); ++j) {
+                    const Nfa expected_image{ mata::nfa::remove_epsilon(
+                        project_to(nft.apply(nfas[j], 0, jump_mode), 1, jump_mode).to_nfa_move()) };
+                    CHECK(mata::nfa::are_equivalent(mata::nfa::remove_epsilon(images[j]), expected_image));
+                    CHECK(forward.is_image_empty(nfas[j]) == expected_image.is_lang_empty());
+
+                    const Nfa expected_preimage{ mata::nfa::remove_epsilon(
+                        project_to(nft.apply_backward(nfas[j], 1, jump_mode), 0, jump_mode).to_nfa_move()) };
+                    const Nfa preimage{ mata::nfa::remove_epsilon(backward.apply(nfas[j])) };
+                    CHECK(mata::nfa::are_equivalent(preimage, expected_preimage));
+                    CHECK(backward.is_image_empty(nfas[j]) == expected_preimage.is_lang_empty());
+                }
+            }
+        }
+    }
+
+    SECTION("many paths between levels 0") {
+        // Two transitions between each two consecutive levels give 2^40 paths from state 0 back to state 0. Only the
+        //  symbols on levels 0 and 1 are kept, hence there are only 4 different steps.
+        const size_t num_of_levels{ 42 };
+        Nft nft{ Nft::with_levels(num_of_levels, num_of_levels, {}, { 0 }, { 0 }) };
+        for (State state{ 0 }; state < num_of_levels; ++state) {
+            nft.levels[state] = static_cast<Level>(state);
+            for (const Symbol symbol: { Symbol{ 'a' }, Symbol{ 'b' } }) {
+                nft.delta.add(state, symbol, (state + 1) % num_of_levels);
+            }
+        }
+        const NftApplier applier{ nft };
+        CHECK(applier.num_of_steps() == 4);
+        Nfa nfa{ 1, { 0 }, { 0 } };
+        nfa.delta.add(0, 'a', 0);
+        Nfa expected{ 1, { 0 }, { 0 } };
+        expected.delta.add(0, 'a', 0);
+        expected.delta.add(0, 'b', 0);
+        CHECK(mata::nfa::are_equivalent(applier.apply(nfa), expected));
+    }
+
+    SECTION("invalid levels") {
+        std::mt19937 generator{ 0 };
+        const Nft nft{ create_random_nft(2, generator) };
+        CHECK_THROWS_AS(NftApplier(nft, 0, 0), std::invalid_argument);
+        CHECK_THROWS_AS(NftApplier(nft, 0, 2), std::invalid_argument);
+    }
+}
@@ -3,12 +3,14 @@
 #include <unordered_set>
 #include <vector>
 #include <fstream>
+#include <cstddef>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
 #include "mata/nft/nft.hh"
 #include "mata/nft/builder.hh"
+#include "mata/nfa/binary-format.hh"
 
 using namespace mata::nft;
 using mata::nfa::Nfa;
@@ -382,3 +384,68 @@ TEST_CASE("mata::nft::parse_from_mata()") {
         }
     }
 }
+
+TEST_CASE("mata::nft::builder::mmap_binary()") {
+    const std::filesystem::path nft_file{ std::filesystem::temp_directory_path() / "mata-test-mmap_binary.bin" };
+
+    SECTION("levels") {
+        Nft nft{ Nft::with_levels(3, 4, { 0, 1, 2, 0 }, { 0 }, { 3 }) };
+        nft.delta.add(0, 'a', 1);
+        nft.delta.add(1, 'b', 2);
+        nft.delta.add(2, 'c', 3);
+        nft.delta.add(0, mata::nft::DONT_CARE, 3);
+        nft.save_binary(nft_file);
+        const Nft loaded{ mata::nft::builder::mmap_binary(nft_file) };
+        CHECK(loaded.num_of_levels == 3);
+        CHECK(loaded.levels == nft.levels);
+        CHECK(loaded.initial == nft.initial);
+        CHECK(loaded.final == nft.final);
+        CHECK(loaded.delta == nft.delta);
+    }
+
+    SECTION("missing levels") {
+        Nft nft{ Nft::with_levels(2, 3, { 0, 1, 0 }, { 0 }, { 2 }) };
+        nft.delta.add(0, 'a', 1);
+        nft.delta.add(1, 'b', 2);
+        nft.levels.resize(2);
+        nft.save_binary(nft_file);
+        const Nft loaded{ mata::nft::builder::mmap_binary(nft_file) };
+        CHECK(loaded.levels == std::vector<mata::nft::Level>{ 0, 1, mata::nft::DEFAULT_LEVEL });
+        CHECK(loaded.delta == nft.delta);
+    }
+
+    SECTION("levels out of range") {
+        Nft nft{ Nft::with_levels(2, 3, { 0, 1, 0 }, { 0 }, { 2 }) };
+        nft.save_binary(nft_file);
+        {
+            std::fstream file{ nft_file, std::ios::binary | std::ios::in | std::ios::out };
+            file.seekp(offsetof(mata::nfa::binary::Header, num_of_levels));
+            const uint64_t num_of_levels{ 1 };
+            file.write(reinterpret_cast<const char*>(&num_of_levels), sizeof(num_of_levels));
+        }
+        CHECK_THROWS_WITH(mata::nft::builder::mmap_binary(nft_file),
+                          Catch::Matchers::ContainsSubstring("levels out of range"));
+    }
+
+    SECTION("alphabet") {
+        OnTheFlyAlphabet alphabet{};
+        Nft nft{ Nft::with_levels(2, 3, { 0, 1, 0 }, { 0 }, { 2 }, &alphabet) };
+        nft.delta.add(0, alphabet.translate_symb("x"), 1);
+        nft.delta.add(1, alphabet.translate_symb("y"), 2);
+        nft.save_binary(nft_file, &alphabet);
+        OnTheFlyAlphabet loaded_alphabet{};
+        const Nft loaded{ mata::nft::builder::mmap_binary(nft_file, &loaded_alphabet) };
+        CHECK(loaded.alphabet == &loaded_alphabet);
+        CHECK(loaded_alphabet.get_symbol_map() == alphabet.get_symbol_map());
+        CHECK(loaded.delta == nft.delta);
+        CHECK(loaded.levels == nft.levels);
+    }
+
+    SECTION("NFA file") {
+        mata::nfa::Nfa{ 2, { 0 }, { 1 } }.save_binary(nft_file);
+        CHECK_THROWS_WITH(mata::nft::builder::mmap_binary(nft_file),
+                          Catch::Matchers::ContainsSubstring("is not 'NFT'"));
+    }
+
+    std::filesystem::remove(nft_file);
+}
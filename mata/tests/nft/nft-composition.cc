@@ -4,13 +4,31 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <random>
+
 #include "mata/nft/nft.hh"
+#include "mata/nft/algorithms.hh"
 #include "mata/utils/ord-vector.hh"
 
+#include "utils.hh"
+
 
 using namespace mata::nft;
 using namespace mata::utils;
 
+namespace {
+
+/// Pick @p size random levels out of @p num_of_levels levels.
+OrdVector<Level> pick_levels(const size_t num_of_levels, const size_t size, std::mt19937& generator) {
+    std::vector<Level> levels(num_of_levels);
+    for (Level level{ 0 }; level < num_of_levels; ++level) { levels[level] = level; }
+    std::shuffle(levels.begin(), levels.end(), generator);
+    levels.resize(size);
+    return OrdVector<Level>{ levels };
+}
+
+} // namespace.
+
 
 TEST_CASE("Mata::nft::compose()") {
 
@@ -421,3 +439,30 @@ TEST_CASE("Mata::nft::compose()") {
         }
     }
 }
+
+TEST_CASE("Mata::nft::compose() on the fly") {
+    std::mt19937 generator{ 42 };
+    for (const JumpMode jump_mode: { JumpMode::RepeatSymbol, JumpMode::AppendDontCares }) {
+        for (size_t i{ 0 }; i < 200; ++i) {
+            const size_t lhs_num_of_levels{ 2 + i % 3 };
+            const size_t rhs_num_of_levels{ 2 + (i / 3) % 3 };
+            const Nft lhs{ create_random_nft(lhs_num_of_levels, generator) };
+            const Nft rhs{ create_random_nft(rhs_num_of_levels, generator) };
+            const size_t num_of_sync_levels{ 1 + (i / 9) % std::min(lhs_num_of_levels - 1, rhs_num_of_levels - 1) };
+            const OrdVector<Level> lhs_sync_levels{ pick_levels(lhs_num_of_levels, num_of_sync_levels, generator) };
+            const OrdVector<Level> rhs_sync_levels{ pick_levels(rhs_num_of_levels, num_of_sync_levels, generator) };
+
+            const Nft result{ compose(lhs, rhs, lhs_sync_levels, rhs_sync_levels, jump_mode) };
+            // Skip the synchronization levels with own levels of both operands between them, for which the inserted
+            //  levels do not align the operands (the composition then loses levels, and compose_naive() does not
+            //  support them at all).
+            if (result.num_of_levels != lhs_num_of_levels + rhs_num_of_levels - 2 * num_of_sync_levels) { continue; }
+            Nft expected{
+                mata::nft::algorithms::compose_naive(lhs, rhs, lhs_sync_levels, rhs_sync_levels, jump_mode) };
+            CHECK(result.num_of_levels == expected.num_of_levels);
+            // Trimming in compose_naive() keeps the levels of the removed states, which get_one_level_aut() rejects.
+            expected.levels.resize(expected.num_of_states());
+            CHECK(are_equivalent(result, expected, jump_mode));
+        }
+    }
+}
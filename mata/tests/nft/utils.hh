@@ -1,6 +1,11 @@
 #ifndef UTILS_HH
 #define UTILS_HH
 
+#include <random>
+#include <vector>
+
+#include "mata/nft/nft.hh"
+
 // Automaton A
 #define FILL_WITH_AUT_A(x) \
     x.initial = {1, 3}; \
@@ -99,4 +104,29 @@
 	x.delta.add(2, 'a', 4); \
 	x.delta.add(1, 'a', 3); \
 
+/// Create a random NFT with jumps, epsilons and DONT_CAREs, with all initial and final states on level 0.
+inline mata::nft::Nft create_random_nft(const size_t num_of_levels, std::mt19937& generator) {
+    using namespace mata::nft;
+    const size_t num_of_states{ 6 };
+    std::uniform_int_distribution<Level> level_distribution(0, static_cast<Level>(num_of_levels - 1));
+    std::uniform_int_distribution<State> state_distribution(0, num_of_states - 1);
+    const std::vector<mata::Symbol> symbols{ 'a', 'b', EPSILON, DONT_CARE };
+    std::uniform_int_distribution<size_t> symbol_distribution(0, symbols.size() - 1);
+
+    Levels levels(num_of_states);
+    for (Level& level: levels) { level = level_distribution(generator); }
+    levels[0] = 0;
+    levels[num_of_states - 1] = 0;
+    Nft nft{ num_of_states, { 0 }, { num_of_states - 1 }, levels, num_of_levels };
+    for (size_t i{ 0 }; i < 12; ++i) {
+        const State source{ state_distribution(generator) };
+        const State target{ state_distribution(generator) };
+        // Transitions lead to a higher level, or (possibly jumping over the remaining levels) to level 0.
+        if (levels[target] > levels[source] || levels[target] == 0) {
+            nft.delta.add(source, symbols[symbol_distribution(generator)], target);
+        }
+    }
+    return nft;
+}
+
 #endif // UTILS_HH
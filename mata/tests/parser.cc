@@ -3,6 +3,7 @@
 
 #include "mata/utils/utils.hh"
 #include "mata/parser/parser.hh"
+#include "mata/parser/lexer.hh"
 #include "mata/parser/inter-aut.hh"
 #include "mata/nfa/nfa.hh"
 #include "mata/nfa/builder.hh"
@@ -670,6 +671,54 @@ TEST_CASE("correct use of mata::Parser::parse_mf()")
 } // parse_mf }}}
 
 
+TEST_CASE("mata::parser::Lexer")
+{ // {{{
+	std::vector<Token> tokens;
+
+	SECTION("lines")
+	{
+		Lexer lexer("  @Type \n\n\t%key a\r\nlast");
+		REQUIRE('@' == lexer.peek_line());
+		REQUIRE("@Type " == lexer.next_line());
+		REQUIRE('%' == lexer.peek_line());
+		REQUIRE("%key a\r" == lexer.next_line());
+		REQUIRE('l' == lexer.peek_line());
+		REQUIRE("last" == lexer.next_line());
+		REQUIRE('\0' == lexer.peek_line());
+		REQUIRE(lexer.position() == 23);
+	}
+
+	SECTION("tokens")
+	{
+		Lexer::tokenize_line("q1 (a1&!a2)| \"x \\\"y\" q2 # comment", tokens);
+		REQUIRE(tokens.size() == 10);
+		REQUIRE(tokens[0].text == "q1");
+		REQUIRE(tokens[1].text == "(");
+		REQUIRE(tokens[2].text == "a1");
+		REQUIRE(tokens[3].text == "&");
+		REQUIRE(tokens[4].text == "!");
+		REQUIRE(tokens[5].text == "a2");
+		REQUIRE(tokens[6].text == ")");
+		REQUIRE(tokens[7].text == "|");
+		REQUIRE(tokens[8].quoted);
+		REQUIRE(tokens[8].escaped);
+		REQUIRE(tokens[8].to_string() == "x \"y");
+		REQUIRE(tokens[9].text == "q2");
+		REQUIRE(!tokens[9].quoted);
+	}
+
+	SECTION("errors")
+	{
+		CHECK_THROWS_WITH(Lexer::tokenize_line("q1 \"a q2", tokens),
+			Catch::Matchers::ContainsSubstring("missing ending quotes"));
+		CHECK_THROWS_WITH(Lexer::tokenize_line("q1 a\"b\" q2", tokens),
+			Catch::Matchers::ContainsSubstring("misplaced quotes"));
+		CHECK_THROWS_WITH(Lexer::tokenize_line("q1 %key", tokens),
+			Catch::Matchers::ContainsSubstring("invalid position of %KEY"));
+	}
+} // Lexer }}}
+
+
 TEST_CASE("parsing automata to intermediate representation")
 { // {{{
     Parsed parsed;
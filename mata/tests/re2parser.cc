@@ -1905,3 +1905,63 @@ TEST_CASE("Foldcase") {
         CHECK(are_equivalent(nfa, result));
     }
 }
+
+TEST_CASE("mata::parser::create_nfa() Glushkov and Thompson constructions") {
+    using mata::parser::RegexConstruction;
+    constexpr Symbol epsilon{ 306 };
+
+    SECTION("Same languages as through RE2 program") {
+        const std::vector<std::string> patterns{
+            "", "a", "abc", "a*", "a+b+a*", "(a+(b+)a*)", "b|(a+)", "b*ca+", "[abcd]*e+", "[abcd]*.*", "[^a-c]",
+            "(ha)+", "(a|b)*abb", "a{2,4}", "(ab){3}", "(a?b)*c?", "x(a|bc|)*y", "(?i)aBc", "(?i)[a-c]x",
+            "^abc$", "a\\bb", "[\\x00-\\x7F]+", "((a|b)*|c+)d", "a(aaaa|aaaaaaa)*", "(cd(abcde)*)|(a(aaa)*)",
+            "[^\\x00-\\xFF]a|b", "(?s).b",
+        };
+        for (const std::string& pattern: patterns) {
+            Nfa prog;
+            mata::parser::create_nfa(&prog, pattern);
+            Nfa glushkov;
+            mata::parser::create_nfa(&glushkov, pattern, false, epsilon, false, Encoding::Latin1,
+                                     RegexConstruction::Glushkov);
+            Nfa thompson;
+            mata::parser::create_nfa(&thompson, pattern, true, epsilon, false, Encoding::Latin1,
+                                     RegexConstruction::Thompson);
+            Nfa thompson_without_epsilon;
+            mata::parser::create_nfa(&thompson_without_epsilon, pattern, false, epsilon, true, Encoding::Latin1,
+                                     RegexConstruction::Thompson);
+            INFO("pattern " << pattern);
+            CHECK(are_equivalent(glushkov, prog));
+            CHECK(are_equivalent(remove_epsilon(thompson, epsilon), prog));
+            CHECK(are_equivalent(thompson_without_epsilon, prog));
+            CHECK(glushkov.delta.get_used_symbols().count(epsilon) == 0);
+            CHECK(glushkov.initial.size() == 1);
+        }
+    }
+
+    SECTION("Glushkov automaton has a state for each position") {
+        Nfa nfa;
+        mata::parser::create_nfa(&nfa, "(ab|c)*d", false, epsilon, false, Encoding::Latin1,
+                                 RegexConstruction::Glushkov);
+        CHECK(nfa.num_of_states() == 5);
+        CHECK(nfa.delta.num_of_transitions() == 10);
+        CHECK(nfa.final.size() == 1);
+        CHECK(nfa.is_in_lang(Word{ 'a', 'b', 'c', 'd' }));
+        CHECK(!nfa.is_in_lang(Word{ 'a', 'd' }));
+    }
+
+    SECTION("Thompson automaton is linear in the size of the regex") {
+        Nfa nfa;
+        mata::parser::create_nfa(&nfa, "(a|b)*", true, epsilon, false, Encoding::Latin1,
+                                 RegexConstruction::Thompson);
+        // RE2 parses (a|b) as the character class [ab].
+        CHECK(nfa.num_of_states() == 4);
+        CHECK(nfa.delta.num_of_transitions() == 6);
+        CHECK(nfa.is_in_lang(Word{ epsilon, 'a', epsilon, 'b', epsilon }));
+    }
+
+    SECTION("UTF-8 encoding is not supported") {
+        Nfa nfa;
+        CHECK_THROWS_AS(mata::parser::create_nfa(&nfa, "a", false, epsilon, true, Encoding::UTF8,
+                                                 RegexConstruction::Glushkov), std::runtime_error);
+    }
+}
@@ -152,6 +152,112 @@ TEST_CASE("mata::nfa::SegNfa::noodlify()")
     }
 }
 
+TEST_CASE("mata::nfa::SegNfa::NoodleGenerator") {
+    Nfa aut{ 20 };
+    aut.initial.insert({ 0, 1, 2 });
+    aut.final.insert({ 11, 12, 13, 14, 15, 16 });
+    aut.delta.add(0, 'e', 3);
+    aut.delta.add(0, 'e', 4);
+    aut.delta.add(0, 'e', 5);
+    aut.delta.add(1, 'e', 3);
+    aut.delta.add(1, 'e', 4);
+    aut.delta.add(2, 'e', 5);
+    aut.delta.add(3, 'e', 6);
+    aut.delta.add(3, 'e', 7);
+    aut.delta.add(4, 'e', 8);
+    aut.delta.add(4, 'e', 9);
+    aut.delta.add(5, 'e', 10);
+    aut.delta.add(6, 'e', 11);
+    aut.delta.add(7, 'e', 12);
+    aut.delta.add(8, 'e', 13);
+    aut.delta.add(8, 'e', 14);
+    aut.delta.add(9, 'e', 15);
+    aut.delta.add(10, 'e', 16);
+    const std::vector<seg_nfa::Noodle> noodles{ seg_nfa::noodlify(aut, 'e') };
+    REQUIRE(noodles.size() == 12);
+
+    const auto are_equivalent_noodles = [](const seg_nfa::Noodle& lhs, const seg_nfa::Noodle& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                          [](const auto& lhs_segment, const auto& rhs_segment) {
+                              return are_equivalent(*lhs_segment, *rhs_segment);
+                          });
+    };
+
+    SECTION("On demand") {
+        seg_nfa::NoodleGenerator generator{ aut, 'e' };
+        for (const seg_nfa::Noodle& noodle: noodles) {
+            const std::optional<seg_nfa::Noodle> generated{ generator.next() };
+            REQUIRE(generated.has_value());
+            CHECK(are_equivalent_noodles(*generated, noodle));
+        }
+        CHECK(!generator.next().has_value());
+        CHECK(!generator.next().has_value());
+    }
+
+    SECTION("Stopped production") {
+        seg_nfa::NoodleGenerator generator{ aut, 'e' };
+        size_t num_of_consumed{ 0 };
+        CHECK(!generator.produce([&](seg_nfa::Noodle&&) { return ++num_of_consumed < 5; }));
+        CHECK(num_of_consumed == 5);
+        const std::optional<seg_nfa::Noodle> generated{ generator.next() };
+        REQUIRE(generated.has_value());
+        CHECK(are_equivalent_noodles(*generated, noodles[5]));
+    }
+
+    SECTION("Parallel production") {
+        seg_nfa::NoodleGenerator generator{ aut, 'e' };
+        REQUIRE(generator.next().has_value());
+        std::vector<seg_nfa::Noodle> produced{};
+        CHECK(generator.produce([&](seg_nfa::Noodle&& noodle) {
+            produced.push_back(std::move(noodle));
+            return true;
+        }, 3));
+        CHECK(produced.size() == noodles.size() - 1);
+        for (auto noodle_it{ noodles.begin() + 1 }; noodle_it != noodles.end(); ++noodle_it) {
+            CHECK(std::any_of(produced.begin(), produced.end(), [&](const seg_nfa::Noodle& noodle) {
+                return are_equivalent_noodles(noodle, *noodle_it);
+            }));
+        }
+        CHECK(!generator.next().has_value());
+    }
+
+    SECTION("Stopped parallel production") {
+        seg_nfa::NoodleGenerator generator{ aut, 'e' };
+        REQUIRE(generator.next().has_value());
+        size_t num_of_consumed{ 0 };
+        CHECK(!generator.produce([&](seg_nfa::Noodle&&) { return ++num_of_consumed < 1; }, 3));
+        CHECK(num_of_consumed == 1);
+        CHECK(!generator.next().has_value());
+    }
+
+    SECTION("Only connected combinations of epsilon transitions") {
+        // Two disconnected lanes, 'a's and 'b's, over many depths: 2^num_of_depths combinations, two noodles.
+        constexpr State num_of_depths{ 24 };
+        Nfa lanes{};
+        lanes.initial.insert(0);
+        for (State depth{ 0 }; depth <= num_of_depths; ++depth) {
+            const State a_lane{ 1 + 4 * depth };
+            const State b_lane{ 3 + 4 * depth };
+            lanes.delta.add(depth == 0 ? 0 : a_lane - 1, 'a', a_lane);
+            lanes.delta.add(depth == 0 ? 0 : b_lane - 1, 'b', b_lane);
+            if (depth < num_of_depths) {
+                lanes.delta.add(a_lane, 'e', a_lane + 3);
+                lanes.delta.add(b_lane, 'e', b_lane + 3);
+            } else {
+                lanes.final.insert({ a_lane, b_lane });
+            }
+        }
+        seg_nfa::NoodleGenerator generator{ lanes, 'e' };
+        size_t num_of_noodles{ 0 };
+        CHECK(generator.produce([&](seg_nfa::Noodle&& noodle) {
+            CHECK(noodle.size() == num_of_depths + 1);
+            ++num_of_noodles;
+            return true;
+        }));
+        CHECK(num_of_noodles == 2);
+    }
+}
+
 TEST_CASE("mata::nfa::SegNfa::noodlify_for_equation()") {
     SECTION("Empty input") {
         CHECK(seg_nfa::noodlify_for_equation(std::vector<std::reference_wrapper<Nfa>>{}, Nfa{}).empty());
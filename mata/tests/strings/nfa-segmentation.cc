@@ -188,3 +188,45 @@ TEST_CASE("mata::nfa::Segmentation::split_segment_automaton()") {
         CHECK(segments[2].delta.num_of_transitions() == 0);
     }
 }
+
+TEST_CASE("mata::nfa::Segmentation::get_segment_view()") {
+    constexpr Symbol epsilon{ 'e' };
+    Nfa aut(10);
+    aut.initial.insert(0);
+    aut.final.insert(6);
+    aut.delta.add(0, 'a', 1);
+    aut.delta.add(1, epsilon, 2);
+    aut.delta.add(1, epsilon, 3);
+    aut.delta.add(2, 'b', 4);
+    aut.delta.add(3, 'a', 4);
+    aut.delta.add(4, epsilon, 5);
+    aut.delta.add(5, 'c', 6);
+    aut.delta.add(9, 'a', 0);
+
+    seg_nfa::Segmentation segmentation{ aut, { epsilon } };
+    CHECK(segmentation.get_epsilon_transitions() == std::vector<std::vector<Transition>>{
+        { { 1, epsilon, 2 }, { 1, epsilon, 3 } }, { { 4, epsilon, 5 } } });
+    REQUIRE(segmentation.num_of_segments() == 3);
+
+    const seg_nfa::Segmentation::SegmentView view{ segmentation.get_segment_view(1) };
+    CHECK(view.num_of_states() == 3);
+    CHECK(view.original_state(0) == 2);
+    CHECK(view.segment_state(4) == 2);
+    CHECK(!view.contains(1));
+    CHECK(!view.contains(9));
+    const Nfa segment{ view.to_nfa() };
+    CHECK(segment.initial == SparseSet<State>{ 0, 1 });
+    CHECK(segment.final == SparseSet<State>{ 2 });
+    CHECK(segment.delta.num_of_transitions() == 2);
+    CHECK(segment.delta.contains(0, 'b', 2));
+    CHECK(segment.delta.contains(1, 'a', 2));
+
+    const std::vector<Nfa>& untrimmed_segments{ segmentation.get_untrimmed_segments() };
+    for (size_t segment_idx{ 0 }; segment_idx < segmentation.num_of_segments(); ++segment_idx) {
+        CHECK(are_equivalent(segmentation.get_segment_view(segment_idx).to_nfa(), untrimmed_segments[segment_idx]));
+    }
+    CHECK(segmentation.get_visited_eps().at(5) == std::map<Symbol, unsigned>{ { epsilon, 2 } });
+    CHECK(segmentation.get_visited_eps().at(1) == std::map<Symbol, unsigned>{ { epsilon, 0 } });
+    // The initial state is reached only from the unreached state 9.
+    CHECK(!segmentation.get_visited_eps().contains(0));
+}
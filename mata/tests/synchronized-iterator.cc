@@ -110,6 +110,39 @@ TEST_CASE("mata::utils::SynchronizedIterator")
         REQUIRE(*current[1]==2);
         REQUIRE(*current[2]==2);
         REQUIRE(!iu.advance());
+
+        // Position[0] advances when synchronizing with a later position.
+        iu.reset();
+        OrdVector<int> v6{1, 3};
+        OrdVector<int> v7{1};
+        OrdVector<int> v8{3};
+
+        push_back(iu,v6);
+        push_back(iu,v7);
+        push_back(iu,v8);
+
+        REQUIRE(!iu.advance());
+
+        iu.reset();
+        OrdVector<int> v9{1, 3, 5};
+        OrdVector<int> v10{1, 3, 4, 5};
+        OrdVector<int> v11{3, 5};
+
+        push_back(iu,v9);
+        push_back(iu,v10);
+        push_back(iu,v11);
+
+        REQUIRE(iu.advance());
+        current = iu.get_current();
+        REQUIRE(*current[0]==3);
+        REQUIRE(*current[1]==3);
+        REQUIRE(*current[2]==3);
+        REQUIRE(iu.advance());
+        current = iu.get_current();
+        REQUIRE(*current[0]==5);
+        REQUIRE(*current[1]==5);
+        REQUIRE(*current[2]==5);
+        REQUIRE(!iu.advance());
     }
 
     SECTION("SynchronizedExistentialIterator, basic functionality")